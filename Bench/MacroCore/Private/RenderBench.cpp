@@ -0,0 +1,121 @@
+#include <benchmark/benchmark.h>
+
+#include <thread>
+
+#include "NMCore/FrameHistory.hpp"
+#include "NMCore/GBuffer.hpp"
+#include "NMCore/Scene/SceneLibrary.hpp"
+
+// Fixed resolutions so results stay comparable between runs and machines
+static const std::vector<std::pair<int64_t, int64_t>> BENCH_RESOLUTIONS = {{320, 180}, {640, 360}};
+
+// Deterministic tile order so runs only differ in scheduling
+constexpr uint64_t BENCH_SEED = 1;
+
+// Render a canonical scene end to end: ray generation, BVH traversal, shading, reflections and canvas writes.
+// Arg 0 selects the resolution, arg 1 the thread count (0 = all available threads).
+static void BM_Render(benchmark::State& state, const std::string& sceneName)
+{
+    std::size_t width = static_cast<std::size_t>(BENCH_RESOLUTIONS[static_cast<std::size_t>(state.range(0))].first);
+    std::size_t height = static_cast<std::size_t>(BENCH_RESOLUTIONS[static_cast<std::size_t>(state.range(0))].second);
+
+    SNMScene scene = NMSceneLibrary::Create(sceneName, width, height);
+    scene.world.BuildBVH();
+    scene.camera.SetSeed(BENCH_SEED);
+
+    NMCanvas image(width, height, DEFAULT_COLOR, ENMCanvasLayout::Tiled);
+    for (auto _ : state)
+    {
+        scene.camera.Render(scene.world, &image, state.range(1));
+        benchmark::ClobberMemory();
+    }
+
+    state.counters["pixels/s"] =
+        benchmark::Counter(static_cast<double>(width * height), benchmark::Counter::kIsIterationInvariantRate);
+    state.SetLabel(std::to_string(width) + "x" + std::to_string(height));
+}
+
+// Re-light a rendered frame from its G-buffer, as after a material or light color change: no primary rays or shadow
+// rays, only lighting and reflections. Same args as BM_Render.
+static void BM_Reshade(benchmark::State& state, const std::string& sceneName)
+{
+    std::size_t width = static_cast<std::size_t>(BENCH_RESOLUTIONS[static_cast<std::size_t>(state.range(0))].first);
+    std::size_t height = static_cast<std::size_t>(BENCH_RESOLUTIONS[static_cast<std::size_t>(state.range(0))].second);
+
+    SNMScene scene = NMSceneLibrary::Create(sceneName, width, height);
+    scene.world.BuildBVH();
+    scene.camera.SetSeed(BENCH_SEED);
+
+    NMGBuffer gBuffer;
+    scene.camera.SetGBuffer(&gBuffer);
+
+    NMCanvas image(width, height, DEFAULT_COLOR, ENMCanvasLayout::Tiled);
+    scene.camera.Render(scene.world, &image, state.range(1));
+    for (auto _ : state)
+    {
+        scene.camera.Reshade(scene.world, &image, state.range(1));
+        benchmark::ClobberMemory();
+    }
+
+    state.counters["pixels/s"] =
+        benchmark::Counter(static_cast<double>(width * height), benchmark::Counter::kIsIterationInvariantRate);
+    state.SetLabel(std::to_string(width) + "x" + std::to_string(height));
+}
+
+// Preview frames of a camera turning a little every frame: the previous frame is reprojected and only the disoccluded
+// pixels are traced, as in interactive scene browsing. Same args as BM_Render.
+static void BM_Reproject(benchmark::State& state, const std::string& sceneName)
+{
+    std::size_t width = static_cast<std::size_t>(BENCH_RESOLUTIONS[static_cast<std::size_t>(state.range(0))].first);
+    std::size_t height = static_cast<std::size_t>(BENCH_RESOLUTIONS[static_cast<std::size_t>(state.range(0))].second);
+
+    SNMScene scene = NMSceneLibrary::Create(sceneName, width, height);
+    scene.world.BuildBVH();
+    scene.camera.SetSeed(BENCH_SEED);
+
+    NMFrameHistory history;
+    scene.camera.SetFrameHistory(&history);
+
+    NMCanvas image(width, height, DEFAULT_COLOR, ENMCanvasLayout::Tiled);
+    scene.camera.Render(scene.world, &image, state.range(1));
+
+    // Turn back and forth so the view stays on the scene
+    int frame = 0;
+    for (auto _ : state)
+    {
+        float step = (frame++ / 20) % 2 == 0 ? 0.01f : -0.01f;
+        scene.camera.SetTransform(NMMatrix::RotationY(step) * scene.camera.GetTransform());
+        scene.camera.Reproject(scene.world, &image, state.range(1), false);
+        benchmark::ClobberMemory();
+    }
+
+    state.counters["pixels/s"] =
+        benchmark::Counter(static_cast<double>(width * height), benchmark::Counter::kIsIterationInvariantRate);
+    state.SetLabel(std::to_string(width) + "x" + std::to_string(height));
+}
+
+static void RegisterSceneBenchmarks(const std::string& prefix, void (*function)(benchmark::State&, const std::string&))
+{
+    for (const std::string& name : NMSceneLibrary::GetNames())
+    {
+        benchmark::internal::Benchmark* bench = benchmark::RegisterBenchmark((prefix + name).c_str(), function, name);
+        for (int64_t resolution = 0; resolution < static_cast<int64_t>(BENCH_RESOLUTIONS.size()); ++resolution)
+        {
+            bench->Args({resolution, 1});
+            if (std::thread::hardware_concurrency() > 1)
+            {
+                bench->Args({resolution, 0});
+            }
+        }
+        bench->ArgNames({"resolution", "threads"})->Unit(benchmark::kMillisecond)->UseRealTime();
+    }
+}
+
+static void RegisterRenderBenchmarks()
+{
+    RegisterSceneBenchmarks("BM_Render/", BM_Render);
+    RegisterSceneBenchmarks("BM_Reshade/", BM_Reshade);
+    RegisterSceneBenchmarks("BM_Reproject/", BM_Reproject);
+}
+
+static const int RENDER_BENCHMARKS_REGISTERED = (RegisterRenderBenchmarks(), 0);
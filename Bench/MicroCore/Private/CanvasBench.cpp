@@ -0,0 +1,160 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "NMCore/Canvas.hpp"
+
+constexpr std::size_t BENCH_CANVAS_WIDTH = 1920;
+constexpr std::size_t BENCH_CANVAS_HEIGHT = 1080;
+constexpr std::size_t BENCH_RENDER_TILE_SIZE = 16;
+
+// Write every pixel tile-by-tile in a shuffled tile order, the way the renderer fills the canvas
+template <ENMCanvasLayout Layout> static void BM_Canvas_WriteTiles(benchmark::State& state)
+{
+    NMCanvas canvas(BENCH_CANVAS_WIDTH, BENCH_CANVAS_HEIGHT, DEFAULT_COLOR, Layout);
+
+    std::vector<std::size_t> tiles;
+    std::size_t tileColumns = (BENCH_CANVAS_WIDTH + BENCH_RENDER_TILE_SIZE - 1) / BENCH_RENDER_TILE_SIZE;
+    std::size_t tileRows = (BENCH_CANVAS_HEIGHT + BENCH_RENDER_TILE_SIZE - 1) / BENCH_RENDER_TILE_SIZE;
+    for (std::size_t i = 0; i < tileColumns * tileRows; ++i)
+    {
+        tiles.push_back(i);
+    }
+    std::mt19937 g(42);
+    std::shuffle(tiles.begin(), tiles.end(), g);
+
+    NMColor color(0.25f, 0.5f, 0.75f);
+    for (auto _ : state)
+    {
+        for (std::size_t tile : tiles)
+        {
+            std::size_t startX = (tile % tileColumns) * BENCH_RENDER_TILE_SIZE;
+            std::size_t startY = (tile / tileColumns) * BENCH_RENDER_TILE_SIZE;
+            for (std::size_t y = startY; y < startY + BENCH_RENDER_TILE_SIZE; ++y)
+            {
+                for (std::size_t x = startX; x < startX + BENCH_RENDER_TILE_SIZE; ++x)
+                {
+                    canvas.WritePixel(x, y, color);
+                }
+            }
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(BENCH_CANVAS_WIDTH * BENCH_CANVAS_HEIGHT));
+}
+BENCHMARK_TEMPLATE(BM_Canvas_WriteTiles, ENMCanvasLayout::Linear);
+BENCHMARK_TEMPLATE(BM_Canvas_WriteTiles, ENMCanvasLayout::Tiled);
+
+// Upscale the canvas to a larger window with bilinear reconstruction, as Application::DrawFrame does
+template <ENMCanvasLayout Layout> static void BM_Canvas_BilinearUpscale(benchmark::State& state)
+{
+    NMCanvas canvas(BENCH_CANVAS_WIDTH / 2, BENCH_CANVAS_HEIGHT / 2, NMColor(0.5f, 0.5f, 0.5f), Layout);
+
+    for (auto _ : state)
+    {
+        NMColor sum;
+        for (std::size_t y = 0; y < BENCH_CANVAS_HEIGHT; ++y)
+        {
+            for (std::size_t x = 0; x < BENCH_CANVAS_WIDTH; ++x)
+            {
+                sum += canvas.SampleBilinear(static_cast<float>(x) * 0.5f, static_cast<float>(y) * 0.5f);
+            }
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(BENCH_CANVAS_WIDTH * BENCH_CANVAS_HEIGHT));
+}
+BENCHMARK_TEMPLATE(BM_Canvas_BilinearUpscale, ENMCanvasLayout::Linear);
+BENCHMARK_TEMPLATE(BM_Canvas_BilinearUpscale, ENMCanvasLayout::Tiled);
+
+// A separable filter's vertical pass walks columns, touching a new row (cache line and page) per pixel
+template <ENMCanvasLayout Layout> static void BM_Canvas_VerticalFilter(benchmark::State& state)
+{
+    NMCanvas canvas(BENCH_CANVAS_WIDTH, BENCH_CANVAS_HEIGHT, NMColor(0.5f, 0.5f, 0.5f), Layout);
+
+    for (auto _ : state)
+    {
+        NMColor sum;
+        for (std::size_t x = 0; x < BENCH_CANVAS_WIDTH; ++x)
+        {
+            for (std::size_t y = 1; y + 1 < BENCH_CANVAS_HEIGHT; ++y)
+            {
+                sum += canvas.ReadPixel(x, y - 1) * 0.25f + canvas.ReadPixel(x, y) * 0.5f
+                       + canvas.ReadPixel(x, y + 1) * 0.25f;
+            }
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(BENCH_CANVAS_WIDTH * BENCH_CANVAS_HEIGHT));
+}
+BENCHMARK_TEMPLATE(BM_Canvas_VerticalFilter, ENMCanvasLayout::Linear);
+BENCHMARK_TEMPLATE(BM_Canvas_VerticalFilter, ENMCanvasLayout::Tiled);
+
+template <ENMCanvasLayout Layout> static void BM_Canvas_ToLinear(benchmark::State& state)
+{
+    NMCanvas canvas(BENCH_CANVAS_WIDTH, BENCH_CANVAS_HEIGHT, NMColor(0.5f, 0.5f, 0.5f), Layout);
+    std::vector<NMColor> linear(BENCH_CANVAS_WIDTH * BENCH_CANVAS_HEIGHT);
+
+    for (auto _ : state)
+    {
+        canvas.ToLinear(linear.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(state.iterations()
+                            * static_cast<int64_t>(BENCH_CANVAS_WIDTH * BENCH_CANVAS_HEIGHT * sizeof(NMColor)));
+}
+BENCHMARK_TEMPLATE(BM_Canvas_ToLinear, ENMCanvasLayout::Linear);
+BENCHMARK_TEMPLATE(BM_Canvas_ToLinear, ENMCanvasLayout::Tiled);
+
+template <ENMCanvasLayout Layout> static void BM_Canvas_FromLinear(benchmark::State& state)
+{
+    NMCanvas canvas(BENCH_CANVAS_WIDTH, BENCH_CANVAS_HEIGHT, DEFAULT_COLOR, Layout);
+    std::vector<NMColor> linear(BENCH_CANVAS_WIDTH * BENCH_CANVAS_HEIGHT, NMColor(0.5f, 0.5f, 0.5f));
+
+    for (auto _ : state)
+    {
+        canvas.FromLinear(linear.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(state.iterations()
+                            * static_cast<int64_t>(BENCH_CANVAS_WIDTH * BENCH_CANVAS_HEIGHT * sizeof(NMColor)));
+}
+BENCHMARK_TEMPLATE(BM_Canvas_FromLinear, ENMCanvasLayout::Linear);
+BENCHMARK_TEMPLATE(BM_Canvas_FromLinear, ENMCanvasLayout::Tiled);
+
+// Serialize a full HD frame with a gradient so the PPM line wrapping sees values of every width
+template <ENMCanvasLayout Layout> static void BM_Canvas_ToPPM(benchmark::State& state)
+{
+    NMCanvas canvas(BENCH_CANVAS_WIDTH, BENCH_CANVAS_HEIGHT, DEFAULT_COLOR, Layout);
+    for (std::size_t y = 0; y < BENCH_CANVAS_HEIGHT; ++y)
+    {
+        for (std::size_t x = 0; x < BENCH_CANVAS_WIDTH; ++x)
+        {
+            canvas.WritePixel(x, y,
+                              NMColor(static_cast<float>(x) / BENCH_CANVAS_WIDTH,
+                                      static_cast<float>(y) / BENCH_CANVAS_HEIGHT, 0.05f));
+        }
+    }
+
+    std::size_t bytes = 0;
+    for (auto _ : state)
+    {
+        std::string ppm = canvas.ToPPM();
+        bytes = ppm.size();
+        benchmark::DoNotOptimize(ppm.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(bytes));
+}
+BENCHMARK_TEMPLATE(BM_Canvas_ToPPM, ENMCanvasLayout::Linear)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Canvas_ToPPM, ENMCanvasLayout::Tiled)->Unit(benchmark::kMillisecond);
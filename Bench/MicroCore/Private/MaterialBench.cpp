@@ -0,0 +1,95 @@
+#include <benchmark/benchmark.h>
+
+#include "NMCore/Material.hpp"
+#include "NMCore/Primitive/Sphere.hpp"
+#include "NMCore/ShadingPacket.hpp"
+
+// Hits across the lit side of a sphere, most of them inside the highlight of the first light
+static std::vector<SNMIntersectionState> BenchHits(const NMSphere& sphere)
+{
+    std::vector<SNMIntersectionState> hits;
+    for (uint32_t i = 0; i < 64; ++i)
+    {
+        float angle = 0.02f * static_cast<float>(i);
+        NMPoint point(-std::sin(angle), std::sin(angle * 0.5f), -std::cos(angle));
+        SNMIntersectionState state;
+        state.object = &sphere;
+        state.point = point;
+        state.normalVector = sphere.NormalAt(point);
+        state.eyeVector = NMVector(-0.2f, 0.3f, -1.0f).Normalized();
+        hits.push_back(state);
+    }
+
+    return hits;
+}
+
+static std::vector<NMPointLight> BenchLights(int64_t count)
+{
+    std::vector<NMPointLight> lights;
+    for (int64_t i = 0; i < count; ++i)
+    {
+        float offset = static_cast<float>(i);
+        lights.push_back(NMPointLight(NMPoint(-10.0f + offset, 10.0f, -10.0f - offset), NMColor(1.0f, 1.0f, 1.0f)));
+    }
+
+    return lights;
+}
+
+static NMSphere BenchSphere()
+{
+    NMSphere sphere;
+    sphere.SetMaterial(NMMaterial(NMColor(0.8f, 1.0f, 0.6f), 0.1f, 0.7f, 0.9f, 200.0f));
+    return sphere;
+}
+
+// One hit against arg lights at a time, like NMWorld::ShadeSurface; reported per hit
+static void BM_Material_Lighting(benchmark::State& state)
+{
+    NMSphere sphere = BenchSphere();
+    std::vector<SNMIntersectionState> hits = BenchHits(sphere);
+    std::vector<NMPointLight> lights = BenchLights(state.range(0));
+    const NMMaterial& material = sphere.GetMaterial();
+
+    for (auto _ : state)
+    {
+        for (const SNMIntersectionState& hit : hits)
+        {
+            NMColor color;
+            for (const NMPointLight& light : lights)
+            {
+                color += material.Lighting(sphere, light, hit.point, hit.eyeVector, hit.normalVector, false);
+            }
+            benchmark::DoNotOptimize(color);
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(hits.size()));
+}
+BENCHMARK(BM_Material_Lighting)->ArgName("lights")->Arg(1)->Arg(4);
+
+// The same hits a packet at a time, including filling the packets
+static void BM_Material_LightingPacket(benchmark::State& state)
+{
+    NMSphere sphere = BenchSphere();
+    std::vector<SNMIntersectionState> hits = BenchHits(sphere);
+    std::vector<NMPointLight> lights = BenchLights(state.range(0));
+    float result[3][SHADING_PACKET_SIZE];
+
+    for (auto _ : state)
+    {
+        for (std::size_t first = 0; first < hits.size(); first += SHADING_PACKET_SIZE)
+        {
+            SNMShadingPacket packet;
+            for (std::size_t i = first; i < first + SHADING_PACKET_SIZE; ++i)
+            {
+                packet.Add(hits[i], 0u);
+            }
+
+            nmshade::Lighting(packet, lights, result);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(hits.size()));
+}
+BENCHMARK(BM_Material_LightingPacket)->ArgName("lights")->Arg(1)->Arg(4);
@@ -0,0 +1,128 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+
+#include "NMCore/Pattern/Checker.hpp"
+#include "NMCore/Pattern/Composite.hpp"
+#include "NMCore/Pattern/Gradient.hpp"
+#include "NMCore/Pattern/Ring.hpp"
+#include "NMCore/Pattern/Stripe.hpp"
+#include "NMCore/Pattern/Texture.hpp"
+#include "NMCore/Primitive/Sphere.hpp"
+#include "NMCore/TextureCache.hpp"
+
+static const NMColor BENCH_COLOR_A = NMColor(0.5f, 1.0f, 0.1f);
+static const NMColor BENCH_COLOR_B = NMColor(0.1f, 1.0f, 0.5f);
+
+template <typename T> static void BM_Pattern_ColorAt(benchmark::State& state)
+{
+    T pattern(BENCH_COLOR_A, BENCH_COLOR_B);
+    NMPoint point(0.75f, 1.25f, -2.5f);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(point);
+        NMColor color = pattern.ColorAt(point);
+        benchmark::DoNotOptimize(color);
+    }
+}
+BENCHMARK_TEMPLATE(BM_Pattern_ColorAt, NMStripePattern);
+BENCHMARK_TEMPLATE(BM_Pattern_ColorAt, NMGradientPattern);
+BENCHMARK_TEMPLATE(BM_Pattern_ColorAt, NMRingPattern);
+BENCHMARK_TEMPLATE(BM_Pattern_ColorAt, NMCheckerPattern);
+
+// Includes the world -> object -> pattern space transforms done for every shaded point
+template <typename T> static void BM_Pattern_ColorAtShapePoint(benchmark::State& state)
+{
+    T pattern(BENCH_COLOR_A, BENCH_COLOR_B, NMMatrix::Scaling(0.1f, 0.1f, 0.1f));
+    NMSphere sphere;
+    sphere.SetTransform(NMMatrix::Translation(1.5f, 0.5f, -0.5f) * NMMatrix::Scaling(0.5f, 0.5f, 0.5f));
+    NMPoint point(1.75f, 0.6f, -0.9f);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(point);
+        NMColor color = pattern.ColorAtShapePoint(sphere, point);
+        benchmark::DoNotOptimize(color);
+    }
+}
+BENCHMARK_TEMPLATE(BM_Pattern_ColorAtShapePoint, NMStripePattern);
+BENCHMARK_TEMPLATE(BM_Pattern_ColorAtShapePoint, NMGradientPattern);
+BENCHMARK_TEMPLATE(BM_Pattern_ColorAtShapePoint, NMRingPattern);
+BENCHMARK_TEMPLATE(BM_Pattern_ColorAtShapePoint, NMCheckerPattern);
+
+// Arg 0 is a stripe of solid colors, i.e. the cost of the program itself against BM_Pattern_ColorAtShapePoint, arg 1
+// nests checkers and rings with their own transforms under the stripe, arg 2 also blends in three octaves of noise
+static void BM_CompositePattern_ColorAtShapePoint(benchmark::State& state)
+{
+    SNMPatternNode a = SNMPatternNode::Solid(BENCH_COLOR_A);
+    SNMPatternNode b = SNMPatternNode::Solid(BENCH_COLOR_B);
+    SNMPatternNode root = SNMPatternNode::Stripe(a, b);
+    if (state.range(0) >= 1)
+    {
+        root = SNMPatternNode::Stripe(
+            SNMPatternNode::Transform(SNMPatternNode::Checker(a, b), NMMatrix::Scaling(0.25f, 0.25f, 0.25f)),
+            SNMPatternNode::Transform(SNMPatternNode::Ring(b, a), NMMatrix::RotationX(nmmath::halfPi)));
+    }
+    if (state.range(0) >= 2)
+    {
+        root = SNMPatternNode::Blend(SNMPatternNode::Perturb(root, 0.2f, 2.0f),
+                                     SNMPatternNode::Noise(a, b, 4.0f, 3), 0.3f);
+    }
+
+    NMCompositePattern pattern(root, NMMatrix::Scaling(0.1f, 0.1f, 0.1f));
+    NMSphere sphere;
+    sphere.SetTransform(NMMatrix::Translation(1.5f, 0.5f, -0.5f) * NMMatrix::Scaling(0.5f, 0.5f, 0.5f));
+    NMPoint point(1.75f, 0.6f, -0.9f);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(point);
+        NMColor color = pattern.ColorAtShapePoint(sphere, point);
+        benchmark::DoNotOptimize(color);
+    }
+}
+BENCHMARK(BM_CompositePattern_ColorAtShapePoint)->ArgName("depth")->Arg(0)->Arg(1)->Arg(2);
+
+static std::shared_ptr<const NMTexture> BenchTexture()
+{
+    NMCanvas image(1024, 1024);
+    for (std::size_t y = 0; y < image.GetHeight(); ++y)
+    {
+        for (std::size_t x = 0; x < image.GetWidth(); ++x)
+        {
+            image.WritePixel(x, y, (x ^ y) & 1 ? BENCH_COLOR_A : BENCH_COLOR_B);
+        }
+    }
+
+    return std::make_shared<const NMTexture>(image);
+}
+
+// Sweeps a diagonal of a 1024x1024 texture; arg 0 samples the full resolution, other args are the footprint in pixels
+static void BenchTextureColorAtFiltered(benchmark::State& state, std::shared_ptr<const NMTextureBase> texture)
+{
+    NMTexturePattern pattern(std::move(texture));
+    float footprint = static_cast<float>(state.range(0)) / 1024.0f;
+    float position = 0.0f;
+
+    for (auto _ : state)
+    {
+        position = position < 1.0f ? position + 0.0137f : 0.0f;
+        NMColor color = pattern.ColorAtFiltered(NMPoint(position, 0.0f, position * 0.7f), footprint);
+        benchmark::DoNotOptimize(color);
+    }
+}
+
+static void BM_Texture_ColorAtFiltered(benchmark::State& state) { BenchTextureColorAtFiltered(state, BenchTexture()); }
+BENCHMARK(BM_Texture_ColorAtFiltered)->ArgName("pixels")->Arg(0)->Arg(3)->Arg(64);
+
+// The same through a texture cache holding all of its tiles, i.e. the lock-free lookup of resident tiles
+static void BM_CachedTexture_ColorAtFiltered(benchmark::State& state)
+{
+    std::string path = "bench_texture_cache.nmtx";
+    NMTextureCache::WriteFile(*BenchTexture(), path);
+    std::shared_ptr<NMTextureCache> cache = std::make_shared<NMTextureCache>();
+    BenchTextureColorAtFiltered(state, std::make_shared<const NMCachedTexture>(cache, path));
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_CachedTexture_ColorAtFiltered)->ArgName("pixels")->Arg(0)->Arg(3)->Arg(64);
@@ -0,0 +1,195 @@
+#include <benchmark/benchmark.h>
+
+#include "NMCore/Primitive/CSG.hpp"
+#include "NMCore/Primitive/Cone.hpp"
+#include "NMCore/Primitive/Cube.hpp"
+#include "NMCore/Primitive/Cylinder.hpp"
+#include "NMCore/Primitive/Disk.hpp"
+#include "NMCore/Primitive/Plane.hpp"
+#include "NMCore/Primitive/SDFPrimitive.hpp"
+#include "NMCore/Primitive/Sphere.hpp"
+
+// Arg 0 hits the primitive, arg 1 misses it
+static NMRay BenchRay(int64_t miss)
+{
+    return miss ? NMRay(NMPoint(0.0f, 5.0f, -5.0f), NMVector(0.0f, 0.0f, 1.0f))
+                : NMRay(NMPoint(0.1f, 0.2f, -5.0f), NMVector(0.0f, 0.0f, 1.0f));
+}
+
+static void BM_Sphere_Intersect(benchmark::State& state)
+{
+    NMSphere sphere;
+    sphere.SetTransform(NMMatrix::Translation(0.0f, 0.5f, 0.0f) * NMMatrix::Scaling(1.5f, 1.5f, 1.5f));
+    NMRay ray = BenchRay(state.range(0));
+
+    for (auto _ : state)
+    {
+        std::vector<SNMIntersection> intersections = sphere.Intersect(ray);
+        benchmark::DoNotOptimize(intersections.data());
+    }
+}
+BENCHMARK(BM_Sphere_Intersect)->ArgName("miss")->Arg(0)->Arg(1);
+
+static void BM_Sphere_NormalAt(benchmark::State& state)
+{
+    NMSphere sphere;
+    sphere.SetTransform(NMMatrix::Scaling(1.0f, 0.5f, 1.0f) * NMMatrix::RotationZ(nmmath::pi / 5.0f));
+    NMPoint point(0.0f, nmmath::sqrt2Over2, -nmmath::sqrt2Over2);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(point);
+        NMVector normal = sphere.NormalAt(point);
+        benchmark::DoNotOptimize(normal);
+    }
+}
+BENCHMARK(BM_Sphere_NormalAt);
+
+static void BM_Plane_Intersect(benchmark::State& state)
+{
+    NMPlane plane;
+    plane.SetTransform(NMMatrix::Translation(0.0f, 0.0f, 5.0f) * NMMatrix::RotationX(nmmath::halfPi));
+    NMRay ray = state.range(0) ? NMRay(NMPoint(0.0f, 0.0f, -5.0f), NMVector(1.0f, 0.0f, 0.0f))
+                               : NMRay(NMPoint(0.0f, 0.0f, -5.0f), NMVector(0.0f, 0.0f, 1.0f));
+
+    for (auto _ : state)
+    {
+        std::vector<SNMIntersection> intersections = plane.Intersect(ray);
+        benchmark::DoNotOptimize(intersections.data());
+    }
+}
+BENCHMARK(BM_Plane_Intersect)->ArgName("miss")->Arg(0)->Arg(1);
+
+static void BM_Plane_NormalAt(benchmark::State& state)
+{
+    NMPlane plane;
+    plane.SetTransform(NMMatrix::Translation(0.0f, 0.0f, 5.0f) * NMMatrix::RotationX(nmmath::halfPi));
+    NMPoint point(1.0f, 2.0f, 5.0f);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(point);
+        NMVector normal = plane.NormalAt(point);
+        benchmark::DoNotOptimize(normal);
+    }
+}
+BENCHMARK(BM_Plane_NormalAt);
+
+// The analytic primitives below are sized and turned so BenchRay() hits or misses them like the sphere
+static void BenchIntersect(benchmark::State& state, const NMPrimitiveBase& primitive)
+{
+    NMRay ray = BenchRay(state.range(0));
+
+    for (auto _ : state)
+    {
+        std::vector<SNMIntersection> intersections = primitive.Intersect(ray);
+        benchmark::DoNotOptimize(intersections.data());
+    }
+}
+
+// A full packet of rays spread around BenchRay(), reported per ray so it compares against the scalar benchmarks
+static void BenchIntersectPacket(benchmark::State& state, const NMPrimitiveBase& primitive)
+{
+    NMRay ray = BenchRay(state.range(0));
+    SNMRayPacket packet;
+    for (uint32_t lane = 0; lane < RAY_PACKET_SIZE; ++lane)
+    {
+        float offset = 0.05f * static_cast<float>(lane);
+        packet.Add(NMRay(ray.GetOrigin() + NMVector(offset, -offset, 0.0f), ray.GetDirection()));
+    }
+
+    float nearest[RAY_PACKET_SIZE];
+    for (auto _ : state)
+    {
+        primitive.IntersectPacket(packet, nearest);
+        benchmark::DoNotOptimize(nearest);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * RAY_PACKET_SIZE);
+}
+
+static NMCube BenchCube()
+{
+    NMCube cube;
+    cube.SetTransform(NMMatrix::Translation(0.0f, 0.5f, 0.0f) * NMMatrix::RotationY(nmmath::pi / 8.0f));
+    return cube;
+}
+
+static NMCylinder BenchCylinder()
+{
+    NMCylinder cylinder;
+    cylinder.SetMinimum(-1.0f);
+    cylinder.SetMaximum(1.0f);
+    cylinder.SetClosed(true);
+    cylinder.SetTransform(NMMatrix::Scaling(1.5f, 1.5f, 1.5f));
+    return cylinder;
+}
+
+static NMCone BenchCone()
+{
+    NMCone cone;
+    cone.SetMinimum(-1.0f);
+    cone.SetMaximum(1.0f);
+    cone.SetClosed(true);
+    cone.SetTransform(NMMatrix::Scaling(1.5f, 1.5f, 1.5f));
+    return cone;
+}
+
+static NMDisk BenchDisk()
+{
+    NMDisk disk;
+    disk.SetTransform(NMMatrix::RotationX(nmmath::halfPi) * NMMatrix::Scaling(1.5f, 1.5f, 1.5f));
+    return disk;
+}
+
+static void BM_Cube_Intersect(benchmark::State& state) { BenchIntersect(state, BenchCube()); }
+BENCHMARK(BM_Cube_Intersect)->ArgName("miss")->Arg(0)->Arg(1);
+
+static void BM_Cube_IntersectPacket(benchmark::State& state) { BenchIntersectPacket(state, BenchCube()); }
+BENCHMARK(BM_Cube_IntersectPacket)->ArgName("miss")->Arg(0)->Arg(1);
+
+static void BM_Cylinder_Intersect(benchmark::State& state) { BenchIntersect(state, BenchCylinder()); }
+BENCHMARK(BM_Cylinder_Intersect)->ArgName("miss")->Arg(0)->Arg(1);
+
+static void BM_Cylinder_IntersectPacket(benchmark::State& state) { BenchIntersectPacket(state, BenchCylinder()); }
+BENCHMARK(BM_Cylinder_IntersectPacket)->ArgName("miss")->Arg(0)->Arg(1);
+
+static void BM_Cone_Intersect(benchmark::State& state) { BenchIntersect(state, BenchCone()); }
+BENCHMARK(BM_Cone_Intersect)->ArgName("miss")->Arg(0)->Arg(1);
+
+static void BM_Cone_IntersectPacket(benchmark::State& state) { BenchIntersectPacket(state, BenchCone()); }
+BENCHMARK(BM_Cone_IntersectPacket)->ArgName("miss")->Arg(0)->Arg(1);
+
+static void BM_Disk_Intersect(benchmark::State& state) { BenchIntersect(state, BenchDisk()); }
+BENCHMARK(BM_Disk_Intersect)->ArgName("miss")->Arg(0)->Arg(1);
+
+static void BM_Disk_IntersectPacket(benchmark::State& state) { BenchIntersectPacket(state, BenchDisk()); }
+BENCHMARK(BM_Disk_IntersectPacket)->ArgName("miss")->Arg(0)->Arg(1);
+
+static void BM_Sphere_IntersectPacket(benchmark::State& state)
+{
+    NMSphere sphere;
+    sphere.SetTransform(NMMatrix::Translation(0.0f, 0.5f, 0.0f) * NMMatrix::Scaling(1.5f, 1.5f, 1.5f));
+    BenchIntersectPacket(state, sphere);
+}
+BENCHMARK(BM_Sphere_IntersectPacket)->ArgName("miss")->Arg(0)->Arg(1);
+
+static void BM_CSG_Intersect(benchmark::State& state)
+{
+    std::shared_ptr<NMCube> cube = std::make_shared<NMCube>();
+    std::shared_ptr<NMSphere> sphere = std::make_shared<NMSphere>();
+    sphere->SetTransform(NMMatrix::Scaling(1.3f, 1.3f, 1.3f));
+    NMCSG csg(ENMCSGOperation::Difference, cube, sphere);
+    csg.SetTransform(NMMatrix::Translation(0.0f, 0.5f, 0.0f));
+    BenchIntersect(state, csg);
+}
+BENCHMARK(BM_CSG_Intersect)->ArgName("miss")->Arg(0)->Arg(1);
+
+// A blob of a sphere and a torus, marched to the surface or through its bounds
+static void BM_SDF_Intersect(benchmark::State& state)
+{
+    NMSDFPrimitive sdf(SNMSDFNode::SmoothUnion(SNMSDFNode::Sphere(0.8f), SNMSDFNode::Torus(1.0f, 0.3f), 0.3f));
+    sdf.SetTransform(NMMatrix::Translation(0.0f, 0.5f, 0.0f) * NMMatrix::RotationX(nmmath::halfPi));
+    BenchIntersect(state, sdf);
+}
+BENCHMARK(BM_SDF_Intersect)->ArgName("miss")->Arg(0)->Arg(1);
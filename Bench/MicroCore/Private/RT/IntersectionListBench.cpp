@@ -0,0 +1,30 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "NMCore/Primitive/Sphere.hpp"
+#include "NMCore/RT/IntersectionList.hpp"
+
+// Sort N intersections with random t values, a quarter of them behind the ray origin
+static void BM_IntersectionList_Sort(benchmark::State& state)
+{
+    NMSphere sphere;
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> distribution(-25.0f, 75.0f);
+
+    std::vector<SNMIntersection> intersections;
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        intersections.push_back(SNMIntersection(distribution(generator), &sphere));
+    }
+
+    for (auto _ : state)
+    {
+        SNMIntersectionList list(intersections);
+        list.Sort();
+        benchmark::DoNotOptimize(list.Hit());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_IntersectionList_Sort)->RangeMultiplier(4)->Range(2, 512);
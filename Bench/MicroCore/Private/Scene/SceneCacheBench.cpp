@@ -0,0 +1,64 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <sstream>
+
+#include "NMCore/Scene/SceneCache.hpp"
+
+// The same generated scene as the parser benchmark, baked into a cache file once per object count
+static std::string BakeScene(std::size_t objectCount)
+{
+    std::ostringstream ss;
+    ss << "light position -10 10 -10 color 1 1 1\n";
+    ss << "pattern stripes stripe 0.5 1 0.1 0.1 1 0.5 scale 0.1 0.1 0.1\n";
+    ss << "material red color 1 0.2 0.2 diffuse 0.7 specular 0.3\n";
+    ss << "material striped pattern stripes diffuse 0.7 specular 0.3\n";
+
+    for (std::size_t i = 0; i < objectCount; ++i)
+    {
+        ss << "sphere material " << (i % 2 == 0 ? "red" : "striped") << " translate " << (i % 1000) << " "
+           << (i / 1000) << " -2.5 scale 0.25 0.25 0.25\n";
+    }
+
+    std::string path = "nm_scene_cache_bench_" + std::to_string(objectCount) + ".nmsc";
+    NMSceneCache::Write(NMSceneParser::Parse(ss.str()), path);
+    return path;
+}
+
+static void BM_SceneCache_Load(benchmark::State& state)
+{
+    std::string path = BakeScene(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        NMSceneCache cache(path);
+        SNMScene scene = cache.Instantiate();
+        benchmark::DoNotOptimize(scene.world.GetObjectCount());
+    }
+
+    std::remove(path.c_str());
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SceneCache_Load)->Arg(1000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+// Parsing plus building the BVH is what a cache load replaces
+static void BM_SceneCache_ParseAndBuildBVH(benchmark::State& state)
+{
+    std::ostringstream ss;
+    ss << "material red color 1 0.2 0.2 diffuse 0.7 specular 0.3\n";
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        ss << "sphere material red translate " << (i % 1000) << " " << (i / 1000) << " -2.5 scale 0.25 0.25 0.25\n";
+    }
+    std::string text = ss.str();
+
+    for (auto _ : state)
+    {
+        SNMScene scene = NMSceneParser::Parse(text);
+        scene.world.BuildBVH();
+        benchmark::DoNotOptimize(scene.world.GetBVH().GetNodes().data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SceneCache_ParseAndBuildBVH)->Arg(1000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,40 @@
+#include <benchmark/benchmark.h>
+
+#include <sstream>
+
+#include "NMCore/Scene/SceneParser.hpp"
+
+// A generated scene with a few shared materials and N transformed spheres
+static std::string GenerateScene(std::size_t objectCount)
+{
+    std::ostringstream ss;
+    ss << "settings reflection_depth 5\n";
+    ss << "camera width 1920 height 1080 fov 60 from 0 1.5 -5 to 0 1 0 up 0 1 0\n";
+    ss << "light position -10 10 -10 color 1 1 1\n";
+    ss << "pattern stripes stripe 0.5 1 0.1 0.1 1 0.5 scale 0.1 0.1 0.1\n";
+    ss << "material red color 1 0.2 0.2 diffuse 0.7 specular 0.3\n";
+    ss << "material striped pattern stripes diffuse 0.7 specular 0.3\n";
+
+    for (std::size_t i = 0; i < objectCount; ++i)
+    {
+        ss << "sphere material " << (i % 2 == 0 ? "red" : "striped") << " translate " << (i % 1000) << " "
+           << (i / 1000) << " -2.5 scale 0.25 0.25 0.25\n";
+    }
+
+    return ss.str();
+}
+
+static void BM_SceneParser_Parse(benchmark::State& state)
+{
+    std::string text = GenerateScene(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        SNMScene scene = NMSceneParser::Parse(text);
+        benchmark::DoNotOptimize(scene.world.GetObjectCount());
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SceneParser_Parse)->Arg(1000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+
+#include "NMCore/Canvas.hpp"
+#include "NMCore/TileBuffer.hpp"
+
+constexpr std::size_t BENCH_SHARED_CANVAS_WIDTH = 1920;
+constexpr std::size_t BENCH_SHARED_CANVAS_HEIGHT = 1088;
+
+static NMCanvas& SharedCanvas()
+{
+    static NMCanvas canvas(BENCH_SHARED_CANVAS_WIDTH, BENCH_SHARED_CANVAS_HEIGHT, DEFAULT_COLOR,
+                           ENMCanvasLayout::Tiled);
+    return canvas;
+}
+
+// Stand-in for shading: cheap enough that canvas traffic dominates
+static inline NMColor ShadePixel(std::size_t x, std::size_t y)
+{
+    return NMColor(static_cast<float>(x) * 0.001f, static_cast<float>(y) * 0.001f, 0.5f);
+}
+
+// Every thread writes its pixels straight into the shared canvas, interleaved with its neighbours
+static void BM_Canvas_ConcurrentWritePixel(benchmark::State& state)
+{
+    NMCanvas& canvas = SharedCanvas();
+    std::size_t threads = static_cast<std::size_t>(state.threads());
+    std::size_t thread = static_cast<std::size_t>(state.thread_index());
+
+    for (auto _ : state)
+    {
+        for (std::size_t y = 0; y < BENCH_SHARED_CANVAS_HEIGHT; ++y)
+        {
+            for (std::size_t x = thread; x < BENCH_SHARED_CANVAS_WIDTH; x += threads)
+            {
+                canvas.WritePixel(x, y, ShadePixel(x, y));
+            }
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations()
+                            * static_cast<int64_t>(BENCH_SHARED_CANVAS_WIDTH * BENCH_SHARED_CANVAS_HEIGHT / threads));
+}
+BENCHMARK(BM_Canvas_ConcurrentWritePixel)->ThreadRange(1, 64)->UseRealTime();
+
+// Every thread shades whole tiles into a local buffer and flushes each tile with one block write
+static void BM_Canvas_ConcurrentTileFlush(benchmark::State& state)
+{
+    NMCanvas& canvas = SharedCanvas();
+    std::size_t threads = static_cast<std::size_t>(state.threads());
+    std::size_t thread = static_cast<std::size_t>(state.thread_index());
+    std::vector<SNMTile> tiles = SNMTile::Split(BENCH_SHARED_CANVAS_WIDTH, BENCH_SHARED_CANVAS_HEIGHT);
+
+    NMTileBuffer buffer;
+    for (auto _ : state)
+    {
+        for (std::size_t i = thread; i < tiles.size(); i += threads)
+        {
+            const SNMTile& tile = tiles[i];
+            buffer.Reset(tile);
+            for (std::size_t y = 0; y < tile.height; ++y)
+            {
+                for (std::size_t x = 0; x < tile.width; ++x)
+                {
+                    buffer.Set(x, y, ShadePixel(tile.x + x, tile.y + y));
+                }
+            }
+
+            buffer.FlushTo(canvas);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations()
+                            * static_cast<int64_t>(BENCH_SHARED_CANVAS_WIDTH * BENCH_SHARED_CANVAS_HEIGHT / threads));
+}
+BENCHMARK(BM_Canvas_ConcurrentTileFlush)->ThreadRange(1, 64)->UseRealTime();
@@ -0,0 +1,105 @@
+#include <benchmark/benchmark.h>
+
+#include "NMM/Matrix.hpp"
+
+static NMMatrix SampleTransform()
+{
+    return NMMatrix::Translation(1.5f, 0.5f, -0.5f) * NMMatrix::RotationY(0.3f) * NMMatrix::RotationX(1.1f)
+           * NMMatrix::Scaling(0.5f, 2.0f, 0.25f);
+}
+
+static void BM_Matrix_Multiply(benchmark::State& state)
+{
+    NMMatrix a = SampleTransform();
+    NMMatrix b = NMMatrix::ViewTransform(NMPoint(0.0f, 1.5f, -5.0f), NMPoint(0.0f, 1.0f, 0.0f),
+                                         NMVector(0.0f, 1.0f, 0.0f));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(a);
+        NMMatrix result = a * b;
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_Matrix_Multiply);
+
+static void BM_Matrix_Inverse(benchmark::State& state)
+{
+    NMMatrix matrix = SampleTransform();
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(matrix);
+        NMMatrix inverse = matrix.Inverse();
+        benchmark::DoNotOptimize(inverse);
+    }
+}
+BENCHMARK(BM_Matrix_Inverse);
+
+static void BM_Matrix_Determinant(benchmark::State& state)
+{
+    NMMatrix matrix = SampleTransform();
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(matrix);
+        benchmark::DoNotOptimize(matrix.Determinant());
+    }
+}
+BENCHMARK(BM_Matrix_Determinant);
+
+static void BM_Matrix_Transposed(benchmark::State& state)
+{
+    NMMatrix matrix = SampleTransform();
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(matrix);
+        NMMatrix transposed = matrix.Transposed();
+        benchmark::DoNotOptimize(transposed);
+    }
+}
+BENCHMARK(BM_Matrix_Transposed);
+
+static void BM_Matrix_TransformPoint(benchmark::State& state)
+{
+    NMMatrix matrix = SampleTransform();
+    NMPoint point(0.25f, -3.0f, 7.5f);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(point);
+        NMPoint result = matrix * point;
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_Matrix_TransformPoint);
+
+static void BM_Matrix_TransformVector(benchmark::State& state)
+{
+    NMMatrix matrix = SampleTransform();
+    NMVector vector(0.25f, -3.0f, 7.5f);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(vector);
+        NMVector result = matrix * vector;
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_Matrix_TransformVector);
+
+static void BM_Matrix_ViewTransform(benchmark::State& state)
+{
+    NMPoint from(1.0f, 3.0f, 2.0f);
+    NMPoint to(4.0f, -2.0f, 8.0f);
+    NMVector up(1.0f, 1.0f, 0.0f);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(from);
+        NMMatrix view = NMMatrix::ViewTransform(from, to, up);
+        benchmark::DoNotOptimize(view);
+    }
+}
+BENCHMARK(BM_Matrix_ViewTransform);
@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+
+#include "NMM/Point.hpp"
+#include "NMM/Tuple.hpp"
+#include "NMM/Vector.hpp"
+
+static void BM_Tuple_Add(benchmark::State& state)
+{
+    NMTuple a(1.0f, -2.0f, 3.0f, 1.0f);
+    NMTuple b(0.5f, 0.25f, -4.0f, 0.0f);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(a);
+        NMTuple result = a + b;
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_Tuple_Add);
+
+static void BM_Tuple_Scale(benchmark::State& state)
+{
+    NMTuple tuple(1.0f, -2.0f, 3.0f, 1.0f);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(tuple);
+        NMTuple result = tuple * 3.5f;
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_Tuple_Scale);
+
+static void BM_Point_SubtractPoint(benchmark::State& state)
+{
+    NMPoint a(3.0f, 2.0f, 1.0f);
+    NMPoint b(5.0f, 6.0f, 7.0f);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(a);
+        NMVector result = a - b;
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_Point_SubtractPoint);
+
+static void BM_Vector_DotProduct(benchmark::State& state)
+{
+    NMVector a(1.0f, 2.0f, 3.0f);
+    NMVector b(2.0f, 3.0f, 4.0f);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(a.DotProduct(b));
+    }
+}
+BENCHMARK(BM_Vector_DotProduct);
+
+static void BM_Vector_CrossProduct(benchmark::State& state)
+{
+    NMVector a(1.0f, 2.0f, 3.0f);
+    NMVector b(2.0f, 3.0f, 4.0f);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(a);
+        NMVector result = a.CrossProduct(b);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_Vector_CrossProduct);
+
+static void BM_Vector_Normalized(benchmark::State& state)
+{
+    NMVector vector(1.0f, -2.0f, 3.0f);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(vector);
+        NMVector result = vector.Normalized();
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_Vector_Normalized);
+
+static void BM_Vector_Reflect(benchmark::State& state)
+{
+    NMVector vector(0.0f, -1.0f, 0.0f);
+    NMVector normal(nmmath::sqrt2Over2, nmmath::sqrt2Over2, 0.0f);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(vector);
+        NMVector result = vector.Reflect(normal);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_Vector_Reflect);
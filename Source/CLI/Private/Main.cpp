@@ -0,0 +1,285 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+#include "NMCore/Camera.hpp"
+#include "NMCore/Scene/ImageLoader.hpp"
+#include "NMCore/Scene/SceneCache.hpp"
+#include "NMCore/Scene/SceneLibrary.hpp"
+#include "NMCore/TextureCache.hpp"
+#include "NMCore/ThreadPool.hpp"
+#include "NMCore/Trace.hpp"
+#include "RenderJob.hpp"
+
+namespace
+{
+void PrintUsage()
+{
+    std::cerr << "Usage: nmrndr [--pool-threads N] [--trace <trace file>] <job file>" << std::endl;
+    std::cerr << "       nmrndr --bake <scene file> <cache file>" << std::endl;
+    std::cerr << "       nmrndr --bake-texture <image file> <texture file>" << std::endl;
+    std::cerr << std::endl;
+    std::cerr << "Renders every job in the job file back-to-back on one thread pool and prints one JSON object per"
+              << std::endl;
+    std::cerr << "rendered frame to stdout. --bake converts a text scene into a binary scene cache that job files"
+              << std::endl;
+    std::cerr << "can name in place of the scene file; only spheres and planes with stripe, gradient, ring or checker"
+              << std::endl;
+    std::cerr << "patterns can be baked, other scenes fail and are always parsed. --trace writes a Chrome trace-event"
+              << std::endl;
+    std::cerr << "timeline of the render workers that opens in Perfetto. --bake-texture converts a PPM or PFM image"
+              << std::endl;
+    std::cerr << "into a tiled texture file that image patterns page in on demand instead of holding it in memory."
+              << std::endl;
+}
+
+int Bake(const char* scenePath, const char* cachePath)
+{
+    try
+    {
+        auto start = std::chrono::steady_clock::now();
+        SNMScene scene = NMSceneParser::ParseFile(scenePath);
+        scene.world.BuildBVH();
+        NMSceneCache::Write(scene, cachePath);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cerr << "Baked " << scene.world.GetObjectCount() << " objects into " << cachePath << " in " << seconds
+                  << "s" << std::endl;
+    }
+    catch (const std::runtime_error& err)
+    {
+        std::cerr << err.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+int BakeTexture(const char* imagePath, const char* texturePath)
+{
+    try
+    {
+        auto start = std::chrono::steady_clock::now();
+        NMTexture texture(NMImageLoader::LoadFile(imagePath));
+        NMTextureCache::WriteFile(texture, texturePath);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cerr << "Baked " << texture.GetWidth() << "x" << texture.GetHeight() << " texture with "
+                  << texture.GetLevelCount() << " levels into " << texturePath << " in " << seconds << "s" << std::endl;
+    }
+    catch (const std::runtime_error& err)
+    {
+        std::cerr << err.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+NMMatrix CameraTransform(const SNMRenderJob& job, std::size_t frame)
+{
+    // Orbit the eye around the target about +y
+    float angle = job.orbit * static_cast<float>(frame - job.firstFrame) * nmmath::pi / 180.0f;
+    NMVector offset = job.from - job.to;
+    NMVector orbited = NMMatrix::RotationY(angle) * offset;
+
+    return NMMatrix::ViewTransform(job.to + orbited, job.to, job.up);
+}
+
+std::string EscapeJSON(const std::string& value)
+{
+    std::string escaped;
+    for (char c : value)
+    {
+        if (c == '"' || c == '\\')
+        {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+
+    return escaped;
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    std::size_t poolThreads = std::thread::hardware_concurrency();
+    const char* jobPath = nullptr;
+    const char* tracePath = nullptr;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--bake") == 0 && i + 2 < argc)
+        {
+            return Bake(argv[i + 1], argv[i + 2]);
+        }
+        else if (std::strcmp(argv[i], "--bake-texture") == 0 && i + 2 < argc)
+        {
+            return BakeTexture(argv[i + 1], argv[i + 2]);
+        }
+        else if (std::strcmp(argv[i], "--pool-threads") == 0 && i + 1 < argc)
+        {
+            poolThreads = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        }
+        else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+        {
+            tracePath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--help") == 0 || std::strcmp(argv[i], "-h") == 0)
+        {
+            PrintUsage();
+            return 0;
+        }
+        else if (!jobPath)
+        {
+            jobPath = argv[i];
+        }
+        else
+        {
+            PrintUsage();
+            return 2;
+        }
+    }
+
+    if (!jobPath || poolThreads == 0)
+    {
+        PrintUsage();
+        return 2;
+    }
+
+    std::vector<SNMRenderJob> jobs;
+    try
+    {
+        std::ifstream jobFile(jobPath);
+        if (!jobFile.is_open())
+        {
+            std::cerr << "Failed to open job file " << jobPath << std::endl;
+            return 1;
+        }
+
+        jobs = NMJobFile::Parse(jobFile);
+    }
+    catch (const std::runtime_error& err)
+    {
+        std::cerr << err.what() << std::endl;
+        return 1;
+    }
+
+    if (tracePath)
+    {
+        NMTrace::SetThreadName("Main");
+        NMTrace::Start();
+    }
+
+    ThreadPool pool(poolThreads);
+
+    int exitCode = 0;
+    for (std::size_t jobIndex = 0; jobIndex < jobs.size(); ++jobIndex)
+    {
+        const SNMRenderJob& job = jobs[jobIndex];
+
+        NMWorld world;
+        try
+        {
+            world = NMSceneLibrary::Load(job.scene);
+        }
+        catch (const std::runtime_error& err)
+        {
+            std::cerr << "job " << jobIndex << ": " << err.what() << std::endl;
+            exitCode = 1;
+            continue;
+        }
+
+        NMCamera camera(job.width, job.height, job.fov * nmmath::pi / 180.0f);
+        if (job.seeded)
+        {
+            camera.SetSeed(job.seed);
+        }
+        NMCanvas canvas(job.width, job.height, DEFAULT_COLOR, ENMCanvasLayout::Tiled);
+        std::size_t threads = job.threads == 0 ? pool.GetThreadCount() : std::min(job.threads, pool.GetThreadCount());
+
+        NMCostMap costMap(job.width, job.height, job.heatmapMetric);
+        if (job.heatmap)
+        {
+            camera.SetCostMap(&costMap);
+        }
+
+        // Stops after the last frame instead of testing frame <= lastFrame, which never fails for the largest frame
+        for (std::size_t frame = job.firstFrame;; ++frame)
+        {
+            camera.SetTransform(CameraTransform(job, frame));
+
+            auto renderStart = std::chrono::steady_clock::now();
+            SNMRenderStats stats = camera.Render(world, &canvas, pool, threads);
+            auto renderEnd = std::chrono::steady_clock::now();
+
+            uint64_t traceWriteStart = NMTrace::IsEnabled() ? NMTrace::Now() : 0;
+            std::string output = job.OutputForFrame(frame);
+            std::ofstream file(output);
+            if (file.is_open())
+            {
+                canvas.ToPPM(file);
+            }
+
+            bool written = file.good();
+            if (job.heatmap)
+            {
+                std::ofstream heatmapFile(job.HeatmapForFrame(frame));
+                if (heatmapFile.is_open())
+                {
+                    costMap.ToFalseColor().ToPPM(heatmapFile);
+                }
+                written = written && heatmapFile.good();
+            }
+            auto writeEnd = std::chrono::steady_clock::now();
+            if (NMTrace::IsEnabled())
+            {
+                NMTrace::Record("WriteImage", "io", traceWriteStart, NMTrace::Now(), static_cast<int64_t>(frame));
+            }
+
+            double renderSeconds = std::chrono::duration<double>(renderEnd - renderStart).count();
+            double writeSeconds = std::chrono::duration<double>(writeEnd - renderEnd).count();
+            double pixels = static_cast<double>(job.width * job.height);
+
+            std::cout << "{\"job\":" << jobIndex << ",\"scene\":\"" << EscapeJSON(job.scene) << "\",\"frame\":" << frame
+                      << ",\"width\":" << job.width << ",\"height\":" << job.height << ",\"threads\":" << threads
+                      << std::setprecision(6) << std::fixed << ",\"render_seconds\":" << renderSeconds
+                      << ",\"write_seconds\":" << writeSeconds << std::setprecision(0)
+                      << ",\"pixels_per_second\":" << pixels / renderSeconds << ",\"output\":\""
+                      << EscapeJSON(output) << "\",\"written\":" << (written ? "true" : "false")
+                      << ",\"stats\":" << stats.ToJSON() << "}" << std::endl;
+
+            if (!written)
+            {
+                std::cerr << "Failed to write " << output << (job.heatmap ? " or its heatmap" : "") << std::endl;
+                exitCode = 1;
+            }
+
+            if (frame == job.lastFrame)
+            {
+                break;
+            }
+        }
+    }
+
+    if (tracePath)
+    {
+        NMTrace::Stop();
+
+        std::ofstream traceFile(tracePath);
+        NMTrace::WriteChromeJSON(traceFile);
+        if (!traceFile.good())
+        {
+            std::cerr << "Failed to write trace " << tracePath << std::endl;
+            exitCode = 1;
+        }
+    }
+
+    return exitCode;
+}
@@ -0,0 +1,233 @@
+#include "RenderJob.hpp"
+
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+std::string SNMRenderJob::OutputForFrame(std::size_t frame) const
+{
+    std::size_t start = output.find('#');
+    if (start == std::string::npos)
+    {
+        return output;
+    }
+
+    std::size_t end = output.find_first_not_of('#', start);
+    if (end == std::string::npos)
+    {
+        end = output.size();
+    }
+
+    std::ostringstream ss;
+    ss << output.substr(0, start) << std::setw(static_cast<int>(end - start)) << std::setfill('0') << frame
+       << output.substr(end);
+    return ss.str();
+}
+
+std::string SNMRenderJob::HeatmapForFrame(std::size_t frame) const
+{
+    std::string path = OutputForFrame(frame);
+    std::size_t slash = path.find_last_of("/\\");
+    std::size_t dot = path.rfind('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+    {
+        return path + ".heat";
+    }
+
+    return path.substr(0, dot) + ".heat" + path.substr(dot);
+}
+
+namespace
+{
+[[noreturn]] void ThrowJobError(std::size_t line, const std::string& message)
+{
+    throw std::runtime_error("job file line " + std::to_string(line) + ": " + message);
+}
+
+float ParseFloat(const std::string& value, std::size_t line)
+{
+    char* end = nullptr;
+    float result = std::strtof(value.c_str(), &end);
+    if (value.empty() || *end != '\0')
+    {
+        ThrowJobError(line, "expected a number but got '" + value + "'");
+    }
+
+    // strtof also reads nan and inf, and overflows to inf
+    if (!std::isfinite(result))
+    {
+        ThrowJobError(line, "expected a finite number but got '" + value + "'");
+    }
+
+    return result;
+}
+
+std::size_t ParseSize(const std::string& value, std::size_t line)
+{
+    char* end = nullptr;
+    errno = 0;
+    unsigned long long result = std::strtoull(value.c_str(), &end, 10);
+    if (value.empty() || *end != '\0' || value[0] == '-')
+    {
+        ThrowJobError(line, "expected a positive integer but got '" + value + "'");
+    }
+
+    if (errno == ERANGE || result > std::numeric_limits<std::size_t>::max())
+    {
+        ThrowJobError(line, "'" + value + "' is too large");
+    }
+
+    return static_cast<std::size_t>(result);
+}
+
+void ParseTriple(const std::string& value, std::size_t line, float& x, float& y, float& z)
+{
+    std::size_t first = value.find(',');
+    std::size_t second = first == std::string::npos ? first : value.find(',', first + 1);
+    if (second == std::string::npos)
+    {
+        ThrowJobError(line, "expected x,y,z but got '" + value + "'");
+    }
+
+    x = ParseFloat(value.substr(0, first), line);
+    y = ParseFloat(value.substr(first + 1, second - first - 1), line);
+    z = ParseFloat(value.substr(second + 1), line);
+}
+}  // namespace
+
+std::vector<SNMRenderJob> NMJobFile::Parse(std::istream& is)
+{
+    std::vector<SNMRenderJob> jobs;
+
+    std::string text;
+    std::size_t lineNumber = 0;
+    while (std::getline(is, text))
+    {
+        ++lineNumber;
+
+        std::istringstream line(text);
+        std::string pair;
+        if (!(line >> pair) || pair[0] == '#')
+        {
+            continue;
+        }
+
+        SNMRenderJob job;
+        do
+        {
+            std::size_t equals = pair.find('=');
+            if (equals == std::string::npos)
+            {
+                ThrowJobError(lineNumber, "expected key=value but got '" + pair + "'");
+            }
+
+            std::string key = pair.substr(0, equals);
+            std::string value = pair.substr(equals + 1);
+            float x, y, z;
+
+            if (key == "scene")
+            {
+                job.scene = value;
+            }
+            else if (key == "width")
+            {
+                job.width = ParseSize(value, lineNumber);
+            }
+            else if (key == "height")
+            {
+                job.height = ParseSize(value, lineNumber);
+            }
+            else if (key == "fov")
+            {
+                job.fov = ParseFloat(value, lineNumber);
+                if (job.fov <= 0.0f || job.fov >= 180.0f)
+                {
+                    ThrowJobError(lineNumber, "fov must be between 0 and 180 degrees but got '" + value + "'");
+                }
+            }
+            else if (key == "from")
+            {
+                ParseTriple(value, lineNumber, x, y, z);
+                job.from = NMPoint(x, y, z);
+            }
+            else if (key == "to")
+            {
+                ParseTriple(value, lineNumber, x, y, z);
+                job.to = NMPoint(x, y, z);
+            }
+            else if (key == "up")
+            {
+                ParseTriple(value, lineNumber, x, y, z);
+                job.up = NMVector(x, y, z);
+            }
+            else if (key == "frames")
+            {
+                std::size_t dash = value.find('-');
+                job.firstFrame = ParseSize(value.substr(0, dash), lineNumber);
+                job.lastFrame =
+                    dash == std::string::npos ? job.firstFrame : ParseSize(value.substr(dash + 1), lineNumber);
+            }
+            else if (key == "orbit")
+            {
+                job.orbit = ParseFloat(value, lineNumber);
+            }
+            else if (key == "threads")
+            {
+                job.threads = ParseSize(value, lineNumber);
+            }
+            else if (key == "seed")
+            {
+                job.seed = ParseSize(value, lineNumber);
+                job.seeded = true;
+            }
+            else if (key == "output")
+            {
+                job.output = value;
+            }
+            else if (key == "heatmap")
+            {
+                try
+                {
+                    job.heatmapMetric = NMCostMap::ParseMetric(value);
+                }
+                catch (const std::runtime_error& err)
+                {
+                    ThrowJobError(lineNumber, err.what());
+                }
+
+                if (!NMCostMap::IsMetricAvailable(job.heatmapMetric))
+                {
+                    ThrowJobError(lineNumber, "heatmap=" + value + " needs a build with render stats");
+                }
+                job.heatmap = true;
+            }
+            else
+            {
+                ThrowJobError(lineNumber, "unknown key '" + key + "'");
+            }
+        } while (line >> pair);
+
+        if (job.scene.empty())
+        {
+            ThrowJobError(lineNumber, "missing scene");
+        }
+
+        if (job.width == 0 || job.height == 0)
+        {
+            ThrowJobError(lineNumber, "width and height must be greater than zero");
+        }
+
+        if (job.lastFrame < job.firstFrame)
+        {
+            ThrowJobError(lineNumber, "frame range ends before it starts");
+        }
+
+        jobs.push_back(job);
+    }
+
+    return jobs;
+}
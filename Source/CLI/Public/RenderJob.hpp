@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "NMCore/CostMap.hpp"
+#include "NMM/Point.hpp"
+#include "NMM/Vector.hpp"
+
+/**
+ * @brief One entry of a job file: a scene rendered from a camera over a range of frames.
+ */
+struct SNMRenderJob
+{
+    std::string scene;
+
+    std::size_t width = 640;
+    std::size_t height = 480;
+
+    /**
+     * @brief The horizontal field of view in degrees, between 0 and 180 exclusive.
+     */
+    float fov = 60.0f;
+
+    NMPoint from = NMPoint(0.0f, 1.5f, -5.0f);
+    NMPoint to = NMPoint(0.0f, 1.0f, 0.0f);
+    NMVector up = NMVector(0.0f, 1.0f, 0.0f);
+
+    std::size_t firstFrame = 0;
+    std::size_t lastFrame = 0;
+
+    /**
+     * @brief Degrees the camera orbits around `to` (about +y) per frame.
+     */
+    float orbit = 0.0f;
+
+    /**
+     * @brief The number of pool threads to render with (0 = all of them).
+     */
+    std::size_t threads = 0;
+
+    /**
+     * @brief Render deterministically with this seed (see NMCamera::SetSeed()).
+     */
+    bool seeded = false;
+    uint64_t seed = 0;
+
+    /**
+     * @brief The output path. A run of '#' characters is replaced with the zero padded frame number.
+     */
+    std::string output = "frame_####.ppm";
+
+    /**
+     * @brief Also write a false-color map of the per-pixel cost next to every frame.
+     */
+    bool heatmap = false;
+    ENMCostMetric heatmapMetric = ENMCostMetric::Time;
+
+    std::string OutputForFrame(std::size_t frame) const;
+
+    /**
+     * @brief The heatmap path of a frame: the output path with ".heat" inserted before its extension.
+     */
+    std::string HeatmapForFrame(std::size_t frame) const;
+};
+
+class NMJobFile
+{
+public:
+
+    /**
+     * @brief Parse a job file.
+     * Each non-empty line that does not start with '#' is one job made of whitespace separated key=value pairs:
+     *
+     *     scene=plane width=1920 height=1080 fov=60 from=0,1.5,-5 to=0,1,0 up=0,1,0 frames=0-23 orbit=2.5
+     *     threads=16 output=out/plane_####.ppm heatmap=time seed=42
+     *
+     * @throws std::runtime_error with the line number when the file is malformed, a number is not finite or the fov
+     *         is not between 0 and 180 degrees.
+     */
+    static std::vector<SNMRenderJob> Parse(std::istream& is);
+};
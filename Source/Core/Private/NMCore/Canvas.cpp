@@ -1,6 +1,8 @@
 #include "NMCore/Canvas.hpp"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <iostream>
 
 inline std::ostream& writeColorToLine(std::ostream& os, std::streampos& lineLength, int color)
@@ -20,6 +22,127 @@ inline std::ostream& writeColorToLine(std::ostream& os, std::streampos& lineLeng
     return os;
 }
 
+void NMCanvas::SetLayout(ENMCanvasLayout newLayout)
+{
+    if (layout == newLayout)
+    {
+        return;
+    }
+
+    std::vector<NMColor> linear = ToLinear();
+
+    layout = newLayout;
+    pixels.assign(StorageSize(), defaultColor);
+
+    FromLinear(linear.data());
+}
+
+void NMCanvas::WriteBlock(std::size_t x, std::size_t y, std::size_t blockWidth, std::size_t blockHeight,
+                          const NMColor* block, std::size_t stride)
+{
+    if (x >= width || y >= height)
+    {
+        return;
+    }
+
+    if (stride == 0)
+    {
+        stride = blockWidth;
+    }
+
+    std::size_t columns = std::min(blockWidth, width - x);
+    std::size_t rows = std::min(blockHeight, height - y);
+
+    for (std::size_t row = 0; row < rows; ++row)
+    {
+        const NMColor* src = block + row * stride;
+
+        if (layout == ENMCanvasLayout::Linear)
+        {
+            std::copy(src, src + columns, pixels.begin() + static_cast<std::ptrdiff_t>(PixelIndex(x, y + row)));
+            continue;
+        }
+
+        // Copy the row one tile-wide run at a time, each run is contiguous in tiled storage
+        std::size_t column = 0;
+        while (column < columns)
+        {
+            std::size_t pixelX = x + column;
+            std::size_t run = std::min(CANVAS_TILE_SIZE - pixelX % CANVAS_TILE_SIZE, columns - column);
+            std::copy(src + column, src + column + run,
+                      pixels.begin() + static_cast<std::ptrdiff_t>(PixelIndex(pixelX, y + row)));
+            column += run;
+        }
+    }
+}
+
+NMColor NMCanvas::SampleBilinear(float x, float y) const
+{
+    std::size_t x0 = static_cast<std::size_t>(x);
+    std::size_t y0 = static_cast<std::size_t>(y);
+    std::size_t x1 = x0 + 1;
+    std::size_t y1 = y0 + 1;
+
+    float alpha = x - static_cast<float>(x0);
+    float beta = y - static_cast<float>(y0);
+
+    return ReadPixel(x0, y0) * ((1.0f - alpha) * (1.0f - beta)) + ReadPixel(x1, y0) * (alpha * (1.0f - beta))
+           + ReadPixel(x0, y1) * ((1.0f - alpha) * beta) + ReadPixel(x1, y1) * (alpha * beta);
+}
+
+void NMCanvas::ToLinear(NMColor* out) const
+{
+    if (layout == ENMCanvasLayout::Linear)
+    {
+        std::copy(pixels.begin(), pixels.end(), out);
+        return;
+    }
+
+    // Walk the tiles in storage order, copying each tile row as a contiguous run
+    const NMColor* tile = pixels.data();
+    for (std::size_t tileY = 0; tileY < height; tileY += CANVAS_TILE_SIZE)
+    {
+        std::size_t rows = std::min(CANVAS_TILE_SIZE, height - tileY);
+        for (std::size_t tileX = 0; tileX < width; tileX += CANVAS_TILE_SIZE)
+        {
+            std::size_t columns = std::min(CANVAS_TILE_SIZE, width - tileX);
+            for (std::size_t row = 0; row < rows; ++row)
+            {
+                const NMColor* src = tile + row * CANVAS_TILE_SIZE;
+                std::copy(src, src + columns, out + (tileY + row) * width + tileX);
+            }
+
+            tile += CANVAS_TILE_AREA;
+        }
+    }
+}
+
+void NMCanvas::FromLinear(const NMColor* in)
+{
+    if (layout == ENMCanvasLayout::Linear)
+    {
+        std::copy(in, in + width * height, pixels.begin());
+        return;
+    }
+
+    NMColor* tile = pixels.data();
+    for (std::size_t tileY = 0; tileY < height; tileY += CANVAS_TILE_SIZE)
+    {
+        std::size_t rows = std::min(CANVAS_TILE_SIZE, height - tileY);
+        for (std::size_t tileX = 0; tileX < width; tileX += CANVAS_TILE_SIZE)
+        {
+            std::size_t columns = std::min(CANVAS_TILE_SIZE, width - tileX);
+            for (std::size_t row = 0; row < rows; ++row)
+            {
+                const NMColor* src = in + (tileY + row) * width + tileX;
+                std::copy(src, src + columns, tile + row * CANVAS_TILE_SIZE);
+            }
+
+            tile += CANVAS_TILE_AREA;
+        }
+    }
+}
+
 std::ostream& NMCanvas::ToPPM(std::ostream& os) const
 {
     os << "P3\n";
@@ -27,7 +150,7 @@ std::ostream& NMCanvas::ToPPM(std::ostream& os) const
     os << "255\n";
 
     std::streampos lineStartPos = 0;
-    for (std::size_t i = 0; i < pixels.size(); ++i)
+    for (std::size_t i = 0; i < width * height; ++i)
     {
         bool isLineStart = i % width == 0;
         if (isLineStart)
@@ -42,9 +165,10 @@ std::ostream& NMCanvas::ToPPM(std::ostream& os) const
             }
         }
 
-        writeColorToLine(os, lineStartPos, pixels[i].GetClampedRed());
-        writeColorToLine(os, lineStartPos, pixels[i].GetClampedGreen());
-        writeColorToLine(os, lineStartPos, pixels[i].GetClampedBlue());
+        const NMColor& pixel = pixels[PixelIndex(i % width, i / width)];
+        writeColorToLine(os, lineStartPos, pixel.GetClampedRed());
+        writeColorToLine(os, lineStartPos, pixel.GetClampedGreen());
+        writeColorToLine(os, lineStartPos, pixel.GetClampedBlue());
     }
 
     os.seekp(-1, std::ios_base::cur);
@@ -52,3 +176,25 @@ std::ostream& NMCanvas::ToPPM(std::ostream& os) const
 
     return os;
 }
+
+uint64_t NMCanvas::Hash() const
+{
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (std::size_t y = 0; y < height; ++y)
+    {
+        for (std::size_t x = 0; x < width; ++x)
+        {
+            const NMColor& color = pixels[PixelIndex(x, y)];
+            float channels[3] = {color.GetRed(), color.GetGreen(), color.GetBlue()};
+
+            unsigned char bytes[sizeof(channels)];
+            std::memcpy(bytes, channels, sizeof(channels));
+            for (unsigned char byte : bytes)
+            {
+                hash = (hash ^ byte) * 0x100000001B3ULL;
+            }
+        }
+    }
+
+    return hash;
+}
@@ -0,0 +1,109 @@
+#include "NMCore/CostMap.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+// Stops of the false-color ramp, spread evenly over [0, 1]
+const NMColor FALSE_COLOR_RAMP[] = {
+    NMColor(0.0f, 0.0f, 0.0f), NMColor(0.35f, 0.05f, 0.55f), NMColor(0.85f, 0.15f, 0.25f),
+    NMColor(1.0f, 0.6f, 0.0f), NMColor(1.0f, 1.0f, 1.0f),
+};
+constexpr std::size_t FALSE_COLOR_STOPS = sizeof(FALSE_COLOR_RAMP) / sizeof(FALSE_COLOR_RAMP[0]);
+
+NMColor FalseColor(float value)
+{
+    value = std::min(std::max(value, 0.0f), 1.0f) * static_cast<float>(FALSE_COLOR_STOPS - 1);
+    std::size_t stop = std::min(static_cast<std::size_t>(value), FALSE_COLOR_STOPS - 2);
+    float t = value - static_cast<float>(stop);
+
+    return FALSE_COLOR_RAMP[stop] * (1.0f - t) + FALSE_COLOR_RAMP[stop + 1] * t;
+}
+}  // namespace
+
+float NMCostMap::Max() const
+{
+    float max = 0.0f;
+    for (float cost : costs)
+    {
+        max = std::max(max, cost);
+    }
+
+    return max;
+}
+
+double NMCostMap::Total() const
+{
+    double total = 0.0;
+    for (float cost : costs)
+    {
+        total += static_cast<double>(cost);
+    }
+
+    return total;
+}
+
+float NMCostMap::Percentile(float fraction) const
+{
+    if (costs.empty())
+    {
+        return 0.0f;
+    }
+
+    std::vector<float> sorted = costs;
+    std::size_t index = std::min(static_cast<std::size_t>(fraction * static_cast<float>(sorted.size())),
+                                 sorted.size() - 1);
+    std::nth_element(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(index), sorted.end());
+
+    return sorted[index];
+}
+
+NMCanvas NMCostMap::ToFalseColor(float scale) const
+{
+    if (scale <= 0.0f)
+    {
+        scale = Percentile(0.99f);
+    }
+
+    NMCanvas image(width, height, NMColor(0.0f, 0.0f, 0.0f));
+    if (scale <= 0.0f)
+    {
+        return image;
+    }
+
+    for (std::size_t y = 0; y < height; ++y)
+    {
+        for (std::size_t x = 0; x < width; ++x)
+        {
+            image.WritePixel(x, y, FalseColor(costs[y * width + x] / scale));
+        }
+    }
+
+    return image;
+}
+
+bool NMCostMap::IsMetricAvailable(ENMCostMetric metric)
+{
+    return metric == ENMCostMetric::Time || NM_RENDER_STATS;
+}
+
+ENMCostMetric NMCostMap::ParseMetric(const std::string& name)
+{
+    if (name == "time")
+    {
+        return ENMCostMetric::Time;
+    }
+
+    if (name == "rays")
+    {
+        return ENMCostMetric::Rays;
+    }
+
+    if (name == "tests")
+    {
+        return ENMCostMetric::IntersectionTests;
+    }
+
+    throw std::runtime_error("Unknown cost metric '" + name + "', expected time, rays or tests");
+}
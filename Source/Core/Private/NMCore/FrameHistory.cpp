@@ -0,0 +1,100 @@
+#include "NMCore/FrameHistory.hpp"
+
+#include <algorithm>
+
+namespace
+{
+constexpr float NO_HIT = std::numeric_limits<float>::infinity();
+}  // namespace
+
+std::size_t NMFrameHistory::Count(ENMSampleState state) const
+{
+    return static_cast<std::size_t>(std::count(states.begin(), states.end(), state));
+}
+
+void NMFrameHistory::Invalidate()
+{
+    std::fill(states.begin(), states.end(), ENMSampleState::Empty);
+    std::fill(colors.begin(), colors.end(), NMColor());
+    std::fill(depths.begin(), depths.end(), NO_HIT);
+}
+
+void NMFrameHistory::Reset(std::size_t cameraWidth, std::size_t cameraHeight, const NMMatrix& cameraTransform)
+{
+    width = cameraWidth;
+    height = cameraHeight;
+    transform = cameraTransform;
+    origin = cameraTransform.Inverse() * NMPoint(0.0f, 0.0f, 0.0f);
+
+    states.assign(width * height, ENMSampleState::Empty);
+    colors.assign(width * height, NMColor());
+    points.assign(width * height, NMPoint());
+    depths.assign(width * height, NO_HIT);
+}
+
+void NMFrameHistory::Reproject(const NMMatrix& cameraTransform, float halfWidth, float halfHeight, float pixelSize)
+{
+    // An unchanged view keeps every sample where it is, including the ones traced for it
+    if (std::equal(cameraTransform.GetData(), cameraTransform.GetData() + NMMATRIX_MAX_ELEMENTS, transform.GetData()))
+    {
+        return;
+    }
+
+    NMPoint newOrigin = cameraTransform.Inverse() * NMPoint(0.0f, 0.0f, 0.0f);
+
+    std::size_t count = width * height;
+    nextStates.assign(count, ENMSampleState::Empty);
+    nextColors.assign(count, NMColor());
+    nextPoints.assign(count, NMPoint());
+    nextDepths.assign(count, NO_HIT);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (states[i] == ENMSampleState::Empty)
+        {
+            continue;
+        }
+
+        // Hits are projected by their position, misses by their direction
+        bool hit = depths[i] < NO_HIT;
+        NMVector direction = points[i] - origin;
+        NMPoint view = hit ? cameraTransform * points[i]
+                           : NMPoint(0.0f, 0.0f, 0.0f) + cameraTransform * direction;
+
+        // The camera looks toward -z and the canvas is at z = -1, samples behind the camera are dropped
+        if (!(view.GetZ() < 0.0f))
+        {
+            continue;
+        }
+
+        float canvasX = view.GetX() / -view.GetZ();
+        float canvasY = view.GetY() / -view.GetZ();
+        float px = (halfWidth - canvasX) / pixelSize;
+        float py = (halfHeight - canvasY) / pixelSize;
+        if (!(px >= 0.0f && py >= 0.0f && px < static_cast<float>(width) && py < static_cast<float>(height)))
+        {
+            continue;
+        }
+
+        // The nearest sample wins, hits always beat misses
+        std::size_t target = static_cast<std::size_t>(py) * width + static_cast<std::size_t>(px);
+        float depth = hit ? (points[i] - newOrigin).Magnitude() : NO_HIT;
+        if (nextStates[target] != ENMSampleState::Empty && nextDepths[target] <= depth)
+        {
+            continue;
+        }
+
+        nextStates[target] = ENMSampleState::Reprojected;
+        nextColors[target] = colors[i];
+        nextPoints[target] = hit ? points[i] : newOrigin + direction;
+        nextDepths[target] = depth;
+    }
+
+    states.swap(nextStates);
+    colors.swap(nextColors);
+    points.swap(nextPoints);
+    depths.swap(nextDepths);
+
+    transform = cameraTransform;
+    origin = newOrigin;
+}
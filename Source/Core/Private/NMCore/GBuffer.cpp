@@ -0,0 +1,74 @@
+#include "NMCore/GBuffer.hpp"
+
+#include <algorithm>
+
+namespace
+{
+// Exact comparisons: any change of the camera or the geometry, however small, moves the first hits
+bool SameMatrix(const NMMatrix& a, const NMMatrix& b)
+{
+    return std::equal(a.GetData(), a.GetData() + NMMATRIX_MAX_ELEMENTS, b.GetData());
+}
+
+bool SamePoint(const NMPoint& a, const NMPoint& b)
+{
+    return a.GetX() == b.GetX() && a.GetY() == b.GetY() && a.GetZ() == b.GetZ();
+}
+}  // namespace
+
+bool NMGBuffer::IsValidFor(const NMWorld& world, std::size_t newCameraWidth, std::size_t newCameraHeight,
+                           float newCameraFov, const NMMatrix& newCameraTransform) const
+{
+    if (!valid || newCameraWidth != cameraWidth || newCameraHeight != cameraHeight || newCameraFov != cameraFov
+        || !SameMatrix(newCameraTransform, cameraTransform) || world.GetObjectCount() != objects.size()
+        || world.GetGeometryRevision() != geometryRevision)
+    {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < objects.size(); ++i)
+    {
+        if (world.GetObject(i).get() != objects[i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void NMGBuffer::Begin(const NMWorld& world, std::size_t newCameraWidth, std::size_t newCameraHeight,
+                      float newCameraFov, const NMMatrix& newCameraTransform)
+{
+    valid = false;
+    width = newCameraWidth;
+    height = newCameraHeight;
+    samples.assign(width * height, SNMGBufferSample());
+
+    cameraWidth = newCameraWidth;
+    cameraHeight = newCameraHeight;
+    cameraFov = newCameraFov;
+    cameraTransform = newCameraTransform;
+
+    objects.clear();
+    for (std::size_t i = 0; i < world.GetObjectCount(); ++i)
+    {
+        objects.push_back(world.GetObject(i).get());
+    }
+    geometryRevision = world.GetGeometryRevision();
+
+    shadowLightPosition = ShadowLightPosition(world);
+    retestShadows = false;
+}
+
+void NMGBuffer::BeginReshade(const NMWorld& world)
+{
+    NMPoint position = ShadowLightPosition(world);
+    retestShadows = !SamePoint(position, shadowLightPosition);
+    shadowLightPosition = position;
+}
+
+NMPoint NMGBuffer::ShadowLightPosition(const NMWorld& world)
+{
+    return world.GetPointLightCount() > 0 ? world.GetPointLight(0).GetPosition() : NMPoint();
+}
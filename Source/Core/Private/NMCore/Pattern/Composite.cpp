@@ -0,0 +1,383 @@
+#include "NMCore/Pattern/Composite.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "NMCore/Pattern/Noise.hpp"
+
+namespace
+{
+SNMPatternNode MakeNode(ENMPatternOpcode opcode, SNMPatternNode a, SNMPatternNode b, float x = 0.0f, float y = 0.0f)
+{
+    SNMPatternNode node;
+    node.opcode = opcode;
+    node.arguments[0] = x;
+    node.arguments[1] = y;
+    node.children.push_back(std::move(a));
+    node.children.push_back(std::move(b));
+    return node;
+}
+
+SNMPatternInstruction MakeInstruction(const SNMPatternNode& node)
+{
+    SNMPatternInstruction instruction;
+    instruction.opcode = node.opcode;
+    instruction.inlineColors = false;
+    instruction.target = 0;
+    instruction.arguments[0] = node.arguments[0];
+    instruction.arguments[1] = node.arguments[1];
+    return instruction;
+}
+
+inline NMColor Mix(const NMColor& a, const NMColor& b, float t) { return a + (b - a) * t; }
+
+/**
+ * @brief True if the node is the same color everywhere, e.g. a blend of two solids or a transformed solid.
+ */
+bool ConstantColor(const SNMPatternNode& node, NMColor& color)
+{
+    NMColor a;
+    NMColor b;
+    switch (node.opcode)
+    {
+        case ENMPatternOpcode::Solid:
+            color = node.color;
+            return true;
+        case ENMPatternOpcode::Transform:
+        case ENMPatternOpcode::Perturb:
+            return node.children.size() == 1 && ConstantColor(node.children[0], color);
+        case ENMPatternOpcode::Blend:
+            if (node.children.size() != 2 || !ConstantColor(node.children[0], a) || !ConstantColor(node.children[1], b))
+            {
+                return false;
+            }
+
+            color = Mix(a, b, node.arguments[0]);
+            return true;
+        case ENMPatternOpcode::Stripe:
+        case ENMPatternOpcode::Ring:
+        case ENMPatternOpcode::Checker:
+        case ENMPatternOpcode::Gradient:
+        case ENMPatternOpcode::Noise:
+            if (node.children.size() != 2 || !ConstantColor(node.children[0], a) || !ConstantColor(node.children[1], b)
+                || !(a == b))
+            {
+                return false;
+            }
+
+            color = a;
+            return true;
+        case ENMPatternOpcode::PopPoint:
+        case ENMPatternOpcode::Jump:
+            break;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Emit the node, tracking the depth of both stacks.
+ * @param pointDepth The number of points on the point stack before the node, at least the shaded point.
+ * @param colorDepth The number of colors on the color stack before the node.
+ */
+void CompileNode(const SNMPatternNode& node, uint32_t pointDepth, uint32_t colorDepth,
+                 std::vector<SNMPatternInstruction>& program, std::vector<float>& transforms)
+{
+    if (pointDepth > NMCompositePattern::MAX_STACK_DEPTH || colorDepth >= NMCompositePattern::MAX_STACK_DEPTH)
+    {
+        throw std::runtime_error("Pattern nests deeper than the evaluation stack");
+    }
+
+    SNMPatternInstruction instruction = MakeInstruction(node);
+    NMColor color;
+    if (ConstantColor(node, color))
+    {
+        instruction.opcode = ENMPatternOpcode::Solid;
+        instruction.colorA = color;
+        program.push_back(instruction);
+        return;
+    }
+
+    switch (node.opcode)
+    {
+        case ENMPatternOpcode::Solid:
+            break;
+        case ENMPatternOpcode::Stripe:
+        case ENMPatternOpcode::Ring:
+        case ENMPatternOpcode::Checker:
+        case ENMPatternOpcode::Gradient:
+        case ENMPatternOpcode::Noise:
+        case ENMPatternOpcode::Blend:
+        {
+            if (node.children.size() != 2)
+            {
+                throw std::runtime_error("Pattern selector or mix needs two children");
+            }
+
+            if (ConstantColor(node.children[0], instruction.colorA)
+                && ConstantColor(node.children[1], instruction.colorB))
+            {
+                instruction.inlineColors = true;
+                program.push_back(instruction);
+                return;
+            }
+
+            if (node.opcode == ENMPatternOpcode::Gradient || node.opcode == ENMPatternOpcode::Noise
+                || node.opcode == ENMPatternOpcode::Blend)
+            {
+                CompileNode(node.children[0], pointDepth, colorDepth, program, transforms);
+                CompileNode(node.children[1], pointDepth, colorDepth + 1, program, transforms);
+                program.push_back(instruction);
+                return;
+            }
+
+            // The selector falls through to a, or continues at b past the jump at the end of a
+            std::size_t selector = program.size();
+            program.push_back(instruction);
+            CompileNode(node.children[0], pointDepth, colorDepth, program, transforms);
+
+            std::size_t jump = program.size();
+            SNMPatternNode jumpNode;
+            jumpNode.opcode = ENMPatternOpcode::Jump;
+            program.push_back(MakeInstruction(jumpNode));
+
+            program[selector].target = static_cast<uint32_t>(program.size());
+            CompileNode(node.children[1], pointDepth, colorDepth, program, transforms);
+            program[jump].target = static_cast<uint32_t>(program.size());
+            return;
+        }
+        case ENMPatternOpcode::Transform:
+        case ENMPatternOpcode::Perturb:
+        {
+            if (node.children.size() != 1)
+            {
+                throw std::runtime_error("Pattern point modifier needs one child");
+            }
+
+            const SNMPatternNode* child = &node.children[0];
+            if (node.opcode == ENMPatternOpcode::Transform)
+            {
+                // Nested transforms become one matrix, identities none
+                NMMatrix inverse = node.transform.Inverse();
+                while (child->opcode == ENMPatternOpcode::Transform && child->children.size() == 1)
+                {
+                    inverse = child->transform.Inverse() * inverse;
+                    child = &child->children[0];
+                }
+
+                if (inverse == NMMatrix::Identity4x4())
+                {
+                    CompileNode(*child, pointDepth, colorDepth, program, transforms);
+                    return;
+                }
+
+                instruction.target = static_cast<uint32_t>(transforms.size() / 12);
+                transforms.insert(transforms.end(), inverse.GetData(), inverse.GetData() + 12);
+            }
+
+            program.push_back(instruction);
+            CompileNode(*child, pointDepth + 1, colorDepth, program, transforms);
+            SNMPatternNode pop;
+            pop.opcode = ENMPatternOpcode::PopPoint;
+            program.push_back(MakeInstruction(pop));
+            return;
+        }
+        case ENMPatternOpcode::PopPoint:
+        case ENMPatternOpcode::Jump:
+            break;
+    }
+
+    throw std::runtime_error("Invalid pattern node");
+}
+
+// Push the picked one of two inline colors, or skip to b if the children are code
+inline void Select(const SNMPatternInstruction& instruction, bool pickA, float (*colors)[3], uint32_t& colorCount,
+                   uint32_t& next)
+{
+    if (instruction.inlineColors)
+    {
+        const NMColor& color = pickA ? instruction.colorA : instruction.colorB;
+        float* c = colors[colorCount++];
+        c[0] = color.GetRed();
+        c[1] = color.GetGreen();
+        c[2] = color.GetBlue();
+    }
+    else if (!pickA)
+    {
+        next = instruction.target;
+    }
+}
+
+// Push the mix of two inline colors, or replace the top two colors with their mix
+inline void Mix(const SNMPatternInstruction& instruction, float t, float (*colors)[3], uint32_t& colorCount)
+{
+    if (instruction.inlineColors)
+    {
+        NMColor color = Mix(instruction.colorA, instruction.colorB, t);
+        float* c = colors[colorCount++];
+        c[0] = color.GetRed();
+        c[1] = color.GetGreen();
+        c[2] = color.GetBlue();
+        return;
+    }
+
+    --colorCount;
+    float* a = colors[colorCount - 1];
+    const float* b = colors[colorCount];
+    a[0] += (b[0] - a[0]) * t;
+    a[1] += (b[1] - a[1]) * t;
+    a[2] += (b[2] - a[2]) * t;
+}
+}  // namespace
+
+constexpr uint32_t NMCompositePattern::MAX_STACK_DEPTH;
+
+SNMPatternNode SNMPatternNode::Solid(const NMColor& color)
+{
+    SNMPatternNode node;
+    node.color = color;
+    return node;
+}
+
+SNMPatternNode SNMPatternNode::Stripe(SNMPatternNode a, SNMPatternNode b)
+{
+    return MakeNode(ENMPatternOpcode::Stripe, std::move(a), std::move(b));
+}
+
+SNMPatternNode SNMPatternNode::Ring(SNMPatternNode a, SNMPatternNode b)
+{
+    return MakeNode(ENMPatternOpcode::Ring, std::move(a), std::move(b));
+}
+
+SNMPatternNode SNMPatternNode::Checker(SNMPatternNode a, SNMPatternNode b)
+{
+    return MakeNode(ENMPatternOpcode::Checker, std::move(a), std::move(b));
+}
+
+SNMPatternNode SNMPatternNode::Gradient(SNMPatternNode a, SNMPatternNode b)
+{
+    return MakeNode(ENMPatternOpcode::Gradient, std::move(a), std::move(b));
+}
+
+SNMPatternNode SNMPatternNode::Noise(SNMPatternNode a, SNMPatternNode b, float frequency, uint32_t octaves)
+{
+    return MakeNode(ENMPatternOpcode::Noise, std::move(a), std::move(b), frequency, static_cast<float>(octaves));
+}
+
+SNMPatternNode SNMPatternNode::Blend(SNMPatternNode a, SNMPatternNode b, float weight)
+{
+    return MakeNode(ENMPatternOpcode::Blend, std::move(a), std::move(b), weight);
+}
+
+SNMPatternNode SNMPatternNode::Transform(SNMPatternNode child, const NMMatrix& transform)
+{
+    SNMPatternNode node;
+    node.opcode = ENMPatternOpcode::Transform;
+    node.transform = transform;
+    node.children.push_back(std::move(child));
+    return node;
+}
+
+SNMPatternNode SNMPatternNode::Perturb(SNMPatternNode child, float scale, float frequency)
+{
+    SNMPatternNode node;
+    node.opcode = ENMPatternOpcode::Perturb;
+    node.arguments[0] = scale;
+    node.arguments[1] = frequency;
+    node.children.push_back(std::move(child));
+    return node;
+}
+
+NMCompositePattern::NMCompositePattern(const SNMPatternNode& root, const NMMatrix& transform)
+    : NMPatternBase(transform)
+{
+    CompileNode(root, 1, 0, program, transforms);
+}
+
+NMColor NMCompositePattern::ColorAt(const NMPoint& point) const
+{
+    float colors[MAX_STACK_DEPTH][3];
+    float points[MAX_STACK_DEPTH][3];
+    uint32_t colorCount = 0;
+    uint32_t pointIndex = 0;
+    points[0][0] = point.GetX();
+    points[0][1] = point.GetY();
+    points[0][2] = point.GetZ();
+
+    const SNMPatternInstruction* code = program.data();
+    const uint32_t size = static_cast<uint32_t>(program.size());
+    for (uint32_t next = 0; next < size;)
+    {
+        const SNMPatternInstruction& instruction = code[next++];
+        const float* a = instruction.arguments;
+        const float* p = points[pointIndex];
+        switch (instruction.opcode)
+        {
+            case ENMPatternOpcode::Solid:
+            {
+                float* c = colors[colorCount++];
+                c[0] = instruction.colorA.GetRed();
+                c[1] = instruction.colorA.GetGreen();
+                c[2] = instruction.colorA.GetBlue();
+                break;
+            }
+            case ENMPatternOpcode::Stripe:
+                Select(instruction, static_cast<int>(std::floor(p[0])) % 2 == 0, colors, colorCount, next);
+                break;
+            case ENMPatternOpcode::Ring:
+            {
+                float distance = std::floor(std::sqrt(p[0] * p[0] + p[2] * p[2]));
+                Select(instruction, std::fmod(distance, 2.0f) == 0.0f, colors, colorCount, next);
+                break;
+            }
+            case ENMPatternOpcode::Checker:
+            {
+                float sum = std::floor(p[0]) + std::floor(p[1]) + std::floor(p[2]);
+                Select(instruction, std::fmod(sum, 2.0f) == 0.0f, colors, colorCount, next);
+                break;
+            }
+            case ENMPatternOpcode::Gradient:
+                Mix(instruction, p[0] - std::floor(p[0]), colors, colorCount);
+                break;
+            case ENMPatternOpcode::Noise:
+            {
+                float noise = nmnoise::Fractal(p[0] * a[0], p[1] * a[0], p[2] * a[0], static_cast<uint32_t>(a[1]));
+                Mix(instruction, std::min(std::max(0.5f + 0.5f * noise, 0.0f), 1.0f), colors, colorCount);
+                break;
+            }
+            case ENMPatternOpcode::Blend:
+                Mix(instruction, a[0], colors, colorCount);
+                break;
+            case ENMPatternOpcode::Transform:
+            {
+                const float* m = &transforms[instruction.target * 12];
+                float* q = points[++pointIndex];
+                q[0] = m[0] * p[0] + m[1] * p[1] + m[2] * p[2] + m[3];
+                q[1] = m[4] * p[0] + m[5] * p[1] + m[6] * p[2] + m[7];
+                q[2] = m[8] * p[0] + m[9] * p[1] + m[10] * p[2] + m[11];
+                break;
+            }
+            case ENMPatternOpcode::Perturb:
+            {
+                // Three decorrelated noise values, one per axis
+                float x = p[0] * a[1];
+                float y = p[1] * a[1];
+                float z = p[2] * a[1];
+                float* q = points[++pointIndex];
+                q[0] = p[0] + a[0] * nmnoise::Perlin(x, y, z);
+                q[1] = p[1] + a[0] * nmnoise::Perlin(x + 31.4f, y + 17.3f, z + 5.9f);
+                q[2] = p[2] + a[0] * nmnoise::Perlin(x + 11.7f, y + 53.1f, z + 23.9f);
+                break;
+            }
+            case ENMPatternOpcode::PopPoint:
+                --pointIndex;
+                break;
+            case ENMPatternOpcode::Jump:
+                next = instruction.target;
+                break;
+        }
+    }
+
+    return NMColor(colors[0][0], colors[0][1], colors[0][2]);
+}
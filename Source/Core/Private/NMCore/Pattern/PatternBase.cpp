@@ -1,11 +1,31 @@
 #include "NMCore/Pattern/PatternBase.hpp"
 
+#include <cmath>
+
 #include "NMCore/Primitive/PrimitiveBase.hpp"
 
-NMColor NMPatternBase::ColorAtShapePoint(const NMPrimitiveBase &shape, const NMPoint &point) const
+namespace
+{
+// The average factor a transform scales lengths by, the cube root of the determinant of its 3x3 part
+float LengthScale(const NMMatrix &transform)
+{
+    const float *m = transform.GetData();
+    float determinant = m[0] * (m[5] * m[10] - m[6] * m[9]) - m[1] * (m[4] * m[10] - m[6] * m[8])
+                        + m[2] * (m[4] * m[9] - m[5] * m[8]);
+    return std::cbrt(std::abs(determinant));
+}
+}  // namespace
+
+NMColor NMPatternBase::ColorAtShapePoint(const NMPrimitiveBase &shape, const NMPoint &point, float footprint) const
 {
-    NMPoint objectPoint = shape.GetTransform().Inverse() * point;
-    NMPoint patternPoint = transform.Inverse() * objectPoint;
+    NMPoint objectPoint = shape.GetInverseTransform() * point;
+    NMPoint patternPoint = inverseTransform * objectPoint;
+
+    if (footprint > 0.0f)
+    {
+        return ColorAtFiltered(patternPoint,
+                               footprint * LengthScale(shape.GetInverseTransform()) * LengthScale(inverseTransform));
+    }
 
     return ColorAt(patternPoint);
 }
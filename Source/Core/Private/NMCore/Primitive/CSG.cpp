@@ -0,0 +1,204 @@
+#include "NMCore/Primitive/CSG.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+// An operand hit tagged with its side for the merge, index is into the hits of that side
+struct SNMCSGHit
+{
+    float t;
+    uint32_t index;
+    bool isLeft;
+};
+
+inline bool IsRayInBounds(const SNMBounds& bounds, const NMRay& ray)
+{
+    return !bounds.IsEmpty() && bounds.Intersects(ray);
+}
+
+inline void TagHits(const std::vector<SNMIntersection>& operandHits, bool isLeft, SNMCSGHit* hits)
+{
+    for (std::size_t i = 0; i < operandHits.size(); ++i)
+    {
+        hits[i].t = operandHits[i].t;
+        hits[i].index = static_cast<uint32_t>(i);
+        hits[i].isLeft = isLeft;
+    }
+}
+}  // namespace
+
+constexpr std::size_t NMCSG::HIT_BUFFER_SIZE;
+
+NMCSG::NMCSG(ENMCSGOperation operation, std::shared_ptr<NMPrimitiveBase> left, std::shared_ptr<NMPrimitiveBase> right)
+    : operation(operation), left(std::move(left)), right(std::move(right))
+{
+    if (!this->left || !this->right)
+    {
+        throw std::runtime_error("CSG needs two operands");
+    }
+
+    UpdateBounds();
+}
+
+bool NMCSG::operator==(const NMPrimitiveBase& other) const
+{
+    if (!NMPrimitiveBase::operator==(other))
+    {
+        return false;
+    }
+
+    const NMCSG* otherCSG = dynamic_cast<const NMCSG*>(&other);
+    return otherCSG && operation == otherCSG->operation && *left == *otherCSG->left && *right == *otherCSG->right;
+}
+
+bool NMCSG::IsHitAllowed(ENMCSGOperation operation, bool isLeftHit, bool isInsideLeft, bool isInsideRight)
+{
+    switch (operation)
+    {
+        case ENMCSGOperation::Union:
+            return isLeftHit ? !isInsideRight : !isInsideLeft;
+        case ENMCSGOperation::Intersection:
+            return isLeftHit ? isInsideRight : isInsideLeft;
+        case ENMCSGOperation::Difference:
+            return isLeftHit ? !isInsideRight : isInsideLeft;
+    }
+
+    return false;
+}
+
+void NMCSG::SetGeometryRevision(const std::shared_ptr<std::atomic<uint64_t>>& revision) const
+{
+    NMPrimitiveBase::SetGeometryRevision(revision);
+    left->SetGeometryRevision(revision);
+    right->SetGeometryRevision(revision);
+}
+
+void NMCSG::Compile()
+{
+    NMPrimitiveBase* operands[] = {left.get(), right.get()};
+    CompileChildren(operands);
+    UpdateBounds();
+}
+
+std::vector<SNMIntersection> NMCSG::LocalIntersect(const NMRay& localRay) const
+{
+    // An operand the ray misses contributes no hits and never contains the ray, so a union keeps all hits of the
+    // other operand, a difference all hits of the left one and an intersection none
+    std::vector<SNMIntersection> leftHits;
+    if (IsRayInBounds(leftBounds, localRay))
+    {
+        leftHits = left->Intersect(localRay);
+    }
+
+    if (leftHits.empty() && operation != ENMCSGOperation::Union)
+    {
+        return leftHits;
+    }
+
+    std::vector<SNMIntersection> rightHits;
+    if (IsRayInBounds(rightBounds, localRay))
+    {
+        rightHits = right->Intersect(localRay);
+    }
+
+    if (rightHits.empty() && operation == ENMCSGOperation::Intersection)
+    {
+        return rightHits;
+    }
+
+    if (rightHits.empty())
+    {
+        return leftHits;
+    }
+
+    if (leftHits.empty())
+    {
+        return rightHits;
+    }
+
+    std::size_t count = leftHits.size() + rightHits.size();
+    SNMCSGHit stackHits[HIT_BUFFER_SIZE];
+    std::vector<SNMCSGHit> heapHits;
+    SNMCSGHit* hits = stackHits;
+    if (count > HIT_BUFFER_SIZE)
+    {
+        heapHits.resize(count);
+        hits = heapHits.data();
+    }
+
+    TagHits(leftHits, true, hits);
+    TagHits(rightHits, false, hits + leftHits.size());
+    std::sort(hits, hits + count, [](const SNMCSGHit& a, const SNMCSGHit& b) { return a.t < b.t; });
+
+    // Walk the hits in order, tracking which operands contain the ray
+    std::vector<SNMIntersection> result;
+    result.reserve(count);
+    bool isInsideLeft = false;
+    bool isInsideRight = false;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const SNMCSGHit& hit = hits[i];
+        if (IsHitAllowed(operation, hit.isLeft, isInsideLeft, isInsideRight))
+        {
+            result.push_back(hit.isLeft ? leftHits[hit.index] : rightHits[hit.index]);
+        }
+
+        if (hit.isLeft)
+        {
+            isInsideLeft = !isInsideLeft;
+        }
+        else
+        {
+            isInsideRight = !isInsideRight;
+        }
+    }
+
+    return result;
+}
+
+bool NMCSG::Includes(const NMPrimitiveBase* object) const
+{
+    return object == this || left->Includes(object) || right->Includes(object);
+}
+
+NMVector NMCSG::LocalNormalAt(const NMPoint& /* localPoint */) const
+{
+    throw std::runtime_error("CSGs have no normal, their hits report the operand that was hit");
+}
+
+NMVector NMCSG::LocalNormalAt(const NMPoint& localPoint, const SNMIntersection& hit) const
+{
+    if (left->Includes(hit.leaf))
+    {
+        return left->NormalAt(localPoint, hit);
+    }
+
+    if (right->Includes(hit.leaf))
+    {
+        return right->NormalAt(localPoint, hit);
+    }
+
+    return LocalNormalAt(localPoint);
+}
+
+void NMCSG::UpdateBounds()
+{
+    leftBounds = left->WorldBounds();
+    rightBounds = right->WorldBounds();
+
+    switch (operation)
+    {
+        case ENMCSGOperation::Union:
+            bounds = leftBounds;
+            bounds.Extend(rightBounds);
+            break;
+        case ENMCSGOperation::Intersection:
+            bounds = leftBounds.Overlap(rightBounds);
+            break;
+        case ENMCSGOperation::Difference:
+            bounds = leftBounds;
+            break;
+    }
+}
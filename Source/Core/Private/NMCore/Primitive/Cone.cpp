@@ -0,0 +1,144 @@
+#include "NMCore/Primitive/Cone.hpp"
+
+#include <cmath>
+
+namespace
+{
+// Coefficients below this are treated as zero: the ray is parallel to the cone's side (or to the caps)
+constexpr float PARALLEL_EPSILON = 1e-6f;
+
+// Points this close to a cap plane take the cap's normal, and cap hits this close outside the rim still count
+constexpr float CAP_EPSILON = 1e-4f;
+
+// Discriminants this far below zero, relative to b^2, are rounding errors of tangent rays and count as zero
+constexpr float TANGENT_EPSILON = 1e-5f;
+}  // namespace
+
+std::vector<SNMIntersection> NMCone::LocalIntersect(const NMRay& localRay) const
+{
+    const float ox = localRay.GetOrigin().GetX();
+    const float oy = localRay.GetOrigin().GetY();
+    const float oz = localRay.GetOrigin().GetZ();
+    const float dx = localRay.GetDirection().GetX();
+    const float dy = localRay.GetDirection().GetY();
+    const float dz = localRay.GetDirection().GetZ();
+
+    std::vector<SNMIntersection> hits;
+
+    float a = dx * dx - dy * dy + dz * dz;
+    float b = 2.0f * (ox * dx - oy * dy + oz * dz);
+    float c = ox * ox - oy * oy + oz * oz;
+
+    if (std::abs(a) > PARALLEL_EPSILON)
+    {
+        float discriminant = b * b - 4.0f * a * c;
+        if (discriminant >= -TANGENT_EPSILON * b * b)
+        {
+            float root = std::sqrt(std::fmax(discriminant, 0.0f));
+            for (float t : {(-b - root) / (2.0f * a), (-b + root) / (2.0f * a)})
+            {
+                float y = oy + t * dy;
+                if (minimum < y && y < maximum)
+                {
+                    hits.push_back(SNMIntersection(t, this));
+                }
+            }
+        }
+    }
+    else if (std::abs(b) > PARALLEL_EPSILON)
+    {
+        // Parallel to one of the halves, the ray only crosses the other
+        float t = -c / (2.0f * b);
+        float y = oy + t * dy;
+        if (minimum < y && y < maximum)
+        {
+            hits.push_back(SNMIntersection(t, this));
+        }
+    }
+
+    if (closed && std::abs(dy) > PARALLEL_EPSILON)
+    {
+        for (float capY : {minimum, maximum})
+        {
+            float t = (capY - oy) / dy;
+            float x = ox + t * dx;
+            float z = oz + t * dz;
+            if (x * x + z * z <= capY * capY + CAP_EPSILON)
+            {
+                hits.push_back(SNMIntersection(t, this));
+            }
+        }
+    }
+
+    return hits;
+}
+
+void NMCone::LocalIntersectPacket(const SNMRayPacket& localRays, float nearest[RAY_PACKET_SIZE]) const
+{
+    for (uint32_t lane = 0; lane < RAY_PACKET_SIZE; ++lane)
+    {
+        const float ox = localRays.origin[0][lane];
+        const float oy = localRays.origin[1][lane];
+        const float oz = localRays.origin[2][lane];
+        const float dx = localRays.direction[0][lane];
+        const float dy = localRays.direction[1][lane];
+        const float dz = localRays.direction[2][lane];
+
+        // Side, invalid candidates become -1 and are dropped by Nearest()
+        float a = dx * dx - dy * dy + dz * dz;
+        float b = 2.0f * (ox * dx - oy * dy + oz * dz);
+        float c = ox * ox - oy * oy + oz * oz;
+        float discriminant = b * b - 4.0f * a * c;
+        bool quadratic = std::abs(a) > PARALLEL_EPSILON;
+        bool linear = !quadratic && std::abs(b) > PARALLEL_EPSILON;
+        float root = std::sqrt(discriminant > 0.0f ? discriminant : 0.0f);
+        float inverse2a = 0.5f / a;
+        float t0 = quadratic ? (-b - root) * inverse2a : -c / (2.0f * b);
+        float t1 = (-b + root) * inverse2a;
+        float y0 = oy + t0 * dy;
+        float y1 = oy + t1 * dy;
+        bool twoRoots = quadratic && discriminant >= -TANGENT_EPSILON * b * b;
+        t0 = ((linear || twoRoots) && minimum < y0 && y0 < maximum) ? t0 : -1.0f;
+        t1 = (twoRoots && minimum < y1 && y1 < maximum) ? t1 : -1.0f;
+
+        // Caps
+        bool caps = closed && std::abs(dy) > PARALLEL_EPSILON;
+        float inverseDy = 1.0f / dy;
+        float tLow = (minimum - oy) * inverseDy;
+        float tHigh = (maximum - oy) * inverseDy;
+        float xLow = ox + tLow * dx;
+        float zLow = oz + tLow * dz;
+        float xHigh = ox + tHigh * dx;
+        float zHigh = oz + tHigh * dz;
+        tLow = (caps && xLow * xLow + zLow * zLow <= minimum * minimum + CAP_EPSILON) ? tLow : -1.0f;
+        tHigh = (caps && xHigh * xHigh + zHigh * zHigh <= maximum * maximum + CAP_EPSILON) ? tHigh : -1.0f;
+
+        float t = nmpacket::NoHit();
+        t = nmpacket::Nearest(t0, t);
+        t = nmpacket::Nearest(t1, t);
+        t = nmpacket::Nearest(tLow, t);
+        t = nmpacket::Nearest(tHigh, t);
+        nearest[lane] = t;
+    }
+}
+
+NMVector NMCone::LocalNormalAt(const NMPoint& localPoint) const
+{
+    float x = localPoint.GetX();
+    float y = localPoint.GetY();
+    float z = localPoint.GetZ();
+    float distance = x * x + z * z;
+
+    if (distance < maximum * maximum && y >= maximum - CAP_EPSILON)
+    {
+        return NMVector(0.0f, 1.0f, 0.0f);
+    }
+
+    if (distance < minimum * minimum && y <= minimum + CAP_EPSILON)
+    {
+        return NMVector(0.0f, -1.0f, 0.0f);
+    }
+
+    float normalY = std::sqrt(distance);
+    return NMVector(x, y > 0.0f ? -normalY : normalY, z);
+}
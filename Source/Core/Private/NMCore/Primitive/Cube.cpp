@@ -0,0 +1,87 @@
+#include "NMCore/Primitive/Cube.hpp"
+
+#include <cmath>
+#include <limits>
+
+namespace
+{
+/**
+ * @brief Narrow [tMin, tMax] to the part of the ray between the planes -1 and 1 of one axis.
+ * A ray parallel to the slab gets infinite distances, which keep or empty the interval depending on whether it runs
+ * inside; fmin and fmax drop the NaN of a ray exactly on a face.
+ */
+inline void ClipSlab(float origin, float direction, float& tMin, float& tMax)
+{
+    float inverse = 1.0f / direction;
+    float t0 = (-1.0f - origin) * inverse;
+    float t1 = (1.0f - origin) * inverse;
+    tMin = std::fmax(tMin, std::fmin(t0, t1));
+    tMax = std::fmin(tMax, std::fmax(t0, t1));
+}
+
+/**
+ * @brief ClipSlab() written with selects, which vectorize where the library fmin and fmax do not.
+ * A NaN distance fails every comparison and leaves the interval unchanged.
+ */
+inline void ClipSlabLane(float origin, float direction, float& tMin, float& tMax)
+{
+    float inverse = 1.0f / direction;
+    float t0 = (-1.0f - origin) * inverse;
+    float t1 = (1.0f - origin) * inverse;
+    float near = t0 < t1 ? t0 : t1;
+    float far = t0 < t1 ? t1 : t0;
+    tMin = near > tMin ? near : tMin;
+    tMax = far < tMax ? far : tMax;
+}
+}  // namespace
+
+std::vector<SNMIntersection> NMCube::LocalIntersect(const NMRay& localRay) const
+{
+    float tMin = -std::numeric_limits<float>::infinity();
+    float tMax = std::numeric_limits<float>::infinity();
+    ClipSlab(localRay.GetOrigin().GetX(), localRay.GetDirection().GetX(), tMin, tMax);
+    ClipSlab(localRay.GetOrigin().GetY(), localRay.GetDirection().GetY(), tMin, tMax);
+    ClipSlab(localRay.GetOrigin().GetZ(), localRay.GetDirection().GetZ(), tMin, tMax);
+
+    if (tMin > tMax)
+    {
+        return std::vector<SNMIntersection>();
+    }
+
+    return std::vector<SNMIntersection>{SNMIntersection(tMin, this), SNMIntersection(tMax, this)};
+}
+
+void NMCube::LocalIntersectPacket(const SNMRayPacket& localRays, float nearest[RAY_PACKET_SIZE]) const
+{
+    for (uint32_t lane = 0; lane < RAY_PACKET_SIZE; ++lane)
+    {
+        float tMin = -std::numeric_limits<float>::infinity();
+        float tMax = std::numeric_limits<float>::infinity();
+        ClipSlabLane(localRays.origin[0][lane], localRays.direction[0][lane], tMin, tMax);
+        ClipSlabLane(localRays.origin[1][lane], localRays.direction[1][lane], tMin, tMax);
+        ClipSlabLane(localRays.origin[2][lane], localRays.direction[2][lane], tMin, tMax);
+
+        bool hit = tMin <= tMax;
+        float t = tMin >= 0.0f ? tMin : tMax;
+        nearest[lane] = hit && t >= 0.0f ? t : nmpacket::NoHit();
+    }
+}
+
+NMVector NMCube::LocalNormalAt(const NMPoint& localPoint) const
+{
+    float x = std::abs(localPoint.GetX());
+    float y = std::abs(localPoint.GetY());
+    float z = std::abs(localPoint.GetZ());
+
+    if (x >= y && x >= z)
+    {
+        return NMVector(localPoint.GetX(), 0.0f, 0.0f);
+    }
+
+    if (y >= z)
+    {
+        return NMVector(0.0f, localPoint.GetY(), 0.0f);
+    }
+
+    return NMVector(0.0f, 0.0f, localPoint.GetZ());
+}
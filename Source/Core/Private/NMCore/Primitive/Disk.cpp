@@ -0,0 +1,35 @@
+#include "NMCore/Primitive/Disk.hpp"
+
+#include <cmath>
+
+std::vector<SNMIntersection> NMDisk::LocalIntersect(const NMRay& localRay) const
+{
+    const float dy = localRay.GetDirection().GetY();
+    if (std::abs(dy) < nmmath::floatEpsilon)
+    {
+        return std::vector<SNMIntersection>();
+    }
+
+    float t = -localRay.GetOrigin().GetY() / dy;
+    float x = localRay.GetOrigin().GetX() + t * localRay.GetDirection().GetX();
+    float z = localRay.GetOrigin().GetZ() + t * localRay.GetDirection().GetZ();
+    if (x * x + z * z > 1.0f)
+    {
+        return std::vector<SNMIntersection>();
+    }
+
+    return std::vector<SNMIntersection>({SNMIntersection(t, this)});
+}
+
+void NMDisk::LocalIntersectPacket(const SNMRayPacket& localRays, float nearest[RAY_PACKET_SIZE]) const
+{
+    for (uint32_t lane = 0; lane < RAY_PACKET_SIZE; ++lane)
+    {
+        const float dy = localRays.direction[1][lane];
+        float t = -localRays.origin[1][lane] / dy;
+        float x = localRays.origin[0][lane] + t * localRays.direction[0][lane];
+        float z = localRays.origin[2][lane] + t * localRays.direction[2][lane];
+        bool hit = std::abs(dy) >= nmmath::floatEpsilon && x * x + z * z <= 1.0f;
+        nearest[lane] = nmpacket::Nearest(hit ? t : -1.0f, nmpacket::NoHit());
+    }
+}
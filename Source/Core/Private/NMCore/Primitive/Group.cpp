@@ -0,0 +1,110 @@
+#include "NMCore/Primitive/Group.hpp"
+
+#include <stdexcept>
+
+bool NMGroup::operator==(const NMPrimitiveBase& other) const
+{
+    if (!NMPrimitiveBase::operator==(other))
+    {
+        return false;
+    }
+
+    const NMGroup* otherGroup = dynamic_cast<const NMGroup*>(&other);
+    if (!otherGroup || children.size() != otherGroup->children.size())
+    {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < children.size(); ++i)
+    {
+        if (!(*children[i] == *otherGroup->children[i]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void NMGroup::AddChild(std::shared_ptr<NMPrimitiveBase> child)
+{
+    child->SetGeometryRevision(geometryRevision);
+    bounds.Extend(child->WorldBounds());
+    children.push_back(std::move(child));
+
+    // The bounds grew, like a moved child
+    BumpGeometryRevision();
+}
+
+void NMGroup::SetGeometryRevision(const std::shared_ptr<std::atomic<uint64_t>>& revision) const
+{
+    NMPrimitiveBase::SetGeometryRevision(revision);
+    for (const std::shared_ptr<NMPrimitiveBase>& child : children)
+    {
+        child->SetGeometryRevision(revision);
+    }
+}
+
+void NMGroup::Compile()
+{
+    CompileChildren(children);
+
+    bounds = SNMBounds();
+    for (const std::shared_ptr<NMPrimitiveBase>& child : children)
+    {
+        bounds.Extend(child->WorldBounds());
+    }
+}
+
+std::vector<SNMIntersection> NMGroup::LocalIntersect(const NMRay& localRay) const
+{
+    std::vector<SNMIntersection> hits;
+    if (bounds.IsEmpty() || !bounds.Intersects(localRay))
+    {
+        return hits;
+    }
+
+    for (const std::shared_ptr<NMPrimitiveBase>& child : children)
+    {
+        std::vector<SNMIntersection> childHits = child->Intersect(localRay);
+        hits.insert(hits.end(), childHits.begin(), childHits.end());
+    }
+
+    return hits;
+}
+
+bool NMGroup::Includes(const NMPrimitiveBase* object) const
+{
+    if (object == this)
+    {
+        return true;
+    }
+
+    for (const std::shared_ptr<NMPrimitiveBase>& child : children)
+    {
+        if (child->Includes(object))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+NMVector NMGroup::LocalNormalAt(const NMPoint& /* localPoint */) const
+{
+    throw std::runtime_error("Groups have no normal, their hits report the child that was hit");
+}
+
+NMVector NMGroup::LocalNormalAt(const NMPoint& localPoint, const SNMIntersection& hit) const
+{
+    for (const std::shared_ptr<NMPrimitiveBase>& child : children)
+    {
+        if (child->Includes(hit.leaf))
+        {
+            return child->NormalAt(localPoint, hit);
+        }
+    }
+
+    return LocalNormalAt(localPoint);
+}
@@ -0,0 +1,341 @@
+#include "NMCore/Primitive/SDFPrimitive.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace
+{
+SNMSDFNode MakeNode(ENMSDFOpcode opcode, float a = 0.0f, float b = 0.0f, float c = 0.0f, float d = 0.0f,
+                    float e = 0.0f, float f = 0.0f)
+{
+    SNMSDFNode node;
+    node.opcode = opcode;
+    node.arguments[0] = a;
+    node.arguments[1] = b;
+    node.arguments[2] = c;
+    node.arguments[3] = d;
+    node.arguments[4] = e;
+    node.arguments[5] = f;
+    return node;
+}
+
+SNMSDFInstruction MakeInstruction(const SNMSDFNode& node)
+{
+    SNMSDFInstruction instruction;
+    instruction.opcode = node.opcode;
+    std::memcpy(instruction.arguments, node.arguments, sizeof(instruction.arguments));
+    return instruction;
+}
+
+/**
+ * @brief Emit the node in postfix order, tracking the depth of both stacks and the bounds of the node.
+ * @param pointDepth The number of points on the point stack before the node, at least the ray's point.
+ * @param valueDepth The number of distances on the distance stack before the node.
+ */
+SNMBounds CompileNode(const SNMSDFNode& node, uint32_t pointDepth, uint32_t valueDepth,
+                      std::vector<SNMSDFInstruction>& program)
+{
+    if (pointDepth > NMSDFPrimitive::MAX_STACK_DEPTH || valueDepth >= NMSDFPrimitive::MAX_STACK_DEPTH)
+    {
+        throw std::runtime_error("SDF nests deeper than the evaluation stack");
+    }
+
+    const float* arguments = node.arguments;
+    switch (node.opcode)
+    {
+        case ENMSDFOpcode::Sphere:
+        {
+            program.push_back(MakeInstruction(node));
+            float r = arguments[0];
+            return SNMBounds(NMPoint(-r, -r, -r), NMPoint(r, r, r));
+        }
+        case ENMSDFOpcode::Box:
+        {
+            program.push_back(MakeInstruction(node));
+            return SNMBounds(NMPoint(-arguments[0], -arguments[1], -arguments[2]),
+                             NMPoint(arguments[0], arguments[1], arguments[2]));
+        }
+        case ENMSDFOpcode::Torus:
+        {
+            program.push_back(MakeInstruction(node));
+            float outer = arguments[0] + arguments[1];
+            return SNMBounds(NMPoint(-outer, -arguments[1], -outer), NMPoint(outer, arguments[1], outer));
+        }
+        case ENMSDFOpcode::Union:
+        case ENMSDFOpcode::SmoothUnion:
+        {
+            if (node.children.size() != 2)
+            {
+                throw std::runtime_error("SDF union needs two children");
+            }
+
+            SNMBounds result = CompileNode(node.children[0], pointDepth, valueDepth, program);
+            result.Extend(CompileNode(node.children[1], pointDepth, valueDepth + 1, program));
+            program.push_back(MakeInstruction(node));
+
+            // Blending lowers the distance by at most a quarter of the smoothness
+            float pad = node.opcode == ENMSDFOpcode::SmoothUnion ? 0.25f * arguments[0] : 0.0f;
+            return SNMBounds(result.min - NMVector(pad, pad, pad), result.max + NMVector(pad, pad, pad));
+        }
+        case ENMSDFOpcode::Translate:
+        case ENMSDFOpcode::Repeat:
+        {
+            if (node.children.size() != 1)
+            {
+                throw std::runtime_error("SDF point modifier needs one child");
+            }
+
+            program.push_back(MakeInstruction(node));
+            SNMBounds child = CompileNode(node.children[0], pointDepth + 1, valueDepth, program);
+            SNMSDFNode pop = MakeNode(ENMSDFOpcode::PopPoint);
+            program.push_back(MakeInstruction(pop));
+
+            NMVector offset(arguments[0], arguments[1], arguments[2]);
+            if (node.opcode == ENMSDFOpcode::Translate)
+            {
+                return SNMBounds(child.min + offset, child.max + offset);
+            }
+
+            NMVector extent(arguments[0] * arguments[3], arguments[1] * arguments[4], arguments[2] * arguments[5]);
+            return SNMBounds(child.min - extent, child.max + extent);
+        }
+        case ENMSDFOpcode::PopPoint:
+            break;
+    }
+
+    throw std::runtime_error("Invalid SDF node");
+}
+
+// The coordinate of the copy of p closest to the origin within the repeated range
+inline float RepeatAxis(float p, float spacing, float copies)
+{
+    if (spacing <= 0.0f)
+    {
+        return p;
+    }
+
+    float cell = std::round(p / spacing);
+    cell = std::min(std::max(cell, -copies), copies);
+    return p - spacing * cell;
+}
+}  // namespace
+
+constexpr uint32_t NMSDFPrimitive::MAX_STACK_DEPTH;
+constexpr uint32_t NMSDFPrimitive::MAX_STEPS;
+constexpr float NMSDFPrimitive::HIT_DISTANCE;
+
+SNMSDFNode SNMSDFNode::Sphere(float radius) { return MakeNode(ENMSDFOpcode::Sphere, radius); }
+
+SNMSDFNode SNMSDFNode::Box(const NMVector& halfExtents)
+{
+    return MakeNode(ENMSDFOpcode::Box, halfExtents.GetX(), halfExtents.GetY(), halfExtents.GetZ());
+}
+
+SNMSDFNode SNMSDFNode::Torus(float majorRadius, float minorRadius)
+{
+    return MakeNode(ENMSDFOpcode::Torus, majorRadius, minorRadius);
+}
+
+SNMSDFNode SNMSDFNode::Union(SNMSDFNode a, SNMSDFNode b)
+{
+    SNMSDFNode node = MakeNode(ENMSDFOpcode::Union);
+    node.children.push_back(std::move(a));
+    node.children.push_back(std::move(b));
+    return node;
+}
+
+SNMSDFNode SNMSDFNode::SmoothUnion(SNMSDFNode a, SNMSDFNode b, float smoothness)
+{
+    SNMSDFNode node = MakeNode(ENMSDFOpcode::SmoothUnion, smoothness);
+    node.children.push_back(std::move(a));
+    node.children.push_back(std::move(b));
+    return node;
+}
+
+SNMSDFNode SNMSDFNode::Translate(SNMSDFNode child, const NMVector& offset)
+{
+    SNMSDFNode node = MakeNode(ENMSDFOpcode::Translate, offset.GetX(), offset.GetY(), offset.GetZ());
+    node.children.push_back(std::move(child));
+    return node;
+}
+
+SNMSDFNode SNMSDFNode::Repeat(SNMSDFNode child, const NMVector& spacing, const NMVector& copies)
+{
+    SNMSDFNode node = MakeNode(ENMSDFOpcode::Repeat, spacing.GetX(), spacing.GetY(), spacing.GetZ(), copies.GetX(),
+                               copies.GetY(), copies.GetZ());
+    node.children.push_back(std::move(child));
+    return node;
+}
+
+NMSDFPrimitive::NMSDFPrimitive(const SNMSDFNode& root) { bounds = CompileNode(root, 1, 0, program); }
+
+bool NMSDFPrimitive::operator==(const NMPrimitiveBase& other) const
+{
+    if (!NMPrimitiveBase::operator==(other))
+    {
+        return false;
+    }
+
+    const NMSDFPrimitive* otherSDF = dynamic_cast<const NMSDFPrimitive*>(&other);
+    if (!otherSDF || program.size() != otherSDF->program.size())
+    {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < program.size(); ++i)
+    {
+        if (program[i].opcode != otherSDF->program[i].opcode
+            || std::memcmp(program[i].arguments, otherSDF->program[i].arguments, sizeof(program[i].arguments)) != 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+float NMSDFPrimitive::Distance(const NMPoint& localPoint) const
+{
+    return Distance(localPoint.GetX(), localPoint.GetY(), localPoint.GetZ());
+}
+
+float NMSDFPrimitive::Distance(float x, float y, float z) const
+{
+    float values[MAX_STACK_DEPTH];
+    float points[MAX_STACK_DEPTH][3];
+    uint32_t valueCount = 0;
+    uint32_t pointIndex = 0;
+    points[0][0] = x;
+    points[0][1] = y;
+    points[0][2] = z;
+
+    for (const SNMSDFInstruction& instruction : program)
+    {
+        const float* a = instruction.arguments;
+        const float* p = points[pointIndex];
+        switch (instruction.opcode)
+        {
+            case ENMSDFOpcode::Sphere:
+                values[valueCount++] = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]) - a[0];
+                break;
+            case ENMSDFOpcode::Box:
+            {
+                float qx = std::abs(p[0]) - a[0];
+                float qy = std::abs(p[1]) - a[1];
+                float qz = std::abs(p[2]) - a[2];
+                float ox = std::max(qx, 0.0f);
+                float oy = std::max(qy, 0.0f);
+                float oz = std::max(qz, 0.0f);
+                float inside = std::min(std::max(qx, std::max(qy, qz)), 0.0f);
+                values[valueCount++] = std::sqrt(ox * ox + oy * oy + oz * oz) + inside;
+                break;
+            }
+            case ENMSDFOpcode::Torus:
+            {
+                float qx = std::sqrt(p[0] * p[0] + p[2] * p[2]) - a[0];
+                values[valueCount++] = std::sqrt(qx * qx + p[1] * p[1]) - a[1];
+                break;
+            }
+            case ENMSDFOpcode::Union:
+            {
+                --valueCount;
+                values[valueCount - 1] = std::min(values[valueCount - 1], values[valueCount]);
+                break;
+            }
+            case ENMSDFOpcode::SmoothUnion:
+            {
+                --valueCount;
+                float d1 = values[valueCount - 1];
+                float d2 = values[valueCount];
+                float h = std::min(std::max(0.5f + 0.5f * (d2 - d1) / a[0], 0.0f), 1.0f);
+                values[valueCount - 1] = d2 + (d1 - d2) * h - a[0] * h * (1.0f - h);
+                break;
+            }
+            case ENMSDFOpcode::Translate:
+            {
+                float* q = points[++pointIndex];
+                q[0] = p[0] - a[0];
+                q[1] = p[1] - a[1];
+                q[2] = p[2] - a[2];
+                break;
+            }
+            case ENMSDFOpcode::Repeat:
+            {
+                float* q = points[++pointIndex];
+                q[0] = RepeatAxis(p[0], a[0], a[3]);
+                q[1] = RepeatAxis(p[1], a[1], a[4]);
+                q[2] = RepeatAxis(p[2], a[2], a[5]);
+                break;
+            }
+            case ENMSDFOpcode::PopPoint:
+                --pointIndex;
+                break;
+        }
+    }
+
+    return values[0];
+}
+
+std::vector<SNMIntersection> NMSDFPrimitive::LocalIntersect(const NMRay& localRay) const
+{
+    std::vector<SNMIntersection> hits;
+
+    // March only where the ray is inside the bounds, starting at the origin at the earliest
+    const float origin[3] = {localRay.GetOrigin().GetX(), localRay.GetOrigin().GetY(), localRay.GetOrigin().GetZ()};
+    const float direction[3] = {localRay.GetDirection().GetX(), localRay.GetDirection().GetY(),
+                                localRay.GetDirection().GetZ()};
+    const float boxMin[3] = {bounds.min.GetX(), bounds.min.GetY(), bounds.min.GetZ()};
+    const float boxMax[3] = {bounds.max.GetX(), bounds.max.GetY(), bounds.max.GetZ()};
+
+    float tMin = 0.0f;
+    float tMax = std::numeric_limits<float>::infinity();
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        float inverse = 1.0f / direction[axis];
+        float t0 = (boxMin[axis] - origin[axis]) * inverse;
+        float t1 = (boxMax[axis] - origin[axis]) * inverse;
+        tMin = std::max(tMin, std::min(t0, t1));
+        tMax = std::min(tMax, std::max(t0, t1));
+    }
+
+    if (!(tMin <= tMax))
+    {
+        return hits;
+    }
+
+    // The distance is in object space, the step along a ray whose direction may be scaled
+    float inverseLength = 1.0f / localRay.GetDirection().Magnitude();
+    float t = tMin;
+    for (uint32_t step = 0; step < MAX_STEPS && t <= tMax; ++step)
+    {
+        float distance = std::abs(Distance(origin[0] + t * direction[0], origin[1] + t * direction[1],
+                                           origin[2] + t * direction[2]));
+        if (distance < HIT_DISTANCE)
+        {
+            hits.push_back(SNMIntersection(t, this));
+            break;
+        }
+
+        t += distance * inverseLength;
+    }
+
+    return hits;
+}
+
+NMVector NMSDFPrimitive::LocalNormalAt(const NMPoint& localPoint) const
+{
+    // The tetrahedron technique: four samples at the corners (1,-1,-1), (-1,-1,1), (-1,1,-1) and (1,1,1)
+    const float h = 1e-3f;
+    float x = localPoint.GetX();
+    float y = localPoint.GetY();
+    float z = localPoint.GetZ();
+    float d0 = Distance(x + h, y - h, z - h);
+    float d1 = Distance(x - h, y - h, z + h);
+    float d2 = Distance(x - h, y + h, z - h);
+    float d3 = Distance(x + h, y + h, z + h);
+
+    return NMVector(d0 - d1 - d2 + d3, -d0 - d1 + d2 + d3, -d0 + d1 - d2 + d3);
+}
@@ -0,0 +1,304 @@
+#include "NMCore/Primitive/TriangleMesh.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+constexpr uint32_t NMTriangleMesh::NO_NORMAL;
+
+namespace
+{
+/**
+ * @brief The per-ray setup of the watertight test: the ray is sheared so it points along +z of a permuted space, then
+ *        every triangle is a 2D edge function test around the origin.
+ */
+struct SNMWatertightRay
+{
+    int kx;
+    int ky;
+    int kz;
+    float sx;
+    float sy;
+    float sz;
+    float origin[3];
+
+    explicit SNMWatertightRay(const NMRay& ray)
+    {
+        const float direction[3] = {ray.GetDirection().GetX(), ray.GetDirection().GetY(), ray.GetDirection().GetZ()};
+        origin[0] = ray.GetOrigin().GetX();
+        origin[1] = ray.GetOrigin().GetY();
+        origin[2] = ray.GetOrigin().GetZ();
+
+        // The largest direction component becomes z, x and y are swapped to keep the winding
+        kz = 0;
+        if (std::abs(direction[1]) > std::abs(direction[kz]))
+        {
+            kz = 1;
+        }
+        if (std::abs(direction[2]) > std::abs(direction[kz]))
+        {
+            kz = 2;
+        }
+        kx = (kz + 1) % 3;
+        ky = (kx + 1) % 3;
+        if (direction[kz] < 0.0f)
+        {
+            std::swap(kx, ky);
+        }
+
+        sx = direction[kx] / direction[kz];
+        sy = direction[ky] / direction[kz];
+        sz = 1.0f / direction[kz];
+    }
+};
+
+/**
+ * @brief Test the ray against the triangles of a packet, adding every hit.
+ */
+void IntersectTrianglePacket(const SNMTrianglePacket& packet, const SNMWatertightRay& ray,
+                             const NMPrimitiveBase* mesh, std::vector<SNMIntersection>& hits)
+{
+    const float* ax = packet.vertices[0][ray.kx];
+    const float* ay = packet.vertices[0][ray.ky];
+    const float* az = packet.vertices[0][ray.kz];
+    const float* bx = packet.vertices[1][ray.kx];
+    const float* by = packet.vertices[1][ray.ky];
+    const float* bz = packet.vertices[1][ray.kz];
+    const float* cx = packet.vertices[2][ray.kx];
+    const float* cy = packet.vertices[2][ray.ky];
+    const float* cz = packet.vertices[2][ray.kz];
+    const float ox = ray.origin[ray.kx];
+    const float oy = ray.origin[ray.ky];
+    const float oz = ray.origin[ray.kz];
+
+    // Branch free over all lanes so the loop vectorizes
+    float x[3][BVH_LEAF_SIZE];
+    float y[3][BVH_LEAF_SIZE];
+    float z[3][BVH_LEAF_SIZE];
+    float u[BVH_LEAF_SIZE];
+    float v[BVH_LEAF_SIZE];
+    float w[BVH_LEAF_SIZE];
+    for (uint32_t lane = 0; lane < BVH_LEAF_SIZE; ++lane)
+    {
+        z[0][lane] = az[lane] - oz;
+        z[1][lane] = bz[lane] - oz;
+        z[2][lane] = cz[lane] - oz;
+        x[0][lane] = ax[lane] - ox - ray.sx * z[0][lane];
+        y[0][lane] = ay[lane] - oy - ray.sy * z[0][lane];
+        x[1][lane] = bx[lane] - ox - ray.sx * z[1][lane];
+        y[1][lane] = by[lane] - oy - ray.sy * z[1][lane];
+        x[2][lane] = cx[lane] - ox - ray.sx * z[2][lane];
+        y[2][lane] = cy[lane] - oy - ray.sy * z[2][lane];
+
+        u[lane] = x[2][lane] * y[1][lane] - y[2][lane] * x[1][lane];
+        v[lane] = x[0][lane] * y[2][lane] - y[0][lane] * x[2][lane];
+        w[lane] = x[1][lane] * y[0][lane] - y[1][lane] * x[0][lane];
+    }
+
+    for (uint32_t lane = 0; lane < packet.count; ++lane)
+    {
+        // An edge through the ray is decided in double precision, so a ray on a shared edge hits either triangle
+        if (u[lane] == 0.0f || v[lane] == 0.0f || w[lane] == 0.0f)
+        {
+            u[lane] = static_cast<float>(static_cast<double>(x[2][lane]) * y[1][lane]
+                                         - static_cast<double>(y[2][lane]) * x[1][lane]);
+            v[lane] = static_cast<float>(static_cast<double>(x[0][lane]) * y[2][lane]
+                                         - static_cast<double>(y[0][lane]) * x[2][lane]);
+            w[lane] = static_cast<float>(static_cast<double>(x[1][lane]) * y[0][lane]
+                                         - static_cast<double>(y[1][lane]) * x[0][lane]);
+        }
+
+        // The ray passes inside if all edge functions have the same sign, either winding is a hit
+        bool anyNegative = u[lane] < 0.0f || v[lane] < 0.0f || w[lane] < 0.0f;
+        bool anyPositive = u[lane] > 0.0f || v[lane] > 0.0f || w[lane] > 0.0f;
+        if (anyNegative && anyPositive)
+        {
+            continue;
+        }
+
+        float determinant = u[lane] + v[lane] + w[lane];
+        if (determinant == 0.0f)
+        {
+            continue;
+        }
+
+        float scaledT = ray.sz * (u[lane] * z[0][lane] + v[lane] * z[1][lane] + w[lane] * z[2][lane]);
+        float inverseDeterminant = 1.0f / determinant;
+        hits.push_back(SNMIntersection(scaledT * inverseDeterminant, mesh, packet.triangles[lane],
+                                       v[lane] * inverseDeterminant, w[lane] * inverseDeterminant));
+    }
+}
+}  // namespace
+
+bool NMTriangleMesh::operator==(const NMPrimitiveBase& other) const
+{
+    if (!NMPrimitiveBase::operator==(other))
+    {
+        return false;
+    }
+
+    const NMTriangleMesh* otherMesh = dynamic_cast<const NMTriangleMesh*>(&other);
+    return otherMesh && positions == otherMesh->positions && positionIndices == otherMesh->positionIndices
+           && normals == otherMesh->normals && normalIndices == otherMesh->normalIndices;
+}
+
+void NMTriangleMesh::SetGeometry(std::vector<float> newPositions, std::vector<uint32_t> newPositionIndices,
+                                 std::vector<float> newNormals, std::vector<uint32_t> newNormalIndices)
+{
+    if (newPositions.size() % 3 != 0 || newPositionIndices.size() % 3 != 0 || newNormals.size() % 3 != 0)
+    {
+        throw std::runtime_error("Triangle mesh buffers must hold three values per vertex, normal and triangle");
+    }
+
+    if (!newNormals.empty() && newNormalIndices.size() != newPositionIndices.size())
+    {
+        throw std::runtime_error("Triangle mesh needs one normal index per vertex index");
+    }
+
+    std::size_t vertexCount = newPositions.size() / 3;
+    for (uint32_t index : newPositionIndices)
+    {
+        if (index >= vertexCount)
+        {
+            throw std::runtime_error("Triangle mesh vertex index " + std::to_string(index) + " is out of range");
+        }
+    }
+
+    std::size_t normalCount = newNormals.size() / 3;
+    for (uint32_t index : newNormalIndices)
+    {
+        if (index != NO_NORMAL && index >= normalCount)
+        {
+            throw std::runtime_error("Triangle mesh normal index " + std::to_string(index) + " is out of range");
+        }
+    }
+
+    positions = std::move(newPositions);
+    positionIndices = std::move(newPositionIndices);
+    normals = std::move(newNormals);
+    normalIndices = normals.empty() ? std::vector<uint32_t>() : std::move(newNormalIndices);
+
+    BuildBVH();
+}
+
+void NMTriangleMesh::BuildBVH()
+{
+    std::size_t triangleCount = GetTriangleCount();
+
+    bounds = SNMBounds();
+    std::vector<SNMBounds> triangleBounds(triangleCount);
+    std::vector<uint32_t> ids(triangleCount);
+    for (std::size_t i = 0; i < triangleCount; ++i)
+    {
+        for (std::size_t corner = 0; corner < 3; ++corner)
+        {
+            triangleBounds[i].Extend(GetVertex(positionIndices[i * 3 + corner]));
+        }
+        bounds.Extend(triangleBounds[i]);
+        ids[i] = static_cast<uint32_t>(i);
+    }
+
+    bvh.Build(triangleBounds, ids);
+    packets.clear();
+    if (bvh.IsEmpty())
+    {
+        return;
+    }
+
+    // Copy the triangles of every leaf into a packet and point the leaf at it
+    std::vector<SNMBVHNode> nodes = bvh.GetNodes();
+    const std::vector<uint32_t>& indices = bvh.GetIndices();
+    packets.reserve(triangleCount / BVH_LEAF_SIZE + 1);
+    for (SNMBVHNode& node : nodes)
+    {
+        if (!node.IsLeaf())
+        {
+            continue;
+        }
+
+        SNMTrianglePacket packet = SNMTrianglePacket();
+        packet.count = node.count;
+        for (uint32_t lane = 0; lane < node.count; ++lane)
+        {
+            uint32_t triangle = indices[node.offset + lane];
+            packet.triangles[lane] = triangle;
+            for (std::size_t corner = 0; corner < 3; ++corner)
+            {
+                std::size_t vertex = positionIndices[triangle * 3 + corner];
+                for (std::size_t axis = 0; axis < 3; ++axis)
+                {
+                    packet.vertices[corner][axis][lane] = positions[vertex * 3 + axis];
+                }
+            }
+        }
+
+        node.offset = static_cast<uint32_t>(packets.size());
+        packets.push_back(packet);
+    }
+
+    // Assign() copies from the pointers, which must not point into the BVH itself
+    std::vector<uint32_t> leafIndices = indices;
+    bvh.Assign(nodes.data(), nodes.size(), leafIndices.data(), leafIndices.size());
+}
+
+std::vector<SNMIntersection> NMTriangleMesh::LocalIntersect(const NMRay& localRay) const
+{
+    std::vector<SNMIntersection> hits;
+    if (packets.empty())
+    {
+        return hits;
+    }
+
+    SNMWatertightRay ray(localRay);
+    bvh.TraverseLeaves(localRay, [this, &ray, &hits](const SNMBVHNode& leaf)
+                       { IntersectTrianglePacket(packets[leaf.offset], ray, this, hits); });
+
+    return hits;
+}
+
+NMVector NMTriangleMesh::LocalNormalAt(const NMPoint& localPoint) const
+{
+    return LocalNormalAt(localPoint, SNMIntersection(0.0f, this));
+}
+
+NMVector NMTriangleMesh::LocalNormalAt(const NMPoint& /* localPoint */, const SNMIntersection& hit) const
+{
+    if (hit.index >= GetTriangleCount())
+    {
+        return NMVector(0.0f, 1.0f, 0.0f);
+    }
+
+    if (normalIndices.empty())
+    {
+        return FaceNormal(hit.index);
+    }
+
+    const uint32_t* corners = &normalIndices[hit.index * 3];
+    if (corners[0] == NO_NORMAL || corners[1] == NO_NORMAL || corners[2] == NO_NORMAL)
+    {
+        return FaceNormal(hit.index);
+    }
+
+    // Interpolate the vertex normals with the barycentric coordinates of the hit
+    float weights[3] = {1.0f - hit.u - hit.v, hit.u, hit.v};
+    float normal[3] = {0.0f, 0.0f, 0.0f};
+    for (std::size_t corner = 0; corner < 3; ++corner)
+    {
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            normal[axis] += weights[corner] * normals[corners[corner] * 3 + axis];
+        }
+    }
+
+    return NMVector(normal[0], normal[1], normal[2]);
+}
+
+NMVector NMTriangleMesh::FaceNormal(uint32_t triangle) const
+{
+    NMPoint a = GetVertex(positionIndices[triangle * 3]);
+    NMPoint b = GetVertex(positionIndices[triangle * 3 + 1]);
+    NMPoint c = GetVertex(positionIndices[triangle * 3 + 2]);
+
+    // Same winding convention as the rest of the renderer's left handed space
+    return (c - a).CrossProduct(b - a);
+}
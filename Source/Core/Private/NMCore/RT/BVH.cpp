@@ -0,0 +1,101 @@
+#include "NMCore/RT/BVH.hpp"
+
+#include <algorithm>
+
+namespace
+{
+struct SNMBuildItem
+{
+    SNMBounds bounds;
+    float center[3];
+    uint32_t id;
+};
+
+void StoreBounds(SNMBVHNode& node, const SNMBounds& bounds)
+{
+    node.min[0] = bounds.min.GetX();
+    node.min[1] = bounds.min.GetY();
+    node.min[2] = bounds.min.GetZ();
+    node.max[0] = bounds.max.GetX();
+    node.max[1] = bounds.max.GetY();
+    node.max[2] = bounds.max.GetZ();
+}
+
+void BuildRange(std::vector<SNMBVHNode>& nodes, std::vector<SNMBuildItem>& items, std::size_t begin,
+                std::size_t end)
+{
+    std::size_t nodeIndex = nodes.size();
+    nodes.push_back(SNMBVHNode());
+
+    SNMBounds bounds;
+    SNMBounds centers;
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        bounds.Extend(items[i].bounds);
+        centers.Extend(NMPoint(items[i].center[0], items[i].center[1], items[i].center[2]));
+    }
+
+    StoreBounds(nodes[nodeIndex], bounds);
+
+    std::size_t count = end - begin;
+    if (count <= BVH_LEAF_SIZE)
+    {
+        nodes[nodeIndex].offset = static_cast<uint32_t>(begin);
+        nodes[nodeIndex].count = static_cast<uint32_t>(count);
+        return;
+    }
+
+    float extent[3] = {centers.max.GetX() - centers.min.GetX(), centers.max.GetY() - centers.min.GetY(),
+                       centers.max.GetZ() - centers.min.GetZ()};
+    int axis = 0;
+    if (extent[1] > extent[axis])
+    {
+        axis = 1;
+    }
+    if (extent[2] > extent[axis])
+    {
+        axis = 2;
+    }
+
+    std::size_t middle = begin + count / 2;
+    std::nth_element(items.begin() + static_cast<std::ptrdiff_t>(begin),
+                     items.begin() + static_cast<std::ptrdiff_t>(middle),
+                     items.begin() + static_cast<std::ptrdiff_t>(end),
+                     [axis](const SNMBuildItem& a, const SNMBuildItem& b) { return a.center[axis] < b.center[axis]; });
+
+    BuildRange(nodes, items, begin, middle);
+    nodes[nodeIndex].offset = static_cast<uint32_t>(nodes.size());
+    nodes[nodeIndex].count = 0;
+    BuildRange(nodes, items, middle, end);
+}
+}  // namespace
+
+void NMBVH::Build(const std::vector<SNMBounds>& bounds, const std::vector<uint32_t>& ids)
+{
+    Clear();
+
+    if (bounds.empty() || bounds.size() != ids.size())
+    {
+        return;
+    }
+
+    std::vector<SNMBuildItem> items(bounds.size());
+    for (std::size_t i = 0; i < bounds.size(); ++i)
+    {
+        NMPoint center = bounds[i].Center();
+        items[i].bounds = bounds[i];
+        items[i].center[0] = center.GetX();
+        items[i].center[1] = center.GetY();
+        items[i].center[2] = center.GetZ();
+        items[i].id = ids[i];
+    }
+
+    nodes.reserve(2 * (items.size() / BVH_LEAF_SIZE + 1));
+    BuildRange(nodes, items, 0, items.size());
+
+    indices.resize(items.size());
+    for (std::size_t i = 0; i < items.size(); ++i)
+    {
+        indices[i] = items[i].id;
+    }
+}
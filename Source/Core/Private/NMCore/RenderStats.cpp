@@ -0,0 +1,96 @@
+#include "NMCore/RenderStats.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+uint64_t SNMRenderStats::TotalRays() const
+{
+    uint64_t total = 0;
+    for (uint64_t count : rays)
+    {
+        total += count;
+    }
+
+    return total;
+}
+
+double SNMRenderStats::AverageReflectionDepth() const
+{
+    uint64_t primary = GetRays(ENMRayType::Primary);
+    if (primary == 0)
+    {
+        return 0.0;
+    }
+
+    return static_cast<double>(GetRays(ENMRayType::Reflection)) / static_cast<double>(primary);
+}
+
+double SNMRenderStats::TextureHitRate() const
+{
+    uint64_t lookups = textureTileHits + textureTileMisses;
+    if (lookups == 0)
+    {
+        return 1.0;
+    }
+
+    return static_cast<double>(textureTileHits) / static_cast<double>(lookups);
+}
+
+double SNMRenderStats::MaxTileSeconds() const
+{
+    double slowest = 0.0;
+    for (const SNMTileTime& tile : tiles)
+    {
+        slowest = std::max(slowest, tile.seconds);
+    }
+
+    return slowest;
+}
+
+void SNMRenderStats::Accumulate(const SNMRenderCounters& counters)
+{
+    for (std::size_t i = 0; i < RAY_TYPE_COUNT; ++i)
+    {
+        rays[i] += counters.rays[i];
+    }
+
+    intersectionTests += counters.intersectionTests;
+    intersectionHits += counters.intersectionHits;
+    textureTileHits += counters.textureTileHits;
+    textureTileMisses += counters.textureTileMisses;
+    textureBytesRead += counters.textureBytesRead;
+}
+
+std::string SNMRenderStats::ToJSON() const
+{
+    std::ostringstream json;
+    json << std::setprecision(6) << std::fixed;
+    json << "{\"enabled\":" << (enabled ? "true" : "false") << ",\"frame_seconds\":" << frameSeconds
+         << ",\"tiles\":" << tileCount;
+
+    if (enabled)
+    {
+        json << ",\"rays\":{\"primary\":" << GetRays(ENMRayType::Primary)
+             << ",\"shadow\":" << GetRays(ENMRayType::Shadow)
+             << ",\"reflection\":" << GetRays(ENMRayType::Reflection)
+             << ",\"refraction\":" << GetRays(ENMRayType::Refraction) << "}"
+             << ",\"intersection_tests\":" << intersectionTests << ",\"intersection_hits\":" << intersectionHits
+             << ",\"texture_tiles\":{\"hits\":" << textureTileHits << ",\"misses\":" << textureTileMisses
+             << ",\"hit_rate\":" << TextureHitRate() << ",\"bytes_read\":" << textureBytesRead << "}"
+             << ",\"average_reflection_depth\":" << AverageReflectionDepth()
+             << ",\"max_tile_seconds\":" << MaxTileSeconds() << ",\"workers\":[";
+
+        for (std::size_t i = 0; i < workers.size(); ++i)
+        {
+            json << (i > 0 ? "," : "") << "{\"tiles\":" << workers[i].tiles
+                 << ",\"busy_seconds\":" << workers[i].busySeconds << ",\"idle_seconds\":" << workers[i].idleSeconds
+                 << ",\"queue_wait_seconds\":" << workers[i].queueWaitSeconds << "}";
+        }
+
+        json << "]";
+    }
+
+    json << "}";
+    return json.str();
+}
@@ -0,0 +1,221 @@
+#include "NMCore/Scene/ImageLoader.hpp"
+
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// Larger images are assumed to be corrupt headers rather than textures
+constexpr unsigned long MAX_IMAGE_SIZE = 1 << 15;
+
+[[noreturn]] void Error(const std::string& sourceName, const std::string& message)
+{
+    throw std::runtime_error(sourceName + ": " + message);
+}
+
+// The next whitespace separated header token, skipping comments
+std::string ReadHeaderToken(std::istream& stream, const std::string& sourceName)
+{
+    int c = stream.get();
+    while (c != EOF && (std::isspace(c) || c == '#'))
+    {
+        if (c == '#')
+        {
+            while (c != EOF && c != '\n')
+            {
+                c = stream.get();
+            }
+        }
+
+        c = stream.get();
+    }
+
+    std::string token;
+    while (c != EOF && !std::isspace(c))
+    {
+        token += static_cast<char>(c);
+        c = stream.get();
+    }
+
+    // The single whitespace after the last header token is consumed here, binary data follows it
+    if (token.empty())
+    {
+        Error(sourceName, "unexpected end of header");
+    }
+
+    return token;
+}
+
+unsigned long ReadHeaderInteger(std::istream& stream, const std::string& sourceName, unsigned long maximum)
+{
+    std::string token = ReadHeaderToken(stream, sourceName);
+    char* end = nullptr;
+    unsigned long value = std::strtoul(token.c_str(), &end, 10);
+    if (*end != '\0' || token[0] == '-' || value == 0 || value > maximum)
+    {
+        Error(sourceName, "invalid header value '" + token + "'");
+    }
+
+    return value;
+}
+
+float ReadHeaderFloat(std::istream& stream, const std::string& sourceName)
+{
+    std::string token = ReadHeaderToken(stream, sourceName);
+    char* end = nullptr;
+    float value = std::strtof(token.c_str(), &end);
+    if (*end != '\0' || value == 0.0f)
+    {
+        Error(sourceName, "invalid header value '" + token + "'");
+    }
+
+    return value;
+}
+
+void ReadBytes(std::istream& stream, const std::string& sourceName, std::vector<unsigned char>& bytes)
+{
+    stream.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (static_cast<std::size_t>(stream.gcount()) != bytes.size())
+    {
+        Error(sourceName, "image data is truncated");
+    }
+}
+
+bool IsLittleEndianHost()
+{
+    const uint16_t probe = 1;
+    unsigned char first;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+NMCanvas LoadPlainPPM(std::istream& stream, const std::string& sourceName, std::size_t width, std::size_t height,
+                      float scale, unsigned long maxValue)
+{
+    NMCanvas canvas(width, height);
+    for (std::size_t y = 0; y < height; ++y)
+    {
+        for (std::size_t x = 0; x < width; ++x)
+        {
+            float channels[3];
+            for (float& channel : channels)
+            {
+                unsigned long value;
+                if (!(stream >> value) || value > maxValue)
+                {
+                    Error(sourceName, "invalid or missing pixel value");
+                }
+
+                channel = static_cast<float>(value) * scale;
+            }
+
+            canvas.WritePixel(x, y, NMColor(channels[0], channels[1], channels[2]));
+        }
+    }
+
+    return canvas;
+}
+
+NMCanvas LoadBinaryPPM(std::istream& stream, const std::string& sourceName, std::size_t width, std::size_t height,
+                       float scale, unsigned long maxValue)
+{
+    std::size_t bytesPerChannel = maxValue > 255 ? 2 : 1;
+    std::vector<unsigned char> row(width * 3 * bytesPerChannel);
+    NMCanvas canvas(width, height);
+    for (std::size_t y = 0; y < height; ++y)
+    {
+        ReadBytes(stream, sourceName, row);
+        for (std::size_t x = 0; x < width; ++x)
+        {
+            float channels[3];
+            for (std::size_t channel = 0; channel < 3; ++channel)
+            {
+                // 16 bit samples are big-endian
+                const unsigned char* sample = &row[(x * 3 + channel) * bytesPerChannel];
+                unsigned long value = bytesPerChannel == 2 ? (static_cast<unsigned long>(sample[0]) << 8) | sample[1]
+                                                           : sample[0];
+                channels[channel] = static_cast<float>(value) * scale;
+            }
+
+            canvas.WritePixel(x, y, NMColor(channels[0], channels[1], channels[2]));
+        }
+    }
+
+    return canvas;
+}
+
+NMCanvas LoadPFM(std::istream& stream, const std::string& sourceName, std::size_t width, std::size_t height,
+                 std::size_t channelCount, bool littleEndian)
+{
+    bool swap = littleEndian != IsLittleEndianHost();
+    std::vector<unsigned char> row(width * channelCount * sizeof(float));
+    NMCanvas canvas(width, height);
+
+    // Rows are stored bottom to top
+    for (std::size_t y = height; y-- > 0;)
+    {
+        ReadBytes(stream, sourceName, row);
+        for (std::size_t x = 0; x < width; ++x)
+        {
+            float channels[3];
+            for (std::size_t channel = 0; channel < channelCount; ++channel)
+            {
+                unsigned char* sample = &row[(x * channelCount + channel) * sizeof(float)];
+                if (swap)
+                {
+                    std::swap(sample[0], sample[3]);
+                    std::swap(sample[1], sample[2]);
+                }
+
+                std::memcpy(&channels[channel], sample, sizeof(float));
+            }
+
+            canvas.WritePixel(x, y, channelCount == 3 ? NMColor(channels[0], channels[1], channels[2])
+                                                      : NMColor(channels[0], channels[0], channels[0]));
+        }
+    }
+
+    return canvas;
+}
+}  // namespace
+
+NMCanvas NMImageLoader::Load(std::istream& stream, const std::string& sourceName)
+{
+    std::string magic = ReadHeaderToken(stream, sourceName);
+    if (magic != "P3" && magic != "P6" && magic != "PF" && magic != "Pf")
+    {
+        Error(sourceName, "unsupported image format '" + magic + "', expected P3, P6, PF or Pf");
+    }
+
+    std::size_t width = ReadHeaderInteger(stream, sourceName, MAX_IMAGE_SIZE);
+    std::size_t height = ReadHeaderInteger(stream, sourceName, MAX_IMAGE_SIZE);
+
+    // The sign of a PFM's scale is its byte order, negative for little-endian
+    if (magic == "PF" || magic == "Pf")
+    {
+        float scale = ReadHeaderFloat(stream, sourceName);
+        return LoadPFM(stream, sourceName, width, height, magic == "PF" ? 3 : 1, scale < 0.0f);
+    }
+
+    unsigned long maxValue = ReadHeaderInteger(stream, sourceName, 65535);
+    float scale = 1.0f / static_cast<float>(maxValue);
+    return magic == "P3" ? LoadPlainPPM(stream, sourceName, width, height, scale, maxValue)
+                         : LoadBinaryPPM(stream, sourceName, width, height, scale, maxValue);
+}
+
+NMCanvas NMImageLoader::LoadFile(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+    {
+        throw std::runtime_error("Failed to open image file " + path);
+    }
+
+    return Load(file, path);
+}
@@ -0,0 +1,332 @@
+#include "NMCore/Scene/ObjLoader.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include "NMCore/Scene/SceneParser.hpp"
+
+namespace
+{
+// Lines are parsed straight out of the read buffer, which only grows for a line longer than this
+constexpr std::size_t OBJ_CHUNK_SIZE = 1 << 20;
+
+inline bool IsSpace(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+/**
+ * @brief Parses OBJ lines into the mesh buffers, one line at a time.
+ */
+class NMObjReader
+{
+public:
+
+    explicit NMObjReader(const std::string& sourceName) : sourceName(sourceName) {}
+
+    /**
+     * @brief Parse one line, without its newline.
+     */
+    void ReadLine(const char* begin, const char* end)
+    {
+        cursor = begin;
+        lineStart = begin;
+        lineEnd = end;
+
+        SkipSpace();
+        const char* keyword = cursor;
+        while (cursor != lineEnd && !IsSpace(*cursor))
+        {
+            ++cursor;
+        }
+
+        std::size_t length = static_cast<std::size_t>(cursor - keyword);
+        if (length == 1 && keyword[0] == 'v')
+        {
+            ReadVector(positions);
+        }
+        else if (length == 2 && keyword[0] == 'v' && keyword[1] == 'n')
+        {
+            ReadVector(normals);
+        }
+        else if (length == 1 && keyword[0] == 'f')
+        {
+            ReadFace();
+        }
+
+        ++line;
+    }
+
+    std::shared_ptr<NMTriangleMesh> Finish()
+    {
+        if (normals.empty())
+        {
+            normalIndices.clear();
+        }
+
+        std::shared_ptr<NMTriangleMesh> mesh = std::make_shared<NMTriangleMesh>();
+        mesh->SetGeometry(std::move(positions), std::move(positionIndices), std::move(normals),
+                          std::move(normalIndices));
+        return mesh;
+    }
+
+protected:
+
+    const std::string& sourceName;
+    std::size_t line = 1;
+
+    const char* cursor = nullptr;
+    const char* lineStart = nullptr;
+    const char* lineEnd = nullptr;
+
+    std::vector<float> positions;
+    std::vector<float> normals;
+    std::vector<uint32_t> positionIndices;
+    std::vector<uint32_t> normalIndices;
+
+    [[noreturn]] void Error(const char* at, const std::string& message) const
+    {
+        throw NMSceneParseError(sourceName, line, static_cast<std::size_t>(at - lineStart) + 1, message);
+    }
+
+    inline void SkipSpace()
+    {
+        while (cursor != lineEnd && IsSpace(*cursor))
+        {
+            ++cursor;
+        }
+    }
+
+    inline bool AtEndOfStatement()
+    {
+        SkipSpace();
+        return cursor == lineEnd || *cursor == '#';
+    }
+
+    float ReadFloat()
+    {
+        if (AtEndOfStatement())
+        {
+            Error(cursor, "expected a number");
+        }
+
+        const char* start = cursor;
+        bool negative = false;
+        if (*cursor == '-' || *cursor == '+')
+        {
+            negative = *cursor == '-';
+            ++cursor;
+        }
+
+        double value = 0.0;
+        bool hasDigits = false;
+        while (cursor != lineEnd && *cursor >= '0' && *cursor <= '9')
+        {
+            value = value * 10.0 + (*cursor - '0');
+            hasDigits = true;
+            ++cursor;
+        }
+
+        if (cursor != lineEnd && *cursor == '.')
+        {
+            ++cursor;
+            double scale = 0.1;
+            while (cursor != lineEnd && *cursor >= '0' && *cursor <= '9')
+            {
+                value += (*cursor - '0') * scale;
+                scale *= 0.1;
+                hasDigits = true;
+                ++cursor;
+            }
+        }
+
+        if (hasDigits && cursor != lineEnd && (*cursor == 'e' || *cursor == 'E'))
+        {
+            ++cursor;
+            bool negativeExponent = false;
+            if (cursor != lineEnd && (*cursor == '-' || *cursor == '+'))
+            {
+                negativeExponent = *cursor == '-';
+                ++cursor;
+            }
+
+            int exponent = 0;
+            bool hasExponent = false;
+            while (cursor != lineEnd && *cursor >= '0' && *cursor <= '9')
+            {
+                exponent = exponent * 10 + (*cursor - '0');
+                hasExponent = true;
+                ++cursor;
+            }
+
+            hasDigits = hasExponent;
+            value *= std::pow(10.0, negativeExponent ? -exponent : exponent);
+        }
+
+        if (!hasDigits || (cursor != lineEnd && !IsSpace(*cursor)))
+        {
+            Error(start, "expected a number");
+        }
+
+        return static_cast<float>(negative ? -value : value);
+    }
+
+    void ReadVector(std::vector<float>& values)
+    {
+        // A fourth vertex component (w) and vertex colors are ignored
+        values.push_back(ReadFloat());
+        values.push_back(ReadFloat());
+        values.push_back(ReadFloat());
+    }
+
+    /**
+     * @brief Read a 1-based or negative (relative to the end) index into a list of count entries.
+     */
+    uint32_t ReadIndex(std::size_t count)
+    {
+        const char* start = cursor;
+        bool negative = cursor != lineEnd && *cursor == '-';
+        if (negative)
+        {
+            ++cursor;
+        }
+
+        std::size_t value = 0;
+        bool hasDigits = false;
+        while (cursor != lineEnd && *cursor >= '0' && *cursor <= '9')
+        {
+            value = value * 10 + static_cast<std::size_t>(*cursor - '0');
+            hasDigits = true;
+            ++cursor;
+        }
+
+        if (!hasDigits)
+        {
+            Error(start, "expected an index");
+        }
+
+        if (value == 0 || value > count)
+        {
+            Error(start, "index " + std::string(negative ? "-" : "") + std::to_string(value) + " is out of range");
+        }
+
+        return static_cast<uint32_t>(negative ? count - value : value - 1);
+    }
+
+    void ReadFace()
+    {
+        uint32_t firstPosition = 0;
+        uint32_t firstNormal = 0;
+        uint32_t previousPosition = 0;
+        uint32_t previousNormal = 0;
+        std::size_t corners = 0;
+
+        while (!AtEndOfStatement())
+        {
+            uint32_t position = ReadIndex(positions.size() / 3);
+            uint32_t normal = NMTriangleMesh::NO_NORMAL;
+            if (cursor != lineEnd && *cursor == '/')
+            {
+                // Skip the texture coordinate index
+                ++cursor;
+                while (cursor != lineEnd && *cursor != '/' && !IsSpace(*cursor))
+                {
+                    ++cursor;
+                }
+
+                if (cursor != lineEnd && *cursor == '/')
+                {
+                    ++cursor;
+                    normal = ReadIndex(normals.size() / 3);
+                }
+            }
+
+            if (cursor != lineEnd && !IsSpace(*cursor) && *cursor != '#')
+            {
+                Error(cursor, "unexpected character in face corner");
+            }
+
+            // Fan the polygon around its first corner
+            if (corners == 0)
+            {
+                firstPosition = position;
+                firstNormal = normal;
+            }
+            else if (corners >= 2)
+            {
+                positionIndices.push_back(firstPosition);
+                positionIndices.push_back(previousPosition);
+                positionIndices.push_back(position);
+                normalIndices.push_back(firstNormal);
+                normalIndices.push_back(previousNormal);
+                normalIndices.push_back(normal);
+            }
+
+            previousPosition = position;
+            previousNormal = normal;
+            ++corners;
+        }
+
+        if (corners < 3)
+        {
+            Error(lineStart, "a face needs at least three corners");
+        }
+    }
+};
+}  // namespace
+
+std::shared_ptr<NMTriangleMesh> NMObjLoader::Load(std::istream& stream, const std::string& sourceName)
+{
+    NMObjReader reader(sourceName);
+
+    std::vector<char> buffer(OBJ_CHUNK_SIZE);
+    std::size_t filled = 0;
+    while (true)
+    {
+        stream.read(buffer.data() + filled, static_cast<std::streamsize>(buffer.size() - filled));
+        if (stream.bad())
+        {
+            throw std::runtime_error("Failed to read OBJ " + sourceName);
+        }
+        filled += static_cast<std::size_t>(stream.gcount());
+
+        const char* end = buffer.data() + filled;
+        const char* lineBegin = buffer.data();
+        while (const char* newline =
+                   static_cast<const char*>(std::memchr(lineBegin, '\n', static_cast<std::size_t>(end - lineBegin))))
+        {
+            reader.ReadLine(lineBegin, newline);
+            lineBegin = newline + 1;
+        }
+
+        std::size_t rest = static_cast<std::size_t>(end - lineBegin);
+        if (!stream)
+        {
+            if (rest > 0)
+            {
+                reader.ReadLine(lineBegin, end);
+            }
+            break;
+        }
+
+        // Keep the unfinished line at the front, growing the buffer if it does not fit
+        std::memmove(buffer.data(), lineBegin, rest);
+        filled = rest;
+        if (filled == buffer.size())
+        {
+            buffer.resize(buffer.size() * 2);
+        }
+    }
+
+    return reader.Finish();
+}
+
+std::shared_ptr<NMTriangleMesh> NMObjLoader::LoadFile(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+    {
+        throw std::runtime_error("Failed to open OBJ file " + path);
+    }
+
+    return Load(file, path);
+}
@@ -0,0 +1,532 @@
+#include "NMCore/Scene/SceneCache.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "NMCore/Pattern/Checker.hpp"
+#include "NMCore/Pattern/Gradient.hpp"
+#include "NMCore/Pattern/Ring.hpp"
+#include "NMCore/Pattern/Stripe.hpp"
+#include "NMCore/Primitive/Plane.hpp"
+#include "NMCore/Primitive/Sphere.hpp"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+constexpr uint64_t SECTION_ALIGNMENT = 16;
+
+void StoreMatrix(const NMMatrix& matrix, float* out) { std::copy_n(matrix.GetData(), 16, out); }
+
+NMMatrix LoadMatrix(const float* values) { return NMMatrix(4, 4, values, 16); }
+
+void StoreColor(const NMColor& color, float* out)
+{
+    out[0] = color.GetRed();
+    out[1] = color.GetGreen();
+    out[2] = color.GetBlue();
+}
+
+NMColor LoadColor(const float* values) { return NMColor(values[0], values[1], values[2]); }
+
+// Material records are zero filled before they are set, so equal materials have equal bytes
+std::string MaterialKey(const SNMCachedMaterial& material)
+{
+    return std::string(reinterpret_cast<const char*>(&material), sizeof(material));
+}
+
+template <typename T> bool StorePattern(const NMPatternBase& pattern, ENMCachedPatternType type, SNMCachedPattern& out)
+{
+    const T* typed = dynamic_cast<const T*>(&pattern);
+    if (typed == nullptr)
+    {
+        return false;
+    }
+
+    out.type = type;
+    StoreColor(typed->GetColorA(), out.colorA);
+    StoreColor(typed->GetColorB(), out.colorB);
+    return true;
+}
+
+/**
+ * @brief Appends sections to the output and records where they start.
+ */
+class NMSectionWriter
+{
+public:
+
+    explicit NMSectionWriter(std::ofstream& file) : file(file) {}
+
+    template <typename T> void Write(const std::vector<T>& items, uint64_t& offset, uint64_t& count)
+    {
+        Pad();
+        offset = position;
+        count = items.size();
+
+        std::size_t bytes = items.size() * sizeof(T);
+        file.write(reinterpret_cast<const char*>(items.data()), static_cast<std::streamsize>(bytes));
+        position += bytes;
+    }
+
+    inline void Skip(uint64_t bytes) { position += bytes; }
+
+protected:
+
+    std::ofstream& file;
+    uint64_t position = 0;
+
+    void Pad()
+    {
+        static const char zeros[SECTION_ALIGNMENT] = {};
+        uint64_t padding = (SECTION_ALIGNMENT - position % SECTION_ALIGNMENT) % SECTION_ALIGNMENT;
+        file.write(zeros, static_cast<std::streamsize>(padding));
+        position += padding;
+    }
+};
+}  // namespace
+
+NMSceneCache::NMSceneCache(const std::string& path)
+{
+#ifndef _WIN32
+    int descriptor = open(path.c_str(), O_RDONLY);
+    if (descriptor < 0)
+    {
+        throw std::runtime_error("Failed to open scene cache " + path);
+    }
+
+    struct stat info;
+    if (fstat(descriptor, &info) != 0 || info.st_size <= 0)
+    {
+        close(descriptor);
+        throw std::runtime_error("Failed to read scene cache " + path);
+    }
+
+    size = static_cast<std::size_t>(info.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    close(descriptor);
+    if (mapping == MAP_FAILED)
+    {
+        throw std::runtime_error("Failed to map scene cache " + path);
+    }
+
+    data = static_cast<const char*>(mapping);
+#else
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+        throw std::runtime_error("Failed to open scene cache " + path);
+    }
+
+    std::streamsize fileSize = file.tellg();
+    buffer.resize(static_cast<std::size_t>(fileSize));
+    file.seekg(0);
+    if (!file.read(buffer.data(), fileSize))
+    {
+        throw std::runtime_error("Failed to read scene cache " + path);
+    }
+
+    data = buffer.data();
+    size = buffer.size();
+#endif
+
+    header = reinterpret_cast<const SNMSceneCacheHeader*>(data);
+
+    try
+    {
+        Validate(path);
+    }
+    catch (...)
+    {
+#ifndef _WIN32
+        munmap(const_cast<char*>(data), size);
+#endif
+        throw;
+    }
+}
+
+NMSceneCache::~NMSceneCache()
+{
+#ifndef _WIN32
+    if (data != nullptr)
+    {
+        munmap(const_cast<char*>(data), size);
+    }
+#endif
+}
+
+bool NMSceneCache::IsCacheFile(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    char magic[sizeof(SCENE_CACHE_MAGIC)] = {};
+    return file.read(magic, sizeof(magic)) && std::memcmp(magic, SCENE_CACHE_MAGIC, sizeof(magic)) == 0;
+}
+
+void NMSceneCache::Validate(const std::string& path) const
+{
+    auto fail = [&path](const std::string& message)
+    { throw std::runtime_error("scene cache " + path + ": " + message); };
+
+    if (size < sizeof(SNMSceneCacheHeader)
+        || std::memcmp(header->magic, SCENE_CACHE_MAGIC, sizeof(header->magic)) != 0)
+    {
+        fail("not a scene cache");
+    }
+
+    if (header->version != SCENE_CACHE_VERSION)
+    {
+        fail("unsupported version " + std::to_string(header->version));
+    }
+
+    auto checkSection = [&](uint64_t offset, uint64_t count, std::size_t itemSize, const char* name)
+    {
+        if (offset % SECTION_ALIGNMENT != 0 || offset > size || count > (size - offset) / itemSize)
+        {
+            fail(std::string(name) + " section is out of bounds");
+        }
+    };
+
+    checkSection(header->patternOffset, header->patternCount, sizeof(SNMCachedPattern), "pattern");
+    checkSection(header->materialOffset, header->materialCount, sizeof(SNMCachedMaterial), "material");
+    checkSection(header->primitiveOffset, header->primitiveCount, sizeof(SNMCachedPrimitive), "primitive");
+    checkSection(header->lightOffset, header->lightCount, sizeof(SNMCachedLight), "light");
+    checkSection(header->bvhNodeOffset, header->bvhNodeCount, sizeof(SNMBVHNode), "bvh node");
+    checkSection(header->bvhIndexOffset, header->bvhIndexCount, sizeof(uint32_t), "bvh index");
+    checkSection(header->unboundedOffset, header->unboundedCount, sizeof(uint32_t), "unbounded");
+
+    if (header->primitiveCount > UINT32_MAX || header->bvhNodeCount > UINT32_MAX
+        || header->reflectionTraceDepth > 255)
+    {
+        fail("header values out of range");
+    }
+
+    if (header->bvhIndexCount + header->unboundedCount != header->primitiveCount)
+    {
+        fail("bvh and unbounded list do not cover every primitive");
+    }
+
+    // Without nodes the indexed primitives would never be intersected
+    if (header->bvhIndexCount > 0 && header->bvhNodeCount == 0)
+    {
+        fail("bvh has indices but no nodes");
+    }
+
+    // Cross references are checked once here so Instantiate() and the BVH traversal can trust them
+    const SNMCachedPattern* patterns = GetPatterns();
+    for (uint64_t i = 0; i < header->patternCount; ++i)
+    {
+        if (patterns[i].type > ENMCachedPatternType::Checker)
+        {
+            fail("pattern " + std::to_string(i) + " has an unknown type");
+        }
+    }
+
+    const SNMCachedMaterial* materials = GetMaterials();
+    for (uint64_t i = 0; i < header->materialCount; ++i)
+    {
+        if (materials[i].pattern < -1 || materials[i].pattern >= static_cast<int64_t>(header->patternCount))
+        {
+            fail("material " + std::to_string(i) + " references a missing pattern");
+        }
+    }
+
+    const SNMCachedPrimitive* primitives = GetPrimitives();
+    for (uint64_t i = 0; i < header->primitiveCount; ++i)
+    {
+        if (primitives[i].type > ENMCachedPrimitiveType::Plane || primitives[i].material >= header->materialCount)
+        {
+            fail("primitive " + std::to_string(i) + " is invalid");
+        }
+    }
+
+    const uint32_t* indices = GetBVHIndices();
+    for (uint64_t i = 0; i < header->bvhIndexCount; ++i)
+    {
+        if (indices[i] >= header->primitiveCount)
+        {
+            fail("bvh references a missing primitive");
+        }
+    }
+
+    const uint32_t* unbounded = GetUnbounded();
+    for (uint64_t i = 0; i < header->unboundedCount; ++i)
+    {
+        if (unbounded[i] >= header->primitiveCount)
+        {
+            fail("unbounded list references a missing primitive");
+        }
+    }
+
+    // Children must come after their parent, which bounds the traversal and lets depths be checked in one pass
+    const SNMBVHNode* nodes = GetBVHNodes();
+    std::vector<uint8_t> depth(static_cast<std::size_t>(header->bvhNodeCount), 0);
+    for (uint64_t i = 0; i < header->bvhNodeCount; ++i)
+    {
+        const SNMBVHNode& node = nodes[i];
+        if (node.IsLeaf())
+        {
+            if (node.offset > header->bvhIndexCount || node.count > header->bvhIndexCount - node.offset)
+            {
+                fail("bvh leaf is out of bounds");
+            }
+            continue;
+        }
+
+        if (node.offset <= i + 1 || node.offset >= header->bvhNodeCount || depth[i] + 1u >= BVH_MAX_DEPTH)
+        {
+            fail("bvh node " + std::to_string(i) + " is invalid");
+        }
+
+        uint8_t childDepth = static_cast<uint8_t>(depth[i] + 1);
+        depth[i + 1] = std::max(depth[i + 1], childDepth);
+        depth[node.offset] = std::max(depth[node.offset], childDepth);
+    }
+}
+
+void NMSceneCache::Write(const SNMScene& scene, const std::string& path)
+{
+    NMWorld world = scene.world;
+    if (!world.HasBVH())
+    {
+        world.BuildBVH();
+    }
+
+    // Shared patterns and equal materials are stored once, looked up by pattern and by record bytes
+    std::vector<SNMCachedPattern> patterns;
+    std::unordered_map<const NMPatternBase*, int32_t> patternIndices;
+    std::vector<SNMCachedMaterial> materials;
+    std::unordered_map<std::string, uint32_t> materialIndices;
+    std::vector<SNMCachedPrimitive> primitives(world.GetObjectCount());
+    std::vector<SNMCachedLight> lights(world.GetPointLightCount());
+
+    for (std::size_t i = 0; i < world.GetObjectCount(); ++i)
+    {
+        std::shared_ptr<NMPrimitiveBase> object = world.GetObject(i);
+        SNMCachedPrimitive& primitive = primitives[i];
+        std::memset(&primitive, 0, sizeof(primitive));
+
+        if (const NMSphere* sphere = dynamic_cast<const NMSphere*>(object.get()))
+        {
+            primitive.type = ENMCachedPrimitiveType::Sphere;
+            primitive.radius = sphere->GetRadius();
+        }
+        else if (dynamic_cast<const NMPlane*>(object.get()) != nullptr)
+        {
+            primitive.type = ENMCachedPrimitiveType::Plane;
+        }
+        else
+        {
+            throw std::runtime_error("Scene cache does not support object " + std::to_string(i));
+        }
+
+        primitive.origin[0] = object->GetOrigin().GetX();
+        primitive.origin[1] = object->GetOrigin().GetY();
+        primitive.origin[2] = object->GetOrigin().GetZ();
+        StoreMatrix(object->GetTransform(), primitive.transform);
+        StoreMatrix(object->GetInverseTransform(), primitive.inverseTransform);
+
+        const NMMaterial& source = object->GetMaterial();
+        SNMCachedMaterial material;
+        std::memset(&material, 0, sizeof(material));
+        StoreColor(source.GetColor(), material.color);
+        material.ambient = source.GetAmbient();
+        material.diffuse = source.GetDiffuse();
+        material.specular = source.GetSpecular();
+        material.shininess = source.GetShininess();
+        material.reflective = source.GetReflective();
+        material.transparency = source.GetTransparency();
+        material.refractiveIndex = source.GetRefractiveIndex();
+        material.pattern = -1;
+
+        if (const NMPatternBase* pattern = source.GetPattern().get())
+        {
+            auto found = patternIndices.find(pattern);
+            if (found == patternIndices.end())
+            {
+                SNMCachedPattern cached;
+                std::memset(&cached, 0, sizeof(cached));
+                if (!StorePattern<NMStripePattern>(*pattern, ENMCachedPatternType::Stripe, cached)
+                    && !StorePattern<NMGradientPattern>(*pattern, ENMCachedPatternType::Gradient, cached)
+                    && !StorePattern<NMRingPattern>(*pattern, ENMCachedPatternType::Ring, cached)
+                    && !StorePattern<NMCheckerPattern>(*pattern, ENMCachedPatternType::Checker, cached))
+                {
+                    throw std::runtime_error("Scene cache does not support the pattern of object "
+                                             + std::to_string(i));
+                }
+
+                StoreMatrix(pattern->GetTransform(), cached.transform);
+                StoreMatrix(pattern->GetInverseTransform(), cached.inverseTransform);
+                found = patternIndices.emplace(pattern, static_cast<int32_t>(patterns.size())).first;
+                patterns.push_back(cached);
+            }
+            material.pattern = found->second;
+        }
+
+        auto sameMaterial =
+            materialIndices.emplace(MaterialKey(material), static_cast<uint32_t>(materials.size())).first;
+        primitive.material = sameMaterial->second;
+        if (primitive.material == materials.size())
+        {
+            materials.push_back(material);
+        }
+    }
+
+    for (std::size_t i = 0; i < world.GetPointLightCount(); ++i)
+    {
+        NMPointLight light = world.GetPointLight(i);
+        lights[i].position[0] = light.GetPosition().GetX();
+        lights[i].position[1] = light.GetPosition().GetY();
+        lights[i].position[2] = light.GetPosition().GetZ();
+        StoreColor(light.GetColor(), lights[i].color);
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        throw std::runtime_error("Failed to open scene cache " + path + " for writing");
+    }
+
+    SNMSceneCacheHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, SCENE_CACHE_MAGIC, sizeof(header.magic));
+    header.version = SCENE_CACHE_VERSION;
+    header.cameraWidth = static_cast<uint32_t>(scene.camera.GetHSize());
+    header.cameraHeight = static_cast<uint32_t>(scene.camera.GetVSize());
+    header.cameraFov = scene.camera.GetFOV();
+    header.reflectionTraceDepth = world.GetSettings().ReflectionTraceDepth;
+    StoreMatrix(scene.camera.GetTransform(), header.cameraTransform);
+
+    // Reserve room for the header, it is rewritten once the section offsets are known
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    NMSectionWriter writer(file);
+    writer.Skip(sizeof(header));
+    writer.Write(patterns, header.patternOffset, header.patternCount);
+    writer.Write(materials, header.materialOffset, header.materialCount);
+    writer.Write(primitives, header.primitiveOffset, header.primitiveCount);
+    writer.Write(lights, header.lightOffset, header.lightCount);
+    writer.Write(world.GetBVH().GetNodes(), header.bvhNodeOffset, header.bvhNodeCount);
+    writer.Write(world.GetBVH().GetIndices(), header.bvhIndexOffset, header.bvhIndexCount);
+    writer.Write(world.GetUnboundedObjects(), header.unboundedOffset, header.unboundedCount);
+
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    if (!file)
+    {
+        throw std::runtime_error("Failed to write scene cache " + path);
+    }
+}
+
+SNMScene NMSceneCache::Instantiate() const
+{
+    SNMScene scene;
+
+    SNMWorldSettings settings;
+    settings.ReflectionTraceDepth = static_cast<uint8_t>(header->reflectionTraceDepth);
+    scene.world.SetSettings(settings);
+
+    scene.camera = NMCamera(header->cameraWidth, header->cameraHeight, header->cameraFov);
+    scene.camera.SetTransform(LoadMatrix(header->cameraTransform));
+
+    const SNMCachedLight* lights = GetLights();
+    for (uint64_t i = 0; i < header->lightCount; ++i)
+    {
+        scene.world.AddLight(NMPointLight(NMPoint(lights[i].position[0], lights[i].position[1], lights[i].position[2]),
+                                          LoadColor(lights[i].color)));
+    }
+
+    std::vector<std::shared_ptr<NMPatternBase>> patterns(static_cast<std::size_t>(header->patternCount));
+    const SNMCachedPattern* cachedPatterns = GetPatterns();
+    for (std::size_t i = 0; i < patterns.size(); ++i)
+    {
+        const SNMCachedPattern& cached = cachedPatterns[i];
+        NMColor colorA = LoadColor(cached.colorA);
+        NMColor colorB = LoadColor(cached.colorB);
+        switch (cached.type)
+        {
+            case ENMCachedPatternType::Stripe:
+                patterns[i] = std::make_shared<NMStripePattern>(colorA, colorB);
+                break;
+            case ENMCachedPatternType::Gradient:
+                patterns[i] = std::make_shared<NMGradientPattern>(colorA, colorB);
+                break;
+            case ENMCachedPatternType::Ring:
+                patterns[i] = std::make_shared<NMRingPattern>(colorA, colorB);
+                break;
+            case ENMCachedPatternType::Checker:
+                patterns[i] = std::make_shared<NMCheckerPattern>(colorA, colorB);
+                break;
+        }
+        patterns[i]->SetTransform(LoadMatrix(cached.transform), LoadMatrix(cached.inverseTransform));
+    }
+
+    std::vector<NMMaterial> materials(static_cast<std::size_t>(header->materialCount));
+    const SNMCachedMaterial* cachedMaterials = GetMaterials();
+    for (std::size_t i = 0; i < materials.size(); ++i)
+    {
+        const SNMCachedMaterial& cached = cachedMaterials[i];
+        materials[i] = NMMaterial(LoadColor(cached.color), cached.ambient, cached.diffuse, cached.specular,
+                                  cached.shininess, cached.reflective, cached.transparency, cached.refractiveIndex);
+        if (cached.pattern >= 0)
+        {
+            materials[i].SetPattern(patterns[static_cast<std::size_t>(cached.pattern)]);
+        }
+    }
+
+    // Primitives live in one contiguous array per type; the world holds aliasing pointers into those arrays so
+    // no allocation happens per object.
+    const SNMCachedPrimitive* primitives = GetPrimitives();
+    std::size_t primitiveCount = static_cast<std::size_t>(header->primitiveCount);
+    std::size_t sphereCount = static_cast<std::size_t>(
+        std::count_if(primitives, primitives + primitiveCount,
+                      [](const SNMCachedPrimitive& primitive)
+                      { return primitive.type == ENMCachedPrimitiveType::Sphere; }));
+
+    std::shared_ptr<std::vector<NMSphere>> spheres = std::make_shared<std::vector<NMSphere>>(sphereCount);
+    std::shared_ptr<std::vector<NMPlane>> planes =
+        std::make_shared<std::vector<NMPlane>>(primitiveCount - sphereCount);
+
+    scene.world.ReserveObjects(primitiveCount);
+    std::size_t sphereIndex = 0;
+    std::size_t planeIndex = 0;
+    for (std::size_t i = 0; i < primitiveCount; ++i)
+    {
+        const SNMCachedPrimitive& cached = primitives[i];
+
+        NMPrimitiveBase* object = nullptr;
+        if (cached.type == ENMCachedPrimitiveType::Sphere)
+        {
+            NMSphere& sphere = (*spheres)[sphereIndex++];
+            sphere.SetRadius(cached.radius);
+            object = &sphere;
+            scene.world.AddObject(std::shared_ptr<NMPrimitiveBase>(spheres, object));
+        }
+        else
+        {
+            object = &(*planes)[planeIndex++];
+            scene.world.AddObject(std::shared_ptr<NMPrimitiveBase>(planes, object));
+        }
+
+        object->SetOrigin(NMPoint(cached.origin[0], cached.origin[1], cached.origin[2]));
+        object->SetTransform(LoadMatrix(cached.transform), LoadMatrix(cached.inverseTransform));
+        object->SetMaterial(materials[cached.material]);
+    }
+
+    NMBVH bvh;
+    bvh.Assign(GetBVHNodes(), static_cast<std::size_t>(header->bvhNodeCount), GetBVHIndices(),
+               static_cast<std::size_t>(header->bvhIndexCount));
+    const uint32_t* unbounded = GetUnbounded();
+    scene.world.SetBVH(std::move(bvh), std::vector<uint32_t>(unbounded, unbounded + header->unboundedCount));
+
+    return scene;
+}
@@ -0,0 +1,215 @@
+#include "NMCore/Scene/SceneLibrary.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "NMCore/Pattern/Gradient.hpp"
+#include "NMCore/Pattern/Stripe.hpp"
+#include "NMCore/Primitive/Plane.hpp"
+#include "NMCore/Primitive/Sphere.hpp"
+#include "NMCore/Scene/SceneCache.hpp"
+#include "NMCore/Scene/SceneParser.hpp"
+
+namespace
+{
+enum class ENMWallType
+{
+    FlatSphere,
+    Plane,
+};
+
+// SNMScene has a default member initializer, so it cannot be brace-initialized in C++11
+SNMScene MakeScene(const NMWorld& world, const NMCamera& camera)
+{
+    SNMScene scene;
+    scene.world = world;
+    scene.camera = camera;
+    return scene;
+}
+
+NMCamera RoomCamera(std::size_t width, std::size_t height)
+{
+    NMCamera camera(width, height, nmmath::thirdPi);
+    camera.SetTransform(
+        NMMatrix::ViewTransform(NMPoint(0.0f, 1.5f, -5.0f), NMPoint(0.0f, 1.0f, 0.0f), NMVector(0.0f, 1.0f, 0.0f)));
+    return camera;
+}
+
+std::shared_ptr<NMPrimitiveBase> Wall(ENMWallType type, float angle)
+{
+    NMMatrix transform = NMMatrix::Translation(0.0f, 0.0f, 5.0f) * NMMatrix::RotationY(angle)
+                         * NMMatrix::RotationX(nmmath::halfPi);
+
+    std::shared_ptr<NMPrimitiveBase> wall;
+    if (type == ENMWallType::Plane)
+    {
+        wall = std::make_shared<NMPlane>();
+    }
+    else
+    {
+        wall = std::make_shared<NMSphere>();
+        transform = transform * NMMatrix::Scaling(10.0f, 0.01f, 10.0f);
+    }
+
+    wall->SetTransform(transform);
+    return wall;
+}
+
+// The room from Examples/4_FirstScene and Examples/5_PlaneScene: a floor, two walls and three spheres. The middle and
+// right sphere materials differ between the scenes and are passed in.
+NMWorld Room(ENMWallType wallType, const NMMaterial& middleMat, const NMMaterial& rightMat)
+{
+    NMWorld world = NMWorld();
+
+    // Floor
+    std::shared_ptr<NMSphere> floor = std::make_shared<NMSphere>();
+    floor->SetTransform(NMMatrix::Scaling(10.0f, 0.01f, 10.0f));
+    NMMaterial floorMat = NMMaterial();
+    floorMat.SetColor(NMColor(1.0f, 0.9f, 0.9f));
+    floorMat.SetSpecular(0.0f);
+    floor->SetMaterial(floorMat);
+    world.AddObject(floor);
+
+    // Left wall
+    std::shared_ptr<NMPrimitiveBase> leftWall = Wall(wallType, -nmmath::quarterPi);
+    leftWall->SetMaterial(floorMat);
+    world.AddObject(leftWall);
+
+    // Right wall
+    std::shared_ptr<NMPrimitiveBase> rightWall = Wall(wallType, nmmath::quarterPi);
+    rightWall->SetMaterial(floorMat);
+    world.AddObject(rightWall);
+
+    // Middle Sphere
+    std::shared_ptr<NMSphere> middle = std::make_shared<NMSphere>();
+    middle->SetTransform(NMMatrix::Translation(-0.5f, 1.0f, 0.5f));
+    middle->SetMaterial(middleMat);
+    world.AddObject(middle);
+
+    // Right Sphere
+    std::shared_ptr<NMSphere> right = std::make_shared<NMSphere>();
+    right->SetTransform(NMMatrix::Translation(1.5f, 0.5f, -0.5f) * NMMatrix::Scaling(0.5f, 0.5f, 0.5f));
+    right->SetMaterial(rightMat);
+    world.AddObject(right);
+
+    // Left Sphere
+    std::shared_ptr<NMSphere> left = std::make_shared<NMSphere>();
+    left->SetTransform(NMMatrix::Translation(-1.5f, 0.33f, -0.75f) * NMMatrix::Scaling(0.33f, 0.33f, 0.33f));
+    NMMaterial leftMat = NMMaterial();
+    leftMat.SetColor(NMColor(1.0f, 0.8f, 0.1f));
+    leftMat.SetDiffuse(0.7f);
+    leftMat.SetSpecular(0.3f);
+    left->SetMaterial(leftMat);
+    world.AddObject(left);
+
+    // Light
+    world.AddLight(NMPointLight(NMPoint(-10.0f, 10.0f, -10.0f), NMColor(1.0f, 1.0f, 1.0f)));
+
+    return world;
+}
+
+// The scene from Examples/3_RenderSphere
+SNMScene SphereScene(std::size_t width, std::size_t height)
+{
+    SNMScene scene;
+
+    std::shared_ptr<NMSphere> sphere = std::make_shared<NMSphere>();
+    NMMaterial sphereMaterial = NMMaterial();
+    sphereMaterial.SetColor(NMColor(1.0f, 0.2f, 1.0f));
+    sphere->SetMaterial(sphereMaterial);
+    scene.world.AddObject(sphere);
+    scene.world.AddLight(NMPointLight(NMPoint(-10.0f, 10.0f, -10.0f), NMColor(1.0f, 1.0f, 1.0f)));
+
+    // The example casts rays from z = -5 onto a 7x7 wall at z = 10, which is a field of view of 2 * atan(3.5 / 15)
+    float fov = 2.0f * std::atan(3.5f / 15.0f);
+    scene.camera = NMCamera(width, height, fov);
+    scene.camera.SetTransform(NMMatrix::ViewTransform(NMPoint(0.0f, 0.0f, -5.0f), NMPoint(0.0f, 0.0f, 0.0f),
+                                                      NMVector(0.0f, 1.0f, 0.0f)));
+
+    return scene;
+}
+
+NMMaterial SolidMaterial(const NMColor& color)
+{
+    NMMaterial material = NMMaterial();
+    material.SetColor(color);
+    material.SetDiffuse(0.7f);
+    material.SetSpecular(0.3f);
+    return material;
+}
+}  // namespace
+
+const std::vector<std::string>& NMSceneLibrary::GetNames()
+{
+    static const std::vector<std::string> names = {"default", "sphere", "first", "plane", "application"};
+    return names;
+}
+
+SNMScene NMSceneLibrary::Create(const std::string& name, std::size_t width, std::size_t height)
+{
+    if (name == "default")
+    {
+        SNMScene scene = MakeScene(NMWorld::Default(), NMCamera(width, height, nmmath::halfPi));
+        scene.camera.SetTransform(NMMatrix::ViewTransform(NMPoint(0.0f, 0.0f, -5.0f), NMPoint(0.0f, 0.0f, 0.0f),
+                                                          NMVector(0.0f, 1.0f, 0.0f)));
+        return scene;
+    }
+
+    if (name == "sphere")
+    {
+        return SphereScene(width, height);
+    }
+
+    if (name == "first")
+    {
+        return MakeScene(Room(ENMWallType::FlatSphere, SolidMaterial(NMColor(0.1f, 1.0f, 0.5f)),
+                              SolidMaterial(NMColor(0.5f, 1.0f, 0.1f))),
+                         RoomCamera(width, height));
+    }
+
+    if (name == "plane")
+    {
+        return MakeScene(Room(ENMWallType::Plane, SolidMaterial(NMColor(0.1f, 1.0f, 0.5f)),
+                              SolidMaterial(NMColor(0.5f, 1.0f, 0.1f))),
+                         RoomCamera(width, height));
+    }
+
+    if (name == "application")
+    {
+        NMMaterial middleMat = SolidMaterial(NMColor(1.0f, 1.0f, 1.0f));
+        middleMat.SetPattern<NMGradientPattern>(
+            NMColor(0.1f, 1.0f, 0.5f), NMColor(1.0f, 0.5f, 0.1f),
+            NMMatrix::Translation(1.0f, 1.0f, 1.0f) * NMMatrix::Scaling(2.0f, 2.0f, 2.0f));
+        middleMat.SetReflective(1.0f);
+
+        NMMaterial rightMat = SolidMaterial(NMColor(1.0f, 1.0f, 1.0f));
+        rightMat.SetPattern<NMStripePattern>(NMColor(0.5f, 1.0f, 0.1f), NMColor(0.1f, 1.0f, 0.5f),
+                                             NMMatrix::Scaling(0.1f, 0.1f, 0.1f));
+
+        return MakeScene(Room(ENMWallType::Plane, middleMat, rightMat), RoomCamera(width, height));
+    }
+
+    throw std::runtime_error("Unknown built-in scene '" + name + "'");
+}
+
+NMWorld NMSceneLibrary::Load(const std::string& scene)
+{
+    NMWorld world;
+    if (std::find(GetNames().begin(), GetNames().end(), scene) != GetNames().end())
+    {
+        world = Create(scene, DEFAULT_SCENE_WIDTH, DEFAULT_SCENE_HEIGHT).world;
+    }
+    else if (NMSceneCache::IsCacheFile(scene))
+    {
+        // Baked scenes come with their hierarchy already built
+        return NMSceneCache(scene).Instantiate().world;
+    }
+    else
+    {
+        world = NMSceneParser::ParseFile(scene).world;
+    }
+
+    world.BuildBVH();
+    return world;
+}
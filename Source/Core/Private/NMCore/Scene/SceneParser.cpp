@@ -0,0 +1,1019 @@
+#include "NMCore/Scene/SceneParser.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "NMCore/Pattern/Checker.hpp"
+#include "NMCore/Pattern/Gradient.hpp"
+#include "NMCore/Pattern/Ring.hpp"
+#include "NMCore/Pattern/Stripe.hpp"
+#include "NMCore/Pattern/Texture.hpp"
+#include "NMCore/Primitive/CSG.hpp"
+#include "NMCore/Primitive/Cone.hpp"
+#include "NMCore/Primitive/Cube.hpp"
+#include "NMCore/Primitive/Cylinder.hpp"
+#include "NMCore/Primitive/Disk.hpp"
+#include "NMCore/Primitive/Group.hpp"
+#include "NMCore/Primitive/Instance.hpp"
+#include "NMCore/Primitive/Plane.hpp"
+#include "NMCore/Primitive/Sphere.hpp"
+#include "NMCore/Primitive/TriangleMesh.hpp"
+#include "NMCore/Scene/ImageLoader.hpp"
+#include "NMCore/Scene/ObjLoader.hpp"
+#include "NMCore/TextureCache.hpp"
+
+namespace
+{
+// Larger decimal exponents leave the float range whatever the digits before them
+constexpr int MAX_EXPONENT = 1000;
+
+struct SNMToken
+{
+    const char* begin = nullptr;
+    std::size_t length = 0;
+    std::size_t line = 0;
+    std::size_t column = 0;
+
+    inline bool Is(const char* text) const
+    {
+        return std::strlen(text) == length && std::memcmp(begin, text, length) == 0;
+    }
+
+    inline std::string ToString() const { return std::string(begin, length); }
+};
+
+/**
+ * @brief Walks the scene text once, handing out tokens as pointers into the source buffer.
+ */
+class NMSceneReader
+{
+public:
+
+    NMSceneReader(const char* data, std::size_t size, const std::string& sourceName)
+        : cursor(data), end(data + size), lineStart(data), sourceName(sourceName)
+    {
+    }
+
+    SNMScene Read()
+    {
+        SNMScene scene;
+
+        while (true)
+        {
+            SkipSpace();
+            if (cursor == end)
+            {
+                break;
+            }
+
+            if (*cursor == '\n')
+            {
+                NextLine();
+                continue;
+            }
+
+            SNMToken keyword = NextToken();
+            if (keyword.Is("sphere"))
+            {
+                ReadObject(scene, std::make_shared<NMSphere>());
+            }
+            else if (keyword.Is("plane"))
+            {
+                ReadObject(scene, std::make_shared<NMPlane>());
+            }
+            else if (keyword.Is("cube"))
+            {
+                ReadObject(scene, std::make_shared<NMCube>());
+            }
+            else if (keyword.Is("cylinder"))
+            {
+                ReadObject(scene, std::make_shared<NMCylinder>());
+            }
+            else if (keyword.Is("cone"))
+            {
+                ReadObject(scene, std::make_shared<NMCone>());
+            }
+            else if (keyword.Is("disk"))
+            {
+                ReadObject(scene, std::make_shared<NMDisk>());
+            }
+            else if (keyword.Is("mesh"))
+            {
+                ReadObject(scene, std::make_shared<NMInstance>(LoadMesh(NextToken())));
+            }
+            else if (keyword.Is("group"))
+            {
+                ReadGroup(keyword);
+            }
+            else if (keyword.Is("csg"))
+            {
+                ReadCSG(keyword);
+            }
+            else if (keyword.Is("end"))
+            {
+                EndGroup(scene, keyword);
+            }
+            else if (keyword.Is("material"))
+            {
+                ReadMaterial();
+            }
+            else if (keyword.Is("pattern"))
+            {
+                ReadPattern();
+            }
+            else if (keyword.Is("light"))
+            {
+                ReadLight(scene);
+            }
+            else if (keyword.Is("camera"))
+            {
+                ReadCamera(scene);
+            }
+            else if (keyword.Is("settings"))
+            {
+                ReadSettings(scene);
+            }
+            else
+            {
+                Error(keyword, "unknown statement '" + keyword.ToString() + "'");
+            }
+        }
+
+        if (!groups.empty())
+        {
+            Error(groups.back().keyword, groups.back().keyword.ToString() + " is missing its 'end'");
+        }
+
+        return scene;
+    }
+
+protected:
+
+    const char* cursor;
+    const char* end;
+    const char* lineStart;
+    std::size_t line = 1;
+
+    const std::string& sourceName;
+
+    std::vector<std::pair<std::string, NMMaterial>> materials;
+    std::vector<std::pair<std::string, std::shared_ptr<NMPatternBase>>> patterns;
+    std::vector<std::pair<std::string, std::shared_ptr<NMTriangleMesh>>> meshes;
+    std::vector<std::pair<std::string, std::shared_ptr<const NMTextureBase>>> textures;
+
+    // Created for the first tiled texture file, shared by all of them
+    std::shared_ptr<NMTextureCache> textureCache;
+    std::size_t textureCacheBytes = DEFAULT_TEXTURE_CACHE_BYTES;
+
+    // A group or CSG being read, its objects are collected in an NMGroup until its 'end'
+    struct SNMOpenGroup
+    {
+        std::shared_ptr<NMGroup> group;
+        SNMToken keyword;
+        ENMCSGOperation operation = ENMCSGOperation::Union;
+    };
+
+    // The groups being read, innermost last
+    std::vector<SNMOpenGroup> groups;
+
+    [[noreturn]] void Error(const SNMToken& token, const std::string& message) const
+    {
+        throw NMSceneParseError(sourceName, token.line, token.column, message);
+    }
+
+    inline void NextLine()
+    {
+        ++cursor;
+        ++line;
+        lineStart = cursor;
+    }
+
+    inline void SkipSpace()
+    {
+        while (cursor != end)
+        {
+            char c = *cursor;
+            if (c == ' ' || c == '\t' || c == '\r')
+            {
+                ++cursor;
+            }
+            else if (c == '#')
+            {
+                while (cursor != end && *cursor != '\n')
+                {
+                    ++cursor;
+                }
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
+
+    inline bool AtEndOfStatement()
+    {
+        SkipSpace();
+        return cursor == end || *cursor == '\n';
+    }
+
+    inline SNMToken Here() const
+    {
+        SNMToken token;
+        token.begin = cursor;
+        token.line = line;
+        token.column = static_cast<std::size_t>(cursor - lineStart) + 1;
+        return token;
+    }
+
+    SNMToken NextToken()
+    {
+        if (AtEndOfStatement())
+        {
+            Error(Here(), "unexpected end of line");
+        }
+
+        SNMToken token = Here();
+        while (cursor != end)
+        {
+            char c = *cursor;
+            if (c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '#')
+            {
+                break;
+            }
+            ++cursor;
+        }
+        token.length = static_cast<std::size_t>(cursor - token.begin);
+
+        return token;
+    }
+
+    float ReadFloat()
+    {
+        SNMToken token = NextToken();
+        const char* c = token.begin;
+        const char* tokenEnd = token.begin + token.length;
+
+        bool negative = false;
+        if (*c == '-' || *c == '+')
+        {
+            negative = *c == '-';
+            ++c;
+        }
+
+        double value = 0.0;
+        bool hasDigits = false;
+        while (c != tokenEnd && *c >= '0' && *c <= '9')
+        {
+            value = value * 10.0 + (*c - '0');
+            hasDigits = true;
+            ++c;
+        }
+
+        if (c != tokenEnd && *c == '.')
+        {
+            ++c;
+            double scale = 0.1;
+            while (c != tokenEnd && *c >= '0' && *c <= '9')
+            {
+                value += (*c - '0') * scale;
+                scale *= 0.1;
+                hasDigits = true;
+                ++c;
+            }
+        }
+
+        if (hasDigits && c != tokenEnd && (*c == 'e' || *c == 'E'))
+        {
+            ++c;
+            bool negativeExponent = false;
+            if (c != tokenEnd && (*c == '-' || *c == '+'))
+            {
+                negativeExponent = *c == '-';
+                ++c;
+            }
+
+            // Stop growing the exponent past MAX_EXPONENT, so a long exponent can not overflow the int
+            int exponent = 0;
+            bool hasExponent = false;
+            while (c != tokenEnd && *c >= '0' && *c <= '9')
+            {
+                if (exponent < MAX_EXPONENT)
+                {
+                    exponent = exponent * 10 + (*c - '0');
+                }
+                hasExponent = true;
+                ++c;
+            }
+
+            if (!hasExponent)
+            {
+                hasDigits = false;
+            }
+            if (value != 0.0)
+            {
+                value *= std::pow(10.0, negativeExponent ? -exponent : exponent);
+            }
+        }
+
+        if (!hasDigits || c != tokenEnd)
+        {
+            Error(token, "expected a number but got '" + token.ToString() + "'");
+        }
+
+        // Also rejects the NaN of a mantissa too long for a double times a tiny power of ten
+        if (!(value <= std::numeric_limits<float>::max()))
+        {
+            Error(token, "'" + token.ToString() + "' is out of range");
+        }
+
+        return static_cast<float>(negative ? -value : value);
+    }
+
+    std::size_t ReadSize()
+    {
+        SNMToken token = NextToken();
+
+        std::size_t value = 0;
+        for (std::size_t i = 0; i < token.length; ++i)
+        {
+            char c = token.begin[i];
+            if (c < '0' || c > '9')
+            {
+                Error(token, "expected a positive integer but got '" + token.ToString() + "'");
+            }
+            std::size_t digit = static_cast<std::size_t>(c - '0');
+            if (value > (std::numeric_limits<std::size_t>::max() - digit) / 10)
+            {
+                Error(token, "'" + token.ToString() + "' is too large");
+            }
+            value = value * 10 + digit;
+        }
+
+        return value;
+    }
+
+    inline float ReadAngle() { return ReadFloat() * nmmath::pi / 180.0f; }
+
+    inline NMColor ReadColor()
+    {
+        float r = ReadFloat();
+        float g = ReadFloat();
+        float b = ReadFloat();
+        return NMColor(r, g, b);
+    }
+
+    inline NMPoint ReadPoint()
+    {
+        float x = ReadFloat();
+        float y = ReadFloat();
+        float z = ReadFloat();
+        return NMPoint(x, y, z);
+    }
+
+    inline NMVector ReadVector()
+    {
+        float x = ReadFloat();
+        float y = ReadFloat();
+        float z = ReadFloat();
+        return NMVector(x, y, z);
+    }
+
+    inline void Compose(NMMatrix& transform, bool& isIdentity, const NMMatrix& operation)
+    {
+        // Most objects have one or two transform keys, skip the multiply by the identity for the first one
+        transform = isIdentity ? operation : transform * operation;
+        isIdentity = false;
+    }
+
+    /**
+     * @brief Apply a transform key to transform.
+     * @return false if the key is not a transform key.
+     */
+    bool ReadTransformKey(const SNMToken& key, NMMatrix& transform, bool& isIdentity)
+    {
+        if (key.Is("translate"))
+        {
+            float x = ReadFloat();
+            float y = ReadFloat();
+            float z = ReadFloat();
+            Compose(transform, isIdentity, NMMatrix::Translation(x, y, z));
+        }
+        else if (key.Is("scale"))
+        {
+            float x = ReadFloat();
+            float y = ReadFloat();
+            float z = ReadFloat();
+            Compose(transform, isIdentity, NMMatrix::Scaling(x, y, z));
+        }
+        else if (key.Is("rotate_x"))
+        {
+            Compose(transform, isIdentity, NMMatrix::RotationX(ReadAngle()));
+        }
+        else if (key.Is("rotate_y"))
+        {
+            Compose(transform, isIdentity, NMMatrix::RotationY(ReadAngle()));
+        }
+        else if (key.Is("rotate_z"))
+        {
+            Compose(transform, isIdentity, NMMatrix::RotationZ(ReadAngle()));
+        }
+        else if (key.Is("shear"))
+        {
+            float xy = ReadFloat();
+            float xz = ReadFloat();
+            float yx = ReadFloat();
+            float yz = ReadFloat();
+            float zx = ReadFloat();
+            float zy = ReadFloat();
+            Compose(transform, isIdentity, NMMatrix::Shearing(xy, xz, yx, yz, zx, zy));
+        }
+        else
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Apply a material key to material.
+     * @return false if the key is not a material key.
+     */
+    bool ReadMaterialKey(const SNMToken& key, NMMaterial& material)
+    {
+        if (key.Is("color"))
+        {
+            material.SetColor(ReadColor());
+        }
+        else if (key.Is("ambient"))
+        {
+            material.SetAmbient(ReadFloat());
+        }
+        else if (key.Is("diffuse"))
+        {
+            material.SetDiffuse(ReadFloat());
+        }
+        else if (key.Is("specular"))
+        {
+            material.SetSpecular(ReadFloat());
+        }
+        else if (key.Is("shininess"))
+        {
+            material.SetShininess(ReadFloat());
+        }
+        else if (key.Is("reflective"))
+        {
+            material.SetReflective(ReadFloat());
+        }
+        else if (key.Is("transparency"))
+        {
+            material.SetTransparency(ReadFloat());
+        }
+        else if (key.Is("refractive_index"))
+        {
+            material.SetRefractiveIndex(ReadFloat());
+        }
+        else if (key.Is("pattern"))
+        {
+            material.SetPattern(FindPattern(NextToken()));
+        }
+        else
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    const NMMaterial& FindMaterial(const SNMToken& name) const
+    {
+        for (const std::pair<std::string, NMMaterial>& material : materials)
+        {
+            if (name.Is(material.first.c_str()))
+            {
+                return material.second;
+            }
+        }
+
+        Error(name, "unknown material '" + name.ToString() + "'");
+    }
+
+    std::shared_ptr<NMPatternBase> FindPattern(const SNMToken& name) const
+    {
+        for (const std::pair<std::string, std::shared_ptr<NMPatternBase>>& pattern : patterns)
+        {
+            if (name.Is(pattern.first.c_str()))
+            {
+                return pattern.second;
+            }
+        }
+
+        Error(name, "unknown pattern '" + name.ToString() + "'");
+    }
+
+    std::string ResolvePath(const SNMToken& pathToken) const
+    {
+        std::string path = pathToken.ToString();
+        std::size_t directoryEnd = sourceName.find_last_of('/');
+        if (path[0] != '/' && directoryEnd != std::string::npos)
+        {
+            path = sourceName.substr(0, directoryEnd + 1) + path;
+        }
+
+        return path;
+    }
+
+    /**
+     * @brief Load the OBJ file a mesh statement names, relative paths are relative to the scene file.
+     * Every file is loaded once, later statements naming it share the mesh.
+     */
+    std::shared_ptr<NMTriangleMesh> LoadMesh(const SNMToken& pathToken)
+    {
+        std::string path = ResolvePath(pathToken);
+        for (const std::pair<std::string, std::shared_ptr<NMTriangleMesh>>& mesh : meshes)
+        {
+            if (mesh.first == path)
+            {
+                return mesh.second;
+            }
+        }
+
+        try
+        {
+            meshes.emplace_back(path, NMObjLoader::LoadFile(path));
+            return meshes.back().second;
+        }
+        catch (const NMSceneParseError&)
+        {
+            throw;
+        }
+        catch (const std::runtime_error& error)
+        {
+            Error(pathToken, error.what());
+        }
+    }
+
+    /**
+     * @brief Load the image an image pattern names and build its mip pyramid, or open it through the texture cache if
+     * it is a tiled texture file. Relative paths are relative to the scene file. Every file is loaded once, later
+     * patterns naming it share the texture.
+     */
+    std::shared_ptr<const NMTextureBase> LoadTexture(const SNMToken& pathToken)
+    {
+        std::string path = ResolvePath(pathToken);
+        for (const std::pair<std::string, std::shared_ptr<const NMTextureBase>>& texture : textures)
+        {
+            if (texture.first == path)
+            {
+                return texture.second;
+            }
+        }
+
+        try
+        {
+            if (NMTextureCache::IsTextureFile(path))
+            {
+                if (!textureCache)
+                {
+                    textureCache = std::make_shared<NMTextureCache>(textureCacheBytes);
+                }
+
+                textures.emplace_back(path, std::make_shared<const NMCachedTexture>(textureCache, path));
+            }
+            else
+            {
+                textures.emplace_back(path, std::make_shared<const NMTexture>(NMImageLoader::LoadFile(path)));
+            }
+
+            return textures.back().second;
+        }
+        catch (const std::runtime_error& error)
+        {
+            Error(pathToken, error.what());
+        }
+    }
+
+    /**
+     * @brief Read a key that only some primitives have, e.g. the extent of a cylinder.
+     * @return False if the key is not one of the object's.
+     */
+    bool ReadShapeKey(const SNMToken& key, NMPrimitiveBase& object)
+    {
+        if (NMCylinder* cylinder = dynamic_cast<NMCylinder*>(&object))
+        {
+            return ReadExtentKey(key, *cylinder);
+        }
+
+        if (NMCone* cone = dynamic_cast<NMCone*>(&object))
+        {
+            return ReadExtentKey(key, *cone);
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief `minimum`, `maximum` and the flag `closed` of a truncated quadric.
+     */
+    template <typename T> bool ReadExtentKey(const SNMToken& key, T& shape)
+    {
+        if (key.Is("minimum"))
+        {
+            shape.SetMinimum(ReadFloat());
+        }
+        else if (key.Is("maximum"))
+        {
+            shape.SetMaximum(ReadFloat());
+        }
+        else if (key.Is("closed"))
+        {
+            shape.SetClosed(true);
+        }
+        else
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    void ReadObject(SNMScene& scene, std::shared_ptr<NMPrimitiveBase> object)
+    {
+        NMMatrix transform = NMMatrix::Identity4x4();
+        bool isIdentity = true;
+        NMMaterial material;
+
+        while (!AtEndOfStatement())
+        {
+            SNMToken key = NextToken();
+            if (key.Is("material"))
+            {
+                material = FindMaterial(NextToken());
+            }
+            else if (!ReadTransformKey(key, transform, isIdentity) && !ReadMaterialKey(key, material)
+                     && !ReadShapeKey(key, *object))
+            {
+                Error(key, "unknown object key '" + key.ToString() + "'");
+            }
+        }
+
+        object->SetTransform(transform);
+        object->SetMaterial(material);
+        AddObject(scene, std::move(object));
+    }
+
+    void AddObject(SNMScene& scene, std::shared_ptr<NMPrimitiveBase> object)
+    {
+        if (groups.empty())
+        {
+            scene.world.AddObject(std::move(object));
+        }
+        else
+        {
+            groups.back().group->AddChild(std::move(object));
+        }
+    }
+
+    void ReadGroup(const SNMToken& keyword)
+    {
+        NMMatrix transform = NMMatrix::Identity4x4();
+        bool isIdentity = true;
+        while (!AtEndOfStatement())
+        {
+            SNMToken key = NextToken();
+            if (!ReadTransformKey(key, transform, isIdentity))
+            {
+                Error(key, "unknown " + keyword.ToString() + " key '" + key.ToString() + "'");
+            }
+        }
+
+        SNMOpenGroup open;
+        open.group = std::make_shared<NMGroup>();
+        open.group->SetTransform(transform);
+        open.keyword = keyword;
+        groups.push_back(std::move(open));
+    }
+
+    void ReadCSG(const SNMToken& keyword)
+    {
+        SNMToken name = NextToken();
+        ENMCSGOperation operation;
+        if (name.Is("union"))
+        {
+            operation = ENMCSGOperation::Union;
+        }
+        else if (name.Is("intersection"))
+        {
+            operation = ENMCSGOperation::Intersection;
+        }
+        else if (name.Is("difference"))
+        {
+            operation = ENMCSGOperation::Difference;
+        }
+        else
+        {
+            Error(name, "unknown csg operation '" + name.ToString() + "'");
+        }
+
+        ReadGroup(keyword);
+        groups.back().operation = operation;
+    }
+
+    void EndGroup(SNMScene& scene, const SNMToken& keyword)
+    {
+        if (groups.empty())
+        {
+            Error(keyword, "'end' without a group");
+        }
+
+        SNMOpenGroup open = std::move(groups.back());
+        groups.pop_back();
+        if (!open.keyword.Is("csg"))
+        {
+            AddObject(scene, std::move(open.group));
+            return;
+        }
+
+        if (open.group->GetChildCount() != 2)
+        {
+            Error(open.keyword, "csg needs exactly two objects");
+        }
+
+        std::shared_ptr<NMCSG> csg =
+            std::make_shared<NMCSG>(open.operation, open.group->GetChild(0), open.group->GetChild(1));
+        csg->SetTransform(open.group->GetTransform(), open.group->GetInverseTransform());
+        AddObject(scene, std::move(csg));
+    }
+
+    void ReadMaterial()
+    {
+        SNMToken name = NextToken();
+
+        NMMaterial material;
+        while (!AtEndOfStatement())
+        {
+            SNMToken key = NextToken();
+            if (!ReadMaterialKey(key, material))
+            {
+                Error(key, "unknown material key '" + key.ToString() + "'");
+            }
+        }
+
+        for (std::pair<std::string, NMMaterial>& existing : materials)
+        {
+            if (name.Is(existing.first.c_str()))
+            {
+                existing.second = material;
+                return;
+            }
+        }
+
+        materials.emplace_back(name.ToString(), material);
+    }
+
+    void ReadPattern()
+    {
+        SNMToken name = NextToken();
+        SNMToken type = NextToken();
+        if (type.Is("image"))
+        {
+            StorePattern(name, ReadImagePattern());
+            return;
+        }
+
+        NMColor colorA = ReadColor();
+        NMColor colorB = ReadColor();
+
+        NMMatrix transform = NMMatrix::Identity4x4();
+        bool isIdentity = true;
+        while (!AtEndOfStatement())
+        {
+            SNMToken key = NextToken();
+            if (!ReadTransformKey(key, transform, isIdentity))
+            {
+                Error(key, "unknown pattern key '" + key.ToString() + "'");
+            }
+        }
+
+        std::shared_ptr<NMPatternBase> pattern;
+        if (type.Is("stripe"))
+        {
+            pattern = std::make_shared<NMStripePattern>(colorA, colorB, transform);
+        }
+        else if (type.Is("gradient"))
+        {
+            pattern = std::make_shared<NMGradientPattern>(colorA, colorB, transform);
+        }
+        else if (type.Is("ring"))
+        {
+            pattern = std::make_shared<NMRingPattern>(colorA, colorB, transform);
+        }
+        else if (type.Is("checker"))
+        {
+            pattern = std::make_shared<NMCheckerPattern>(colorA, colorB, transform);
+        }
+        else
+        {
+            Error(type, "unknown pattern type '" + type.ToString() + "'");
+        }
+
+        StorePattern(name, pattern);
+    }
+
+    // image <file> [planar|spherical|cylindrical] [transform keys]
+    std::shared_ptr<NMPatternBase> ReadImagePattern()
+    {
+        std::shared_ptr<const NMTextureBase> texture = LoadTexture(NextToken());
+
+        ENMUVMapping mapping = ENMUVMapping::Planar;
+        NMMatrix transform = NMMatrix::Identity4x4();
+        bool isIdentity = true;
+        while (!AtEndOfStatement())
+        {
+            SNMToken key = NextToken();
+            if (key.Is("planar"))
+            {
+                mapping = ENMUVMapping::Planar;
+            }
+            else if (key.Is("spherical"))
+            {
+                mapping = ENMUVMapping::Spherical;
+            }
+            else if (key.Is("cylindrical"))
+            {
+                mapping = ENMUVMapping::Cylindrical;
+            }
+            else if (!ReadTransformKey(key, transform, isIdentity))
+            {
+                Error(key, "unknown pattern key '" + key.ToString() + "'");
+            }
+        }
+
+        return std::make_shared<NMTexturePattern>(texture, mapping, transform);
+    }
+
+    void StorePattern(const SNMToken& name, const std::shared_ptr<NMPatternBase>& pattern)
+    {
+        for (std::pair<std::string, std::shared_ptr<NMPatternBase>>& existing : patterns)
+        {
+            if (name.Is(existing.first.c_str()))
+            {
+                existing.second = pattern;
+                return;
+            }
+        }
+
+        patterns.emplace_back(name.ToString(), pattern);
+    }
+
+    void ReadLight(SNMScene& scene)
+    {
+        NMPoint position;
+        NMColor color(1.0f, 1.0f, 1.0f);
+
+        while (!AtEndOfStatement())
+        {
+            SNMToken key = NextToken();
+            if (key.Is("position"))
+            {
+                position = ReadPoint();
+            }
+            else if (key.Is("color"))
+            {
+                color = ReadColor();
+            }
+            else
+            {
+                Error(key, "unknown light key '" + key.ToString() + "'");
+            }
+        }
+
+        scene.world.AddLight(NMPointLight(position, color));
+    }
+
+    void ReadCamera(SNMScene& scene)
+    {
+        std::size_t width = scene.camera.GetHSize();
+        std::size_t height = scene.camera.GetVSize();
+        float fov = scene.camera.GetFOV();
+        NMPoint from(0.0f, 0.0f, 0.0f);
+        NMPoint to(0.0f, 0.0f, -1.0f);
+        NMVector up(0.0f, 1.0f, 0.0f);
+
+        while (!AtEndOfStatement())
+        {
+            SNMToken key = NextToken();
+            if (key.Is("width"))
+            {
+                width = ReadSize();
+            }
+            else if (key.Is("height"))
+            {
+                height = ReadSize();
+            }
+            else if (key.Is("fov"))
+            {
+                fov = ReadAngle();
+            }
+            else if (key.Is("from"))
+            {
+                from = ReadPoint();
+            }
+            else if (key.Is("to"))
+            {
+                to = ReadPoint();
+            }
+            else if (key.Is("up"))
+            {
+                up = ReadVector();
+            }
+            else
+            {
+                Error(key, "unknown camera key '" + key.ToString() + "'");
+            }
+        }
+
+        if (width == 0 || height == 0)
+        {
+            Error(Here(), "camera width and height must be greater than zero");
+        }
+
+        scene.camera = NMCamera(width, height, fov);
+        scene.camera.SetTransform(NMMatrix::ViewTransform(from, to, up));
+    }
+
+    void ReadSettings(SNMScene& scene)
+    {
+        SNMWorldSettings settings = scene.world.GetSettings();
+
+        while (!AtEndOfStatement())
+        {
+            SNMToken key = NextToken();
+            if (key.Is("reflection_depth"))
+            {
+                SkipSpace();
+                SNMToken value = Here();
+                std::size_t depth = ReadSize();
+                if (depth > 255)
+                {
+                    Error(value, "reflection_depth must be at most 255");
+                }
+                settings.ReflectionTraceDepth = static_cast<uint8_t>(depth);
+            }
+            else if (key.Is("texture_cache_mb"))
+            {
+                if (textureCache)
+                {
+                    Error(key, "texture_cache_mb must come before the first tiled texture");
+                }
+                SkipSpace();
+                SNMToken value = Here();
+                std::size_t megabytes = ReadSize();
+                if (megabytes > std::numeric_limits<std::size_t>::max() >> 20)
+                {
+                    Error(value, "texture_cache_mb is too large");
+                }
+                textureCacheBytes = megabytes << 20;
+            }
+            else
+            {
+                Error(key, "unknown settings key '" + key.ToString() + "'");
+            }
+        }
+
+        scene.world.SetSettings(settings);
+    }
+};
+}  // namespace
+
+SNMScene NMSceneParser::Parse(const char* data, std::size_t size, const std::string& sourceName)
+{
+    NMSceneReader reader(data, size, sourceName);
+    return reader.Read();
+}
+
+SNMScene NMSceneParser::ParseFile(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+        throw std::runtime_error("Failed to open scene file " + path);
+    }
+
+    // Read the whole file with one allocation, the parser works directly on the buffer
+    std::streamsize size = file.tellg();
+    std::vector<char> buffer(static_cast<std::size_t>(size));
+    file.seekg(0);
+    if (!file.read(buffer.data(), size))
+    {
+        throw std::runtime_error("Failed to read scene file " + path);
+    }
+
+    return Parse(buffer.data(), buffer.size(), path);
+}
@@ -0,0 +1,102 @@
+#include "NMCore/Texture.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+namespace
+{
+// Average 2x2 pixels into one, odd edges average the pixels that exist
+NMCanvas Downsample(const NMCanvas& source)
+{
+    std::size_t width = std::max<std::size_t>(1, (source.GetWidth() + 1) / 2);
+    std::size_t height = std::max<std::size_t>(1, (source.GetHeight() + 1) / 2);
+    NMCanvas level(width, height, DEFAULT_COLOR, ENMCanvasLayout::Tiled);
+
+    for (std::size_t y = 0; y < height; ++y)
+    {
+        for (std::size_t x = 0; x < width; ++x)
+        {
+            NMColor sum;
+            float count = 0.0f;
+            for (std::size_t sy = 2 * y; sy < std::min(2 * y + 2, source.GetHeight()); ++sy)
+            {
+                for (std::size_t sx = 2 * x; sx < std::min(2 * x + 2, source.GetWidth()); ++sx)
+                {
+                    sum += source.ReadPixel(sx, sy);
+                    count += 1.0f;
+                }
+            }
+
+            level.WritePixel(x, y, sum * (1.0f / count));
+        }
+    }
+
+    return level;
+}
+
+inline std::size_t WrapIndex(int64_t index, std::size_t size)
+{
+    int64_t signedSize = static_cast<int64_t>(size);
+    int64_t wrapped = index % signedSize;
+    return static_cast<std::size_t>(wrapped < 0 ? wrapped + signedSize : wrapped);
+}
+}  // namespace
+
+NMTexture::NMTexture(const NMCanvas& image)
+{
+    if (image.GetWidth() == 0 || image.GetHeight() == 0)
+    {
+        throw std::runtime_error("Texture image is empty");
+    }
+
+    levels.push_back(image);
+    levels.back().SetLayout(ENMCanvasLayout::Tiled);
+    while (levels.back().GetWidth() > 1 || levels.back().GetHeight() > 1)
+    {
+        NMCanvas next = Downsample(levels.back());
+        levels.push_back(std::move(next));
+    }
+}
+
+NMColor NMTextureBase::SampleBilinear(float u, float v, std::size_t level) const
+{
+    level = std::min(level, GetLevelCount() - 1);
+    std::size_t width = GetLevelWidth(level);
+    std::size_t height = GetLevelHeight(level);
+
+    // Texel centers are at half integers, row 0 is the top of the image
+    float x = u * static_cast<float>(width) - 0.5f;
+    float y = (1.0f - v) * static_cast<float>(height) - 0.5f;
+    float x0 = std::floor(x);
+    float y0 = std::floor(y);
+    float tx = x - x0;
+    float ty = y - y0;
+
+    int64_t ix = static_cast<int64_t>(x0);
+    int64_t iy = static_cast<int64_t>(y0);
+    NMColor texels[4];
+    ReadQuad(level, WrapIndex(ix, width), WrapIndex(ix + 1, width), WrapIndex(iy, height), WrapIndex(iy + 1, height),
+             texels);
+
+    NMColor upper = texels[0] * (1.0f - tx) + texels[1] * tx;
+    NMColor lower = texels[2] * (1.0f - tx) + texels[3] * tx;
+    return upper * (1.0f - ty) + lower * ty;
+}
+
+NMColor NMTextureBase::SampleTrilinear(float u, float v, float levelOfDetail) const
+{
+    float maxLevel = static_cast<float>(GetLevelCount() - 1);
+    float lod = std::min(std::max(levelOfDetail, 0.0f), maxLevel);
+    float fine = std::floor(lod);
+    float blend = lod - fine;
+
+    std::size_t level = static_cast<std::size_t>(fine);
+    NMColor color = SampleBilinear(u, v, level);
+    if (blend <= 0.0f)
+    {
+        return color;
+    }
+
+    return color * (1.0f - blend) + SampleBilinear(u, v, level + 1) * blend;
+}
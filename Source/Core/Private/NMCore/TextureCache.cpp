@@ -0,0 +1,406 @@
+#include "NMCore/TextureCache.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+#include "NMCore/RenderStats.hpp"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+constexpr std::size_t NMTextureCache::MIN_RESIDENT_TILES;
+constexpr uint32_t NMTextureCache::NO_SLOT;
+
+namespace
+{
+// Tile data starts on a page boundary so tile reads stay page aligned
+constexpr uint64_t TEXTURE_DATA_ALIGNMENT = 4096;
+
+inline uint32_t TileCount(uint32_t texels) { return (texels + TEXTURE_TILE_SIZE - 1) / TEXTURE_TILE_SIZE; }
+}  // namespace
+
+NMTextureCache::NMTextureCache(std::size_t memoryBudget)
+    : capacity(std::max(memoryBudget / TEXTURE_TILE_BYTES, MIN_RESIDENT_TILES)),
+      tileData(new float[capacity * TEXTURE_TILE_FLOATS]),
+      pins(new std::atomic<uint32_t>[capacity]),
+      referenced(new std::atomic<uint8_t>[capacity]),
+      owners(capacity)
+{
+    // Slots are handed out from the front, pages of the tile data are only touched once a tile is loaded into them
+    freeSlots.reserve(capacity);
+    for (std::size_t slot = capacity; slot-- > 0;)
+    {
+        pins[slot].store(0, std::memory_order_relaxed);
+        referenced[slot].store(0, std::memory_order_relaxed);
+        freeSlots.push_back(static_cast<uint32_t>(slot));
+    }
+}
+
+NMTextureCache::~NMTextureCache()
+{
+#ifndef _WIN32
+    for (const std::unique_ptr<SNMFile>& file : files)
+    {
+        close(file->descriptor);
+    }
+#endif
+}
+
+void NMTextureCache::WriteFile(const NMTexture& texture, const std::string& path)
+{
+    if (texture.GetLevelCount() > TEXTURE_FILE_MAX_LEVELS)
+    {
+        throw std::runtime_error("Texture has too many levels for a texture file " + path);
+    }
+
+    SNMTextureFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, TEXTURE_FILE_MAGIC, sizeof(header.magic));
+    header.version = TEXTURE_FILE_VERSION;
+    header.tileSize = TEXTURE_TILE_SIZE;
+    header.levelCount = static_cast<uint32_t>(texture.GetLevelCount());
+    header.dataOffset = (sizeof(header) + TEXTURE_DATA_ALIGNMENT - 1) / TEXTURE_DATA_ALIGNMENT * TEXTURE_DATA_ALIGNMENT;
+
+    for (uint32_t level = 0; level < header.levelCount; ++level)
+    {
+        SNMTextureFileLevel& info = header.levels[level];
+        info.width = static_cast<uint32_t>(texture.GetLevelWidth(level));
+        info.height = static_cast<uint32_t>(texture.GetLevelHeight(level));
+        info.tilesX = TileCount(info.width);
+        info.tilesY = TileCount(info.height);
+        info.firstTile = header.tileCount;
+        header.tileCount += static_cast<uint64_t>(info.tilesX) * info.tilesY;
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        throw std::runtime_error("Failed to open texture file for writing " + path);
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    std::vector<char> padding(header.dataOffset - sizeof(header), 0);
+    file.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+
+    std::vector<float> tile(TEXTURE_TILE_FLOATS);
+    for (uint32_t level = 0; level < header.levelCount; ++level)
+    {
+        const SNMTextureFileLevel& info = header.levels[level];
+        const NMCanvas& canvas = texture.GetLevel(level);
+        for (uint32_t tileY = 0; tileY < info.tilesY; ++tileY)
+        {
+            for (uint32_t tileX = 0; tileX < info.tilesX; ++tileX)
+            {
+                std::fill(tile.begin(), tile.end(), 0.0f);
+                uint32_t endY = std::min((tileY + 1) * TEXTURE_TILE_SIZE, info.height);
+                uint32_t endX = std::min((tileX + 1) * TEXTURE_TILE_SIZE, info.width);
+                for (uint32_t y = tileY * TEXTURE_TILE_SIZE; y < endY; ++y)
+                {
+                    for (uint32_t x = tileX * TEXTURE_TILE_SIZE; x < endX; ++x)
+                    {
+                        const NMColor& color = canvas.ReadPixel(x, y);
+                        float* texel = &tile[((y % TEXTURE_TILE_SIZE) * TEXTURE_TILE_SIZE + x % TEXTURE_TILE_SIZE) * 3];
+                        texel[0] = color.GetRed();
+                        texel[1] = color.GetGreen();
+                        texel[2] = color.GetBlue();
+                    }
+                }
+
+                file.write(reinterpret_cast<const char*>(tile.data()), TEXTURE_TILE_BYTES);
+            }
+        }
+    }
+
+    if (!file)
+    {
+        throw std::runtime_error("Failed to write texture file " + path);
+    }
+}
+
+bool NMTextureCache::IsTextureFile(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    char magic[sizeof(TEXTURE_FILE_MAGIC)] = {};
+    file.read(magic, sizeof(magic));
+    return file && std::memcmp(magic, TEXTURE_FILE_MAGIC, sizeof(magic)) == 0;
+}
+
+std::size_t NMTextureCache::GetResidentTiles() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return residentTiles;
+}
+
+NMTextureCache::SNMFile& NMTextureCache::Open(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const std::unique_ptr<SNMFile>& file : files)
+    {
+        if (file->path == path)
+        {
+            return *file;
+        }
+    }
+
+    std::unique_ptr<SNMFile> file(new SNMFile());
+    file->path = path;
+
+#ifndef _WIN32
+    file->descriptor = open(path.c_str(), O_RDONLY);
+    if (file->descriptor < 0)
+    {
+        throw std::runtime_error("Failed to open texture file " + path);
+    }
+
+    bool complete = pread(file->descriptor, &file->header, sizeof(file->header), 0)
+                    == static_cast<ssize_t>(sizeof(file->header));
+    off_t fileSize = lseek(file->descriptor, 0, SEEK_END);
+#else
+    file->stream.open(path, std::ios::binary);
+    if (!file->stream.is_open())
+    {
+        throw std::runtime_error("Failed to open texture file " + path);
+    }
+
+    bool complete = static_cast<bool>(file->stream.read(reinterpret_cast<char*>(&file->header), sizeof(file->header)));
+    file->stream.seekg(0, std::ios::end);
+    std::streamoff fileSize = file->stream.tellg();
+#endif
+
+    const SNMTextureFileHeader& header = file->header;
+    bool valid = complete && std::memcmp(header.magic, TEXTURE_FILE_MAGIC, sizeof(header.magic)) == 0
+                 && header.version == TEXTURE_FILE_VERSION && header.tileSize == TEXTURE_TILE_SIZE
+                 && header.levelCount > 0 && header.levelCount <= TEXTURE_FILE_MAX_LEVELS
+                 && header.dataOffset + header.tileCount * TEXTURE_TILE_BYTES <= static_cast<uint64_t>(fileSize);
+
+    for (uint32_t level = 0; valid && level < header.levelCount; ++level)
+    {
+        const SNMTextureFileLevel& info = header.levels[level];
+        valid = info.width > 0 && info.height > 0 && info.tilesX == TileCount(info.width)
+                && info.tilesY == TileCount(info.height)
+                && info.firstTile + static_cast<uint64_t>(info.tilesX) * info.tilesY <= header.tileCount;
+    }
+
+    if (!valid)
+    {
+#ifndef _WIN32
+        close(file->descriptor);
+#endif
+        throw std::runtime_error("Invalid or incompatible texture file " + path);
+    }
+
+    file->slots.reset(new std::atomic<uint32_t>[header.tileCount]);
+    for (uint64_t tile = 0; tile < header.tileCount; ++tile)
+    {
+        file->slots[tile].store(0, std::memory_order_relaxed);
+    }
+
+    files.push_back(std::move(file));
+    return *files.back();
+}
+
+const float* NMTextureCache::Pin(SNMFile& file, uint64_t tile, uint32_t& slot)
+{
+    std::atomic<uint32_t>& entry = file.slots[tile];
+    for (;;)
+    {
+        // Fast path: pin the slot, then check it still holds the tile. ReclaimSlot() clears the entry before it
+        // checks the pins, so either it sees this pin or this sees the cleared entry.
+        uint32_t resident = entry.load(std::memory_order_acquire);
+        if (resident != 0)
+        {
+            slot = resident - 1;
+            pins[slot].fetch_add(1);
+            if (entry.load() == resident)
+            {
+                referenced[slot].store(1, std::memory_order_relaxed);
+                nmstats::CountTextureTile(true, 0);
+                return tileData.get() + slot * TEXTURE_TILE_FLOATS;
+            }
+
+            Unpin(slot);
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        if (entry.load(std::memory_order_relaxed) != 0)
+        {
+            continue;
+        }
+
+        const float* texels = LoadTile(lock, file, tile, slot);
+        if (texels != nullptr)
+        {
+            return texels;
+        }
+    }
+}
+
+uint32_t NMTextureCache::ReclaimSlot()
+{
+    if (!freeSlots.empty())
+    {
+        uint32_t slot = freeSlots.back();
+        freeSlots.pop_back();
+        return slot;
+    }
+
+    // Two sweeps: the first may only clear the referenced flags
+    for (std::size_t step = 0; step < 2 * capacity; ++step)
+    {
+        uint32_t slot = static_cast<uint32_t>(clockHand);
+        clockHand = (clockHand + 1) % capacity;
+
+        SNMSlotOwner& owner = owners[slot];
+        if (owner.file == nullptr || referenced[slot].exchange(0, std::memory_order_relaxed) != 0
+            || pins[slot].load() != 0)
+        {
+            continue;
+        }
+
+        std::atomic<uint32_t>& entry = owner.file->slots[owner.tile];
+        entry.store(0);
+        if (pins[slot].load() != 0)
+        {
+            // A reader pinned the slot in between, it keeps the tile
+            entry.store(slot + 1);
+            continue;
+        }
+
+        owner.file = nullptr;
+        --residentTiles;
+        return slot;
+    }
+
+    return NO_SLOT;
+}
+
+const float* NMTextureCache::LoadTile(std::unique_lock<std::mutex>& lock, SNMFile& file, uint64_t tile,
+                                      uint32_t& slot)
+{
+    slot = ReclaimSlot();
+    if (slot == NO_SLOT)
+    {
+        // Every slot is pinned, wait for a worker to finish its lookup
+        lock.unlock();
+        std::this_thread::yield();
+        return nullptr;
+    }
+
+    // The slot belongs to no tile while it is read, so it can neither be reclaimed nor found
+    lock.unlock();
+    float* texels = tileData.get() + slot * TEXTURE_TILE_FLOATS;
+    try
+    {
+        ReadTile(file, tile, texels);
+    }
+    catch (...)
+    {
+        lock.lock();
+        freeSlots.push_back(slot);
+        throw;
+    }
+
+    lock.lock();
+    std::atomic<uint32_t>& entry = file.slots[tile];
+    if (entry.load(std::memory_order_relaxed) != 0)
+    {
+        // Another worker loaded the same tile meanwhile, use its slot
+        freeSlots.push_back(slot);
+        return nullptr;
+    }
+
+    owners[slot].file = &file;
+    owners[slot].tile = tile;
+    // Added, not stored: a reader with a stale entry for the reclaimed slot may have pinned it and unpins it later
+    pins[slot].fetch_add(1);
+    referenced[slot].store(1, std::memory_order_relaxed);
+    ++residentTiles;
+    entry.store(slot + 1, std::memory_order_release);
+
+    nmstats::CountTextureTile(false, TEXTURE_TILE_BYTES);
+    return texels;
+}
+
+void NMTextureCache::ReadTile(SNMFile& file, uint64_t tile, float* out)
+{
+    uint64_t offset = file.header.dataOffset + tile * TEXTURE_TILE_BYTES;
+
+#ifndef _WIN32
+    char* destination = reinterpret_cast<char*>(out);
+    std::size_t done = 0;
+    while (done < TEXTURE_TILE_BYTES)
+    {
+        ssize_t bytes = pread(file.descriptor, destination + done, TEXTURE_TILE_BYTES - done,
+                              static_cast<off_t>(offset + done));
+        if (bytes <= 0)
+        {
+            throw std::runtime_error("Failed to read a tile of texture file " + file.path);
+        }
+
+        done += static_cast<std::size_t>(bytes);
+    }
+#else
+    std::lock_guard<std::mutex> lock(file.streamMutex);
+    file.stream.seekg(static_cast<std::streamoff>(offset));
+    if (!file.stream.read(reinterpret_cast<char*>(out), TEXTURE_TILE_BYTES))
+    {
+        throw std::runtime_error("Failed to read a tile of texture file " + file.path);
+    }
+#endif
+}
+
+NMCachedTexture::NMCachedTexture(std::shared_ptr<NMTextureCache> cache, const std::string& path)
+    : cache(std::move(cache)), file(&this->cache->Open(path))
+{
+}
+
+void NMCachedTexture::ReadQuad(std::size_t level, std::size_t x0, std::size_t x1, std::size_t y0, std::size_t y1,
+                               NMColor texels[4]) const
+{
+    const SNMTextureFileLevel& info = file->header.levels[level];
+    uint64_t pinnedTile = UINT64_MAX;
+    uint32_t pinnedSlot = NMTextureCache::NO_SLOT;
+    const float* tile = nullptr;
+
+    // The four texels mostly share a tile, which is pinned once
+    try
+    {
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            std::size_t x = (i & 1) ? x1 : x0;
+            std::size_t y = (i & 2) ? y1 : y0;
+            uint64_t tileIndex = info.firstTile + (y / TEXTURE_TILE_SIZE) * info.tilesX + x / TEXTURE_TILE_SIZE;
+            if (tileIndex != pinnedTile)
+            {
+                if (pinnedSlot != NMTextureCache::NO_SLOT)
+                {
+                    cache->Unpin(pinnedSlot);
+                    pinnedSlot = NMTextureCache::NO_SLOT;
+                }
+
+                uint32_t slot;
+                tile = cache->Pin(*file, tileIndex, slot);
+                pinnedSlot = slot;
+                pinnedTile = tileIndex;
+            }
+
+            const float* texel = tile + ((y % TEXTURE_TILE_SIZE) * TEXTURE_TILE_SIZE + x % TEXTURE_TILE_SIZE) * 3;
+            texels[i] = NMColor(texel[0], texel[1], texel[2]);
+        }
+    }
+    catch (...)
+    {
+        // Nothing may stay pinned when a tile fails to load, the slot could never be reclaimed
+        if (pinnedSlot != NMTextureCache::NO_SLOT)
+        {
+            cache->Unpin(pinnedSlot);
+        }
+        throw;
+    }
+
+    cache->Unpin(pinnedSlot);
+}
@@ -0,0 +1,269 @@
+#include "NMCore/Trace.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+/**
+ * @brief The ring buffer of one thread. Only the owning thread writes events and head.
+ */
+struct SNMTraceBuffer
+{
+    std::vector<SNMTraceEvent> events;
+    std::atomic<uint64_t> head{0};
+    uint32_t tid = 0;
+    std::string threadName;
+    bool inUse = false;
+};
+
+int64_t ClockNanoseconds()
+{
+    return static_cast<int64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+}
+
+struct SNMTraceRegistry
+{
+    std::mutex mutex;
+    std::vector<std::unique_ptr<SNMTraceBuffer>> buffers;
+    std::size_t capacity = TRACE_DEFAULT_CAPACITY;
+    // Read by Now() without the lock
+    std::atomic<int64_t> epoch{ClockNanoseconds()};
+};
+
+SNMTraceRegistry& Registry()
+{
+    static SNMTraceRegistry registry;
+    return registry;
+}
+
+std::string& ThreadName()
+{
+    static thread_local std::string name;
+    return name;
+}
+
+/**
+ * @brief The calling thread's buffer. Hands the buffer back to the registry when the thread exits, so a new thread
+ * reuses it instead of allocating another one.
+ */
+struct SNMThreadBuffer
+{
+    SNMTraceBuffer* buffer = nullptr;
+
+    ~SNMThreadBuffer()
+    {
+        if (buffer)
+        {
+            std::unique_lock<std::mutex> lock(Registry().mutex);
+            buffer->inUse = false;
+        }
+    }
+};
+
+SNMTraceBuffer*& ThreadBuffer()
+{
+    static thread_local SNMThreadBuffer handle;
+    return handle.buffer;
+}
+
+SNMTraceBuffer* RegisterThread()
+{
+    SNMTraceRegistry& registry = Registry();
+    std::unique_lock<std::mutex> lock(registry.mutex);
+
+    // Reuse the buffer of an exited thread, preferably one with the same name. Its events stay on the same timeline
+    // row, so the registry only grows to the largest number of threads that traced at the same time.
+    SNMTraceBuffer* reused = nullptr;
+    for (std::unique_ptr<SNMTraceBuffer>& buffer : registry.buffers)
+    {
+        if (!buffer->inUse && (!reused || buffer->threadName == ThreadName()))
+        {
+            reused = buffer.get();
+            if (reused->threadName == ThreadName())
+            {
+                break;
+            }
+        }
+    }
+
+    if (reused)
+    {
+        reused->threadName = ThreadName();
+    }
+    else
+    {
+        std::unique_ptr<SNMTraceBuffer> buffer(new SNMTraceBuffer());
+        buffer->events.resize(registry.capacity);
+        buffer->tid = static_cast<uint32_t>(registry.buffers.size() + 1);
+        buffer->threadName = ThreadName();
+        reused = buffer.get();
+        registry.buffers.push_back(std::move(buffer));
+    }
+
+    reused->inUse = true;
+    ThreadBuffer() = reused;
+    return reused;
+}
+
+void WriteJSONString(std::ostream& os, const std::string& value)
+{
+    os << '"';
+    for (char c : value)
+    {
+        if (c == '"' || c == '\\')
+        {
+            os << '\\';
+        }
+        os << c;
+    }
+    os << '"';
+}
+}  // namespace
+
+std::atomic<bool> NMTrace::enabled{false};
+
+void NMTrace::Start(std::size_t eventsPerThread)
+{
+    SNMTraceRegistry& registry = Registry();
+    std::unique_lock<std::mutex> lock(registry.mutex);
+
+    registry.capacity = eventsPerThread > 0 ? eventsPerThread : 1;
+    for (std::unique_ptr<SNMTraceBuffer>& buffer : registry.buffers)
+    {
+        buffer->events.resize(registry.capacity);
+        buffer->head.store(0, std::memory_order_relaxed);
+    }
+
+    registry.epoch.store(ClockNanoseconds(), std::memory_order_relaxed);
+    enabled.store(true, std::memory_order_release);
+}
+
+void NMTrace::Stop()
+{
+    enabled.store(false, std::memory_order_release);
+}
+
+uint64_t NMTrace::Now()
+{
+    return static_cast<uint64_t>(ClockNanoseconds() - Registry().epoch.load(std::memory_order_relaxed));
+}
+
+void NMTrace::Record(const char* name, const char* category, uint64_t start, uint64_t end, int64_t id)
+{
+    if (!IsEnabled())
+    {
+        return;
+    }
+
+    SNMTraceBuffer* buffer = ThreadBuffer();
+    if (!buffer)
+    {
+        buffer = RegisterThread();
+    }
+
+    uint64_t head = buffer->head.load(std::memory_order_relaxed);
+    buffer->events[head % buffer->events.size()] = SNMTraceEvent{name, category, start, end > start ? end - start : 0,
+                                                                 id};
+    buffer->head.store(head + 1, std::memory_order_release);
+}
+
+void NMTrace::SetThreadName(const std::string& name)
+{
+    ThreadName() = name;
+
+    if (SNMTraceBuffer* buffer = ThreadBuffer())
+    {
+        std::unique_lock<std::mutex> lock(Registry().mutex);
+        buffer->threadName = name;
+    }
+}
+
+std::size_t NMTrace::GetEventCount()
+{
+    SNMTraceRegistry& registry = Registry();
+    std::unique_lock<std::mutex> lock(registry.mutex);
+
+    std::size_t count = 0;
+    for (const std::unique_ptr<SNMTraceBuffer>& buffer : registry.buffers)
+    {
+        uint64_t head = buffer->head.load(std::memory_order_acquire);
+        count += static_cast<std::size_t>(std::min<uint64_t>(head, buffer->events.size()));
+    }
+
+    return count;
+}
+
+uint64_t NMTrace::GetDroppedCount()
+{
+    SNMTraceRegistry& registry = Registry();
+    std::unique_lock<std::mutex> lock(registry.mutex);
+
+    uint64_t dropped = 0;
+    for (const std::unique_ptr<SNMTraceBuffer>& buffer : registry.buffers)
+    {
+        uint64_t head = buffer->head.load(std::memory_order_acquire);
+        dropped += head > buffer->events.size() ? head - buffer->events.size() : 0;
+    }
+
+    return dropped;
+}
+
+void NMTrace::WriteChromeJSON(std::ostream& os)
+{
+    SNMTraceRegistry& registry = Registry();
+    std::unique_lock<std::mutex> lock(registry.mutex);
+
+    std::ios_base::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+    os << std::fixed << std::setprecision(3);
+
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (const std::unique_ptr<SNMTraceBuffer>& buffer : registry.buffers)
+    {
+        uint64_t head = buffer->head.load(std::memory_order_acquire);
+        if (head == 0)
+        {
+            continue;
+        }
+
+        if (!buffer->threadName.empty())
+        {
+            os << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->tid
+               << ",\"args\":{\"name\":";
+            WriteJSONString(os, buffer->threadName);
+            os << "}}";
+            first = false;
+        }
+
+        // Oldest event first, skipping events that have been overwritten
+        uint64_t capacity = buffer->events.size();
+        for (uint64_t i = head > capacity ? head - capacity : 0; i < head; ++i)
+        {
+            const SNMTraceEvent& event = buffer->events[i % capacity];
+
+            // Chrome trace timestamps are in microseconds
+            os << (first ? "" : ",") << "\n{\"name\":\"" << event.name << "\",\"cat\":\"" << event.category
+               << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->tid
+               << ",\"ts\":" << static_cast<double>(event.start) / 1000.0
+               << ",\"dur\":" << static_cast<double>(event.duration) / 1000.0;
+            if (event.id >= 0)
+            {
+                os << ",\"args\":{\"id\":" << event.id << "}";
+            }
+            os << "}";
+            first = false;
+        }
+    }
+    os << "\n]}\n";
+
+    os.flags(flags);
+    os.precision(precision);
+}
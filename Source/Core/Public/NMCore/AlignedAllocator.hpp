@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#    include <malloc.h>
+#endif
+
+constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+/**
+ * @brief A standard allocator that aligns every allocation to Alignment bytes.
+ * Used for buffers that are written by several threads so that blocks which start on an Alignment boundary never share
+ * a cache line with their neighbours.
+ */
+template <typename T, std::size_t Alignment = CACHE_LINE_SIZE> class NMAlignedAllocator
+{
+public:
+
+    using value_type = T;
+
+    template <typename U> struct rebind
+    {
+        using other = NMAlignedAllocator<U, Alignment>;
+    };
+
+    NMAlignedAllocator() = default;
+    template <typename U> NMAlignedAllocator(const NMAlignedAllocator<U, Alignment>& /* other */) {}
+
+    T* allocate(std::size_t count)
+    {
+        void* memory = nullptr;
+
+#ifdef _WIN32
+        memory = _aligned_malloc(count * sizeof(T), Alignment);
+#else
+        if (posix_memalign(&memory, Alignment, count * sizeof(T)) != 0)
+        {
+            memory = nullptr;
+        }
+#endif
+
+        if (memory == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+
+        return static_cast<T*>(memory);
+    }
+
+    void deallocate(T* memory, std::size_t /* count */)
+    {
+#ifdef _WIN32
+        _aligned_free(memory);
+#else
+        free(memory);
+#endif
+    }
+
+    template <typename U> bool operator==(const NMAlignedAllocator<U, Alignment>& /* other */) const { return true; }
+    template <typename U> bool operator!=(const NMAlignedAllocator<U, Alignment>& /* other */) const { return false; }
+};
@@ -1,16 +1,52 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <random>
 
 #include "Canvas.hpp"
+#include "CostMap.hpp"
+#include "FrameHistory.hpp"
+#include "GBuffer.hpp"
 #include "NMM/Matrix.hpp"
 #include "NMM/Point.hpp"
 #include "NMM/Vector.hpp"
 #include "RT/Ray.hpp"
+#include "Random.hpp"
+#include "RenderStats.hpp"
+#include "StopToken.hpp"
 #include "ThreadPool.hpp"
+#include "TileBuffer.hpp"
+#include "Trace.hpp"
 #include "World.hpp"
 
+/**
+ * @brief What a render pass does with the pixels of a tile.
+ */
+enum class ENMRenderPass : uint8_t
+{
+    /**
+     * @brief Trace the primary ray of every pixel.
+     */
+    Trace = 0,
+
+    /**
+     * @brief Shade the hits cached in the G-buffer.
+     */
+    Reshade,
+
+    /**
+     * @brief Trace the pixels the frame history has no sample for.
+     */
+    Disoccluded,
+
+    /**
+     * @brief Trace the pixels whose color the frame history carried over from an earlier view.
+     */
+    Refine,
+};
+
 class NMCamera
 {
 public:
@@ -20,8 +56,38 @@ public:
         UpdatePixelSize();
     }
 
+    NMCamera(const NMCamera& other)
+        : hSize(other.hSize),
+          vSize(other.vSize),
+          fov(other.fov),
+          halfWidth(other.halfWidth),
+          halfHeight(other.halfHeight),
+          pixelSize(other.pixelSize),
+          transform(other.transform),
+          inverseTransform(other.inverseTransform),
+          deterministic(other.deterministic),
+          seed(other.seed)
+    {
+    }
+
     ~NMCamera() {}
 
+    NMCamera& operator=(const NMCamera& other)
+    {
+        hSize = other.hSize;
+        vSize = other.vSize;
+        fov = other.fov;
+        halfWidth = other.halfWidth;
+        halfHeight = other.halfHeight;
+        pixelSize = other.pixelSize;
+        transform = other.transform;
+        inverseTransform = other.inverseTransform;
+        deterministic = other.deterministic;
+        seed = other.seed;
+
+        return *this;
+    }
+
     inline std::size_t GetHSize() const { return hSize; }
     inline std::size_t GetVSize() const { return vSize; }
 
@@ -31,7 +97,87 @@ public:
 
     inline const NMMatrix& GetTransform() const { return transform; }
 
-    inline void SetTransform(const NMMatrix& transform) { this->transform = transform; }
+    /**
+     * @brief Render deterministically: tiles are shuffled with a fixed seed and per-pixel random streams are derived
+     *        from the seed and the pixel coordinates (see RandomForPixel()).
+     * Every pixel is shaded independently of the others, so deterministic renders are bitwise identical no matter how
+     * many threads render them or which thread gets which tile.
+     */
+    inline void SetSeed(uint64_t newSeed)
+    {
+        seed = newSeed;
+        deterministic = true;
+    }
+
+    /**
+     * @brief Go back to shuffling tiles with a new random seed for every frame.
+     */
+    inline void ClearSeed() { deterministic = false; }
+
+    inline bool IsDeterministic() const { return deterministic; }
+    inline uint64_t GetSeed() const { return seed; }
+
+    /**
+     * @brief The random stream of a pixel for sampling, seeded from the render seed and the pixel coordinates.
+     * @param sample Selects an independent stream for each sample of the pixel.
+     */
+    inline NMRandom RandomForPixel(std::size_t px, std::size_t py, uint32_t sample = 0) const
+    {
+        return NMRandom::ForPixel(seed, static_cast<uint32_t>(px), static_cast<uint32_t>(py), sample);
+    }
+
+    /**
+     * @brief The order in which the tiles of the next frame are handed to the workers.
+     * The tiles are shuffled so the image fills in evenly, with the camera's seed when it is deterministic.
+     */
+    std::vector<SNMTile> TileOrder() const
+    {
+        std::vector<SNMTile> tiles = SNMTile::Split(hSize, vSize);
+
+        uint64_t frameSeed = seed;
+        if (!deterministic)
+        {
+            std::random_device rd;
+            frameSeed = (static_cast<uint64_t>(rd()) << 32) | rd();
+        }
+
+        // Fisher-Yates with NMRandom instead of std::shuffle, whose output differs between standard libraries
+        NMRandom random(NMRandom::Mix(frameSeed));
+        for (std::size_t i = tiles.size(); i > 1; --i)
+        {
+            std::size_t j = random.NextBelow(static_cast<uint32_t>(i));
+            std::swap(tiles[i - 1], tiles[j]);
+        }
+
+        return tiles;
+    }
+
+    /**
+     * @brief Record the cost of every pixel into a map while rendering, nullptr to stop recording.
+     * The map is resized to the camera's size when a render starts. It is not copied with the camera.
+     */
+    inline void SetCostMap(NMCostMap* map) { costMap = map; }
+    inline NMCostMap* GetCostMap() const { return costMap; }
+
+    /**
+     * @brief Cache the first hit of every pixel while rendering so Reshade() can skip primary rays, nullptr to stop.
+     * The buffer is not copied with the camera.
+     */
+    inline void SetGBuffer(NMGBuffer* buffer) { gBuffer = buffer; }
+    inline NMGBuffer* GetGBuffer() const { return gBuffer; }
+
+    /**
+     * @brief Keep the color and depth of every pixel so Reproject() can reuse them after a camera move, nullptr to
+     *        stop. The history is not copied with the camera.
+     */
+    inline void SetFrameHistory(NMFrameHistory* history) { frameHistory = history; }
+    inline NMFrameHistory* GetFrameHistory() const { return frameHistory; }
+
+    inline void SetTransform(const NMMatrix& transform)
+    {
+        this->transform = transform;
+        inverseTransform = transform.Inverse();
+    }
 
     NMRay RayForPixel(std::size_t px, std::size_t py)
     {
@@ -47,14 +193,15 @@ public:
         // Using the camera matrix, transform the canvas point and the origin,
         // and then compute the ray's direction vector.
         // (Remember that the canvas is at z=-1)
-        NMMatrix inverseTransform = transform.Inverse();
         NMPoint pixel = inverseTransform * NMPoint(worldX, worldY, -1.0f);
         NMPoint origin = inverseTransform * NMPoint(0.0f, 0.0f, 0.0f);
         NMVector direction = pixel - origin;
 
         direction.Normalize();
 
-        return NMRay(origin, direction);
+        NMRay ray(origin, direction);
+        ray.SetSpread(pixelSize);
+        return ray;
     }
 
     /**
@@ -66,7 +213,7 @@ public:
      */
     inline NMCanvas Render(const NMWorld& world, int64_t threadCount = 0)
     {
-        NMCanvas image(hSize, vSize);
+        NMCanvas image(hSize, vSize, DEFAULT_COLOR, ENMCanvasLayout::Tiled);
         Render(world, &image, threadCount);
         return image;
     }
@@ -78,73 +225,129 @@ public:
      * @param image The canvas to render to.
      * @param threadCount The number of threads to use for rendering (0 = use all available threads).
      *                    A negative value will use all available threads minus the absolute value of the parameter.
-     * @return The rendered canvas.
+     * @return The statistics of the frame.
      */
-    void Render(const NMWorld& world, NMCanvas* image, int64_t threadCount = 0)
+    SNMRenderStats Render(const NMWorld& world, NMCanvas* image, int64_t threadCount = 0)
     {
         if (pool)
         {
             throw std::runtime_error("Camera is already rendering");
         }
 
-        if (threadCount <= 0)
+        ThreadPool workers(ThreadCount(threadCount));
+        return Render(world, image, workers);
+    }
+
+    /**
+     * @brief Render the world to a canvas using an existing thread pool.
+     * @note This method will block until rendering is complete. The pool is left running so it can be reused for
+     *       the next frame.
+     * @param world The world to render to the canvas.
+     * @param image The canvas to render to.
+     * @param workers The thread pool to render on.
+     * @param threadCount The maximum number of pool threads to use (0 = all of the pool's threads).
+     * @return The statistics of the frame.
+     */
+    SNMRenderStats Render(const NMWorld& world, NMCanvas* image, ThreadPool& workers, std::size_t threadCount = 0)
+    {
+        return RenderFrame(world, image, workers, threadCount, {ENMRenderPass::Trace});
+    }
+
+    /**
+     * @brief Render the world again from the hits cached in the G-buffer, without tracing primary rays.
+     * Use it after changing only materials or lights. Falls back to a full Render(), which fills the G-buffer again,
+     * when there is no G-buffer or it no longer matches the camera and the world's objects (see NMGBuffer).
+     * @note This method will block until rendering is complete. The cost map is not updated by a reshade.
+     * @param world The world to render to the canvas.
+     * @param image The canvas to render to.
+     * @param threadCount The number of threads to use for rendering, as for Render().
+     * @return The statistics of the frame.
+     */
+    SNMRenderStats Reshade(const NMWorld& world, NMCanvas* image, int64_t threadCount = 0)
+    {
+        if (pool)
         {
-            threadCount = std::thread::hardware_concurrency() + threadCount;
+            throw std::runtime_error("Camera is already rendering");
         }
 
-        pool = new ThreadPool(static_cast<std::size_t>(threadCount));
+        ThreadPool workers(ThreadCount(threadCount));
+        return Reshade(world, image, workers);
+    }
 
-        // Generate a list of indices to render and shuffle them
-        std::vector<std::size_t> indices;
-        for (std::size_t i = 0; i < hSize * vSize; ++i)
+    /**
+     * @brief Render the world again from the hits cached in the G-buffer using an existing thread pool.
+     * @see Reshade(const NMWorld&, NMCanvas*, int64_t)
+     */
+    SNMRenderStats Reshade(const NMWorld& world, NMCanvas* image, ThreadPool& workers, std::size_t threadCount = 0)
+    {
+        if (pool)
         {
-            indices.push_back(i);
+            throw std::runtime_error("Camera is already rendering");
         }
-        std::random_device rd;
-        std::mt19937 g(rd());
-        std::shuffle(indices.begin(), indices.end(), g);
 
-        for (std::size_t i = 0; i < indices.size(); ++i)
+        bool reshade = gBuffer && gBuffer->IsValidFor(world, hSize, vSize, fov, transform);
+        return RenderFrame(world, image, workers, threadCount,
+                           {reshade ? ENMRenderPass::Reshade : ENMRenderPass::Trace});
+    }
+
+    /**
+     * @brief Render the world after a camera move, reusing the previous frame kept in the frame history.
+     * The samples of the previous frame are reprojected into the current view and written to the canvas. The pixels
+     * no sample landed on are traced first, then the reprojected pixels are traced again so the frame converges to
+     * the exact image. Stopping the render (StopRender()) after the first pass leaves a complete, approximate image,
+     * and the next Reproject() continues from it. Without a frame history of the camera's size this is a Render().
+     * @note This method will block until rendering is complete. The cost map and G-buffer are not updated.
+     * @param world The world to render to the canvas.
+     * @param image The canvas to render to, usually the one the previous frame was rendered to.
+     * @param workers The thread pool to render on.
+     * @param threadCount The maximum number of pool threads to use (0 = all of the pool's threads).
+     * @param refine Trace the reprojected pixels again after the disoccluded ones. Without refinement the frame is
+     *               approximate; a later Reproject() with an unchanged camera refines it.
+     * @return The statistics of the frame.
+     */
+    SNMRenderStats Reproject(const NMWorld& world, NMCanvas* image, ThreadPool& workers, std::size_t threadCount = 0,
+                             bool refine = true)
+    {
+        if (!frameHistory || !frameHistory->Matches(hSize, vSize))
         {
-            std::size_t index = indices[i];
-            std::size_t x = index % hSize;
-            std::size_t y = index / hSize;
-            pool->Enqueue(
-                [this, &world, &image, x, y]
-                {
-                    NMRay ray = RayForPixel(x, y);
-                    NMColor color = world.ColorAt(ray);
-                    image->WritePixel(x, y, color);
-                });
+            return RenderFrame(world, image, workers, threadCount, {ENMRenderPass::Trace});
         }
 
-        // // Sequentially render each pixel
-        // for (std::size_t y = 0; y < vSize; ++y)
-        // {
-        //     for (std::size_t x = 0; x < hSize; ++x)
-        //     {
-        //         pool->Enqueue(
-        //             [this, &world, &image, x, y]
-        //             {
-        //                 NMRay ray = RayForPixel(x, y);
-        //                 NMColor color = world.ColorAt(ray);
-        //                 image->WritePixel(x, y, color);
-        //             });
-        //     }
-        // }
-        delete pool;
-        pool = nullptr;
+        std::vector<ENMRenderPass> passes = {ENMRenderPass::Disoccluded};
+        if (refine)
+        {
+            passes.push_back(ENMRenderPass::Refine);
+        }
+
+        return RenderFrame(world, image, workers, threadCount, passes);
+    }
+
+    /**
+     * @brief Render the world after a camera move, reusing the previous frame kept in the frame history.
+     * @see Reproject(const NMWorld&, NMCanvas*, ThreadPool&, std::size_t, bool)
+     */
+    SNMRenderStats Reproject(const NMWorld& world, NMCanvas* image, int64_t threadCount = 0, bool refine = true)
+    {
+        if (pool)
+        {
+            throw std::runtime_error("Camera is already rendering");
+        }
+
+        ThreadPool workers(ThreadCount(threadCount));
+        return Reproject(world, image, workers, 0, refine);
     }
 
     /**
      * @brief Stop rendering the world to a canvas.
-     * @note This method will return immediately, but the thread running Render() will block until cancel has completed.
+     * @note This method will return immediately. Workers check the stop token before every pixel and reflection
+     *       bounce, so the thread running Render() returns after at most about one pixel per worker; tiles that were
+     *       in progress are discarded and keep the canvas' previous contents.
      */
     void StopRender()
     {
         if (pool)
         {
-            pool->Cancel();
+            stopToken.RequestStop();
         }
     }
 
@@ -160,8 +363,317 @@ protected:
     float pixelSize;
 
     NMMatrix transform = NMMatrix::Identity4x4();
+    NMMatrix inverseTransform = NMMatrix::Identity4x4();
+
+    std::atomic<ThreadPool*> pool{nullptr};
+    NMStopToken stopToken;
+
+    NMCostMap* costMap = nullptr;
+    NMGBuffer* gBuffer = nullptr;
+    NMFrameHistory* frameHistory = nullptr;
+
+    bool deterministic = false;
+    uint64_t seed = 0;
 
-    ThreadPool* pool = nullptr;
+    /**
+     * @brief Render one frame on the pool.
+     * @param passes The passes of the frame. Every pass covers all tiles and finishes before the next one starts.
+     */
+    SNMRenderStats RenderFrame(const NMWorld& world, NMCanvas* image, ThreadPool& workers, std::size_t threadCount,
+                               const std::vector<ENMRenderPass>& passes)
+    {
+        if (pool)
+        {
+            throw std::runtime_error("Camera is already rendering");
+        }
+
+        // Reset before publishing the pool, a StopRender() that sees the pool must not be undone
+        stopToken.Reset();
+        pool = &workers;
+
+        ENMRenderPass firstPass = passes.front();
+        NMTraceScope frameTrace(firstPass == ENMRenderPass::Trace     ? "Frame"
+                                : firstPass == ENMRenderPass::Reshade ? "Reshade"
+                                                                      : "Reproject",
+                                "render");
+
+        std::vector<SNMTile> tiles = TileOrder();
+
+        if (threadCount == 0 || threadCount > workers.GetThreadCount())
+        {
+            threadCount = workers.GetThreadCount();
+        }
+
+        if (costMap && firstPass == ENMRenderPass::Trace)
+        {
+            costMap->Resize(hSize, vSize);
+        }
+
+        if (gBuffer)
+        {
+            if (firstPass == ENMRenderPass::Trace)
+            {
+                gBuffer->Begin(world, hSize, vSize, fov, transform);
+            }
+            else if (firstPass == ENMRenderPass::Reshade)
+            {
+                gBuffer->BeginReshade(world);
+            }
+            else
+            {
+                gBuffer->Invalidate();
+            }
+        }
+
+        if (frameHistory)
+        {
+            if (firstPass == ENMRenderPass::Trace)
+            {
+                frameHistory->Reset(hSize, vSize, transform);
+            }
+            else if (firstPass == ENMRenderPass::Disoccluded)
+            {
+                frameHistory->Reproject(transform, halfWidth, halfHeight, pixelSize);
+            }
+        }
+
+        SNMRenderStats stats;
+        stats.tileCount = passes.size() * tiles.size();
+
+        // Every worker writes to its own cache line aligned counters and times, they are merged after the frame
+        NMRenderCountersArray counters(NM_RENDER_STATS ? threadCount : 0);
+        NMWorkerSlotArray workerSlots(NM_RENDER_STATS ? threadCount : 0);
+
+        auto frameStart = std::chrono::steady_clock::now();
+
+        // A pass reads the frame history the previous one writes for the same tile, so every pass waits for the last
+        for (std::size_t passIndex = 0; passIndex < passes.size() && !stopToken.IsStopRequested(); ++passIndex)
+        {
+            RenderPass(world, image, workers, threadCount, tiles, passes[passIndex], passIndex, counters, workerSlots);
+        }
+
+        pool = nullptr;
+
+        if (gBuffer && (firstPass == ENMRenderPass::Trace || firstPass == ENMRenderPass::Reshade))
+        {
+            gBuffer->Finish(!stopToken.IsStopRequested());
+        }
+
+        stats.frameSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - frameStart).count();
+
+#if NM_RENDER_STATS
+        for (std::size_t i = 0; i < threadCount; ++i)
+        {
+            stats.Accumulate(counters[i]);
+            stats.tiles.insert(stats.tiles.end(), workerSlots[i].tileTimes.begin(), workerSlots[i].tileTimes.end());
+
+            SNMWorkerStats worker = workerSlots[i].stats;
+            worker.idleSeconds = std::max(0.0, stats.frameSeconds - worker.busySeconds - worker.queueWaitSeconds);
+            stats.workers.push_back(worker);
+        }
+#endif
+
+        return stats;
+    }
+
+    /**
+     * @brief Render one pass over all tiles on the pool, returning once every tile of the pass is done.
+     */
+    void RenderPass(const NMWorld& world, NMCanvas* image, ThreadPool& workers, std::size_t threadCount,
+                    const std::vector<SNMTile>& tiles, ENMRenderPass pass, std::size_t passIndex,
+                    NMRenderCountersArray& counters, NMWorkerSlotArray& workerSlots)
+    {
+        auto passStart = std::chrono::steady_clock::now();
+        uint64_t traceEnqueue = NMTrace::IsEnabled() ? NMTrace::Now() : 0;
+
+        // Each worker pulls tiles until none are left, so the queue only ever holds one task per thread
+        std::atomic<std::size_t> nextTile(0);
+        for (std::size_t i = 0; i < threadCount; ++i)
+        {
+            workers.Enqueue(
+                [this, &world, image, &tiles, pass, passIndex, &nextTile, &counters, &workerSlots, passStart,
+                 traceEnqueue, i]
+                {
+                    if (NMTrace::IsEnabled())
+                    {
+                        NMTrace::Record("QueueWait", "render", traceEnqueue, NMTrace::Now());
+                    }
+
+                    nmstop::CurrentToken() = &stopToken;
+
+#if NM_RENDER_STATS
+                    SNMWorkerSlot& slot = workerSlots[i];
+                    SNMWorkerStats& worker = slot.stats;
+                    auto taskStart = std::chrono::steady_clock::now();
+                    worker.queueWaitSeconds += std::chrono::duration<double>(taskStart - passStart).count();
+                    nmstats::CurrentCounters() = &counters[i];
+#else
+                    (void)counters;
+                    (void)workerSlots;
+                    (void)passStart;
+                    (void)i;
+#endif
+
+                    std::size_t item;
+                    while (!stopToken.IsStopRequested() && (item = nextTile++) < tiles.size())
+                    {
+                        NMTraceScope tileTrace("Tile", "render",
+                                               static_cast<int64_t>(passIndex * tiles.size() + item));
+                        const SNMTile& tile = tiles[item];
+#if NM_RENDER_STATS
+                        auto tileStart = std::chrono::steady_clock::now();
+                        RenderTile(world, image, tile, pass);
+                        double seconds =
+                            std::chrono::duration<double>(std::chrono::steady_clock::now() - tileStart).count();
+
+                        slot.tileTimes.push_back(SNMTileTime{tile.x, tile.y, seconds});
+                        worker.busySeconds += seconds;
+                        ++worker.tiles;
+#else
+                        RenderTile(world, image, tile, pass);
+#endif
+                    }
+
+                    nmstop::CurrentToken() = nullptr;
+#if NM_RENDER_STATS
+                    nmstats::CurrentCounters() = nullptr;
+#endif
+                });
+        }
+
+        workers.Wait();
+    }
+
+    static std::size_t ThreadCount(int64_t threadCount)
+    {
+        if (threadCount <= 0)
+        {
+            threadCount = std::thread::hardware_concurrency() + threadCount;
+        }
+
+        return static_cast<std::size_t>(threadCount);
+    }
+
+    /**
+     * @brief Shade every pixel of a tile into a worker-local buffer and write it to the image in one block.
+     */
+    void RenderTile(const NMWorld& world, NMCanvas* image, const SNMTile& tile, ENMRenderPass pass)
+    {
+        NMTileBuffer buffer(tile);
+        if (pass == ENMRenderPass::Reshade)
+        {
+            for (std::size_t y = 0; y < tile.height; ++y)
+            {
+                for (std::size_t x = 0; x < tile.width && !stopToken.IsStopRequested(); ++x)
+                {
+                    buffer.Set(x, y, gBuffer->Reshade(world, tile.x + x, tile.y + y));
+                }
+            }
+        }
+        else if (pass == ENMRenderPass::Disoccluded || pass == ENMRenderPass::Refine)
+        {
+            // Trace the pixels of the pass and keep the history's color for the others
+            ENMSampleState traced = pass == ENMRenderPass::Disoccluded ? ENMSampleState::Empty
+                                                                        : ENMSampleState::Reprojected;
+            bool changed = pass == ENMRenderPass::Disoccluded;
+            for (std::size_t y = 0; y < tile.height; ++y)
+            {
+                for (std::size_t x = 0; x < tile.width && !stopToken.IsStopRequested(); ++x)
+                {
+                    std::size_t px = tile.x + x;
+                    std::size_t py = tile.y + y;
+                    if (frameHistory->GetState(px, py) == traced)
+                    {
+                        buffer.Set(x, y, ColorForPixel(world, px, py, nullptr));
+                        changed = true;
+                    }
+                    else
+                    {
+                        buffer.Set(x, y, frameHistory->GetColor(px, py));
+                    }
+                }
+            }
+
+            if (!changed)
+            {
+                return;
+            }
+        }
+        else if (costMap)
+        {
+            RenderTileWithCost(world, buffer, tile);
+        }
+        else
+        {
+            for (std::size_t y = 0; y < tile.height; ++y)
+            {
+                for (std::size_t x = 0; x < tile.width && !stopToken.IsStopRequested(); ++x)
+                {
+                    buffer.Set(x, y, ColorForPixel(world, tile.x + x, tile.y + y, gBuffer));
+                }
+            }
+        }
+
+        // A stopped tile may hold unshaded pixels and colors with missing bounces, the canvas keeps the old ones
+        if (stopToken.IsStopRequested())
+        {
+            return;
+        }
+
+        buffer.FlushTo(*image);
+    }
+
+    /**
+     * @brief Trace the primary ray of a pixel, caching its hit in the G-buffer and the frame history when set.
+     */
+    inline NMColor ColorForPixel(const NMWorld& world, std::size_t px, std::size_t py, NMGBuffer* cache)
+    {
+        NMRay ray = RayForPixel(px, py);
+        nmstats::CountRay(ENMRayType::Primary);
+
+        if (!cache && !frameHistory)
+        {
+            return world.ColorAt(ray);
+        }
+
+        NMColor color;
+        float distance = std::numeric_limits<float>::infinity();
+        if (cache)
+        {
+            color = cache->Record(world, ray, px, py);
+            const SNMGBufferSample& sample = cache->At(px, py);
+            distance = sample.state.object ? sample.state.t : distance;
+        }
+        else
+        {
+            color = world.ColorAndDistanceAt(ray, distance);
+        }
+
+        // Only complete colors become Traced, a stopped pixel is traced again by the next frame
+        if (frameHistory && !stopToken.IsStopRequested())
+        {
+            frameHistory->Store(px, py, color, ray, distance);
+        }
+
+        return color;
+    }
+
+    /**
+     * @brief The instrumented variant of the RenderTile loop, measuring every pixel into the cost map.
+     */
+    void RenderTileWithCost(const NMWorld& world, NMTileBuffer& buffer, const SNMTile& tile)
+    {
+        for (std::size_t y = 0; y < tile.height; ++y)
+        {
+            for (std::size_t x = 0; x < tile.width && !stopToken.IsStopRequested(); ++x)
+            {
+                uint64_t begin = costMap->Begin();
+                buffer.Set(x, y, ColorForPixel(world, tile.x + x, tile.y + y, gBuffer));
+
+                costMap->Write(tile.x + x, tile.y + y, costMap->End(begin));
+            }
+        }
+    }
 
     void UpdatePixelSize()
     {
@@ -1,9 +1,11 @@
 #pragma once
 
+#include <cstdint>
 #include <sstream>
 #include <string>
 #include <vector>
 
+#include "AlignedAllocator.hpp"
 #include "Color.hpp"
 
 #define DEFAULT_COLOR NMColor()
@@ -11,19 +13,37 @@
 constexpr std::size_t DEFAULT_CANVAS_WIDTH = 10;
 constexpr std::size_t DEFAULT_CANVAS_HEIGHT = 10;
 
+constexpr std::size_t CANVAS_TILE_SIZE = 8;
+constexpr std::size_t CANVAS_TILE_AREA = CANVAS_TILE_SIZE * CANVAS_TILE_SIZE;
+
+/**
+ * @brief The order pixels are stored in memory.
+ * Linear is row-major. Tiled stores the image as CANVAS_TILE_SIZE square blocks (each block row-major, blocks
+ * row-major) so that 2D neighbourhoods share cache lines and pages.
+ */
+enum class ENMCanvasLayout
+{
+    Linear,
+    Tiled
+};
+
 class NMCanvas
 {
 public:
 
     NMCanvas() : NMCanvas(DEFAULT_CANVAS_WIDTH, DEFAULT_CANVAS_HEIGHT) {}
-    NMCanvas(std::size_t width, std::size_t height, const NMColor& color = DEFAULT_COLOR)
-        : width(width), height(height), pixels(width * height, color), defaultColor(color)
+    NMCanvas(std::size_t width, std::size_t height, const NMColor& color = DEFAULT_COLOR,
+             ENMCanvasLayout layout = ENMCanvasLayout::Linear)
+        : width(width), height(height), layout(layout), defaultColor(color)
     {
+        pixels.resize(StorageSize(), color);
     }
 
     inline std::size_t GetWidth() const { return width; }
     inline std::size_t GetHeight() const { return height; }
 
+    inline ENMCanvasLayout GetLayout() const { return layout; }
+
     inline bool IsSize(std::size_t width, std::size_t height) const
     {
         return this->width == width && this->height == height;
@@ -38,9 +58,14 @@ public:
 
         this->width = width;
         this->height = height;
-        pixels.resize(width * height, defaultColor);
+        pixels.resize(StorageSize(), defaultColor);
     }
 
+    /**
+     * @brief Change the memory layout of the canvas, keeping the image contents.
+     */
+    void SetLayout(ENMCanvasLayout newLayout);
+
     inline const NMColor& ReadPixel(std::size_t x, std::size_t y) const
     {
         // if x or y is out of bounds, return the default color
@@ -50,7 +75,7 @@ public:
             return color;
         }
 
-        return pixels[y * width + x];
+        return pixels[PixelIndex(x, y)];
     }
 
     inline void WritePixel(std::size_t x, std::size_t y, const NMColor& color)
@@ -60,9 +85,46 @@ public:
             return;
         }
 
-        pixels[y * width + x] = color;
+        pixels[PixelIndex(x, y)] = color;
     }
 
+    /**
+     * @brief Copy a row-major block of blockWidth * blockHeight colors into the canvas at (x, y).
+     * Rows of the block are stride colors apart (0 = blockWidth). Parts of the block outside of the canvas are
+     * skipped. Blocks aligned to CANVAS_TILE_SIZE on a tiled canvas are copied as whole tiles, so threads writing
+     * separate aligned blocks never touch the same cache line.
+     */
+    void WriteBlock(std::size_t x, std::size_t y, std::size_t blockWidth, std::size_t blockHeight,
+                    const NMColor* block, std::size_t stride = 0);
+
+    /**
+     * @brief Sample the canvas at a fractional pixel position using bilinear interpolation.
+     * Samples outside of the canvas read as the default color.
+     */
+    NMColor SampleBilinear(float x, float y) const;
+
+    /**
+     * @brief Copy the image into a row-major buffer of GetWidth() * GetHeight() colors.
+     */
+    void ToLinear(NMColor* out) const;
+    inline std::vector<NMColor> ToLinear() const
+    {
+        std::vector<NMColor> out(width * height);
+        ToLinear(out.data());
+        return out;
+    }
+
+    /**
+     * @brief Replace the image with a row-major buffer of GetWidth() * GetHeight() colors.
+     */
+    void FromLinear(const NMColor* in);
+
+    /**
+     * @brief A 64-bit FNV-1a hash of the exact bits of every pixel in row-major order, independent of the layout.
+     * Two canvases hash equal only if they are bitwise identical (up to hash collisions).
+     */
+    uint64_t Hash() const;
+
     void Clear(const NMColor& color = DEFAULT_COLOR) { std::fill(pixels.begin(), pixels.end(), color); }
 
     std::ostream& ToPPM(std::ostream& os) const;
@@ -77,7 +139,33 @@ protected:
 
     std::size_t width;
     std::size_t height;
-    std::vector<NMColor> pixels;
+    ENMCanvasLayout layout;
+    std::vector<NMColor, NMAlignedAllocator<NMColor>> pixels;
 
     NMColor defaultColor;
+
+    inline std::size_t TileColumns() const { return (width + CANVAS_TILE_SIZE - 1) / CANVAS_TILE_SIZE; }
+    inline std::size_t TileRows() const { return (height + CANVAS_TILE_SIZE - 1) / CANVAS_TILE_SIZE; }
+
+    inline std::size_t StorageSize() const
+    {
+        if (layout == ENMCanvasLayout::Linear)
+        {
+            return width * height;
+        }
+
+        // Tiled storage is padded out to whole tiles so every tile is a contiguous block
+        return TileColumns() * TileRows() * CANVAS_TILE_AREA;
+    }
+
+    inline std::size_t PixelIndex(std::size_t x, std::size_t y) const
+    {
+        if (layout == ENMCanvasLayout::Linear)
+        {
+            return y * width + x;
+        }
+
+        std::size_t tile = (y / CANVAS_TILE_SIZE) * TileColumns() + (x / CANVAS_TILE_SIZE);
+        return tile * CANVAS_TILE_AREA + (y % CANVAS_TILE_SIZE) * CANVAS_TILE_SIZE + (x % CANVAS_TILE_SIZE);
+    }
 };
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#    include <intrin.h>
+#    define NM_HAS_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#    include <x86intrin.h>
+#    define NM_HAS_TSC 1
+#else
+#    define NM_HAS_TSC 0
+#endif
+
+#include "Canvas.hpp"
+#include "RenderStats.hpp"
+
+/**
+ * @brief What a cost map measures for every pixel.
+ */
+enum class ENMCostMetric : uint8_t
+{
+    /**
+     * @brief Time spent shading the pixel, in TSC cycles (nanoseconds where no TSC is available).
+     */
+    Time = 0,
+
+    /**
+     * @brief Rays of every type traced for the pixel. Requires NM_RENDER_STATS.
+     */
+    Rays,
+
+    /**
+     * @brief Primitive intersection tests done for the pixel. Requires NM_RENDER_STATS.
+     */
+    IntersectionTests,
+};
+
+namespace nmprofile
+{
+/**
+ * @brief A cheap, monotonic per-core timestamp for measuring short spans on one thread.
+ */
+inline uint64_t ReadTimestamp()
+{
+#if NM_HAS_TSC
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+#endif
+}
+}  // namespace nmprofile
+
+/**
+ * @brief A per-pixel cost buffer filled by NMCamera::Render when set with NMCamera::SetCostMap().
+ * Every render tile writes only its own pixels, so workers fill the map without synchronization.
+ */
+class NMCostMap
+{
+public:
+
+    NMCostMap(std::size_t width, std::size_t height, ENMCostMetric metric = ENMCostMetric::Time)
+        : width(width), height(height), metric(metric), costs(width * height, 0.0f)
+    {
+    }
+
+    inline std::size_t GetWidth() const { return width; }
+    inline std::size_t GetHeight() const { return height; }
+
+    inline ENMCostMetric GetMetric() const { return metric; }
+    inline void SetMetric(ENMCostMetric newMetric) { metric = newMetric; }
+
+    /**
+     * @brief Resize the map, clearing it if the size changes.
+     */
+    void Resize(std::size_t newWidth, std::size_t newHeight)
+    {
+        if (width == newWidth && height == newHeight)
+        {
+            return;
+        }
+
+        width = newWidth;
+        height = newHeight;
+        costs.assign(width * height, 0.0f);
+    }
+
+    inline void Clear() { std::fill(costs.begin(), costs.end(), 0.0f); }
+
+    inline float Read(std::size_t x, std::size_t y) const
+    {
+        if (x >= width || y >= height)
+        {
+            return 0.0f;
+        }
+
+        return costs[y * width + x];
+    }
+
+    inline void Write(std::size_t x, std::size_t y, float cost)
+    {
+        if (x >= width || y >= height)
+        {
+            return;
+        }
+
+        costs[y * width + x] = cost;
+    }
+
+    float Max() const;
+    double Total() const;
+
+    /**
+     * @brief Read the map's metric before shading a pixel, End() then returns the pixel's cost.
+     */
+    inline uint64_t Begin() const
+    {
+        if (metric == ENMCostMetric::Time)
+        {
+            return nmprofile::ReadTimestamp();
+        }
+
+        return CounterValue();
+    }
+
+    inline float End(uint64_t begin) const
+    {
+        uint64_t end = metric == ENMCostMetric::Time ? nmprofile::ReadTimestamp() : CounterValue();
+        return end > begin ? static_cast<float>(end - begin) : 0.0f;
+    }
+
+    /**
+     * @brief The cost below which the given fraction of pixels lie.
+     */
+    float Percentile(float fraction) const;
+
+    /**
+     * @brief Render the map as a false-color image, from black (no cost) over purple, red and orange to white.
+     * @param scale The cost mapped to white, 0 = the 99th percentile cost so a few outliers (e.g. a preempted
+     *              thread) do not wash out the image. Pass the same scale to compare maps.
+     */
+    NMCanvas ToFalseColor(float scale = 0.0f) const;
+
+    /**
+     * @brief Whether the metric can be measured in this build.
+     */
+    static bool IsMetricAvailable(ENMCostMetric metric);
+
+    /**
+     * @brief Parse "time", "rays" or "tests".
+     * @throws std::runtime_error for any other name.
+     */
+    static ENMCostMetric ParseMetric(const std::string& name);
+
+protected:
+
+    std::size_t width;
+    std::size_t height;
+    ENMCostMetric metric;
+    std::vector<float> costs;
+
+    inline uint64_t CounterValue() const
+    {
+        const SNMRenderCounters* counters = nmstats::CurrentCounters();
+        if (!counters)
+        {
+            return 0;
+        }
+
+        if (metric == ENMCostMetric::IntersectionTests)
+        {
+            return counters->intersectionTests;
+        }
+
+        uint64_t rays = 0;
+        for (uint64_t count : counters->rays)
+        {
+            rays += count;
+        }
+
+        return rays;
+    }
+};
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "Color.hpp"
+#include "NMM/Matrix.hpp"
+#include "NMM/Point.hpp"
+#include "RT/Ray.hpp"
+
+/**
+ * @brief How current the color of a pixel in the frame history is.
+ */
+enum class ENMSampleState : uint8_t
+{
+    /**
+     * @brief Nothing is known about the pixel, e.g. it was disoccluded by the last camera move.
+     */
+    Empty = 0,
+
+    /**
+     * @brief The color was carried over from an earlier view and is only approximate (specular highlights and
+     *        reflections depend on the view).
+     */
+    Reprojected,
+
+    /**
+     * @brief The color was traced for the current view.
+     */
+    Traced,
+};
+
+/**
+ * @brief The color and primary hit point of every pixel of the previous frame, kept for temporal reprojection.
+ * Filled by NMCamera::Render and NMCamera::Reproject when set with NMCamera::SetFrameHistory().
+ *
+ * When the camera moves, Reproject() splats the known hit points of the previous view into the new one (nearest
+ * sample wins), so the camera only has to trace the pixels no sample landed on before refining the rest.
+ * Primary rays that missed are carried over by their direction. The history assumes a static world: call Invalidate()
+ * after changing objects, materials or lights.
+ *
+ * Every render tile reads and writes only its own pixels and a pass starts once the previous one finished, so
+ * workers update the history without synchronization.
+ */
+class NMFrameHistory
+{
+public:
+
+    NMFrameHistory() = default;
+
+    inline std::size_t GetWidth() const { return width; }
+    inline std::size_t GetHeight() const { return height; }
+
+    inline ENMSampleState GetState(std::size_t x, std::size_t y) const { return states[y * width + x]; }
+    inline const NMColor& GetColor(std::size_t x, std::size_t y) const { return colors[y * width + x]; }
+
+    /**
+     * @brief The distance along the primary ray to the first hit, infinity if the ray missed.
+     */
+    inline float GetDepth(std::size_t x, std::size_t y) const { return depths[y * width + x]; }
+
+    /**
+     * @brief The number of pixels in a state.
+     */
+    std::size_t Count(ENMSampleState state) const;
+
+    /**
+     * @brief Whether the history holds samples for a camera of the given size.
+     */
+    inline bool Matches(std::size_t cameraWidth, std::size_t cameraHeight) const
+    {
+        return cameraWidth == width && cameraHeight == height;
+    }
+
+    /**
+     * @brief Forget every sample, e.g. after the world changed.
+     */
+    void Invalidate();
+
+    /**
+     * @brief Start a history for a new view, resizing it and forgetting every sample.
+     */
+    void Reset(std::size_t cameraWidth, std::size_t cameraHeight, const NMMatrix& cameraTransform);
+
+    /**
+     * @brief Move the samples into a new view.
+     * Samples that stay in view become Reprojected, or stay Traced if the view did not change; all other pixels are
+     * Empty. The camera parameters are the ones NMCamera::RayForPixel uses.
+     */
+    void Reproject(const NMMatrix& cameraTransform, float halfWidth, float halfHeight, float pixelSize);
+
+    /**
+     * @brief Store a traced pixel.
+     * @param ray The primary ray of the pixel.
+     * @param depth The distance to the first hit along the ray, infinity if the ray missed.
+     */
+    inline void Store(std::size_t x, std::size_t y, const NMColor& color, const NMRay& ray, float depth)
+    {
+        std::size_t index = y * width + x;
+        states[index] = ENMSampleState::Traced;
+        colors[index] = color;
+        depths[index] = depth;
+
+        // Misses keep a point one unit along the ray, which is enough to find their direction again
+        points[index] = ray.Position(depth < std::numeric_limits<float>::infinity() ? depth : 1.0f);
+    }
+
+protected:
+
+    std::size_t width = 0;
+    std::size_t height = 0;
+
+    // The view the samples belong to
+    NMMatrix transform = NMMatrix::Identity4x4();
+    NMPoint origin = NMPoint();
+
+    std::vector<ENMSampleState> states;
+    std::vector<NMColor> colors;
+    std::vector<NMPoint> points;
+    std::vector<float> depths;
+
+    // Scratch buffers of Reproject(), kept to avoid allocating every frame
+    std::vector<ENMSampleState> nextStates;
+    std::vector<NMColor> nextColors;
+    std::vector<NMPoint> nextPoints;
+    std::vector<float> nextDepths;
+};
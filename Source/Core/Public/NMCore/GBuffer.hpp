@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "NMM/Matrix.hpp"
+#include "NMM/Point.hpp"
+#include "RT/IntersectionState.hpp"
+#include "RT/Ray.hpp"
+#include "World.hpp"
+
+/**
+ * @brief The cached first hit of one pixel.
+ */
+struct SNMGBufferSample
+{
+    /**
+     * @brief The hit of the primary ray, state.object is nullptr if the ray missed.
+     */
+    SNMIntersectionState state;
+
+    /**
+     * @brief Whether the hit was in shadow of the world's shadow casting light.
+     */
+    bool isShadowed = false;
+};
+
+/**
+ * @brief A per-pixel cache of primary ray hits filled by NMCamera::Render when set with NMCamera::SetGBuffer().
+ *
+ * NMCamera::Reshade() re-lights the cached hits instead of tracing primary rays again, for look development where only
+ * materials or lights change. Materials and light colors are read anew on every reshade, shadow rays are only traced
+ * again when the shadow casting light (the world's first light, see NMWorld::IsShadowed()) has moved, and
+ * reflections are always traced again from the cached hits.
+ *
+ * The buffer remembers the camera, the objects and the geometry revision (see NMWorld::GetGeometryRevision()) it was
+ * filled with and is invalid as soon as the camera or the objects of the world change, or any of its primitives,
+ * e.g. a child of a group, is moved. Every render tile writes only its own pixels, so workers fill and reshade the
+ * buffer without synchronization.
+ */
+class NMGBuffer
+{
+public:
+
+    NMGBuffer() = default;
+
+    inline std::size_t GetWidth() const { return width; }
+    inline std::size_t GetHeight() const { return height; }
+
+    inline const SNMGBufferSample& At(std::size_t x, std::size_t y) const { return samples[y * width + x]; }
+
+    /**
+     * @brief Whether the buffer holds a complete frame.
+     */
+    inline bool IsValid() const { return valid; }
+    inline void Invalidate() { valid = false; }
+
+    /**
+     * @brief Whether the buffer holds a complete frame of the world seen through the given camera.
+     * Compares the camera, the world's objects and the geometry revision with the ones the buffer was filled with.
+     */
+    bool IsValidFor(const NMWorld& world, std::size_t cameraWidth, std::size_t cameraHeight, float cameraFov,
+                    const NMMatrix& cameraTransform) const;
+
+    /**
+     * @brief Prepare the buffer to be filled by a render of the world through the given camera.
+     * The buffer stays invalid until Finish() is called.
+     */
+    void Begin(const NMWorld& world, std::size_t cameraWidth, std::size_t cameraHeight, float cameraFov,
+               const NMMatrix& cameraTransform);
+
+    /**
+     * @brief Mark a render as finished. An interrupted render leaves the buffer invalid.
+     */
+    inline void Finish(bool complete) { valid = complete; }
+
+    /**
+     * @brief Prepare a reshade of the world, deciding whether the cached shadows are still valid.
+     */
+    void BeginReshade(const NMWorld& world);
+
+    /**
+     * @brief Trace a primary ray, cache its hit and return the shaded color, equal to NMWorld::ColorAt().
+     */
+    NMColor Record(const NMWorld& world, const NMRay& ray, std::size_t x, std::size_t y)
+    {
+        SNMGBufferSample& sample = samples[y * width + x];
+
+        SNMIntersectionList intersections = world.Intersect(ray);
+        SNMIntersection* intersection = intersections.Hit();
+        if (intersection == nullptr)
+        {
+            sample = SNMGBufferSample();
+            return NMColor(0.0f, 0.0f, 0.0f);
+        }
+
+        sample.state = SNMIntersectionState(*intersection, ray);
+        sample.isShadowed = world.IsShadowed(sample.state.overPoint);
+
+        return Shade(world, sample);
+    }
+
+    /**
+     * @brief Shade a cached hit again with the current materials and lights of the world.
+     */
+    NMColor Reshade(const NMWorld& world, std::size_t x, std::size_t y)
+    {
+        SNMGBufferSample& sample = samples[y * width + x];
+        if (sample.state.object == nullptr)
+        {
+            return NMColor(0.0f, 0.0f, 0.0f);
+        }
+
+        if (retestShadows)
+        {
+            sample.isShadowed = world.IsShadowed(sample.state.overPoint);
+        }
+
+        return Shade(world, sample);
+    }
+
+protected:
+
+    std::size_t width = 0;
+    std::size_t height = 0;
+    std::vector<SNMGBufferSample> samples;
+    bool valid = false;
+
+    // What the buffer was filled with
+    std::size_t cameraWidth = 0;
+    std::size_t cameraHeight = 0;
+    float cameraFov = 0.0f;
+    NMMatrix cameraTransform = NMMatrix::Identity4x4();
+    std::vector<const NMPrimitiveBase*> objects;
+    uint64_t geometryRevision = 0;
+
+    NMPoint shadowLightPosition = NMPoint();
+    bool retestShadows = false;
+
+    inline NMColor Shade(const NMWorld& world, const SNMGBufferSample& sample) const
+    {
+        return world.ShadeSurface(sample.state, sample.isShadowed)
+               + world.ReflectedColor(sample.state, world.GetSettings().ReflectionTraceDepth);
+    }
+
+    static NMPoint ShadowLightPosition(const NMWorld& world);
+};
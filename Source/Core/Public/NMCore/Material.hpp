@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <memory>
 
 #include "Color.hpp"
@@ -76,21 +77,43 @@ public:
         pattern = std::make_shared<T>(std::forward<Args>(args)...);
     }
 
+    /**
+     * @brief The color of the surface at a point, from the pattern if the material has one.
+     * @param footprint The width of the ray at the point, for patterns that filter (see
+     *        NMPatternBase::ColorAtFiltered).
+     */
+    inline NMColor SurfaceColor(const NMPrimitiveBase &object, const NMPoint &point, float footprint = 0.0f) const
+    {
+        return pattern ? pattern->ColorAtShapePoint(object, point, footprint) : color;
+    }
+
+    /**
+     * @param footprint The width of the ray at the point, for patterns that filter (see
+     *        NMPatternBase::ColorAtFiltered).
+     */
     NMColor Lighting(const NMPrimitiveBase &object, const NMPointLight &light, const NMPoint &point,
-                     const NMVector &eyeVector, const NMVector &normalVector, bool inShadow) const
+                     const NMVector &eyeVector, const NMVector &normalVector, bool inShadow,
+                     float footprint = 0.0f) const
     {
-        // If the material has a pattern, use the pattern color instead of the material's color
-        NMColor materialColor = pattern ? pattern->ColorAtShapePoint(object, point) : color;
+        return Lighting(SurfaceColor(object, point, footprint), light, point, eyeVector, normalVector, inShadow);
+    }
 
+    /**
+     * @brief The Phong lighting of a point whose surface color is already known, so hits lit by several lights look
+     * their pattern up once (see NMWorld::ShadeSurface).
+     */
+    NMColor Lighting(const NMColor &surfaceColor, const NMPointLight &light, const NMPoint &point,
+                     const NMVector &eyeVector, const NMVector &normalVector, bool inShadow) const
+    {
         // Combine the surface color with the light's color/intensity
-        NMColor effectiveColor = materialColor * light.GetColor();
-
-        // Find the direction to the light source
-        NMVector lightVector = (light.GetPosition() - point).Normalized();
+        NMColor effectiveColor = surfaceColor * light.GetColor();
 
         // Compute the ambient contribution
         NMColor ambientColor = effectiveColor * ambient;
 
+        // Find the direction to the light source
+        NMVector lightVector = (light.GetPosition() - point).Normalized();
+
         // LightDotNormal represents the cosine of the angle between the
         // light vector and the normal vector. A negative number means the
         // light is on the other side of the surface.
@@ -105,16 +128,18 @@ public:
 
         // ReflectDotEye represents the cosine of the angle between the
         // reflection vector and the eye vector. A negative number means the
-        // light reflects away from the eye.
-        NMVector reflectVector = (-lightVector).Reflect(normalVector);
-        float reflectDotEye = reflectVector.DotProduct(eyeVector);
+        // light reflects away from the eye. The reflection of the light
+        // vector is 2 (l.n) n - l, so its dot product with the eye needs no
+        // vector of its own.
+        float reflectDotEye = 2.0f * lightDotNormal * normalVector.DotProduct(eyeVector)
+                              - lightVector.DotProduct(eyeVector);
         if (reflectDotEye <= 0)
         {
             return ambientColor + diffuseColor;
         }
 
         // Compute the specular contribution
-        float factor = static_cast<float>(pow(reflectDotEye, shininess));
+        float factor = nmmath::FastPow(std::min(reflectDotEye, 1.0f), shininess);
         NMColor specularColor = light.GetColor() * specular * factor;
 
         return ambientColor + diffuseColor + specularColor;
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "NMCore/Pattern/PatternBase.hpp"
+
+enum class ENMPatternOpcode : uint8_t
+{
+    // Push a constant color
+    Solid = 0,
+
+    // Pick one of two children by the current point, like the pattern of the same name
+    Stripe,
+    Ring,
+    Checker,
+
+    // Mix two children by a weight: the fraction along x, fractal noise at the point, or a constant
+    Gradient,
+    Noise,
+    Blend,
+
+    // Push a modified copy of the current point for the children that follow, up to the matching PopPoint
+    Transform,
+    Perturb,
+    PopPoint,
+
+    // Continue at another instruction, skipping the child a selector did not pick
+    Jump,
+};
+
+/**
+ * @brief A node of a composite pattern, built with the static functions and compiled by NMCompositePattern.
+ * Children are patterns themselves, so stripes can alternate between checkers, rings can blend noise and so on.
+ */
+struct SNMPatternNode
+{
+    ENMPatternOpcode opcode = ENMPatternOpcode::Solid;
+    NMColor color;
+    float arguments[2] = {0.0f, 0.0f};
+    NMMatrix transform = NMMatrix::Identity4x4();
+    std::vector<SNMPatternNode> children;
+
+    static SNMPatternNode Solid(const NMColor& color);
+
+    static SNMPatternNode Stripe(SNMPatternNode a, SNMPatternNode b);
+    static SNMPatternNode Ring(SNMPatternNode a, SNMPatternNode b);
+    static SNMPatternNode Checker(SNMPatternNode a, SNMPatternNode b);
+    static SNMPatternNode Gradient(SNMPatternNode a, SNMPatternNode b);
+
+    /**
+     * @brief Mix the children by fractal noise, mostly a where the noise is low and mostly b where it is high.
+     * @param frequency The number of noise cells per unit.
+     * @param octaves The number of octaves of noise, each adding finer detail.
+     */
+    static SNMPatternNode Noise(SNMPatternNode a, SNMPatternNode b, float frequency = 1.0f, uint32_t octaves = 1);
+
+    /**
+     * @param weight The share of b in the result, 0 for a alone and 1 for b alone.
+     */
+    static SNMPatternNode Blend(SNMPatternNode a, SNMPatternNode b, float weight = 0.5f);
+
+    /**
+     * @brief The child with its own pattern transform, applied on top of the transforms of its parents.
+     */
+    static SNMPatternNode Transform(SNMPatternNode child, const NMMatrix& transform);
+
+    /**
+     * @brief Jitter the points the child is evaluated at by Perlin noise, e.g. to make stripes wavy like marble.
+     * @param scale The largest distance a point is moved.
+     * @param frequency The number of noise cells per unit.
+     */
+    static SNMPatternNode Perturb(SNMPatternNode child, float scale, float frequency = 1.0f);
+};
+
+struct SNMPatternInstruction
+{
+    ENMPatternOpcode opcode;
+
+    // Selectors and mixes whose children are both solid carry the two colors instead of code for the children
+    bool inlineColors;
+
+    // The instruction to continue at for selectors picking b and for Jump, the matrix of Transform
+    uint32_t target;
+
+    float arguments[2];
+    NMColor colorA;
+    NMColor colorB;
+};
+
+/**
+ * @brief A pattern made of nested, blended and perturbed patterns and noise.
+ *
+ * The node tree is compiled into a flat program once, when the pattern is created, which ColorAt() runs over two
+ * small fixed size stacks, the colors and the points modified by Transform and Perturb; evaluating a node is a switch
+ * case rather than a virtual call per child. Mixes are postfix, while selectors come before their children and jump
+ * over the one they do not pick, so only one side of a stripe is evaluated. Compiling precomputes the inverse of every
+ * transform, merging nested ones into one matrix, and folds constant subtrees: blends of solid colors become one
+ * color and selectors of solid colors carry both inline.
+ *
+ * The pattern's own transform is the usual NMPatternBase one, applied by ColorAtShapePoint().
+ */
+class NMCompositePattern : public NMPatternBase
+{
+public:
+
+    /**
+     * @throws std::runtime_error if the tree nests deeper than MAX_STACK_DEPTH or a node has the wrong children.
+     */
+    explicit NMCompositePattern(const SNMPatternNode& root, const NMMatrix& transform = NMMatrix::Identity4x4());
+
+    virtual ~NMCompositePattern() = default;
+
+    virtual NMColor ColorAt(const NMPoint& point) const override;
+
+    inline const std::vector<SNMPatternInstruction>& GetProgram() const { return program; }
+
+    static constexpr uint32_t MAX_STACK_DEPTH = 16;
+
+protected:
+
+    std::vector<SNMPatternInstruction> program;
+
+    // The inverse transforms of the Transform instructions, the top three rows
+    std::vector<float> transforms;
+};
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+namespace nmnoise
+{
+/**
+ * @brief Ken Perlin's improved gradient noise, roughly in [-1, 1] and 0 at every integer lattice point.
+ * The permutation is the reference one, so the noise is the same on every run and platform.
+ */
+float Perlin(float x, float y, float z);
+
+/**
+ * @brief The sum of octaves of Perlin noise, each at twice the frequency and half the amplitude of the one before,
+ * divided by the total amplitude so the result stays in the range of a single octave.
+ */
+float Fractal(float x, float y, float z, uint32_t octaves);
+}  // namespace nmnoise
@@ -10,16 +10,41 @@ class NMPatternBase
 {
 public:
 
-    NMPatternBase(const NMMatrix& transform = NMMatrix::Identity4x4()) : transform(transform){};
+    NMPatternBase(const NMMatrix& transform = NMMatrix::Identity4x4())
+        : transform(transform), inverseTransform(transform.Inverse()){};
     virtual ~NMPatternBase() = default;
 
     virtual NMColor ColorAt(const NMPoint& point) const = 0;
-    NMColor ColorAtShapePoint(const NMPrimitiveBase& shape, const NMPoint& point) const;
+
+    /**
+     * @brief The color averaged over a footprint around the point, for patterns that can filter (e.g. textures).
+     * @param footprint The width of the area to average, in pattern space.
+     */
+    virtual NMColor ColorAtFiltered(const NMPoint& point, float /* footprint */) const { return ColorAt(point); }
+
+    /**
+     * @param footprint The width of the area to average in world space, 0 for none. It is scaled into pattern space
+     *        by the shape's and the pattern's transforms.
+     */
+    NMColor ColorAtShapePoint(const NMPrimitiveBase& shape, const NMPoint& point, float footprint = 0.0f) const;
 
     inline const NMMatrix& GetTransform() const { return transform; }
-    inline virtual void SetTransform(const NMMatrix& newTransform) { transform = newTransform; }
+    inline virtual void SetTransform(const NMMatrix& newTransform)
+    {
+        transform = newTransform;
+        inverseTransform = newTransform.Inverse();
+    }
+
+    inline virtual void SetTransform(const NMMatrix& newTransform, const NMMatrix& newInverseTransform)
+    {
+        transform = newTransform;
+        inverseTransform = newInverseTransform;
+    }
+
+    inline const NMMatrix& GetInverseTransform() const { return inverseTransform; }
 
 protected:
 
     NMMatrix transform;
+    NMMatrix inverseTransform;
 };
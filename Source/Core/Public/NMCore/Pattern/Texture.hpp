@@ -0,0 +1,51 @@
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+
+#include "NMCore/Pattern/PatternBase.hpp"
+#include "NMCore/Pattern/UVMapping.hpp"
+#include "NMCore/Texture.hpp"
+
+/**
+ * @brief An image wrapped onto the pattern space by a UV mapping.
+ * Unfiltered lookups sample the full resolution bilinearly; filtered lookups pick the mip level matching the
+ * footprint and filter trilinearly. Any number of patterns can share a texture.
+ */
+class NMTexturePattern : public NMPatternBase
+{
+public:
+
+    /**
+     * @throws std::runtime_error if texture is null.
+     */
+    NMTexturePattern(std::shared_ptr<const NMTextureBase> texture, ENMUVMapping mapping = ENMUVMapping::Planar,
+                     const NMMatrix& transform = NMMatrix::Identity4x4())
+        : NMPatternBase(transform), texture(std::move(texture)), mapping(mapping)
+    {
+        if (!this->texture)
+        {
+            throw std::runtime_error("Texture pattern needs a texture");
+        }
+    }
+
+    inline const std::shared_ptr<const NMTextureBase>& GetTexture() const { return texture; }
+    inline ENMUVMapping GetMapping() const { return mapping; }
+
+    virtual NMColor ColorAt(const NMPoint& point) const override
+    {
+        SNMUV uv = nmuv::Map(mapping, point);
+        return texture->SampleBilinear(uv.u, uv.v);
+    }
+
+    virtual NMColor ColorAtFiltered(const NMPoint& point, float footprint) const override
+    {
+        SNMUV uv = nmuv::Map(mapping, point);
+        return texture->SampleTrilinear(uv.u, uv.v, texture->LevelOfDetail(footprint / nmuv::TextureSpan(mapping)));
+    }
+
+protected:
+
+    std::shared_ptr<const NMTextureBase> texture;
+    ENMUVMapping mapping;
+};
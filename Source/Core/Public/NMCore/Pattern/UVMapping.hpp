@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+#include "NMM/Point.hpp"
+#include "NMM/Util.hpp"
+
+/**
+ * @brief How a point in pattern space is wrapped onto the unit square of a texture.
+ */
+enum class ENMUVMapping : uint8_t
+{
+    /**
+     * @brief The xz plane, repeating every unit along x and z.
+     */
+    Planar = 0,
+
+    /**
+     * @brief Longitude and latitude around the origin, for unit spheres.
+     */
+    Spherical,
+
+    /**
+     * @brief The angle around the y axis and the height, repeating every unit along y, for unit cylinders.
+     */
+    Cylindrical,
+};
+
+struct SNMUV
+{
+    float u;
+    float v;
+};
+
+namespace nmuv
+{
+// The fractional part, also for negative values
+inline float Wrap(float value) { return value - std::floor(value); }
+
+inline SNMUV Planar(const NMPoint& point) { return {Wrap(point.GetX()), Wrap(point.GetZ())}; }
+
+inline SNMUV Spherical(const NMPoint& point)
+{
+    float theta = std::atan2(point.GetX(), point.GetZ());
+    float radius = std::sqrt(point.GetX() * point.GetX() + point.GetY() * point.GetY() + point.GetZ() * point.GetZ());
+    float phi = radius > 0.0f ? std::acos(nmmath::Clamp(point.GetY() / radius, -1.0f, 1.0f)) : 0.0f;
+
+    return {1.0f - (theta / (2.0f * nmmath::pi) + 0.5f), 1.0f - phi / nmmath::pi};
+}
+
+inline SNMUV Cylindrical(const NMPoint& point)
+{
+    float theta = std::atan2(point.GetX(), point.GetZ());
+    return {1.0f - (theta / (2.0f * nmmath::pi) + 0.5f), Wrap(point.GetY())};
+}
+
+inline SNMUV Map(ENMUVMapping mapping, const NMPoint& point)
+{
+    switch (mapping)
+    {
+        case ENMUVMapping::Spherical:
+            return Spherical(point);
+        case ENMUVMapping::Cylindrical:
+            return Cylindrical(point);
+        case ENMUVMapping::Planar:
+            break;
+    }
+
+    return Planar(point);
+}
+
+/**
+ * @brief The length in pattern space that one texture width spans, at the widest (the equator of a sphere).
+ * A footprint divided by it is a fraction of the texture.
+ */
+inline float TextureSpan(ENMUVMapping mapping) { return mapping == ENMUVMapping::Planar ? 1.0f : 2.0f * nmmath::pi; }
+}  // namespace nmuv
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "NMCore/Primitive/PrimitiveBase.hpp"
+
+enum class ENMCSGOperation : uint8_t
+{
+    /**
+     * @brief Everything inside either operand.
+     */
+    Union = 0,
+
+    /**
+     * @brief Only what is inside both operands.
+     */
+    Intersection,
+
+    /**
+     * @brief What is inside the left operand but not the right one, i.e. the right operand cut out of the left.
+     */
+    Difference,
+};
+
+/**
+ * @brief Constructive solid geometry: two operands, each a primitive, group or another CSG, combined by an operation.
+ *
+ * A ray is intersected with both operands and the hits are walked in order while tracking whether the ray is inside
+ * either operand; a hit survives where it lies on the surface of the combined solid. Operands must be closed solids for
+ * the inside tracking to hold. Surviving hits report the primitive that was hit, which provides the normal and the
+ * material, so a difference shows the material of the cutting operand on the cut.
+ *
+ * The bounds of both operands are kept so a ray that misses one of them skips its intersection, or the whole CSG when
+ * the operation cannot produce a hit without it. Merging happens in a fixed size buffer on the stack, only rays with
+ * more than HIT_BUFFER_SIZE operand hits fall back to the heap. The operand hits and the result are still vectors
+ * returned by LocalIntersect(), so a ray that reaches both operands allocates them. Like NMGroup, Compile() (called by
+ * NMWorld::AddObject() and NMWorld::BuildBVH()) pushes the transform into the operands.
+ */
+class NMCSG : public NMPrimitiveBase
+{
+public:
+
+    /**
+     * @throws std::runtime_error if an operand is null.
+     */
+    NMCSG(ENMCSGOperation operation, std::shared_ptr<NMPrimitiveBase> left, std::shared_ptr<NMPrimitiveBase> right);
+
+    virtual ~NMCSG() = default;
+
+    virtual bool operator==(const NMPrimitiveBase& other) const override;
+
+    inline ENMCSGOperation GetOperation() const { return operation; }
+    inline const std::shared_ptr<NMPrimitiveBase>& GetLeft() const { return left; }
+    inline const std::shared_ptr<NMPrimitiveBase>& GetRight() const { return right; }
+
+    /**
+     * @brief Whether a hit lies on the surface of the combined solid.
+     * @param isLeftHit True if the hit is on the left operand, false if on the right one.
+     * @param isInsideLeft Whether the ray is inside the left operand just before the hit.
+     * @param isInsideRight Whether the ray is inside the right operand just before the hit.
+     */
+    static bool IsHitAllowed(ENMCSGOperation operation, bool isLeftHit, bool isInsideLeft, bool isInsideRight);
+
+    virtual void SetGeometryRevision(const std::shared_ptr<std::atomic<uint64_t>>& revision) const override;
+
+    /**
+     * @brief Push the transform down into the operands and recompute their bounds, see CompileChildren().
+     */
+    virtual void Compile() override;
+
+    virtual std::vector<SNMIntersection> LocalIntersect(const NMRay& localRay) const override;
+
+    virtual bool Includes(const NMPrimitiveBase* object) const override;
+
+    /**
+     * @brief Hits report the operand primitive that was hit, so a CSG is never asked for its normal.
+     * @throws std::runtime_error always.
+     */
+    virtual NMVector LocalNormalAt(const NMPoint& localPoint) const override;
+
+    /**
+     * @brief The normal of the operand that includes hit.leaf, for a CSG shared by an NMInstance.
+     * @throws std::runtime_error if neither operand includes it.
+     */
+    virtual NMVector LocalNormalAt(const NMPoint& localPoint, const SNMIntersection& hit) const override;
+
+    inline virtual SNMBounds LocalBounds() const override { return bounds; }
+
+    // Operand hits merged on the stack per ray, more than this are merged on the heap
+    static constexpr std::size_t HIT_BUFFER_SIZE = 16;
+
+protected:
+
+    ENMCSGOperation operation;
+    std::shared_ptr<NMPrimitiveBase> left;
+    std::shared_ptr<NMPrimitiveBase> right;
+
+    // The operand bounds in CSG space and the bounds of the result
+    SNMBounds leftBounds;
+    SNMBounds rightBounds;
+    SNMBounds bounds;
+
+    void UpdateBounds();
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "NMCore/Primitive/PrimitiveBase.hpp"
+
+/**
+ * @brief A double napped cone around the y axis in object space whose radius at height y is |y|, optionally truncated
+ *        to (minimum, maximum) and closed with caps at both ends.
+ */
+class NMCone : public NMPrimitiveBase
+{
+public:
+
+    NMCone() = default;
+
+    virtual ~NMCone() = default;
+
+    virtual bool operator==(const NMPrimitiveBase& other) const override
+    {
+        if (!NMPrimitiveBase::operator==(other))
+        {
+            return false;
+        }
+
+        const NMCone* otherCone = dynamic_cast<const NMCone*>(&other);
+        return otherCone && minimum == otherCone->minimum && maximum == otherCone->maximum
+               && closed == otherCone->closed;
+    }
+
+    inline float GetMinimum() const { return minimum; }
+    inline void SetMinimum(float newMinimum) { minimum = newMinimum; }
+
+    inline float GetMaximum() const { return maximum; }
+    inline void SetMaximum(float newMaximum) { maximum = newMaximum; }
+
+    inline bool IsClosed() const { return closed; }
+    inline void SetClosed(bool newClosed) { closed = newClosed; }
+
+    virtual std::vector<SNMIntersection> LocalIntersect(const NMRay& localRay) const override;
+    virtual void LocalIntersectPacket(const SNMRayPacket& localRays, float nearest[RAY_PACKET_SIZE]) const override;
+    virtual NMVector LocalNormalAt(const NMPoint& localPoint) const override;
+
+    /**
+     * @brief The box around the truncated cone, as wide as its wider end and infinite while it is not truncated.
+     */
+    inline virtual SNMBounds LocalBounds() const override
+    {
+        float radius = std::max(std::abs(minimum), std::abs(maximum));
+        return SNMBounds(NMPoint(-radius, minimum, -radius), NMPoint(radius, maximum, radius));
+    }
+
+protected:
+
+    float minimum = -std::numeric_limits<float>::infinity();
+    float maximum = std::numeric_limits<float>::infinity();
+    bool closed = false;
+};
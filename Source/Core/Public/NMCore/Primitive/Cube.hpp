@@ -0,0 +1,35 @@
+#pragma once
+
+#include <vector>
+
+#include "NMCore/Primitive/PrimitiveBase.hpp"
+
+/**
+ * @brief An axis aligned cube from -1 to 1 on every axis in object space, intersected with the slab test.
+ */
+class NMCube : public NMPrimitiveBase
+{
+public:
+
+    NMCube() = default;
+
+    virtual ~NMCube() = default;
+
+    virtual bool operator==(const NMPrimitiveBase& other) const override
+    {
+        return NMPrimitiveBase::operator==(other) && dynamic_cast<const NMCube*>(&other) != nullptr;
+    }
+
+    virtual std::vector<SNMIntersection> LocalIntersect(const NMRay& localRay) const override;
+    virtual void LocalIntersectPacket(const SNMRayPacket& localRays, float nearest[RAY_PACKET_SIZE]) const override;
+
+    /**
+     * @brief The normal of the face the point lies on, i.e. of its largest component.
+     */
+    virtual NMVector LocalNormalAt(const NMPoint& localPoint) const override;
+
+    inline virtual SNMBounds LocalBounds() const override
+    {
+        return SNMBounds(NMPoint(-1.0f, -1.0f, -1.0f), NMPoint(1.0f, 1.0f, 1.0f));
+    }
+};
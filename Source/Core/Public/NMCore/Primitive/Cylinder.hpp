@@ -0,0 +1,58 @@
+#pragma once
+
+#include <limits>
+#include <vector>
+
+#include "NMCore/Primitive/PrimitiveBase.hpp"
+
+/**
+ * @brief A cylinder of radius 1 around the y axis in object space, optionally truncated to (minimum, maximum) and
+ *        closed with caps at both ends.
+ */
+class NMCylinder : public NMPrimitiveBase
+{
+public:
+
+    NMCylinder() = default;
+
+    virtual ~NMCylinder() = default;
+
+    virtual bool operator==(const NMPrimitiveBase& other) const override
+    {
+        if (!NMPrimitiveBase::operator==(other))
+        {
+            return false;
+        }
+
+        const NMCylinder* otherCylinder = dynamic_cast<const NMCylinder*>(&other);
+        return otherCylinder && minimum == otherCylinder->minimum && maximum == otherCylinder->maximum
+               && closed == otherCylinder->closed;
+    }
+
+    inline float GetMinimum() const { return minimum; }
+    inline void SetMinimum(float newMinimum) { minimum = newMinimum; }
+
+    inline float GetMaximum() const { return maximum; }
+    inline void SetMaximum(float newMaximum) { maximum = newMaximum; }
+
+    inline bool IsClosed() const { return closed; }
+    inline void SetClosed(bool newClosed) { closed = newClosed; }
+
+    virtual std::vector<SNMIntersection> LocalIntersect(const NMRay& localRay) const override;
+    virtual void LocalIntersectPacket(const SNMRayPacket& localRays, float nearest[RAY_PACKET_SIZE]) const override;
+    virtual NMVector LocalNormalAt(const NMPoint& localPoint) const override;
+
+    /**
+     * @brief The box around the truncated cylinder, infinite along y while it is not truncated.
+     */
+    inline virtual SNMBounds LocalBounds() const override
+    {
+        return SNMBounds(NMPoint(-1.0f, minimum, -1.0f), NMPoint(1.0f, maximum, 1.0f));
+    }
+
+protected:
+
+    float minimum = -std::numeric_limits<float>::infinity();
+    float maximum = std::numeric_limits<float>::infinity();
+    bool closed = false;
+};
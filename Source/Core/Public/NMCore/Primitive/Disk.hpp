@@ -0,0 +1,35 @@
+#pragma once
+
+#include <vector>
+
+#include "NMCore/Primitive/PrimitiveBase.hpp"
+
+/**
+ * @brief A disk of radius 1 in the xz plane of object space, facing +y. A bounded plane, e.g. for floors and caps.
+ */
+class NMDisk : public NMPrimitiveBase
+{
+public:
+
+    NMDisk() = default;
+
+    virtual ~NMDisk() = default;
+
+    virtual bool operator==(const NMPrimitiveBase& other) const override
+    {
+        return NMPrimitiveBase::operator==(other) && dynamic_cast<const NMDisk*>(&other) != nullptr;
+    }
+
+    virtual std::vector<SNMIntersection> LocalIntersect(const NMRay& localRay) const override;
+    virtual void LocalIntersectPacket(const SNMRayPacket& localRays, float nearest[RAY_PACKET_SIZE]) const override;
+
+    inline virtual NMVector LocalNormalAt(const NMPoint& /* localPoint */) const override
+    {
+        return NMVector(0.0f, 1.0f, 0.0f);
+    }
+
+    inline virtual SNMBounds LocalBounds() const override
+    {
+        return SNMBounds(NMPoint(-1.0f, 0.0f, -1.0f), NMPoint(1.0f, 0.0f, 1.0f));
+    }
+};
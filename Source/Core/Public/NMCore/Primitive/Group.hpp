@@ -0,0 +1,72 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "NMCore/Primitive/PrimitiveBase.hpp"
+
+/**
+ * @brief A list of child primitives, including other groups, that are transformed and culled together.
+ *
+ * Children are positioned relative to the group, so a hierarchy replaces hand multiplied transform chains. Compile()
+ * (called by NMWorld::AddObject() and NMWorld::BuildBVH()) flattens the transforms: the group's transform is
+ * multiplied into every child and the child's inverse is baked from the two inverses, recursively, leaving every group
+ * with the identity. Rendering then transforms each ray once per leaf and never walks up a parent chain to find a
+ * normal.
+ *
+ * A group keeps the bounds of its children and a ray that misses them skips all of them. Hits are reported for the
+ * child that was hit, so each child keeps its own material. A primitive belongs to at most one group since compiling
+ * changes its transform; share geometry between groups through NMInstance. A group can itself be shared by instances,
+ * which then shade all children with the instance's material.
+ */
+class NMGroup : public NMPrimitiveBase
+{
+public:
+
+    NMGroup() = default;
+
+    virtual ~NMGroup() = default;
+
+    virtual bool operator==(const NMPrimitiveBase& other) const override;
+
+    /**
+     * @brief Add a child, positioned by its current transform relative to the group.
+     */
+    void AddChild(std::shared_ptr<NMPrimitiveBase> child);
+
+    inline std::size_t GetChildCount() const { return children.size(); }
+    inline const std::shared_ptr<NMPrimitiveBase>& GetChild(std::size_t index) const { return children[index]; }
+
+    virtual void SetGeometryRevision(const std::shared_ptr<std::atomic<uint64_t>>& revision) const override;
+
+    /**
+     * @brief Push the group's transform down into its children and recompute the bounds, see CompileChildren().
+     * Calling it again is a no-op unless the group was transformed in between, which moves all children along.
+     */
+    virtual void Compile() override;
+
+    virtual std::vector<SNMIntersection> LocalIntersect(const NMRay& localRay) const override;
+
+    virtual bool Includes(const NMPrimitiveBase* object) const override;
+
+    /**
+     * @brief Hits report the child that was hit, so a group is never asked for its normal.
+     * @throws std::runtime_error always.
+     */
+    virtual NMVector LocalNormalAt(const NMPoint& localPoint) const override;
+
+    /**
+     * @brief The normal of the child that includes hit.leaf, for a group shared by an NMInstance.
+     * @throws std::runtime_error if no child includes it.
+     */
+    virtual NMVector LocalNormalAt(const NMPoint& localPoint, const SNMIntersection& hit) const override;
+
+    inline virtual SNMBounds LocalBounds() const override { return bounds; }
+
+protected:
+
+    std::vector<std::shared_ptr<NMPrimitiveBase>> children;
+
+    // The union of the children's bounds in group space, empty for an empty group
+    SNMBounds bounds;
+};
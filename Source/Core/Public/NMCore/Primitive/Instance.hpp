@@ -0,0 +1,97 @@
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+
+#include "NMCore/Primitive/PrimitiveBase.hpp"
+
+/**
+ * @brief A transformed reference to geometry shared with other instances.
+ *
+ * The instance owns only its transform, the cached inverse and a material; the geometry and its object space
+ * acceleration structure (e.g. the BVH of an NMTriangleMesh) exist once however many instances point at them. Added to
+ * an NMWorld, the world BVH over the instances is the top level and the geometry's own BVH the bottom level of a two
+ * level hierarchy, so a million instances of one mesh cost a million transforms rather than a million meshes.
+ *
+ * The geometry's own transform is applied inside the instance's. Hits report the instance as their object so shading
+ * uses the instance's material, the rest of the hit (e.g. a mesh's triangle and barycentrics) is passed through. The
+ * primitive that was hit is kept as SNMIntersection::leaf, so a shared group or CSG finds the child for the normal.
+ * A shared group holding two instances of the same geometry cannot tell them apart by the leaf and takes the normal
+ * of the first.
+ */
+class NMInstance : public NMPrimitiveBase
+{
+public:
+
+    /**
+     * @param geometry The shared geometry, the instance starts out with its material.
+     * @throws std::runtime_error if geometry is null.
+     */
+    explicit NMInstance(std::shared_ptr<const NMPrimitiveBase> geometry) : geometry(std::move(geometry))
+    {
+        if (!this->geometry)
+        {
+            throw std::runtime_error("Instance needs geometry");
+        }
+
+        material = this->geometry->GetMaterial();
+    }
+
+    virtual ~NMInstance() = default;
+
+    inline virtual bool operator==(const NMPrimitiveBase& other) const override
+    {
+        if (!NMPrimitiveBase::operator==(other))
+        {
+            return false;
+        }
+
+        const NMInstance* otherInstance = dynamic_cast<const NMInstance*>(&other);
+        return otherInstance && geometry == otherInstance->geometry;
+    }
+
+    inline const std::shared_ptr<const NMPrimitiveBase>& GetGeometry() const { return geometry; }
+
+    inline virtual void SetGeometryRevision(const std::shared_ptr<std::atomic<uint64_t>>& revision) const override
+    {
+        NMPrimitiveBase::SetGeometryRevision(revision);
+        geometry->SetGeometryRevision(revision);
+    }
+
+    inline virtual std::vector<SNMIntersection> LocalIntersect(const NMRay& localRay) const override
+    {
+        std::vector<SNMIntersection> hits = geometry->Intersect(localRay);
+        for (SNMIntersection& hit : hits)
+        {
+            // An instance nested in the geometry already recorded the innermost primitive
+            if (!hit.leaf)
+            {
+                hit.leaf = hit.object;
+            }
+            hit.object = this;
+        }
+
+        return hits;
+    }
+
+    inline virtual NMVector LocalNormalAt(const NMPoint& localPoint) const override
+    {
+        return geometry->NormalAt(localPoint);
+    }
+
+    inline virtual NMVector LocalNormalAt(const NMPoint& localPoint, const SNMIntersection& hit) const override
+    {
+        return geometry->NormalAt(localPoint, hit);
+    }
+
+    inline virtual bool Includes(const NMPrimitiveBase* object) const override
+    {
+        return object == this || geometry->Includes(object);
+    }
+
+    inline virtual SNMBounds LocalBounds() const override { return geometry->WorldBounds(); }
+
+protected:
+
+    std::shared_ptr<const NMPrimitiveBase> geometry;
+};
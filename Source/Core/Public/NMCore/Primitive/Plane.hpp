@@ -34,4 +34,6 @@ public:
     {
         return NMVector(0.0f, 1.0f, 0.0f);
     }
+
+    inline virtual SNMBounds LocalBounds() const override { return SNMBounds::Infinite(); }
 };
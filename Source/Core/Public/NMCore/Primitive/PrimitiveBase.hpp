@@ -1,8 +1,14 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
 #include "NMCore/Material.hpp"
+#include "NMCore/RT/Bounds.hpp"
 #include "NMCore/RT/Intersection.hpp"
 #include "NMCore/RT/Ray.hpp"
+#include "NMCore/RT/RayPacket.hpp"
 #include "NMM/Matrix.hpp"
 #include "NMM/Point.hpp"
 #include "NMM/Vector.hpp"
@@ -20,24 +26,62 @@ public:
     }
 
     inline virtual NMMatrix GetTransform() const { return transform; }
-    inline virtual void SetTransform(const NMMatrix& newTransform) { transform = newTransform; }
+    inline virtual void SetTransform(const NMMatrix& newTransform)
+    {
+        transform = newTransform;
+        inverseTransform = newTransform.Inverse();
+        BumpGeometryRevision();
+    }
+
+    /**
+     * @brief Set the transform together with its precomputed inverse.
+     * Used when loading baked scenes so the inverse does not have to be recomputed per object.
+     */
+    inline virtual void SetTransform(const NMMatrix& newTransform, const NMMatrix& newInverseTransform)
+    {
+        transform = newTransform;
+        inverseTransform = newInverseTransform;
+        BumpGeometryRevision();
+    }
+
+    inline const NMMatrix& GetInverseTransform() const { return inverseTransform; }
 
     inline virtual const NMMaterial& GetMaterial() const { return material; }
     inline virtual void SetMaterial(const NMMaterial& newMaterial) { material = newMaterial; }
 
     inline const NMPoint& GetOrigin() const { return origin; }
-    inline void SetOrigin(const NMPoint& newOrigin) { origin = newOrigin; }
+    inline void SetOrigin(const NMPoint& newOrigin)
+    {
+        origin = newOrigin;
+        BumpGeometryRevision();
+    }
+
+    /**
+     * @brief Report changes of the transform or origin to a counter, the geometry revision of the NMWorld the primitive
+     *        is added to (see NMWorld::GetGeometryRevision()). Primitives made of others pass it on to their children.
+     * A primitive reports to the last world it was added to. Const so the shared geometry of an NMInstance reports too.
+     */
+    inline virtual void SetGeometryRevision(const std::shared_ptr<std::atomic<uint64_t>>& revision) const
+    {
+        geometryRevision = revision;
+    }
 
     inline std::vector<SNMIntersection> Intersect(const NMRay& ray) const
     {
-        NMRay localRay = ray.Transformed(transform.Inverse());
+        NMRay localRay = ray.Transformed(inverseTransform);
         return LocalIntersect(localRay);
     }
 
-    virtual NMVector NormalAt(const NMPoint& worldPoint) const
+    /**
+     * @brief The nearest hit at t >= 0 of every ray of a packet, infinity for a miss.
+     */
+    inline void IntersectPacket(const SNMRayPacket& rays, float nearest[RAY_PACKET_SIZE]) const
     {
-        NMMatrix inverseTransform = transform.Inverse();
+        LocalIntersectPacket(rays.Transformed(inverseTransform), nearest);
+    }
 
+    virtual NMVector NormalAt(const NMPoint& worldPoint) const
+    {
         NMPoint localPoint = inverseTransform * worldPoint;
         NMVector localNormal = LocalNormalAt(localPoint);
         NMVector worldNormal = inverseTransform.Transposed() * localNormal;
@@ -45,13 +89,112 @@ public:
         return worldNormal.Normalized();
     }
 
+    /**
+     * @brief The normal at a hit, for primitives whose normal depends on the part that was hit (see
+     *        SNMIntersection::index).
+     */
+    NMVector NormalAt(const NMPoint& worldPoint, const SNMIntersection& hit) const
+    {
+        NMPoint localPoint = inverseTransform * worldPoint;
+        NMVector localNormal = LocalNormalAt(localPoint, hit);
+        NMVector worldNormal = inverseTransform.Transposed() * localNormal;
+
+        return worldNormal.Normalized();
+    }
+
+    /**
+     * @brief Whether object is this primitive or one of its parts, used to find the child that was hit inside an
+     *        instance (see SNMIntersection::leaf).
+     */
+    inline virtual bool Includes(const NMPrimitiveBase* object) const { return object == this; }
+
+    /**
+     * @brief Prepare the primitive for rendering once it is complete, called by NMWorld::AddObject() and again by
+     *        NMWorld::BuildBVH(). Must be safe to call repeatedly; primitives that need no preparation (the default) do
+     *        nothing.
+     */
+    virtual void Compile() {}
+
     virtual std::vector<SNMIntersection> LocalIntersect(const NMRay& localRay) const = 0;
+
+    /**
+     * @brief Batch version of LocalIntersect() that only reports the nearest hit at t >= 0 of each lane.
+     * The default runs LocalIntersect() lane by lane; primitives override it with one branch free loop over all
+     * lanes that the compiler can vectorize.
+     */
+    virtual void LocalIntersectPacket(const SNMRayPacket& localRays, float nearest[RAY_PACKET_SIZE]) const
+    {
+        for (uint32_t lane = 0; lane < RAY_PACKET_SIZE; ++lane)
+        {
+            nearest[lane] = nmpacket::NoHit();
+            if (lane >= localRays.count)
+            {
+                continue;
+            }
+
+            for (const SNMIntersection& hit : LocalIntersect(localRays.GetRay(lane)))
+            {
+                nearest[lane] = nmpacket::Nearest(hit.t, nearest[lane]);
+            }
+        }
+    }
+
     inline virtual NMVector LocalNormalAt(const NMPoint& localPoint) const { return localPoint - origin; }
+    inline virtual NMVector LocalNormalAt(const NMPoint& localPoint, const SNMIntersection& /* hit */) const
+    {
+        return LocalNormalAt(localPoint);
+    }
+
+    /**
+     * @brief The bounds of the primitive in object space.
+     * Unbounded primitives (e.g. planes) return SNMBounds::Infinite(), which is also the default.
+     */
+    inline virtual SNMBounds LocalBounds() const { return SNMBounds::Infinite(); }
+
+    inline SNMBounds WorldBounds() const { return LocalBounds().Transformed(transform); }
 
 protected:
 
     NMMatrix transform = NMMatrix::Identity4x4();
+    NMMatrix inverseTransform = NMMatrix::Identity4x4();
     NMMaterial material = NMMaterial();
 
     NMPoint origin = NMPoint(0.0f, 0.0f, 0.0f);
+
+    /**
+     * @brief For primitives made of others (NMGroup, NMCSG): multiply the transform into every child, reset it to the
+     *        identity and compile the children. Calling it again only compiles the children.
+     * @param children A range of pointers to the children.
+     */
+    template <typename TChildren>
+    void CompileChildren(const TChildren& children)
+    {
+        const NMMatrix identity = NMMatrix::Identity4x4();
+        if (!(transform == identity))
+        {
+            for (const auto& child : children)
+            {
+                // (G * C)^-1 = C^-1 * G^-1, so no inverse is computed
+                child->SetTransform(transform * child->GetTransform(), child->GetInverseTransform() * inverseTransform);
+            }
+
+            NMPrimitiveBase::SetTransform(identity, identity);
+        }
+
+        for (const auto& child : children)
+        {
+            child->Compile();
+        }
+    }
+
+    // Bookkeeping rather than geometry, see SetGeometryRevision()
+    mutable std::shared_ptr<std::atomic<uint64_t>> geometryRevision;
+
+    inline void BumpGeometryRevision() const
+    {
+        if (geometryRevision)
+        {
+            geometryRevision->fetch_add(1, std::memory_order_release);
+        }
+    }
 };
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "NMCore/Primitive/PrimitiveBase.hpp"
+
+enum class ENMSDFOpcode : uint8_t
+{
+    // Shapes, centered on the origin; push their distance
+    Sphere = 0,
+    Box,
+    Torus,
+
+    // Pop two distances and push their combination
+    Union,
+    SmoothUnion,
+
+    // Push a modified copy of the current point for the shapes that follow, up to the matching PopPoint
+    Translate,
+    Repeat,
+    PopPoint,
+};
+
+/**
+ * @brief A node of a signed distance function, built with the static functions and compiled by NMSDFPrimitive.
+ */
+struct SNMSDFNode
+{
+    ENMSDFOpcode opcode = ENMSDFOpcode::Sphere;
+    float arguments[6] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    std::vector<SNMSDFNode> children;
+
+    static SNMSDFNode Sphere(float radius);
+
+    /**
+     * @param halfExtents Half the size of the box along each axis.
+     */
+    static SNMSDFNode Box(const NMVector& halfExtents);
+
+    /**
+     * @brief A torus around the y axis.
+     * @param majorRadius The distance from the center to the middle of the tube.
+     * @param minorRadius The radius of the tube.
+     */
+    static SNMSDFNode Torus(float majorRadius, float minorRadius);
+
+    static SNMSDFNode Union(SNMSDFNode a, SNMSDFNode b);
+
+    /**
+     * @brief A union that blends the two shapes where they are closer than smoothness.
+     */
+    static SNMSDFNode SmoothUnion(SNMSDFNode a, SNMSDFNode b, float smoothness);
+
+    static SNMSDFNode Translate(SNMSDFNode child, const NMVector& offset);
+
+    /**
+     * @brief Repeat the child on a grid around the origin.
+     * The distance stays exact only while the child fits its cell, i.e. is smaller than spacing.
+     * @param spacing The distance between copies along each axis, 0 does not repeat along that axis.
+     * @param copies The number of extra copies to each side along each axis, so bounds stay finite.
+     */
+    static SNMSDFNode Repeat(SNMSDFNode child, const NMVector& spacing, const NMVector& copies);
+};
+
+struct SNMSDFInstruction
+{
+    ENMSDFOpcode opcode;
+    float arguments[6];
+};
+
+/**
+ * @brief A surface given by a signed distance function, intersected by sphere tracing.
+ *
+ * The node tree is compiled into a flat postfix program once, which Distance() runs over two small fixed size stacks,
+ * the distances and the points modified by Translate and Repeat; evaluating a node is a switch case rather than a
+ * virtual call. Bounds are derived from the nodes, so the primitive takes part in the world BVH, and the ray is only
+ * marched inside them.
+ *
+ * Only the first surface in front of the ray origin is reported, marching by the absolute distance so rays starting
+ * inside find the exit. Refraction needs the entry and the exit of a solid and is not supported.
+ */
+class NMSDFPrimitive : public NMPrimitiveBase
+{
+public:
+
+    /**
+     * @throws std::runtime_error if the tree nests deeper than MAX_STACK_DEPTH.
+     */
+    explicit NMSDFPrimitive(const SNMSDFNode& root);
+
+    virtual ~NMSDFPrimitive() = default;
+
+    virtual bool operator==(const NMPrimitiveBase& other) const override;
+
+    inline const std::vector<SNMSDFInstruction>& GetProgram() const { return program; }
+
+    /**
+     * @brief The signed distance from a point in object space to the surface, negative inside.
+     */
+    float Distance(const NMPoint& localPoint) const;
+
+    virtual std::vector<SNMIntersection> LocalIntersect(const NMRay& localRay) const override;
+
+    /**
+     * @brief The gradient of the distance function, from four evaluations around the point.
+     */
+    virtual NMVector LocalNormalAt(const NMPoint& localPoint) const override;
+
+    inline virtual SNMBounds LocalBounds() const override { return bounds; }
+
+    static constexpr uint32_t MAX_STACK_DEPTH = 16;
+
+    // Sphere tracing gives up after this many steps and reports a miss
+    static constexpr uint32_t MAX_STEPS = 128;
+
+    // Distances below this, in object space, are hits
+    static constexpr float HIT_DISTANCE = 1e-4f;
+
+protected:
+
+    std::vector<SNMSDFInstruction> program;
+    SNMBounds bounds;
+
+    float Distance(float x, float y, float z) const;
+};
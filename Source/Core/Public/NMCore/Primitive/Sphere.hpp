@@ -49,6 +49,11 @@ public:
         return std::vector<SNMIntersection>{int1, int2};
     }
 
+    virtual SNMBounds LocalBounds() const override
+    {
+        return SNMBounds(origin - NMVector(1.0f, 1.0f, 1.0f), origin + NMVector(1.0f, 1.0f, 1.0f));
+    }
+
     static NMSphere GlassSphere()
     {
         NMSphere sphere;
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "NMCore/Primitive/PrimitiveBase.hpp"
+#include "NMCore/RT/BVH.hpp"
+
+/**
+ * @brief The triangles of one mesh BVH leaf, stored lane by lane so a single loop tests all four of them.
+ * Lanes past count are zero and never reported.
+ */
+struct SNMTrianglePacket
+{
+    // [corner][axis][lane]
+    float vertices[3][3][BVH_LEAF_SIZE];
+    uint32_t triangles[BVH_LEAF_SIZE];
+    uint32_t count;
+};
+
+/**
+ * @brief A mesh of triangles with indexed vertex positions and optional vertex normals.
+ *
+ * The buffers are kept in contiguous arrays, three floats per position or normal and three indices per triangle.
+ * SetGeometry() builds an object space BVH whose leaves hold up to four triangles as an SNMTrianglePacket, so the
+ * cost of a ray grows with the logarithm of the triangle count. Triangles are intersected with the watertight
+ * algorithm of Woop, Benthin and Wald, so rays never slip through the shared edge of two triangles.
+ *
+ * Intersections carry the triangle in SNMIntersection::index and the barycentric coordinates of the second and third
+ * corner in u and v. Triangles with normals at all three corners are shaded smoothly, all others flat.
+ */
+class NMTriangleMesh : public NMPrimitiveBase
+{
+public:
+
+    static constexpr uint32_t NO_NORMAL = UINT32_MAX;
+
+    NMTriangleMesh() = default;
+
+    virtual ~NMTriangleMesh() = default;
+
+    virtual bool operator==(const NMPrimitiveBase& other) const override;
+
+    /**
+     * @brief Replace the geometry and rebuild the BVH.
+     * @param positions x, y and z of every vertex.
+     * @param positionIndices The three vertices of every triangle.
+     * @param normals x, y and z of every vertex normal, empty for a flat shaded mesh.
+     * @param normalIndices The three normals of every triangle if there are normals, NO_NORMAL for a corner without.
+     * @throws std::runtime_error if an index is out of range or the buffer sizes do not match.
+     */
+    void SetGeometry(std::vector<float> positions, std::vector<uint32_t> positionIndices,
+                     std::vector<float> normals = std::vector<float>(),
+                     std::vector<uint32_t> normalIndices = std::vector<uint32_t>());
+
+    inline std::size_t GetVertexCount() const { return positions.size() / 3; }
+    inline std::size_t GetTriangleCount() const { return positionIndices.size() / 3; }
+
+    inline NMPoint GetVertex(std::size_t index) const
+    {
+        return NMPoint(positions[index * 3], positions[index * 3 + 1], positions[index * 3 + 2]);
+    }
+
+    inline const std::vector<float>& GetPositions() const { return positions; }
+    inline const std::vector<uint32_t>& GetPositionIndices() const { return positionIndices; }
+    inline const std::vector<float>& GetNormals() const { return normals; }
+    inline const std::vector<uint32_t>& GetNormalIndices() const { return normalIndices; }
+    inline const NMBVH& GetBVH() const { return bvh; }
+
+    virtual std::vector<SNMIntersection> LocalIntersect(const NMRay& localRay) const override;
+
+    /**
+     * @brief The normal of the first triangle, meshes need the hit to find theirs.
+     */
+    virtual NMVector LocalNormalAt(const NMPoint& localPoint) const override;
+    virtual NMVector LocalNormalAt(const NMPoint& localPoint, const SNMIntersection& hit) const override;
+
+    inline virtual SNMBounds LocalBounds() const override { return bounds; }
+
+protected:
+
+    std::vector<float> positions;
+    std::vector<uint32_t> positionIndices;
+    std::vector<float> normals;
+    std::vector<uint32_t> normalIndices;
+
+    SNMBounds bounds;
+
+    // Leaf nodes reference one packet each through their offset
+    NMBVH bvh;
+    std::vector<SNMTrianglePacket> packets;
+
+    void BuildBVH();
+
+    NMVector FaceNormal(uint32_t triangle) const;
+};
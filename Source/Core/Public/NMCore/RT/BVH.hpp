@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "NMCore/RT/Bounds.hpp"
+#include "NMCore/RT/Ray.hpp"
+
+static constexpr uint32_t BVH_LEAF_SIZE = 4;
+static constexpr uint32_t BVH_MAX_DEPTH = 64;
+
+/**
+ * @brief A flattened BVH node.
+ * Interior nodes store their left child directly after themselves and the index of their right child in offset.
+ * Leaf nodes (count > 0) reference count consecutive entries of the index array starting at offset.
+ * The layout is plain data so nodes can be written to and mapped from disk as-is.
+ */
+struct SNMBVHNode
+{
+    float min[3];
+    uint32_t offset;
+    float max[3];
+    uint32_t count;
+
+    inline bool IsLeaf() const { return count > 0; }
+};
+
+static_assert(sizeof(SNMBVHNode) == 32, "SNMBVHNode must stay 32 bytes, it is stored in binary scene caches");
+
+/**
+ * @brief A bounding volume hierarchy over a set of items identified by 32-bit ids.
+ */
+class NMBVH
+{
+public:
+
+    NMBVH() = default;
+
+    /**
+     * @brief Build the hierarchy with median splits along the largest centroid axis.
+     * @param bounds The world space bounds of every item, all of them must be finite.
+     * @param ids The id reported to the traversal visitor for each item, ids[i] belongs to bounds[i].
+     */
+    void Build(const std::vector<SNMBounds>& bounds, const std::vector<uint32_t>& ids);
+
+    /**
+     * @brief Adopt a hierarchy built earlier (e.g. loaded from a scene cache) without rebuilding it.
+     */
+    void Assign(const SNMBVHNode* newNodes, std::size_t nodeCount, const uint32_t* newIndices, std::size_t indexCount)
+    {
+        nodes.assign(newNodes, newNodes + nodeCount);
+        indices.assign(newIndices, newIndices + indexCount);
+    }
+
+    inline void Clear()
+    {
+        nodes.clear();
+        indices.clear();
+    }
+
+    inline bool IsEmpty() const { return nodes.empty(); }
+
+    inline const std::vector<SNMBVHNode>& GetNodes() const { return nodes; }
+    inline const std::vector<uint32_t>& GetIndices() const { return indices; }
+
+    /**
+     * @brief Call visit(id) for every item whose leaf box overlaps the ray's line.
+     */
+    template <typename Visitor> void Traverse(const NMRay& ray, Visitor&& visit) const
+    {
+        TraverseLeaves(ray,
+                       [this, &visit](const SNMBVHNode& leaf)
+                       {
+                           for (uint32_t i = 0; i < leaf.count; ++i)
+                           {
+                               visit(indices[leaf.offset + i]);
+                           }
+                       });
+    }
+
+    /**
+     * @brief Call visit(node) for every leaf node whose box overlaps the ray's line.
+     */
+    template <typename Visitor> void TraverseLeaves(const NMRay& ray, Visitor&& visit) const
+    {
+        if (nodes.empty())
+        {
+            return;
+        }
+
+        const float origin[3] = {ray.GetOrigin().GetX(), ray.GetOrigin().GetY(), ray.GetOrigin().GetZ()};
+        const float inverse[3] = {1.0f / ray.GetDirection().GetX(), 1.0f / ray.GetDirection().GetY(),
+                                  1.0f / ray.GetDirection().GetZ()};
+
+        uint32_t stack[BVH_MAX_DEPTH];
+        uint32_t stackSize = 0;
+        stack[stackSize++] = 0;
+
+        while (stackSize > 0)
+        {
+            const SNMBVHNode& node = nodes[stack[--stackSize]];
+            if (!Overlaps(node, origin, inverse))
+            {
+                continue;
+            }
+
+            if (node.IsLeaf())
+            {
+                visit(node);
+                continue;
+            }
+
+            uint32_t self = static_cast<uint32_t>(&node - nodes.data());
+            stack[stackSize++] = node.offset;
+            stack[stackSize++] = self + 1;
+        }
+    }
+
+protected:
+
+    std::vector<SNMBVHNode> nodes;
+    std::vector<uint32_t> indices;
+
+    static inline bool Overlaps(const SNMBVHNode& node, const float origin[3], const float inverse[3])
+    {
+        float tMin = -std::numeric_limits<float>::infinity();
+        float tMax = std::numeric_limits<float>::infinity();
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            float t0 = (node.min[axis] - origin[axis]) * inverse[axis];
+            float t1 = (node.max[axis] - origin[axis]) * inverse[axis];
+            if (t0 > t1)
+            {
+                std::swap(t0, t1);
+            }
+
+            tMin = t0 > tMin ? t0 : tMin;
+            tMax = t1 < tMax ? t1 : tMax;
+        }
+
+        return tMin <= tMax;
+    }
+};
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+
+#include "NMCore/RT/Ray.hpp"
+#include "NMM/Matrix.hpp"
+#include "NMM/Point.hpp"
+
+/**
+ * @brief An axis aligned bounding box.
+ * A default constructed box is empty (min > max) so it can be grown with Extend().
+ */
+struct SNMBounds
+{
+    NMPoint min = NMPoint(std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity(),
+                          std::numeric_limits<float>::infinity());
+    NMPoint max = NMPoint(-std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+                          -std::numeric_limits<float>::infinity());
+
+    SNMBounds() = default;
+    SNMBounds(const NMPoint& min, const NMPoint& max) : min(min), max(max) {}
+
+    static SNMBounds Infinite()
+    {
+        const float inf = std::numeric_limits<float>::infinity();
+        return SNMBounds(NMPoint(-inf, -inf, -inf), NMPoint(inf, inf, inf));
+    }
+
+    inline bool IsEmpty() const
+    {
+        return min.GetX() > max.GetX() || min.GetY() > max.GetY() || min.GetZ() > max.GetZ();
+    }
+
+    inline bool IsFinite() const
+    {
+        return !IsEmpty() && std::isfinite(min.GetX()) && std::isfinite(min.GetY()) && std::isfinite(min.GetZ())
+               && std::isfinite(max.GetX()) && std::isfinite(max.GetY()) && std::isfinite(max.GetZ());
+    }
+
+    inline NMPoint Center() const
+    {
+        return NMPoint((min.GetX() + max.GetX()) * 0.5f, (min.GetY() + max.GetY()) * 0.5f,
+                       (min.GetZ() + max.GetZ()) * 0.5f);
+    }
+
+    inline void Extend(const NMPoint& point)
+    {
+        min = NMPoint(std::min(min.GetX(), point.GetX()), std::min(min.GetY(), point.GetY()),
+                      std::min(min.GetZ(), point.GetZ()));
+        max = NMPoint(std::max(max.GetX(), point.GetX()), std::max(max.GetY(), point.GetY()),
+                      std::max(max.GetZ(), point.GetZ()));
+    }
+
+    inline void Extend(const SNMBounds& other)
+    {
+        if (other.IsEmpty())
+        {
+            return;
+        }
+
+        Extend(other.min);
+        Extend(other.max);
+    }
+
+    /**
+     * @brief The box covered by both boxes, empty if they do not overlap.
+     */
+    inline SNMBounds Overlap(const SNMBounds& other) const
+    {
+        SNMBounds result(NMPoint(std::max(min.GetX(), other.min.GetX()), std::max(min.GetY(), other.min.GetY()),
+                                 std::max(min.GetZ(), other.min.GetZ())),
+                         NMPoint(std::min(max.GetX(), other.max.GetX()), std::min(max.GetY(), other.max.GetY()),
+                                 std::min(max.GetZ(), other.max.GetZ())));
+        return result.IsEmpty() ? SNMBounds() : result;
+    }
+
+    /**
+     * @brief The axis aligned box enclosing this box after transforming its eight corners.
+     * Infinite boxes stay infinite since their corners cannot be transformed meaningfully.
+     */
+    SNMBounds Transformed(const NMMatrix& transform) const
+    {
+        if (!IsFinite())
+        {
+            return IsEmpty() ? SNMBounds() : Infinite();
+        }
+
+        SNMBounds result;
+        for (int corner = 0; corner < 8; ++corner)
+        {
+            NMPoint point((corner & 1) ? max.GetX() : min.GetX(), (corner & 2) ? max.GetY() : min.GetY(),
+                          (corner & 4) ? max.GetZ() : min.GetZ());
+            result.Extend(transform * point);
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Slab test against the ray.
+     * The default interval covers the whole line, matching NMWorld::Intersect which also reports hits behind
+     * the ray origin.
+     * @return True if the ray overlaps the box somewhere in [minT, maxT].
+     */
+    bool Intersects(const NMRay& ray, float minT = -std::numeric_limits<float>::infinity(),
+                    float maxT = std::numeric_limits<float>::infinity()) const
+    {
+        const float origin[3] = {ray.GetOrigin().GetX(), ray.GetOrigin().GetY(), ray.GetOrigin().GetZ()};
+        const float direction[3] = {ray.GetDirection().GetX(), ray.GetDirection().GetY(),
+                                    ray.GetDirection().GetZ()};
+        const float boxMin[3] = {min.GetX(), min.GetY(), min.GetZ()};
+        const float boxMax[3] = {max.GetX(), max.GetY(), max.GetZ()};
+
+        float tMin = minT;
+        float tMax = maxT;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            float inverse = 1.0f / direction[axis];
+            float t0 = (boxMin[axis] - origin[axis]) * inverse;
+            float t1 = (boxMax[axis] - origin[axis]) * inverse;
+            if (t0 > t1)
+            {
+                std::swap(t0, t1);
+            }
+
+            // NaN (origin on a slab with a zero direction) compares false and keeps the interval unchanged.
+            tMin = t0 > tMin ? t0 : tMin;
+            tMax = t1 < tMax ? t1 : tMax;
+            if (tMin > tMax)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+};
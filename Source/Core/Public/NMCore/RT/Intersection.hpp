@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 class NMPrimitiveBase;
 
 struct SNMIntersection
@@ -7,7 +9,30 @@ struct SNMIntersection
     float t;
     const NMPrimitiveBase* object;
 
+    /**
+     * @brief The part of the object that was hit (e.g. the triangle of a mesh) and the barycentric coordinates of the
+     *        hit on it, for primitives that need them to find the normal. Zero for everything else.
+     */
+    uint32_t index = 0;
+    float u = 0.0f;
+    float v = 0.0f;
+
+    /**
+     * @brief The primitive that was hit inside an NMInstance, which replaces object with itself. A group or CSG shared
+     *        by the instance asks its child that includes the leaf for the normal. Null outside instances.
+     */
+    const NMPrimitiveBase* leaf = nullptr;
+
     SNMIntersection(float initialT, const NMPrimitiveBase* initialObject) : t(initialT), object(initialObject) {}
 
-    bool operator==(const SNMIntersection& other) const { return t == other.t && object == other.object; }
+    SNMIntersection(float initialT, const NMPrimitiveBase* initialObject, uint32_t initialIndex, float initialU,
+                    float initialV)
+        : t(initialT), object(initialObject), index(initialIndex), u(initialU), v(initialV)
+    {
+    }
+
+    bool operator==(const SNMIntersection& other) const
+    {
+        return t == other.t && object == other.object && index == other.index;
+    }
 };
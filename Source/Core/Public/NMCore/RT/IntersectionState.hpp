@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <cmath>
 #include <vector>
 
 #include "NMCore/Primitive/PrimitiveBase.hpp"
@@ -24,7 +25,8 @@ public:
           object(intersection.object),
           point(ray.Position(t)),
           eyeVector(-ray.GetDirection()),
-          normalVector(object->NormalAt(point))
+          normalVector(object->NormalAt(point, intersection)),
+          footprint(std::abs(t) * ray.GetSpread())
     {
         overPoint = point + (normalVector * nmmath::rayEpsilon);
         reflectVector = ray.GetDirection().Reflect(normalVector);
@@ -82,6 +84,10 @@ public:
     NMVector eyeVector = NMVector();
     NMVector normalVector = NMVector();
     NMVector reflectVector = NMVector();
+
+    // The width of the ray at the hit, see NMRay::GetSpread()
+    float footprint = 0.0f;
+
     bool isInside = false;
 
     float n1;
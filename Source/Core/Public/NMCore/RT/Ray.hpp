@@ -19,10 +19,23 @@ public:
 
     NMPoint Position(float t) const { return origin + direction * t; }
 
-    NMRay Transformed(const NMMatrix& transform) const { return NMRay(transform * origin, transform * direction); }
+    /**
+     * @brief How fast the ray widens with distance: a pixel's width one unit along a camera ray, 0 for a thin ray.
+     * Hits use it as a distance based level of detail, e.g. to pick a texture's mip level.
+     */
+    float GetSpread() const { return spread; }
+    void SetSpread(float newSpread) { spread = newSpread; }
+
+    NMRay Transformed(const NMMatrix& transform) const
+    {
+        NMRay result(transform * origin, transform * direction);
+        result.spread = spread;
+        return result;
+    }
 
 protected:
 
     NMPoint origin;
     NMVector direction;
+    float spread = 0.0f;
 };
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+#include "NMCore/RT/Ray.hpp"
+#include "NMM/Matrix.hpp"
+
+static constexpr uint32_t RAY_PACKET_SIZE = 8;
+
+/**
+ * @brief Up to RAY_PACKET_SIZE rays stored lane by lane, for the batch intersection routines of the primitives.
+ * Lanes past count are zero rays; their results are meaningless and must be ignored.
+ */
+struct SNMRayPacket
+{
+    // [axis][lane]
+    float origin[3][RAY_PACKET_SIZE];
+    float direction[3][RAY_PACKET_SIZE];
+    uint32_t count;
+
+    SNMRayPacket() : count(0)
+    {
+        std::fill_n(&origin[0][0], 3 * RAY_PACKET_SIZE, 0.0f);
+        std::fill_n(&direction[0][0], 3 * RAY_PACKET_SIZE, 0.0f);
+    }
+
+    /**
+     * @brief Append a ray, the packet must not be full.
+     */
+    inline void Add(const NMRay& ray)
+    {
+        origin[0][count] = ray.GetOrigin().GetX();
+        origin[1][count] = ray.GetOrigin().GetY();
+        origin[2][count] = ray.GetOrigin().GetZ();
+        direction[0][count] = ray.GetDirection().GetX();
+        direction[1][count] = ray.GetDirection().GetY();
+        direction[2][count] = ray.GetDirection().GetZ();
+        ++count;
+    }
+
+    inline NMRay GetRay(uint32_t lane) const
+    {
+        return NMRay(NMPoint(origin[0][lane], origin[1][lane], origin[2][lane]),
+                     NMVector(direction[0][lane], direction[1][lane], direction[2][lane]));
+    }
+
+    /**
+     * @brief All rays transformed by a 4x4 matrix, e.g. into the object space of a primitive.
+     */
+    SNMRayPacket Transformed(const NMMatrix& transform) const
+    {
+        const float* m = transform.GetData();
+        SNMRayPacket result;
+        result.count = count;
+        for (uint32_t lane = 0; lane < RAY_PACKET_SIZE; ++lane)
+        {
+            const float ox = origin[0][lane];
+            const float oy = origin[1][lane];
+            const float oz = origin[2][lane];
+            const float dx = direction[0][lane];
+            const float dy = direction[1][lane];
+            const float dz = direction[2][lane];
+            for (int row = 0; row < 3; ++row)
+            {
+                const float* r = m + row * 4;
+                result.origin[row][lane] = r[0] * ox + r[1] * oy + r[2] * oz + r[3];
+                result.direction[row][lane] = r[0] * dx + r[1] * dy + r[2] * dz;
+            }
+        }
+
+        return result;
+    }
+};
+
+namespace nmpacket
+{
+/**
+ * @brief Fold a candidate hit into the nearest hit so far; candidates behind the ray or NaN are ignored.
+ * Written as a select so lane loops over it stay branch free.
+ */
+inline float Nearest(float t, float nearest) { return (t >= 0.0f && t < nearest) ? t : nearest; }
+
+inline float NoHit() { return std::numeric_limits<float>::infinity(); }
+}  // namespace nmpacket
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief A small, fast PCG32 random number generator (O'Neill, pcg-random.org).
+ *
+ * The sequence only depends on the seed and the stream, never on the platform or standard library, so renders that
+ * draw from it are reproducible everywhere. Every pixel gets its own stream (see ForPixel()), which makes the numbers a
+ * pixel sees independent of which thread renders it and in which order.
+ */
+class NMRandom
+{
+public:
+
+    explicit NMRandom(uint64_t seed, uint64_t stream = 0) : state(0), increment((stream << 1) | 1)
+    {
+        Next();
+        state += seed;
+        Next();
+    }
+
+    /**
+     * @brief The stream of a pixel (and sample) for a render seed.
+     */
+    static inline NMRandom ForPixel(uint64_t seed, uint32_t x, uint32_t y, uint32_t sample = 0)
+    {
+        return NMRandom(Mix(seed ^ Mix(sample)), (static_cast<uint64_t>(y) << 32) | x);
+    }
+
+    inline uint32_t Next()
+    {
+        uint64_t old = state;
+        state = old * 6364136223846793005ULL + increment;
+
+        uint32_t xorShifted = static_cast<uint32_t>(((old >> 18) ^ old) >> 27);
+        uint32_t rotation = static_cast<uint32_t>(old >> 59);
+        return (xorShifted >> rotation) | (xorShifted << ((32 - rotation) & 31));
+    }
+
+    /**
+     * @brief A uniform float in [0, 1).
+     */
+    inline float NextFloat() { return static_cast<float>(Next() >> 8) * (1.0f / 16777216.0f); }
+
+    /**
+     * @brief A uniform integer in [0, bound), without modulo bias.
+     */
+    inline uint32_t NextBelow(uint32_t bound)
+    {
+        if (bound <= 1)
+        {
+            return 0;
+        }
+
+        // Reject the values below 2^32 % bound so every residue is equally likely
+        uint32_t threshold = (0u - bound) % bound;
+        while (true)
+        {
+            uint32_t value = Next();
+            if (value >= threshold)
+            {
+                return value % bound;
+            }
+        }
+    }
+
+    /**
+     * @brief The SplitMix64 finalizer, used to turn structured inputs (seeds, counters) into well spread seeds.
+     */
+    static inline uint64_t Mix(uint64_t value)
+    {
+        value += 0x9E3779B97F4A7C15ULL;
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+        return value ^ (value >> 31);
+    }
+
+protected:
+
+    uint64_t state;
+    uint64_t increment;
+};
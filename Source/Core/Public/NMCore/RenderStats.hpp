@@ -0,0 +1,184 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "AlignedAllocator.hpp"
+
+// Set to 0 (or build with WITH_RENDER_STATS=OFF) to compile the hot path counters out entirely
+#ifndef NM_RENDER_STATS
+#    define NM_RENDER_STATS 1
+#endif
+
+enum class ENMRayType : uint8_t
+{
+    Primary = 0,
+    Shadow,
+    Reflection,
+    Refraction,
+
+    Count
+};
+
+constexpr std::size_t RAY_TYPE_COUNT = static_cast<std::size_t>(ENMRayType::Count);
+
+/**
+ * @brief The hot path counters of one render worker.
+ * Every worker owns one instance, aligned to a cache line so that workers never write to the same line.
+ */
+struct alignas(CACHE_LINE_SIZE) SNMRenderCounters
+{
+    uint64_t rays[RAY_TYPE_COUNT] = {};
+    uint64_t intersectionTests = 0;
+    uint64_t intersectionHits = 0;
+    uint64_t textureTileHits = 0;
+    uint64_t textureTileMisses = 0;
+    uint64_t textureBytesRead = 0;
+};
+
+/**
+ * @brief The wall time spent shading one tile.
+ */
+struct SNMTileTime
+{
+    std::size_t x;
+    std::size_t y;
+    double seconds;
+};
+
+/**
+ * @brief How one render worker spent the frame.
+ * busySeconds is the time spent shading tiles, queueWaitSeconds the time between the task being queued and a pool
+ * thread picking it up, and idleSeconds the rest of the frame.
+ */
+struct SNMWorkerStats
+{
+    std::size_t tiles = 0;
+    double busySeconds = 0.0;
+    double idleSeconds = 0.0;
+    double queueWaitSeconds = 0.0;
+};
+
+/**
+ * @brief The statistics of one call to NMCamera::Render.
+ * frameSeconds and tileCount are always filled in. Everything else is only collected when NM_RENDER_STATS is enabled,
+ * which is what `enabled` reports.
+ */
+struct SNMRenderStats
+{
+    bool enabled = NM_RENDER_STATS != 0;
+
+    double frameSeconds = 0.0;
+    std::size_t tileCount = 0;
+
+    uint64_t rays[RAY_TYPE_COUNT] = {};
+    uint64_t intersectionTests = 0;
+    uint64_t intersectionHits = 0;
+
+    // Tile lookups of out-of-core textures (see NMTextureCache) and the bytes their misses read from disk
+    uint64_t textureTileHits = 0;
+    uint64_t textureTileMisses = 0;
+    uint64_t textureBytesRead = 0;
+
+    std::vector<SNMWorkerStats> workers;
+    std::vector<SNMTileTime> tiles;
+
+    inline uint64_t GetRays(ENMRayType type) const { return rays[static_cast<std::size_t>(type)]; }
+
+    uint64_t TotalRays() const;
+
+    /**
+     * @brief The mean number of reflection bounces traced per primary ray.
+     */
+    double AverageReflectionDepth() const;
+
+    /**
+     * @brief The fraction of texture tile lookups that found the tile resident, 1 if there were none.
+     */
+    double TextureHitRate() const;
+
+    /**
+     * @brief The slowest tile of the frame, or 0 if no tile timings were collected.
+     */
+    double MaxTileSeconds() const;
+
+    /**
+     * @brief Add the counters of one worker to the frame totals.
+     */
+    void Accumulate(const SNMRenderCounters& counters);
+
+    /**
+     * @brief A single line JSON object with the totals and per-worker times (tile timings are left out).
+     */
+    std::string ToJSON() const;
+};
+
+using NMRenderCountersArray = std::vector<SNMRenderCounters, NMAlignedAllocator<SNMRenderCounters>>;
+
+/**
+ * @brief The times one render worker collects during a frame, copied into SNMRenderStats once the workers are done.
+ * Aligned to a cache line like SNMRenderCounters, so workers updating their times never write to the same line.
+ */
+struct alignas(CACHE_LINE_SIZE) SNMWorkerSlot
+{
+    SNMWorkerStats stats;
+    std::vector<SNMTileTime> tileTimes;
+};
+
+using NMWorkerSlotArray = std::vector<SNMWorkerSlot, NMAlignedAllocator<SNMWorkerSlot>>;
+
+namespace nmstats
+{
+/**
+ * @brief The counters of the render worker running on this thread, nullptr outside of NMCamera::Render.
+ */
+inline SNMRenderCounters*& CurrentCounters()
+{
+    static thread_local SNMRenderCounters* counters = nullptr;
+    return counters;
+}
+
+inline void CountRay(ENMRayType type)
+{
+#if NM_RENDER_STATS
+    if (SNMRenderCounters* counters = CurrentCounters())
+    {
+        ++counters->rays[static_cast<std::size_t>(type)];
+    }
+#else
+    (void)type;
+#endif
+}
+
+inline void CountIntersectionTest(bool hit)
+{
+#if NM_RENDER_STATS
+    if (SNMRenderCounters* counters = CurrentCounters())
+    {
+        ++counters->intersectionTests;
+        counters->intersectionHits += hit ? 1 : 0;
+    }
+#else
+    (void)hit;
+#endif
+}
+
+/**
+ * @param bytesRead The bytes a miss read from disk to load the tile.
+ */
+inline void CountTextureTile(bool hit, uint64_t bytesRead)
+{
+#if NM_RENDER_STATS
+    if (SNMRenderCounters* counters = CurrentCounters())
+    {
+        counters->textureTileHits += hit ? 1 : 0;
+        counters->textureTileMisses += hit ? 0 : 1;
+        counters->textureBytesRead += bytesRead;
+    }
+#else
+    (void)hit;
+    (void)bytesRead;
+#endif
+}
+}  // namespace nmstats
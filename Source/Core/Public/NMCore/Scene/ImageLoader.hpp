@@ -0,0 +1,29 @@
+#pragma once
+
+#include <istream>
+#include <string>
+
+#include "NMCore/Canvas.hpp"
+
+/**
+ * @brief Loader for Netpbm color images and Portable FloatMaps.
+ *
+ * Plain (P3) and binary (P6, 8 or 16 bits per channel) PPMs are scaled to [0, 1] by their maximum value; color (PF)
+ * and grayscale (Pf) PFMs keep their linear values and may be either byte order. Header comments are skipped.
+ */
+class NMImageLoader
+{
+public:
+
+    /**
+     * @brief Read an image from a stream.
+     * @throws std::runtime_error naming the source if the image is malformed or truncated.
+     */
+    static NMCanvas Load(std::istream& stream, const std::string& sourceName = "<image>");
+
+    /**
+     * @brief Read an image from a PPM or PFM file.
+     * @throws std::runtime_error if the file cannot be opened or is malformed.
+     */
+    static NMCanvas LoadFile(const std::string& path);
+};
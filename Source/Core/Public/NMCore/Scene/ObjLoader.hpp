@@ -0,0 +1,32 @@
+#pragma once
+
+#include <istream>
+#include <memory>
+#include <string>
+
+#include "NMCore/Primitive/TriangleMesh.hpp"
+
+/**
+ * @brief Loader for Wavefront OBJ meshes.
+ *
+ * The file is read in fixed size chunks and parsed in place, so memory is bounded by the mesh buffers themselves and
+ * no face allocates: polygons are fanned into triangles as their corners are read. `v`, `vn` and `f` statements are
+ * used (with `v`, `v/vt`, `v//vn` and `v/vt/vn` corners and negative, i.e. relative, indices); texture coordinates,
+ * groups, smoothing groups and materials are skipped.
+ */
+class NMObjLoader
+{
+public:
+
+    /**
+     * @brief Read a mesh from a stream.
+     * @throws NMSceneParseError with the line and column of the first malformed statement.
+     */
+    static std::shared_ptr<NMTriangleMesh> Load(std::istream& stream, const std::string& sourceName = "<obj>");
+
+    /**
+     * @brief Read a mesh from an OBJ file.
+     * @throws std::runtime_error if the file cannot be opened, NMSceneParseError if it is malformed.
+     */
+    static std::shared_ptr<NMTriangleMesh> LoadFile(const std::string& path);
+};
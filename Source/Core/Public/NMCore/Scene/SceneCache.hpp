@@ -0,0 +1,171 @@
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "NMCore/RT/BVH.hpp"
+#include "NMCore/Scene/SceneParser.hpp"
+
+static constexpr char SCENE_CACHE_MAGIC[4] = {'N', 'M', 'S', 'C'};
+static constexpr uint32_t SCENE_CACHE_VERSION = 1;
+
+enum class ENMCachedPrimitiveType : uint32_t
+{
+    Sphere = 0,
+    Plane = 1,
+};
+
+enum class ENMCachedPatternType : uint32_t
+{
+    Stripe = 0,
+    Gradient = 1,
+    Ring = 2,
+    Checker = 3,
+};
+
+/**
+ * @brief Fixed layout records of the binary scene cache.
+ * Every record is plain data in native byte order so a mapped file can be used without any decoding step.
+ * Transforms are stored row-major together with their precomputed inverses.
+ */
+struct SNMCachedPattern
+{
+    ENMCachedPatternType type;
+    float colorA[3];
+    float colorB[3];
+    float transform[16];
+    float inverseTransform[16];
+};
+
+struct SNMCachedMaterial
+{
+    float color[3];
+    float ambient;
+    float diffuse;
+    float specular;
+    float shininess;
+    float reflective;
+    float transparency;
+    float refractiveIndex;
+    int32_t pattern;  // index into the pattern table, -1 if the material has no pattern
+};
+
+struct SNMCachedPrimitive
+{
+    ENMCachedPrimitiveType type;
+    uint32_t material;
+    float origin[3];
+    float radius;
+    float transform[16];
+    float inverseTransform[16];
+};
+
+struct SNMCachedLight
+{
+    float position[3];
+    float color[3];
+};
+
+struct SNMSceneCacheHeader
+{
+    char magic[4];
+    uint32_t version;
+
+    uint32_t cameraWidth;
+    uint32_t cameraHeight;
+    float cameraFov;
+    uint32_t reflectionTraceDepth;
+    float cameraTransform[16];
+
+    uint64_t patternOffset;
+    uint64_t patternCount;
+    uint64_t materialOffset;
+    uint64_t materialCount;
+    uint64_t primitiveOffset;
+    uint64_t primitiveCount;
+    uint64_t lightOffset;
+    uint64_t lightCount;
+    uint64_t bvhNodeOffset;
+    uint64_t bvhNodeCount;
+    uint64_t bvhIndexOffset;
+    uint64_t bvhIndexCount;
+    uint64_t unboundedOffset;
+    uint64_t unboundedCount;
+};
+
+/**
+ * @brief A baked scene mapped read-only from disk.
+ *
+ * The cache holds the flattened primitives with their inverse transforms, the material and pattern tables, the
+ * lights, the camera and a prebuilt BVH. Loading it maps the file and validates the section table; no text is parsed
+ * and primitives are instantiated into one contiguous array per primitive type.
+ *
+ * Only spheres and planes whose patterns are stripes, gradients, rings or checkers have records; Write() rejects
+ * scenes with any other primitive (cubes, cylinders, cones, disks, meshes, groups, CSGs, SDFs, instances) or pattern
+ * (e.g. image patterns), which are parsed from text instead.
+ *
+ * @note The format uses native byte order and is meant as a local cache next to the source scene, not an
+ *       interchange format.
+ */
+class NMSceneCache
+{
+public:
+
+    /**
+     * @brief Map a cache file.
+     * @throws std::runtime_error if the file cannot be read or is not a valid cache of this version.
+     */
+    explicit NMSceneCache(const std::string& path);
+    ~NMSceneCache();
+
+    NMSceneCache(const NMSceneCache&) = delete;
+    NMSceneCache& operator=(const NMSceneCache&) = delete;
+
+    /**
+     * @brief Bake a scene into a cache file, building its BVH if the world does not have one yet.
+     * @throws std::runtime_error if the file cannot be written or the scene contains unsupported primitives or
+     *         patterns ("Scene cache does not support object i", "... the pattern of object i").
+     */
+    static void Write(const SNMScene& scene, const std::string& path);
+
+    /**
+     * @brief Create the world and camera described by the cache.
+     */
+    SNMScene Instantiate() const;
+
+    inline const SNMSceneCacheHeader& GetHeader() const { return *header; }
+
+    inline const SNMCachedPattern* GetPatterns() const { return Section<SNMCachedPattern>(header->patternOffset); }
+    inline const SNMCachedMaterial* GetMaterials() const { return Section<SNMCachedMaterial>(header->materialOffset); }
+    inline const SNMCachedPrimitive* GetPrimitives() const
+    {
+        return Section<SNMCachedPrimitive>(header->primitiveOffset);
+    }
+    inline const SNMCachedLight* GetLights() const { return Section<SNMCachedLight>(header->lightOffset); }
+    inline const SNMBVHNode* GetBVHNodes() const { return Section<SNMBVHNode>(header->bvhNodeOffset); }
+    inline const uint32_t* GetBVHIndices() const { return Section<uint32_t>(header->bvhIndexOffset); }
+    inline const uint32_t* GetUnbounded() const { return Section<uint32_t>(header->unboundedOffset); }
+
+    /**
+     * @brief True if the file starts with the cache magic, used to tell caches from text scenes.
+     */
+    static bool IsCacheFile(const std::string& path);
+
+protected:
+
+    const char* data = nullptr;
+    std::size_t size = 0;
+    const SNMSceneCacheHeader* header = nullptr;
+
+    // Fallback storage when the platform cannot map files
+    std::vector<char> buffer;
+
+    template <typename T> inline const T* Section(uint64_t offset) const
+    {
+        return reinterpret_cast<const T*>(data + offset);
+    }
+
+    void Validate(const std::string& path) const;
+};
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "NMCore/Scene/SceneParser.hpp"
+
+/**
+ * @brief The canonical scenes of the examples, shared by the CLI, benchmarks and image tests.
+ *
+ * - `default`: NMWorld::Default() seen from (0, 0, -5)
+ * - `sphere`: the lit sphere of Examples/3_RenderSphere
+ * - `first`: the room of Examples/4_FirstScene (walls are flattened spheres)
+ * - `plane`: the room of Examples/5_PlaneScene (walls are planes)
+ * - `application`: the patterned, reflective room shown by the SDL TestApplication
+ */
+class NMSceneLibrary
+{
+public:
+
+    static const std::vector<std::string>& GetNames();
+
+    /**
+     * @brief Build a canonical scene with a camera of the given size.
+     * @throws std::runtime_error if the name is not one of GetNames().
+     */
+    static SNMScene Create(const std::string& name, std::size_t width, std::size_t height);
+
+    /**
+     * @brief Build the world for a scene named in a job file.
+     * Canonical scene names are built in, any other name is loaded as a scene cache (see NMSceneCache) or a text
+     * scene file (see NMSceneParser). The returned world always has its BVH built.
+     * @throws std::runtime_error if the scene file cannot be read or parsed.
+     */
+    static NMWorld Load(const std::string& scene);
+};
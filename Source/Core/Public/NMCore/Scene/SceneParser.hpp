@@ -0,0 +1,103 @@
+#pragma once
+
+#include <stdexcept>
+#include <string>
+
+#include "NMCore/Camera.hpp"
+#include "NMCore/World.hpp"
+
+constexpr std::size_t DEFAULT_SCENE_WIDTH = 640;
+constexpr std::size_t DEFAULT_SCENE_HEIGHT = 480;
+
+/**
+ * @brief A world and the camera to look at it with, as loaded from a scene file.
+ */
+struct SNMScene
+{
+    NMWorld world;
+    NMCamera camera = NMCamera(DEFAULT_SCENE_WIDTH, DEFAULT_SCENE_HEIGHT, nmmath::thirdPi);
+};
+
+class NMSceneParseError : public std::runtime_error
+{
+public:
+
+    NMSceneParseError(const std::string& source, std::size_t line, std::size_t column, const std::string& message)
+        : std::runtime_error(source + ":" + std::to_string(line) + ":" + std::to_string(column) + ": " + message),
+          line(line),
+          column(column)
+    {
+    }
+
+    inline std::size_t GetLine() const { return line; }
+    inline std::size_t GetColumn() const { return column; }
+
+protected:
+
+    std::size_t line;
+    std::size_t column;
+};
+
+/**
+ * @brief Parser for the text scene format.
+ *
+ * A scene file is a list of statements, one per line. Each statement is a keyword followed by key/value arguments.
+ * `#` starts a comment that runs to the end of the line. Angles are in degrees and transform keys are multiplied in the
+ * order they are written (`translate ... rotate_y ...` is `Translation * RotationY`).
+ *
+ *     settings reflection_depth 5
+ *     camera width 1920 height 1080 fov 60 from 0 1.5 -5 to 0 1 0 up 0 1 0
+ *     light position -10 10 -10 color 1 1 1
+ *     pattern stripes stripe 0.5 1 0.1  0.1 1 0.5  scale 0.1 0.1 0.1
+ *     pattern earth image textures/earth.ppm spherical
+ *     material floor color 1 0.9 0.9 specular 0
+ *     sphere material floor pattern stripes diffuse 0.7 translate 1.5 0.5 -0.5 scale 0.5 0.5 0.5
+ *     plane material floor translate 0 0 5 rotate_y -45 rotate_x 90
+ *     cylinder minimum 0 maximum 2 closed material floor scale 0.5 1 0.5
+ *     mesh models/bunny.obj material floor scale 10 10 10
+ *     group translate 0 0 5 rotate_y 45
+ *         sphere translate 0 1 0
+ *         mesh models/bunny.obj rotate_x 90
+ *     end
+ *     csg difference translate 0 1 0
+ *         cube
+ *         sphere scale 1.3 1.3 1.3
+ *     end
+ *
+ * Patterns are `stripe`, `gradient`, `ring` or `checker`, each followed by its two colors, or `image` followed by a
+ * PPM or PFM file (see NMImageLoader) and optionally `planar`, `spherical` or `cylindrical` to map it with (see
+ * nmuv::Map, planar by default); patterns accept the transform keys. Image files load once, like meshes, and are
+ * sampled through a mip pyramid (see NMTexture); tiled texture files (see NMTextureCache) instead stay on disk and
+ * are paged in through a texture cache of `settings texture_cache_mb` megabytes, 256 by default, which has to come
+ * before the first of them. Materials accept `color`, `ambient`, `diffuse`, `specular`, `shininess`, `reflective`,
+ * `transparency`, `refractive_index` and `pattern`.
+ * Objects accept `material <name>`, any material key (applied on top of the named material) and the transform keys
+ * `translate`, `scale`, `rotate_x`, `rotate_y`, `rotate_z` and `shear`. The objects are `sphere`, `plane`, `cube`,
+ * `cylinder`, `cone`, `disk` and `mesh`; cylinders and cones also accept `minimum`, `maximum` and the flag `closed`.
+ * A `mesh` loads a Wavefront OBJ file (see NMObjLoader), relative paths are relative to the scene file. Each file is
+ * loaded once: every `mesh` statement is an NMInstance of the shared mesh. Objects between `group` and `end` form an
+ * NMGroup; the group accepts the transform keys, which apply to all of its objects, and groups nest. `csg` followed by
+ * `union`, `intersection` or `difference` and the transform keys combines the next two objects, up to its `end`, into
+ * an NMCSG.
+ */
+class NMSceneParser
+{
+public:
+
+    /**
+     * @brief Parse a scene from memory in a single pass.
+     * @throws NMSceneParseError with the line and column of the first error.
+     */
+    static SNMScene Parse(const char* data, std::size_t size, const std::string& sourceName = "<scene>");
+
+    static inline SNMScene Parse(const std::string& text, const std::string& sourceName = "<scene>")
+    {
+        return Parse(text.data(), text.size(), sourceName);
+    }
+
+    /**
+     * @brief Read and parse a scene file.
+     * @throws std::runtime_error if the file cannot be read, NMSceneParseError if it is malformed.
+     */
+    static SNMScene ParseFile(const std::string& path);
+};
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "NMCore/Light/Point.hpp"
+#include "NMCore/Material.hpp"
+#include "NMCore/RT/IntersectionState.hpp"
+#include "NMCore/RT/RayPacket.hpp"
+#include "NMM/Util.hpp"
+
+// Hits are shaded in packets as wide as the ray packets
+static constexpr uint32_t SHADING_PACKET_SIZE = RAY_PACKET_SIZE;
+
+// A hit's shadows are one bit per light
+static constexpr std::size_t SHADING_PACKET_MAX_LIGHTS = 32;
+
+/**
+ * @brief Up to SHADING_PACKET_SIZE hits stored lane by lane with the lighting terms of their materials, for
+ * nmshade::Lighting(). Lanes past count are zero hits; their results are meaningless and must be ignored.
+ */
+struct SNMShadingPacket
+{
+    // [axis][lane]
+    float point[3][SHADING_PACKET_SIZE];
+    float normal[3][SHADING_PACKET_SIZE];
+    float eye[3][SHADING_PACKET_SIZE];
+
+    // The surface color after the pattern, [channel][lane]
+    float color[3][SHADING_PACKET_SIZE];
+
+    float ambient[SHADING_PACKET_SIZE];
+    float diffuse[SHADING_PACKET_SIZE];
+    float specular[SHADING_PACKET_SIZE];
+    float shininess[SHADING_PACKET_SIZE];
+
+    // Bit i is set if the hit is in the shadow of light i
+    uint32_t shadowMask[SHADING_PACKET_SIZE];
+
+    uint32_t count;
+
+    SNMShadingPacket() : count(0)
+    {
+        std::fill_n(&point[0][0], 3 * SHADING_PACKET_SIZE, 0.0f);
+        std::fill_n(&normal[0][0], 3 * SHADING_PACKET_SIZE, 0.0f);
+        std::fill_n(&eye[0][0], 3 * SHADING_PACKET_SIZE, 0.0f);
+        std::fill_n(&color[0][0], 3 * SHADING_PACKET_SIZE, 0.0f);
+        std::fill_n(ambient, SHADING_PACKET_SIZE, 0.0f);
+        std::fill_n(diffuse, SHADING_PACKET_SIZE, 0.0f);
+        std::fill_n(specular, SHADING_PACKET_SIZE, 0.0f);
+        std::fill_n(shininess, SHADING_PACKET_SIZE, 1.0f);
+        std::fill_n(shadowMask, SHADING_PACKET_SIZE, 0u);
+    }
+
+    /**
+     * @brief Append a hit whose surface color is known, the packet must not be full.
+     */
+    inline void Add(const NMMaterial& material, const NMColor& surfaceColor, const NMPoint& hitPoint,
+                    const NMVector& eyeVector, const NMVector& normalVector, uint32_t hitShadowMask)
+    {
+        point[0][count] = hitPoint.GetX();
+        point[1][count] = hitPoint.GetY();
+        point[2][count] = hitPoint.GetZ();
+        normal[0][count] = normalVector.GetX();
+        normal[1][count] = normalVector.GetY();
+        normal[2][count] = normalVector.GetZ();
+        eye[0][count] = eyeVector.GetX();
+        eye[1][count] = eyeVector.GetY();
+        eye[2][count] = eyeVector.GetZ();
+        color[0][count] = surfaceColor.GetRed();
+        color[1][count] = surfaceColor.GetGreen();
+        color[2][count] = surfaceColor.GetBlue();
+        ambient[count] = material.GetAmbient();
+        diffuse[count] = material.GetDiffuse();
+        specular[count] = material.GetSpecular();
+        shininess[count] = material.GetShininess();
+        shadowMask[count] = hitShadowMask;
+        ++count;
+    }
+
+    /**
+     * @brief Append a hit, looking up its surface color, the packet must not be full.
+     */
+    inline void Add(const SNMIntersectionState& state, uint32_t hitShadowMask)
+    {
+        const NMMaterial& material = state.object->GetMaterial();
+        Add(material, material.SurfaceColor(*state.object, state.point, state.footprint), state.point,
+            state.eyeVector, state.normalVector, hitShadowMask);
+    }
+};
+
+namespace nmshade
+{
+/**
+ * @brief The lighting of every hit of a packet by all lights, the sum of NMMaterial::Lighting() over the lights.
+ *
+ * Lights are the outer loop and lanes the inner one, so a light's position and color are loaded once per packet and
+ * the shading lane loop is branch free (the lit, shadowed and specular cases are 0/1 factors, the specular power is
+ * nmmath::FastPow()) for the compiler to vectorize. Only the square roots are taken lane by lane.
+ *
+ * @param result [channel][lane], overwritten.
+ * @throws std::runtime_error if there are more than SHADING_PACKET_MAX_LIGHTS lights.
+ */
+inline void Lighting(const SNMShadingPacket& packet, const std::vector<NMPointLight>& lights,
+                     float result[3][SHADING_PACKET_SIZE])
+{
+    if (lights.size() > SHADING_PACKET_MAX_LIGHTS)
+    {
+        throw std::runtime_error("Too many lights for a shading packet");
+    }
+
+    // Summed locally, the compiler cannot tell result apart from the packet
+    float sum[3][SHADING_PACKET_SIZE];
+    std::fill_n(&sum[0][0], 3 * SHADING_PACKET_SIZE, 0.0f);
+
+    for (std::size_t index = 0; index < lights.size(); ++index)
+    {
+        const NMPointLight& light = lights[index];
+        const float lightX = light.GetPosition().GetX();
+        const float lightY = light.GetPosition().GetY();
+        const float lightZ = light.GetPosition().GetZ();
+        const float lightColor[3] = {light.GetColor().GetRed(), light.GetColor().GetGreen(),
+                                     light.GetColor().GetBlue()};
+        const uint32_t shadowBit = 1u << index;
+
+        // The square roots keep their errno branch, so they get a loop of their own
+        float distance[SHADING_PACKET_SIZE];
+        for (uint32_t lane = 0; lane < SHADING_PACKET_SIZE; ++lane)
+        {
+            const float lx = lightX - packet.point[0][lane];
+            const float ly = lightY - packet.point[1][lane];
+            const float lz = lightZ - packet.point[2][lane];
+            distance[lane] = std::sqrt(lx * lx + ly * ly + lz * lz);
+        }
+
+        for (uint32_t lane = 0; lane < SHADING_PACKET_SIZE; ++lane)
+        {
+            const float nx = packet.normal[0][lane];
+            const float ny = packet.normal[1][lane];
+            const float nz = packet.normal[2][lane];
+            const float ex = packet.eye[0][lane];
+            const float ey = packet.eye[1][lane];
+            const float ez = packet.eye[2][lane];
+
+            const float lx = (lightX - packet.point[0][lane]) / distance[lane];
+            const float ly = (lightY - packet.point[1][lane]) / distance[lane];
+            const float lz = (lightZ - packet.point[2][lane]) / distance[lane];
+
+            // See NMMaterial::Lighting for the terms
+            const float lightDotNormal = lx * nx + ly * ny + lz * nz;
+            const float normalDotEye = nx * ex + ny * ey + nz * ez;
+            const float reflectDotEye = 2.0f * lightDotNormal * normalDotEye - (lx * ex + ly * ey + lz * ez);
+
+            // The cases are 0/1 factors, selects around the products or logical ands would be branches. The power of a
+            // non positive base is finite garbage that the specular factor zeroes.
+            const bool lit = (lightDotNormal >= 0.0f) & ((packet.shadowMask[lane] & shadowBit) == 0);
+            const float diffuseFactor = lit ? 1.0f : 0.0f;
+            const float specularFactor = lit & (reflectDotEye > 0.0f) ? 1.0f : 0.0f;
+
+            const float power = nmmath::FastPow(reflectDotEye, packet.shininess[lane]);
+            const float surfaceTerm = packet.ambient[lane] + diffuseFactor * packet.diffuse[lane] * lightDotNormal;
+            const float specularTerm = specularFactor * packet.specular[lane] * power;
+
+            for (int channel = 0; channel < 3; ++channel)
+            {
+                sum[channel][lane] += packet.color[channel][lane] * lightColor[channel] * surfaceTerm
+                                         + lightColor[channel] * specularTerm;
+            }
+        }
+    }
+
+    std::copy_n(&sum[0][0], 3 * SHADING_PACKET_SIZE, &result[0][0]);
+}
+}  // namespace nmshade
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+
+/**
+ * @brief A flag that asks a render to stop as soon as possible.
+ * Render workers publish their camera's token with nmstop::CurrentToken(), so code deep inside a pixel (e.g.
+ * NMWorld::ReflectedColor()) can give up on the remaining bounces without the token being passed down to it.
+ */
+class NMStopToken
+{
+public:
+
+    NMStopToken() = default;
+
+    inline void RequestStop() { stopRequested.store(true, std::memory_order_relaxed); }
+    inline void Reset() { stopRequested.store(false, std::memory_order_relaxed); }
+    inline bool IsStopRequested() const { return stopRequested.load(std::memory_order_relaxed); }
+
+protected:
+
+    std::atomic<bool> stopRequested{false};
+};
+
+namespace nmstop
+{
+/**
+ * @brief The stop token of the render worker running on this thread, nullptr outside of NMCamera::Render.
+ */
+inline const NMStopToken*& CurrentToken()
+{
+    static thread_local const NMStopToken* token = nullptr;
+    return token;
+}
+
+/**
+ * @brief Whether the render running on this thread was asked to stop. Colors computed after this turned true are
+ *        incomplete and must be discarded.
+ */
+inline bool IsStopRequested()
+{
+    const NMStopToken* token = CurrentToken();
+    return token && token->IsStopRequested();
+}
+}  // namespace nmstop
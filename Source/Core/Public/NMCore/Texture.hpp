@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "Canvas.hpp"
+#include "Color.hpp"
+
+/**
+ * @brief A mip pyramid of an image and its filtering, independent of where the texels live.
+ *
+ * Texture coordinates wrap: u runs left to right and v bottom to top over [0, 1). Level 0 is the full resolution,
+ * every further level half the size of the one above down to a single texel.
+ */
+class NMTextureBase
+{
+public:
+
+    virtual ~NMTextureBase() = default;
+
+    virtual std::size_t GetLevelCount() const = 0;
+    virtual std::size_t GetLevelWidth(std::size_t level) const = 0;
+    virtual std::size_t GetLevelHeight(std::size_t level) const = 0;
+
+    inline std::size_t GetWidth() const { return GetLevelWidth(0); }
+    inline std::size_t GetHeight() const { return GetLevelHeight(0); }
+
+    /**
+     * @brief Read the four texels bilinear filtering blends, in the order (x0, y0), (x1, y0), (x0, y1), (x1, y1).
+     */
+    virtual void ReadQuad(std::size_t level, std::size_t x0, std::size_t x1, std::size_t y0, std::size_t y1,
+                          NMColor texels[4]) const = 0;
+
+    /**
+     * @brief Bilinear filtering between the four texels around (u, v) of one level.
+     */
+    NMColor SampleBilinear(float u, float v, std::size_t level = 0) const;
+
+    /**
+     * @brief Bilinear samples of the two levels around a fractional level, blended (trilinear filtering).
+     * @param levelOfDetail Clamped to the pyramid, see LevelOfDetail().
+     */
+    NMColor SampleTrilinear(float u, float v, float levelOfDetail) const;
+
+    /**
+     * @brief The level whose texels are about the size of a footprint.
+     * @param footprint The width of the area to sample as a fraction of the texture's width.
+     */
+    inline float LevelOfDetail(float footprint) const
+    {
+        float texels = footprint * static_cast<float>(GetWidth());
+        return texels > 1.0f ? std::log2(texels) : 0.0f;
+    }
+};
+
+/**
+ * @brief An image prepared for sampling: a mip pyramid of tiled canvases held in memory.
+ *
+ * The pyramid is built once, each level averaging 2x2 pixels of the one above, so a sample covering many pixels reads
+ * a few from a smaller level instead of aliasing. Levels use the tiled canvas layout so the neighbouring pixels
+ * bilinear filtering reads, and nearby pixels sampling the same area, share cache lines.
+ */
+class NMTexture : public NMTextureBase
+{
+public:
+
+    /**
+     * @throws std::runtime_error if the image is empty.
+     */
+    explicit NMTexture(const NMCanvas& image);
+
+    inline const NMCanvas& GetLevel(std::size_t level) const { return levels[level]; }
+
+    virtual std::size_t GetLevelCount() const override { return levels.size(); }
+    virtual std::size_t GetLevelWidth(std::size_t level) const override { return levels[level].GetWidth(); }
+    virtual std::size_t GetLevelHeight(std::size_t level) const override { return levels[level].GetHeight(); }
+
+    virtual void ReadQuad(std::size_t level, std::size_t x0, std::size_t x1, std::size_t y0, std::size_t y1,
+                          NMColor texels[4]) const override
+    {
+        const NMCanvas& canvas = levels[level];
+        texels[0] = canvas.ReadPixel(x0, y0);
+        texels[1] = canvas.ReadPixel(x1, y0);
+        texels[2] = canvas.ReadPixel(x0, y1);
+        texels[3] = canvas.ReadPixel(x1, y1);
+    }
+
+protected:
+
+    std::vector<NMCanvas> levels;
+};
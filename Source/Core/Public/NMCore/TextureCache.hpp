@@ -0,0 +1,181 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Texture.hpp"
+
+static constexpr char TEXTURE_FILE_MAGIC[4] = {'N', 'M', 'T', 'X'};
+static constexpr uint32_t TEXTURE_FILE_VERSION = 1;
+static constexpr uint32_t TEXTURE_FILE_MAX_LEVELS = 32;
+
+// The width and height of a texture tile in texels, a tile of RGB floats is 12 KiB
+static constexpr uint32_t TEXTURE_TILE_SIZE = 32;
+static constexpr std::size_t TEXTURE_TILE_FLOATS = TEXTURE_TILE_SIZE * TEXTURE_TILE_SIZE * 3;
+static constexpr std::size_t TEXTURE_TILE_BYTES = TEXTURE_TILE_FLOATS * sizeof(float);
+
+static constexpr std::size_t DEFAULT_TEXTURE_CACHE_BYTES = std::size_t(256) << 20;
+
+/**
+ * @brief Fixed layout records of the tiled texture file.
+ * Like the scene cache the records are plain data in native byte order. Every level is cut into square tiles of RGB
+ * floats, row by row; tiles on the right and bottom edges are padded to the full size so tile i of the file starts at
+ * dataOffset + i * TEXTURE_TILE_BYTES.
+ */
+struct SNMTextureFileLevel
+{
+    uint32_t width;
+    uint32_t height;
+    uint32_t tilesX;
+    uint32_t tilesY;
+    uint64_t firstTile;
+};
+
+struct SNMTextureFileHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t tileSize;
+    uint32_t levelCount;
+    uint64_t tileCount;
+    uint64_t dataOffset;
+    SNMTextureFileLevel levels[TEXTURE_FILE_MAX_LEVELS];
+};
+
+/**
+ * @brief A bounded pool of texture tiles loaded on demand from tiled texture files.
+ *
+ * The pool is sized once from the memory budget. Looking up a resident tile takes no lock: every tile of an open file
+ * has an atomic entry naming its slot, and a reader pins the slot with a reference count before reading it. Misses
+ * take the cache's lock only to pick a slot, read the tile with pread() outside of it and publish the slot. Slots are
+ * reclaimed in CLOCK order, the usual approximation of LRU whose hits only set a flag instead of reordering a list;
+ * pinned slots are never reclaimed.
+ *
+ * Lookups and the bytes misses read are counted per render worker (see nmstats::CountTextureTile) and reported with
+ * the frame's SNMRenderStats.
+ */
+class NMTextureCache
+{
+public:
+
+    /**
+     * @param memoryBudget The bytes of tile data to keep resident, at least MIN_RESIDENT_TILES tiles.
+     */
+    explicit NMTextureCache(std::size_t memoryBudget = DEFAULT_TEXTURE_CACHE_BYTES);
+    ~NMTextureCache();
+
+    NMTextureCache(const NMTextureCache&) = delete;
+    NMTextureCache& operator=(const NMTextureCache&) = delete;
+
+    // Enough slots for every render worker to hold a pinned tile while others are loaded
+    static constexpr std::size_t MIN_RESIDENT_TILES = 64;
+
+    /**
+     * @brief Write the pyramid of a texture as a tiled texture file.
+     * @throws std::runtime_error if the file cannot be written or the texture has too many levels.
+     */
+    static void WriteFile(const NMTexture& texture, const std::string& path);
+
+    /**
+     * @brief True if the file starts with the tiled texture magic, used to tell them from images.
+     */
+    static bool IsTextureFile(const std::string& path);
+
+    inline std::size_t GetCapacity() const { return capacity; }
+    std::size_t GetResidentTiles() const;
+
+protected:
+
+    friend class NMCachedTexture;
+
+    static constexpr uint32_t NO_SLOT = UINT32_MAX;
+
+    struct SNMFile
+    {
+        std::string path;
+        SNMTextureFileHeader header;
+
+        // Per tile of the file: its slot + 1, 0 while the tile is not resident
+        std::unique_ptr<std::atomic<uint32_t>[]> slots;
+
+#ifndef _WIN32
+        int descriptor = -1;
+#else
+        std::ifstream stream;
+        std::mutex streamMutex;
+#endif
+    };
+
+    // The tile a slot holds; file is null for free slots and slots being loaded
+    struct SNMSlotOwner
+    {
+        SNMFile* file = nullptr;
+        uint64_t tile = 0;
+    };
+
+    std::size_t capacity;
+    std::unique_ptr<float[]> tileData;
+    std::unique_ptr<std::atomic<uint32_t>[]> pins;
+    std::unique_ptr<std::atomic<uint8_t>[]> referenced;
+
+    // Guarded by mutex
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<SNMFile>> files;
+    std::vector<SNMSlotOwner> owners;
+    std::vector<uint32_t> freeSlots;
+    std::size_t clockHand = 0;
+    std::size_t residentTiles = 0;
+
+    /**
+     * @brief Open a tiled texture file, files already open are shared.
+     * @throws std::runtime_error if the file cannot be read or is not a valid texture file of this version.
+     */
+    SNMFile& Open(const std::string& path);
+
+    /**
+     * @brief The texels of a tile, loading it if needed. The tile stays resident until Unpin(slot).
+     * @throws std::runtime_error if the tile cannot be read.
+     */
+    const float* Pin(SNMFile& file, uint64_t tile, uint32_t& slot);
+
+    inline void Unpin(uint32_t slot) { pins[slot].fetch_sub(1, std::memory_order_release); }
+
+    // Both called with the mutex held
+    uint32_t ReclaimSlot();
+    const float* LoadTile(std::unique_lock<std::mutex>& lock, SNMFile& file, uint64_t tile, uint32_t& slot);
+
+    void ReadTile(SNMFile& file, uint64_t tile, float* out);
+};
+
+/**
+ * @brief A texture whose texels stay on disk in a tiled texture file and are paged in through an NMTextureCache.
+ */
+class NMCachedTexture : public NMTextureBase
+{
+public:
+
+    /**
+     * @throws std::runtime_error if the file cannot be opened or is not a valid texture file.
+     */
+    NMCachedTexture(std::shared_ptr<NMTextureCache> cache, const std::string& path);
+
+    virtual std::size_t GetLevelCount() const override { return file->header.levelCount; }
+    virtual std::size_t GetLevelWidth(std::size_t level) const override { return file->header.levels[level].width; }
+    virtual std::size_t GetLevelHeight(std::size_t level) const override
+    {
+        return file->header.levels[level].height;
+    }
+
+    virtual void ReadQuad(std::size_t level, std::size_t x0, std::size_t x1, std::size_t y0, std::size_t y1,
+                          NMColor texels[4]) const override;
+
+protected:
+
+    std::shared_ptr<NMTextureCache> cache;
+    NMTextureCache::SNMFile* file;
+};
@@ -1,11 +1,16 @@
+#pragma once
+
 #include <condition_variable>
 #include <functional>
 #include <iostream>
 #include <mutex>
 #include <queue>
+#include <string>
 #include <thread>
 #include <vector>
 
+#include "Trace.hpp"
+
 class ThreadPool
 {
 public:
@@ -14,7 +19,12 @@ public:
     {
         for (std::size_t i = 0; i < numThreads; ++i)
         {
-            workers.emplace_back([this] { this->RunTask(); });
+            workers.emplace_back(
+                [this, i]
+                {
+                    NMTrace::SetThreadName("Pool worker " + std::to_string(i));
+                    this->RunTask();
+                });
         }
     }
 
@@ -31,6 +41,8 @@ public:
         }
     }
 
+    inline std::size_t GetThreadCount() const { return workers.size(); }
+
     template <class F> void Enqueue(F&& f)
     {
         {
@@ -40,13 +52,34 @@ public:
         condition.notify_one();
     }
 
-    void Cancel()
+    /**
+     * @brief Block until the queue is empty and no task is running.
+     */
+    void Wait()
+    {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        idleCondition.wait(lock, [this] { return tasks.empty() && activeTasks == 0; });
+    }
+
+    /**
+     * @brief Drop every queued task without running it. Running tasks finish, and the pool stays usable.
+     * The dropped tasks (and whatever they captured) are destroyed before this returns, outside of the queue lock so
+     * workers are not held up by it.
+     * @return The number of dropped tasks.
+     */
+    std::size_t Cancel()
     {
+        std::queue<std::function<void()>> dropped;
         {
             std::unique_lock<std::mutex> lock(queueMutex);
-            cancel = true;
+            dropped.swap(tasks);
+            if (activeTasks == 0)
+            {
+                idleCondition.notify_all();
+            }
         }
-        condition.notify_all();
+
+        return dropped.size();
     }
 
 protected:
@@ -58,7 +91,8 @@ protected:
     std::mutex stopMutex;
     std::condition_variable condition;
     std::condition_variable stopCondition;
-    bool cancel = false;
+    std::condition_variable idleCondition;
+    std::size_t activeTasks = 0;
     bool stop = false;
     bool stopWhenEmpty = true;
 
@@ -69,19 +103,40 @@ protected:
             std::function<void()> task;
 
             {
-                std::unique_lock<std::mutex> lock(queueMutex);
-                condition.wait(lock, [this] { return stop || cancel || (stopWhenEmpty && !tasks.empty()); });
+                std::unique_lock<std::mutex> lock(queueMutex, std::defer_lock);
+                {
+                    NMTraceScope trace("LockWait", "pool");
+                    lock.lock();
+                }
+
+                {
+                    NMTraceScope trace("Idle", "pool");
+                    condition.wait(lock, [this] { return stop || (stopWhenEmpty && !tasks.empty()); });
+                }
 
-                if ((stop && tasks.empty()) || cancel)
+                if (stop && tasks.empty())
                 {
                     return;
                 }
 
                 task = std::move(tasks.front());
                 tasks.pop();
+                ++activeTasks;
+            }
+
+            {
+                NMTraceScope trace("Task", "pool");
+                task();
             }
 
-            task();
+            {
+                std::unique_lock<std::mutex> lock(queueMutex);
+                --activeTasks;
+                if (tasks.empty() && activeTasks == 0)
+                {
+                    idleCondition.notify_all();
+                }
+            }
         }
     }
 };
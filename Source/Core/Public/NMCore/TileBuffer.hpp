@@ -0,0 +1,88 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "AlignedAllocator.hpp"
+#include "Canvas.hpp"
+#include "Color.hpp"
+
+constexpr std::size_t RENDER_TILE_SIZE = 16;
+constexpr std::size_t RENDER_TILE_AREA = RENDER_TILE_SIZE * RENDER_TILE_SIZE;
+
+static_assert(RENDER_TILE_SIZE % CANVAS_TILE_SIZE == 0, "Render tiles must cover whole canvas tiles");
+
+/**
+ * @brief A rectangular region of the image that is rendered as one unit of work.
+ */
+struct SNMTile
+{
+    std::size_t x = 0;
+    std::size_t y = 0;
+    std::size_t width = 0;
+    std::size_t height = 0;
+
+    SNMTile() = default;
+    SNMTile(std::size_t x, std::size_t y, std::size_t width, std::size_t height)
+        : x(x), y(y), width(width), height(height)
+    {
+    }
+
+    inline std::size_t Area() const { return width * height; }
+
+    /**
+     * @brief Split an image into row-major tiles of at most tileSize pixels square.
+     */
+    static std::vector<SNMTile> Split(std::size_t imageWidth, std::size_t imageHeight,
+                                      std::size_t tileSize = RENDER_TILE_SIZE)
+    {
+        std::vector<SNMTile> tiles;
+        for (std::size_t y = 0; y < imageHeight; y += tileSize)
+        {
+            for (std::size_t x = 0; x < imageWidth; x += tileSize)
+            {
+                tiles.emplace_back(x, y, std::min(tileSize, imageWidth - x), std::min(tileSize, imageHeight - y));
+            }
+        }
+
+        return tiles;
+    }
+};
+
+/**
+ * @brief Worker-local storage for the pixels of one tile.
+ * Render workers shade into the buffer and then flush it into the canvas with a single block write, so the shared
+ * canvas is only touched once per tile instead of once per pixel.
+ */
+class alignas(CACHE_LINE_SIZE) NMTileBuffer
+{
+public:
+
+    NMTileBuffer() = default;
+    explicit NMTileBuffer(const SNMTile& tile) : tile(tile) {}
+
+    inline const SNMTile& GetTile() const { return tile; }
+    inline void Reset(const SNMTile& newTile) { tile = newTile; }
+
+    inline const NMColor& Get(std::size_t localX, std::size_t localY) const
+    {
+        return pixels[localY * RENDER_TILE_SIZE + localX];
+    }
+
+    inline void Set(std::size_t localX, std::size_t localY, const NMColor& color)
+    {
+        pixels[localY * RENDER_TILE_SIZE + localX] = color;
+    }
+
+    inline void FlushTo(NMCanvas& canvas) const
+    {
+        canvas.WriteBlock(tile.x, tile.y, std::min(tile.width, RENDER_TILE_SIZE),
+                          std::min(tile.height, RENDER_TILE_SIZE), pixels.data(), RENDER_TILE_SIZE);
+    }
+
+protected:
+
+    SNMTile tile;
+    std::array<NMColor, RENDER_TILE_AREA> pixels;
+};
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+constexpr std::size_t TRACE_DEFAULT_CAPACITY = 1 << 16;
+
+/**
+ * @brief One complete (begin + duration) event of the trace timeline.
+ * Names and categories must be string literals (or otherwise outlive the trace), only the pointers are stored.
+ */
+struct SNMTraceEvent
+{
+    const char* name;
+    const char* category;
+    uint64_t start;
+    uint64_t duration;
+    int64_t id;
+};
+
+/**
+ * @brief A process-wide timeline of scoped events, written as Chrome trace-event JSON (chrome://tracing, Perfetto).
+ *
+ * Every thread records into its own fixed size ring buffer without locks; when a buffer is full the oldest events are
+ * overwritten. The buffer is allocated on the thread's first event and reused by later sessions; when the thread exits
+ * its buffer, and the events in it, pass to the next new thread, so the memory is bounded by the peak thread count.
+ * Recording is switched on and off at runtime, a disabled trace costs one relaxed atomic load per event.
+ *
+ * @note Start(), Stop() and WriteChromeJSON() must not be called while other threads are recording, e.g. call them
+ *       between frames.
+ */
+class NMTrace
+{
+public:
+
+    /**
+     * @brief Clear all buffers and start recording.
+     * @param eventsPerThread The ring buffer capacity of every thread.
+     */
+    static void Start(std::size_t eventsPerThread = TRACE_DEFAULT_CAPACITY);
+
+    static void Stop();
+
+    static inline bool IsEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Nanoseconds since the trace was started.
+     */
+    static uint64_t Now();
+
+    /**
+     * @brief Record an event on the calling thread's timeline. Does nothing while the trace is disabled.
+     * @param id An optional value shown in the event's arguments (e.g. a tile or frame number), -1 for none.
+     */
+    static void Record(const char* name, const char* category, uint64_t start, uint64_t end, int64_t id = -1);
+
+    /**
+     * @brief Name the calling thread's timeline. May be called at any time, also while the trace is disabled.
+     */
+    static void SetThreadName(const std::string& name);
+
+    /**
+     * @brief The number of events currently held in all buffers.
+     */
+    static std::size_t GetEventCount();
+
+    /**
+     * @brief The number of events overwritten because a thread's buffer was full.
+     */
+    static uint64_t GetDroppedCount();
+
+    /**
+     * @brief Write the recorded events as a Chrome trace-event JSON object.
+     */
+    static void WriteChromeJSON(std::ostream& os);
+
+protected:
+
+    static std::atomic<bool> enabled;
+};
+
+/**
+ * @brief Records the lifetime of the scope as one trace event.
+ */
+class NMTraceScope
+{
+public:
+
+    NMTraceScope(const char* name, const char* category, int64_t id = -1)
+        : name(name), category(category), id(id), active(NMTrace::IsEnabled()), start(active ? NMTrace::Now() : 0)
+    {
+    }
+
+    ~NMTraceScope()
+    {
+        if (active)
+        {
+            NMTrace::Record(name, category, start, NMTrace::Now(), id);
+        }
+    }
+
+    NMTraceScope(const NMTraceScope&) = delete;
+    NMTraceScope& operator=(const NMTraceScope&) = delete;
+
+protected:
+
+    const char* name;
+    const char* category;
+    int64_t id;
+    bool active;
+    uint64_t start;
+};
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -8,8 +10,11 @@
 #include "NMM/Point.hpp"
 #include "NMM/Vector.hpp"
 #include "Primitive/Sphere.hpp"
+#include "RT/BVH.hpp"
 #include "RT/IntersectionList.hpp"
 #include "RT/IntersectionState.hpp"
+#include "RenderStats.hpp"
+#include "StopToken.hpp"
 
 struct SNMWorldSettings
 {
@@ -33,6 +38,9 @@ public:
 
     NMWorld(SNMWorldSettings worldSettings = SNMWorldSettings()) : worldSettings(worldSettings) {}
 
+    inline const SNMWorldSettings& GetSettings() const { return worldSettings; }
+    inline void SetSettings(const SNMWorldSettings& newSettings) { worldSettings = newSettings; }
+
     static NMWorld Default()
     {
         NMWorld world;
@@ -42,12 +50,12 @@ public:
         // Create a unit sphere
         std::shared_ptr<NMSphere> outerSphere = std::make_shared<NMSphere>();
         outerSphere->SetMaterial(NMMaterial(NMColor(0.8f, 1.0f, 0.6f), 0.1f, 0.7f, 0.2f, 200.0f));
-        world.objects.push_back(outerSphere);
+        world.AddObject(outerSphere);
 
         // Create an inner sphere
         std::shared_ptr<NMSphere> innerSphere = std::make_shared<NMSphere>();
         innerSphere->SetTransform(NMMatrix::Scaling(0.5f, 0.5f, 0.5f));
-        world.objects.push_back(innerSphere);
+        world.AddObject(innerSphere);
 
         return world;
     }
@@ -56,6 +64,8 @@ public:
 
     inline std::size_t GetPointLightCount() const { return pointLights.size(); }
 
+    inline const std::vector<NMPointLight>& GetPointLights() const { return pointLights; }
+
     inline void AddLight(const NMPointLight& light) { pointLights.push_back(light); }
 
     inline void SetLight(std::size_t index, const NMPointLight& light)
@@ -72,15 +82,103 @@ public:
 
     inline std::size_t GetObjectCount() const { return objects.size(); }
 
-    inline void AddObject(std::shared_ptr<NMPrimitiveBase> object) { objects.push_back(object); }
+    /**
+     * @brief Add an object and compile it (see NMPrimitiveBase::Compile()), so groups and CSGs render correctly even
+     *        without BuildBVH().
+     * @note Complete a group before adding it; changes made afterwards are compiled by BuildBVH().
+     */
+    inline void AddObject(std::shared_ptr<NMPrimitiveBase> object)
+    {
+        object->SetGeometryRevision(geometryRevision);
+        object->Compile();
+        objects.push_back(std::move(object));
+    }
+
+    inline void ReserveObjects(std::size_t count) { objects.reserve(count); }
+
+    /**
+     * @brief Compile the objects and build a bounding volume hierarchy over the bounded ones.
+     * Unbounded objects (e.g. planes) are kept in a separate list and always tested.
+     * @note The hierarchy is ignored once objects are added or any primitive of the world is moved (see
+     *       GetGeometryRevision()) afterwards; call this again after changing objects.
+     */
+    void BuildBVH()
+    {
+        std::vector<SNMBounds> bounds;
+        std::vector<uint32_t> ids;
+        std::vector<uint32_t> unbounded;
+
+        for (std::size_t i = 0; i < objects.size(); ++i)
+        {
+            objects[i]->Compile();
+            SNMBounds objectBounds = objects[i]->WorldBounds();
+            if (objectBounds.IsFinite())
+            {
+                bounds.push_back(objectBounds);
+                ids.push_back(static_cast<uint32_t>(i));
+            }
+            else
+            {
+                unbounded.push_back(static_cast<uint32_t>(i));
+            }
+        }
+
+        NMBVH newBvh;
+        newBvh.Build(bounds, ids);
+        SetBVH(std::move(newBvh), std::move(unbounded));
+    }
+
+    /**
+     * @brief Use a prebuilt hierarchy whose ids index the objects of this world.
+     * @param unbounded The indices of the objects that are not part of the hierarchy.
+     */
+    void SetBVH(NMBVH newBvh, std::vector<uint32_t> unbounded)
+    {
+        bvh = std::move(newBvh);
+        unboundedObjects = std::move(unbounded);
+        bvhObjectCount = objects.size();
+        bvhRevision = GetGeometryRevision();
+    }
+
+    /**
+     * @brief Whether the hierarchy matches the objects. A new object or a moved primitive of this world makes the world
+     *        fall back to testing every object until the hierarchy is built again.
+     */
+    inline bool HasBVH() const
+    {
+        return bvhObjectCount > 0 && bvhObjectCount == objects.size() && bvhRevision == GetGeometryRevision();
+    }
+
+    /**
+     * @brief A counter that changes whenever the transform or origin of a primitive of the world changes, including
+     *        children of groups and CSGs and the geometry of instances.
+     * Structures built over the world bounds of the objects (the BVH, NMGBuffer) record it, so they can tell they may
+     * be out of date without visiting every primitive. Copies of a world share the objects and the counter.
+     */
+    inline uint64_t GetGeometryRevision() const { return geometryRevision->load(std::memory_order_acquire); }
+
+    inline const NMBVH& GetBVH() const { return bvh; }
+    inline const std::vector<uint32_t>& GetUnboundedObjects() const { return unboundedObjects; }
 
     SNMIntersectionList Intersect(const NMRay& ray) const
     {
         SNMIntersectionList intersections;
 
-        for (std::shared_ptr<NMPrimitiveBase> object : objects)
+        if (HasBVH())
+        {
+            bvh.Traverse(ray, [&](uint32_t id) { IntersectObject(*objects[id], ray, intersections); });
+
+            for (uint32_t id : unboundedObjects)
+            {
+                IntersectObject(*objects[id], ray, intersections);
+            }
+        }
+        else
         {
-            intersections.Add(object->Intersect(ray));
+            for (const std::shared_ptr<NMPrimitiveBase>& object : objects)
+            {
+                IntersectObject(*object, ray, intersections);
+            }
         }
 
         intersections.Sort();
@@ -96,6 +194,7 @@ public:
         NMVector direction = vector.Normalized();
 
         NMRay ray(point, direction);
+        nmstats::CountRay(ENMRayType::Shadow);
         SNMIntersectionList intersections = Intersect(ray);
 
         SNMIntersection* intersection = intersections.Hit();
@@ -110,23 +209,40 @@ public:
 
     NMColor ShadeHit(const SNMIntersectionState& state, uint8_t remainingReflections) const
     {
-        NMColor surfaceColor = NMColor(0.0f, 0.0f, 0.0f);
+        NMColor surfaceColor = ShadeSurface(state, IsShadowed(state.overPoint));
+        NMColor reflectedColor = ReflectedColor(state, remainingReflections);
+
+        return surfaceColor + reflectedColor;
+    }
 
-        bool isShadowed = IsShadowed(state.overPoint);
-        for (NMPointLight light : pointLights)
+    /**
+     * @brief The direct lighting of a hit by all lights, without reflections.
+     * @param isShadowed The result of IsShadowed() for the hit's overPoint.
+     */
+    NMColor ShadeSurface(const SNMIntersectionState& state, bool isShadowed) const
+    {
+        NMColor surfaceColor = NMColor(0.0f, 0.0f, 0.0f);
+        if (pointLights.empty())
         {
-            surfaceColor += state.object->GetMaterial().Lighting(*state.object, light, state.point, state.eyeVector,
-                                                                 state.normalVector, isShadowed);
+            return surfaceColor;
         }
 
-        NMColor reflectedColor = ReflectedColor(state, remainingReflections);
+        // The pattern is looked up once per hit, not once per light
+        const NMMaterial& material = state.object->GetMaterial();
+        NMColor materialColor = material.SurfaceColor(*state.object, state.point, state.footprint);
+        for (const NMPointLight& light : pointLights)
+        {
+            surfaceColor += material.Lighting(materialColor, light, state.point, state.eyeVector, state.normalVector,
+                                              isShadowed);
+        }
 
-        return surfaceColor + reflectedColor;
+        return surfaceColor;
     }
 
     NMColor ReflectedColor(const SNMIntersectionState& state, uint8_t remainingReflections) const
     {
-        if (remainingReflections == 0)
+        // A stopped render discards the pixel anyway, skip the rest of its bounces
+        if (remainingReflections == 0 || nmstop::IsStopRequested())
         {
             return NMColor(0.0f, 0.0f, 0.0f);
         }
@@ -138,6 +254,7 @@ public:
         }
 
         NMRay ray(state.overPoint, state.reflectVector);
+        nmstats::CountRay(ENMRayType::Reflection);
         NMColor color = ColorAt(ray, remainingReflections - 1);
 
         return color * reflectiveValue;
@@ -145,6 +262,27 @@ public:
 
     inline NMColor ColorAt(const NMRay& ray) const { return ColorAt(ray, worldSettings.ReflectionTraceDepth); }
 
+    /**
+     * @brief The color seen along a ray, also returning the distance to the first hit.
+     * @param hitDistance Set to the distance along the ray, infinity if the ray missed.
+     */
+    NMColor ColorAndDistanceAt(const NMRay& ray, float& hitDistance) const
+    {
+        SNMIntersectionList intersections = Intersect(ray);
+        SNMIntersection* intersection = intersections.Hit();
+
+        if (intersection == nullptr)
+        {
+            hitDistance = std::numeric_limits<float>::infinity();
+            return NMColor(0.0f, 0.0f, 0.0f);
+        }
+
+        hitDistance = intersection->t;
+        SNMIntersectionState state = SNMIntersectionState(*intersection, ray);
+
+        return ShadeHit(state, worldSettings.ReflectionTraceDepth);
+    }
+
 protected:
 
     SNMWorldSettings worldSettings;
@@ -152,6 +290,20 @@ protected:
     std::vector<NMPointLight> pointLights;
     std::vector<std::shared_ptr<NMPrimitiveBase>> objects;
 
+    NMBVH bvh;
+    std::vector<uint32_t> unboundedObjects;
+    std::size_t bvhObjectCount = 0;
+    uint64_t bvhRevision = 0;
+    std::shared_ptr<std::atomic<uint64_t>> geometryRevision = std::make_shared<std::atomic<uint64_t>>(0);
+
+    static inline void IntersectObject(const NMPrimitiveBase& object, const NMRay& ray,
+                                       SNMIntersectionList& intersections)
+    {
+        std::vector<SNMIntersection> objectIntersections = object.Intersect(ray);
+        nmstats::CountIntersectionTest(!objectIntersections.empty());
+        intersections.Add(std::move(objectIntersections));
+    }
+
     NMColor ColorAt(const NMRay& ray, uint8_t remainingReflections) const
     {
         SNMIntersectionList intersections = Intersect(ray);
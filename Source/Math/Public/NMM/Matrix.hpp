@@ -1,8 +1,11 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <stdexcept>
 #include <vector>
 
 #include "NMM/Point.hpp"
@@ -10,6 +13,11 @@
 #include "NMM/Util.hpp"
 #include "NMM/Vector.hpp"
 
+// Matrices are at most 4x4 and store their elements inline so that creating, copying and multiplying them never
+// touches the heap. This keeps per-ray transforms and bulk scene loading free of allocations.
+static constexpr std::size_t NMMATRIX_MAX_DIMENSION = 4;
+static constexpr std::size_t NMMATRIX_MAX_ELEMENTS = NMMATRIX_MAX_DIMENSION * NMMATRIX_MAX_DIMENSION;
+
 class NMMatrix
 {
 public:
@@ -18,15 +26,18 @@ public:
 
     NMMatrix(std::size_t width, std::size_t height, const float& value = 0.0f) : width(width), height(height)
     {
-        data.resize(width * height, value);
+        CheckDimensions();
+        data.fill(0.0f);
+        std::fill_n(data.begin(), width * height, value);
     }
 
     NMMatrix(const std::vector<std::vector<float>>& multiDimensionalData)
     {
         height = multiDimensionalData.size();
         width = multiDimensionalData[0].size();
+        CheckDimensions();
 
-        data.resize(width * height);
+        data.fill(0.0f);
         for (std::size_t y = 0; y < height; ++y)
         {
             for (std::size_t x = 0; x < width; ++x)
@@ -37,10 +48,18 @@ public:
     }
 
     NMMatrix(std::size_t width, std::size_t height, const std::vector<float>& data)
-        : width(width), height(height), data(data)
+        : NMMatrix(width, height, data.data(), data.size())
     {
     }
 
+    NMMatrix(std::size_t width, std::size_t height, const float* values, std::size_t count)
+        : width(width), height(height)
+    {
+        CheckDimensions();
+        data.fill(0.0f);
+        std::copy_n(values, std::min(count, width * height), data.begin());
+    }
+
     bool operator==(const NMMatrix& other) const
     {
         if (width != other.width || height != other.height)
@@ -48,7 +67,7 @@ public:
             return false;
         }
 
-        for (std::size_t i = 0; i < data.size(); ++i)
+        for (std::size_t i = 0; i < width * height; ++i)
         {
             if (!nmmath::FloatEquals(data[i], other.data[i]))
             {
@@ -66,9 +85,8 @@ public:
             return NMMatrix();
         }
 
-        std::vector<float> resultData(width * other.height);
+        NMMatrix result(other.width, height);
 
-        // TODO: solve this without cubic complexity
         for (std::size_t y = 0; y < height; ++y)
         {
             for (std::size_t x = 0; x < other.width; ++x)
@@ -76,13 +94,13 @@ public:
                 float sum = 0.0f;
                 for (std::size_t i = 0; i < width; ++i)
                 {
-                    sum += Get(i, y) * other.Get(x, i);
+                    sum += data[y * width + i] * other.data[i * other.width + x];
                 }
-                resultData[y * other.width + x] = sum;
+                result.data[y * other.width + x] = sum;
             }
         }
 
-        return NMMatrix(other.width, height, resultData);
+        return result;
     }
 
     NMTuple operator*(const NMTuple& tuple) const
@@ -92,11 +110,10 @@ public:
             return NMTuple();
         }
 
-        NMMatrix tupleMatrix(1, 4, {tuple.GetX(), tuple.GetY(), tuple.GetZ(), tuple.GetW()});
-
-        auto resultMatrix = *this * tupleMatrix;
-
-        return NMTuple(resultMatrix.Get(0, 0), resultMatrix.Get(0, 1), resultMatrix.Get(0, 2), resultMatrix.Get(0, 3));
+        return NMTuple(Row(0, tuple.GetX(), tuple.GetY(), tuple.GetZ(), tuple.GetW()),
+                       Row(1, tuple.GetX(), tuple.GetY(), tuple.GetZ(), tuple.GetW()),
+                       Row(2, tuple.GetX(), tuple.GetY(), tuple.GetZ(), tuple.GetW()),
+                       Row(3, tuple.GetX(), tuple.GetY(), tuple.GetZ(), tuple.GetW()));
     }
 
     NMPoint operator*(const NMPoint& point) const
@@ -106,11 +123,9 @@ public:
             return NMPoint();
         }
 
-        NMMatrix pointMatrix(1, 4, {point.GetX(), point.GetY(), point.GetZ(), 1.0f});
-
-        auto resultMatrix = *this * pointMatrix;
-
-        return NMPoint(resultMatrix.Get(0, 0), resultMatrix.Get(0, 1), resultMatrix.Get(0, 2));
+        return NMPoint(Row(0, point.GetX(), point.GetY(), point.GetZ(), 1.0f),
+                       Row(1, point.GetX(), point.GetY(), point.GetZ(), 1.0f),
+                       Row(2, point.GetX(), point.GetY(), point.GetZ(), 1.0f));
     }
 
     NMVector operator*(const NMVector& vector) const
@@ -120,11 +135,9 @@ public:
             return NMVector();
         }
 
-        NMMatrix vectorMatrix(1, 4, {vector.GetX(), vector.GetY(), vector.GetZ(), 0.0f});
-
-        NMMatrix resultMatrix = *this * vectorMatrix;
-
-        return NMVector(resultMatrix.Get(0, 0), resultMatrix.Get(0, 1), resultMatrix.Get(0, 2));
+        return NMVector(Row(0, vector.GetX(), vector.GetY(), vector.GetZ(), 0.0f),
+                        Row(1, vector.GetX(), vector.GetY(), vector.GetZ(), 0.0f),
+                        Row(2, vector.GetX(), vector.GetY(), vector.GetZ(), 0.0f));
     }
 
     friend std::ostream& operator<<(std::ostream& os, const NMMatrix& matrix)
@@ -133,9 +146,9 @@ public:
 
         // get the largest number of digits in the matrix
         int maxDigits = 0;
-        for (auto& val : matrix.data)
+        for (std::size_t i = 0; i < matrix.width * matrix.height; ++i)
         {
-            auto digits = static_cast<int>(std::to_string(val).length());
+            auto digits = static_cast<int>(std::to_string(matrix.data[i]).length());
             if (digits > maxDigits)
             {
                 maxDigits = digits;
@@ -195,7 +208,7 @@ public:
 
     inline NMMatrix Transposed() const
     {
-        NMMatrix result(width, height, data);
+        NMMatrix result(*this);
 
         result.Transpose();
 
@@ -227,24 +240,28 @@ public:
 
     NMMatrix Inverse() const
     {
-        if (!IsInvertible())
+        if (width == 4 && height == 4)
         {
-            return NMMatrix();
+            return Inverse4x4();
         }
 
-        std::vector<float> resultData(width * height);
-
         auto determinant = Determinant();
+        if (std::isnan(determinant) || nmmath::FloatEquals(determinant, 0.0f))
+        {
+            return NMMatrix();
+        }
+
+        NMMatrix result(width, height);
         for (std::size_t y = 0; y < height; ++y)
         {
             for (std::size_t x = 0; x < width; ++x)
             {
                 auto cofactor = Cofactor(y, x);
-                resultData[x * width + y] = cofactor / determinant;
+                result.data[x * width + y] = cofactor / determinant;
             }
         }
 
-        return NMMatrix(width, height, resultData);
+        return result;
     }
 
     NMMatrix Submatrix(std::size_t row, std::size_t column) const
@@ -255,7 +272,7 @@ public:
         }
 
         std::size_t idx = 0;
-        std::vector<float> resultData((width - 1) * (height - 1));
+        NMMatrix result(width - 1, height - 1);
         for (std::size_t y = 0; y < height; ++y)
         {
             if (y == row)
@@ -270,12 +287,12 @@ public:
                     continue;
                 }
 
-                resultData[idx] = data[y * width + x];
+                result.data[idx] = data[y * width + x];
                 idx++;
             }
         }
 
-        return NMMatrix(width - 1, height - 1, resultData);
+        return result;
     }
 
     float Minor(std::size_t row, std::size_t column) const { return Submatrix(row, column).Determinant(); }
@@ -348,9 +365,76 @@ public:
         return orientation * Translation(-from.GetX(), -from.GetY(), -from.GetZ());
     }
 
+    // Row-major element storage; only the first width * height entries are meaningful.
+    inline const float* GetData() const { return data.data(); }
+
 protected:
 
+    inline void CheckDimensions() const
+    {
+        if (width > NMMATRIX_MAX_DIMENSION || height > NMMATRIX_MAX_DIMENSION)
+        {
+            throw std::invalid_argument("NMMatrix supports at most 4x4 elements");
+        }
+    }
+
+    // Closed form 4x4 inverse from the 2x2 sub-determinants of the upper and lower row pairs. Computes the same
+    // cofactors as the generic path without recursing through submatrices.
+    NMMatrix Inverse4x4() const
+    {
+        const float* a = data.data();
+
+        float s0 = a[0] * a[5] - a[4] * a[1];
+        float s1 = a[0] * a[6] - a[4] * a[2];
+        float s2 = a[0] * a[7] - a[4] * a[3];
+        float s3 = a[1] * a[6] - a[5] * a[2];
+        float s4 = a[1] * a[7] - a[5] * a[3];
+        float s5 = a[2] * a[7] - a[6] * a[3];
+
+        float c5 = a[10] * a[15] - a[14] * a[11];
+        float c4 = a[9] * a[15] - a[13] * a[11];
+        float c3 = a[9] * a[14] - a[13] * a[10];
+        float c2 = a[8] * a[15] - a[12] * a[11];
+        float c1 = a[8] * a[14] - a[12] * a[10];
+        float c0 = a[8] * a[13] - a[12] * a[9];
+
+        float determinant = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+        if (nmmath::FloatEquals(determinant, 0.0f))
+        {
+            return NMMatrix();
+        }
+
+        NMMatrix result(4, 4);
+        float* b = result.data.data();
+        b[0] = (a[5] * c5 - a[6] * c4 + a[7] * c3) / determinant;
+        b[1] = (-a[1] * c5 + a[2] * c4 - a[3] * c3) / determinant;
+        b[2] = (a[13] * s5 - a[14] * s4 + a[15] * s3) / determinant;
+        b[3] = (-a[9] * s5 + a[10] * s4 - a[11] * s3) / determinant;
+        b[4] = (-a[4] * c5 + a[6] * c2 - a[7] * c1) / determinant;
+        b[5] = (a[0] * c5 - a[2] * c2 + a[3] * c1) / determinant;
+        b[6] = (-a[12] * s5 + a[14] * s2 - a[15] * s1) / determinant;
+        b[7] = (a[8] * s5 - a[10] * s2 + a[11] * s1) / determinant;
+        b[8] = (a[4] * c4 - a[5] * c2 + a[7] * c0) / determinant;
+        b[9] = (-a[0] * c4 + a[1] * c2 - a[3] * c0) / determinant;
+        b[10] = (a[12] * s4 - a[13] * s2 + a[15] * s0) / determinant;
+        b[11] = (-a[8] * s4 + a[9] * s2 - a[11] * s0) / determinant;
+        b[12] = (-a[4] * c3 + a[5] * c1 - a[6] * c0) / determinant;
+        b[13] = (a[0] * c3 - a[1] * c1 + a[2] * c0) / determinant;
+        b[14] = (-a[12] * s3 + a[13] * s1 - a[14] * s0) / determinant;
+        b[15] = (a[8] * s3 - a[9] * s1 + a[10] * s0) / determinant;
+
+        return result;
+    }
+
+    // Dot product of a 4x4 row with a homogeneous column. Accumulates from 0.0f in the same order as the generic
+    // multiply so both paths round identically (including the sign of zero results).
+    inline float Row(std::size_t y, float x0, float x1, float x2, float x3) const
+    {
+        const float* row = data.data() + y * 4;
+        return 0.0f + row[0] * x0 + row[1] * x1 + row[2] * x2 + row[3] * x3;
+    }
+
     std::size_t width;
     std::size_t height;
-    std::vector<float> data;
+    std::array<float, NMMATRIX_MAX_ELEMENTS> data;
 };
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <limits>
 #include <type_traits>
 
@@ -39,4 +42,66 @@ inline float Clamp(float value, float min, float max)
 
     return value;
 }
+
+/**
+ * @brief log2(x) for positive, normal x, within a few ulp.
+ * The exponent is read from the bits; the mantissa, scaled into [sqrt(1/2), sqrt(2)), goes through the atanh series
+ * of the logarithm, which converges fast around 1 where specular highlights need it most.
+ */
+inline float FastLog2(float x)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    int32_t exponent = static_cast<int32_t>((bits >> 23) & 0xff) - 127;
+    uint32_t mantissaBits = (bits & 0x007fffffu) | 0x3f800000u;
+
+    // Mantissas above sqrt(2) are halved through their exponent bits. Integer selects keep lane loops over this branch
+    // free, which floating point ones that may trap would not
+    uint32_t high = mantissaBits > 0x3fb504f3u ? 1u : 0u;
+    mantissaBits -= high << 23;
+    exponent += static_cast<int32_t>(high);
+
+    float mantissa;
+    std::memcpy(&mantissa, &mantissaBits, sizeof(mantissa));
+    float s = (mantissa - 1.0f) / (mantissa + 1.0f);
+    float s2 = s * s;
+    float series = 1.0f + s2 * (1.0f / 3.0f + s2 * (1.0f / 5.0f + s2 * (1.0f / 7.0f + s2 * (1.0f / 9.0f))));
+
+    // 2 * atanh(s) / ln(2)
+    return static_cast<float>(exponent) + s * series * 2.88539008f;
+}
+
+/**
+ * @brief 2^y for |y| < 2^31, within a few ulp. Results that would be denormal are flushed to 0, since arithmetic on
+ * denormals is slow on most CPUs and they only arise from the faint tails of highlights; results above 2^127 are
+ * clamped.
+ */
+inline float FastExp2(float y)
+{
+    // Round to the nearest whole power so the fraction is in [-0.5, 0.5]
+    int32_t whole = static_cast<int32_t>(y + std::copysign(0.5f, y));
+    float t = (y - static_cast<float>(whole)) * 0.693147181f;
+
+    float fraction =
+        1.0f
+        + t * (1.0f
+               + t * (1.0f / 2.0f
+                      + t * (1.0f / 6.0f
+                             + t * (1.0f / 24.0f + t * (1.0f / 120.0f + t * (1.0f / 720.0f + t * (1.0f / 5040.0f)))))));
+
+    // The power is clamped as an integer: clamping y in floating point lets the compiler split the constant cases off
+    // into branches, which keeps lane loops over this from vectorizing
+    int32_t power = std::min(whole, 127);
+    uint32_t scaleBits = power > -126 ? static_cast<uint32_t>(power + 127) << 23 : 0u;
+    float scale;
+    std::memcpy(&scale, &scaleBits, sizeof(scale));
+    return fraction * scale;
+}
+
+/**
+ * @brief base^exponent in float for positive, normal bases, e.g. the specular term of lighting.
+ * Unlike std::pow it has no special cases to branch on, so it is cheap and vectorizes in lane loops. The relative
+ * error grows with the exponent, about 1e-5 for an exponent of 200.
+ */
+inline float FastPow(float base, float exponent) { return FastExp2(exponent * FastLog2(base)); }
 }  // namespace nmmath
@@ -2,36 +2,49 @@
 
 #include <SDL2/SDL.h>
 
-#define DEBUG_DRAW_TIME 0
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <vector>
 
-NMColor bilinearInterp(NMCanvas* canvas, float x, float y)
+#include "NMCore/Trace.hpp"
+#include "NMRender/Overlay.hpp"
+
+namespace
 {
-    std::size_t x0 = static_cast<std::size_t>(x);
-    std::size_t y0 = static_cast<std::size_t>(y);
-    std::size_t x1 = x0 + 1;
-    std::size_t y1 = y0 + 1;
+// Radians per pixel of mouse movement and per second of a held arrow key
+constexpr float MOUSE_TURN_SPEED = 0.005f;
+constexpr float KEY_TURN_SPEED = 1.5f;
 
-    auto alpha = x - static_cast<float>(x0);
-    double beta = y - static_cast<float>(y0);
+// Movement in units of the orbit distance per second, and per pixel of mouse movement when panning
+constexpr float MOVE_SPEED = 0.5f;
+constexpr float PAN_SPEED = 0.002f;
+constexpr float FAST_FACTOR = 4.0f;
 
-    auto px100 = canvas->ReadPixel(x0, y0);
-    auto px101 = canvas->ReadPixel(x1, y0);
-    auto px110 = canvas->ReadPixel(x0, y1);
-    auto px111 = canvas->ReadPixel(x1, y1);
+// Distance factor per mouse wheel step
+constexpr float ZOOM_STEP = 0.9f;
 
-    float colChan[3] = {};
-    for (std::size_t i = 0; i < 3; i++)
-    {
-        colChan[i] = static_cast<float>((1 - alpha) * (1 - beta) * px100[i] + alpha * (1 - beta) * px101[i]
-                                        + (1 - alpha) * beta * px110[i] + alpha * beta * px111[i]);
-    }
-    return NMColor(colChan[0], colChan[1], colChan[2]);
-}
+// Canvas pixels per window pixel are 1 / renderScale
+constexpr std::size_t MAX_RENDER_SCALE = 8;
 
-Application::Application(std::size_t width, std::size_t height) : windowWidth(width), windowHeight(height) {}
+constexpr int OVERLAY_SCALE = 2;
+constexpr int OVERLAY_MARGIN = 8;
+}  // namespace
+
+Application::Application(std::size_t width, std::size_t height)
+    : windowWidth(width), windowHeight(height), camera(1, 1, nmmath::halfPi)
+{
+}
 
 Application::~Application()
 {
+    if (texture)
+    {
+        SDL_DestroyTexture(texture);
+    }
+    SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
     SDL_Quit();
 }
@@ -54,36 +67,41 @@ int Application::Run()
         return 10;
     }
 
-    NMCanvas* canvas = new NMCanvas(windowWidth, windowHeight);
-    NMWorld world = LoadWorld();
-    NMCamera camera = LoadScene();
+    // One pool for the whole session, every restarted frame reuses its threads
+    workers.reset(new ThreadPool(std::max(std::thread::hardware_concurrency(), 1u)));
+    camera.SetFrameHistory(&history);
+    LoadCurrentScene();
 
-    // async render
-    std::thread renderThread([&world, &camera, &canvas]() { camera.Render(world, canvas); });
+    std::thread renderThread(&Application::RenderLoop, this);
 
-#if DEBUG_DRAW_TIME
-    auto startDraw = std::chrono::high_resolution_clock::now();
-    auto endDraw = std::chrono::high_resolution_clock::now();
-#endif
+    auto lastInput = std::chrono::steady_clock::now();
     while (isRunning)
     {
-        ProcessInput();
-
-#if DEBUG_DRAW_TIME
-        startDraw = std::chrono::high_resolution_clock::now();
-#endif
+        auto now = std::chrono::steady_clock::now();
+        ProcessInput(std::chrono::duration<float>(now - lastInput).count());
+        lastInput = now;
 
-        DrawFrame(canvas);
+        // RequestRender() can not stop a frame that has not started yet, so a view posted while the render thread was
+        // starting a frame is outdated by it; keep stopping until the render thread picks up the new view
+        if (IsRequestPending())
+        {
+            camera.StopRender();
+        }
 
-#if DEBUG_DRAW_TIME
-        endDraw = std::chrono::high_resolution_clock::now();
+        DrawFrame();
+    }
 
-        auto drawDuration = std::chrono::duration_cast<std::chrono::milliseconds>(endDraw - startDraw);
-        printf("Draw time: %4ldms\n", drawDuration.count());
-#endif
+    {
+        std::unique_lock<std::mutex> lock(renderMutex);
+        renderCondition.notify_all();
     }
 
-    camera.StopRender();
+    // The render thread may just be starting a frame, keep stopping until it left its loop
+    while (!renderLoopDone)
+    {
+        camera.StopRender();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
     renderThread.join();
 
     return 0;
@@ -116,6 +134,11 @@ void Application::ResizeWindow(std::size_t width, std::size_t height, bool updat
     {
         SDL_SetWindowSize(window, static_cast<int>(windowWidth), static_cast<int>(windowHeight));
     }
+
+    if (workers)
+    {
+        RequestRender();
+    }
 }
 
 bool Application::Initialize()
@@ -128,7 +151,7 @@ bool Application::Initialize()
 
     uint32_t flags = SDL_WINDOW_SHOWN;
 
-    window = SDL_CreateWindow("NM RNDR", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
+    window = SDL_CreateWindow(windowTitle, SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
                               static_cast<int>(windowWidth), static_cast<int>(windowHeight), flags);
     if (!window)
     {
@@ -163,52 +186,353 @@ bool Application::Initialize()
         return false;
     }
 
+    // The canvas is rendered below window resolution, filter it when scaling up
+    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "linear");
+
     return true;
 }
 
-void Application::ProcessInput()
+void Application::LoadCurrentScene()
+{
+    NMCamera sceneCamera = LoadScene();
+    world = std::make_shared<const NMWorld>(LoadWorld());
+    fov = sceneCamera.GetFOV();
+    controller.SetViewTransform(sceneCamera.GetTransform());
+
+    RequestRender();
+}
+
+void Application::RequestRender()
+{
+    {
+        std::unique_lock<std::mutex> lock(renderMutex);
+        request.transform = controller.GetViewTransform();
+        request.width = std::max<std::size_t>(windowWidth / renderScale, 1);
+        request.height = std::max<std::size_t>(windowHeight / renderScale, 1);
+        request.fov = fov;
+        request.world = world;
+        requestPending = true;
+    }
+    renderCondition.notify_one();
+
+    // The frame in progress is outdated, the render thread picks up the new view as soon as it returns
+    camera.StopRender();
+}
+
+bool Application::IsRequestPending()
+{
+    std::unique_lock<std::mutex> lock(renderMutex);
+    return requestPending;
+}
+
+void Application::RenderLoop()
 {
+    NMTrace::SetThreadName("Render");
+
+    std::shared_ptr<const NMWorld> renderWorld;
+    while (true)
+    {
+        SNMViewRequest view;
+        {
+            std::unique_lock<std::mutex> lock(renderMutex);
+            renderCondition.wait(lock, [this]() { return !isRunning || requestPending; });
+            if (!isRunning)
+            {
+                break;
+            }
+
+            view = request;
+            requestPending = false;
+        }
+
+        // Samples of another world can not be reprojected
+        if (view.world != renderWorld)
+        {
+            renderWorld = view.world;
+            history.Invalidate();
+        }
+
+        if (!canvas || !canvas->IsSize(view.width, view.height))
+        {
+            canvas.reset(new NMCanvas(view.width, view.height, DEFAULT_COLOR, ENMCanvasLayout::Tiled));
+        }
+
+        // Assigning keeps the frame history, a new size makes the next frame a full render
+        if (camera.GetHSize() != view.width || camera.GetVSize() != view.height || camera.GetFOV() != view.fov)
+        {
+            camera = NMCamera(view.width, view.height, view.fov);
+        }
+        camera.SetTransform(view.transform);
+
+        // Show the preview as soon as the disoccluded pixels are traced, then refine it unless the view changed
+        SNMRenderStats stats = camera.Reproject(*renderWorld, canvas.get(), *workers, 0, false);
+        PublishFrame(stats, view);
+
+        if (isRunning && !IsRequestPending())
+        {
+            stats = camera.Reproject(*renderWorld, canvas.get(), *workers);
+            PublishFrame(stats, view);
+        }
+    }
+
+    renderLoopDone = true;
+}
+
+void Application::PublishFrame(const SNMRenderStats& stats, const SNMViewRequest& view)
+{
+    {
+        std::unique_lock<std::mutex> lock(canvasMutex);
+        // Assigning reuses the pixel storage while the size stays the same
+        if (displayCanvas)
+        {
+            *displayCanvas = *canvas;
+        }
+        else
+        {
+            displayCanvas.reset(new NMCanvas(*canvas));
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(renderMutex);
+    frameInfo.seconds = stats.frameSeconds;
+    frameInfo.rays = stats.enabled ? stats.TotalRays() : 0;
+    frameInfo.width = view.width;
+    frameInfo.height = view.height;
+    frameInfo.complete = history.Count(ENMSampleState::Traced) == view.width * view.height;
+}
+
+void Application::ProcessInput(float deltaSeconds)
+{
+    bool viewChanged = false;
+    bool sceneChanged = false;
+
     SDL_Event event;
     while (SDL_PollEvent(&event))
     {
-        if (event.type == SDL_QUIT)
+        switch (event.type)
         {
-            isRunning = false;
+            case SDL_QUIT:
+                isRunning = false;
+                break;
+
+            case SDL_MOUSEMOTION:
+            {
+                float dx = static_cast<float>(event.motion.xrel);
+                float dy = static_cast<float>(event.motion.yrel);
+                if (event.motion.state & SDL_BUTTON_LMASK)
+                {
+                    controller.Rotate(-dx * MOUSE_TURN_SPEED, -dy * MOUSE_TURN_SPEED);
+                    viewChanged = true;
+                }
+                else if (event.motion.state & (SDL_BUTTON_RMASK | SDL_BUTTON_MMASK))
+                {
+                    float pan = PAN_SPEED * controller.GetDistance();
+                    controller.Move(0.0f, -dx * pan, dy * pan);
+                    viewChanged = true;
+                }
+                break;
+            }
+
+            case SDL_MOUSEWHEEL:
+                controller.Zoom(std::pow(ZOOM_STEP, static_cast<float>(event.wheel.y)));
+                viewChanged = true;
+                break;
+
+            case SDL_KEYDOWN:
+                if (event.key.repeat)
+                {
+                    break;
+                }
+
+                switch (event.key.keysym.scancode)
+                {
+                    case SDL_SCANCODE_ESCAPE:
+                        isRunning = false;
+                        break;
+                    case SDL_SCANCODE_TAB:
+                        controller.SetMode(controller.GetMode() == ENMCameraMode::Orbit ? ENMCameraMode::Fly
+                                                                                         : ENMCameraMode::Orbit);
+                        break;
+                    case SDL_SCANCODE_N:
+                        sceneChanged = NextScene() || sceneChanged;
+                        break;
+                    case SDL_SCANCODE_R:
+                        sceneChanged = true;
+                        break;
+                    case SDL_SCANCODE_EQUALS:
+                    case SDL_SCANCODE_KP_PLUS:
+                        renderScale = std::max<std::size_t>(renderScale / 2, 1);
+                        viewChanged = true;
+                        break;
+                    case SDL_SCANCODE_MINUS:
+                    case SDL_SCANCODE_KP_MINUS:
+                        renderScale = std::min(renderScale * 2, MAX_RENDER_SCALE);
+                        viewChanged = true;
+                        break;
+                    case SDL_SCANCODE_H:
+                    case SDL_SCANCODE_F1:
+                        showOverlay = !showOverlay;
+                        break;
+                    default:
+                        break;
+                }
+                break;
         }
     }
 
-    const Uint8* keyboardState = SDL_GetKeyboardState(nullptr);
-    if (keyboardState[SDL_SCANCODE_ESCAPE])
+    // Held keys move continuously, scaled by the frame time
+    const Uint8* keys = SDL_GetKeyboardState(nullptr);
+    float speed = (keys[SDL_SCANCODE_LSHIFT] || keys[SDL_SCANCODE_RSHIFT]) ? FAST_FACTOR : 1.0f;
+    float move = MOVE_SPEED * controller.GetDistance() * speed * deltaSeconds;
+    float turn = KEY_TURN_SPEED * speed * deltaSeconds;
+
+    float forward = static_cast<float>(keys[SDL_SCANCODE_W] - keys[SDL_SCANCODE_S]);
+    float right = static_cast<float>(keys[SDL_SCANCODE_D] - keys[SDL_SCANCODE_A]);
+    float up = static_cast<float>(keys[SDL_SCANCODE_E] - keys[SDL_SCANCODE_Q]);
+    float yaw = static_cast<float>(keys[SDL_SCANCODE_LEFT] - keys[SDL_SCANCODE_RIGHT]);
+    float pitch = static_cast<float>(keys[SDL_SCANCODE_UP] - keys[SDL_SCANCODE_DOWN]);
+
+    if (forward != 0.0f || right != 0.0f || up != 0.0f)
     {
-        isRunning = false;
+        controller.Move(forward * move, right * move, up * move);
+        viewChanged = true;
+    }
+    if (yaw != 0.0f || pitch != 0.0f)
+    {
+        controller.Rotate(yaw * turn, pitch * turn);
+        viewChanged = true;
+    }
+
+    if (sceneChanged)
+    {
+        LoadCurrentScene();
+    }
+    else if (viewChanged)
+    {
+        RequestRender();
     }
 }
 
-void Application::DrawFrame(NMCanvas* canvas)
+void Application::DrawFrame()
 {
+    auto drawStart = std::chrono::steady_clock::now();
+
     SDL_SetRenderDrawColor(renderer, 10, 10, 10, 255);
     SDL_RenderClear(renderer);
 
-    float scaleX = static_cast<float>(windowWidth) / static_cast<float>(canvas->GetWidth());
-    float scaleY = static_cast<float>(windowHeight) / static_cast<float>(canvas->GetHeight());
-    float scale = std::min(scaleX, scaleY);
-
-    // Draw each pixel of the canvas to the screen
-    NMColor pixelColor;
-    for (std::size_t y = 0; y < windowHeight; ++y)
+    // Upload the last finished frame
     {
-        for (std::size_t x = 0; x < windowWidth; ++x)
+        std::unique_lock<std::mutex> lock(canvasMutex);
+        if (displayCanvas)
         {
-            auto origX = static_cast<float>(x) / scale;
-            auto origY = static_cast<float>(y) / scale;
-
-            pixelColor = bilinearInterp(canvas, origX, origY);
-            SDL_SetRenderDrawColor(renderer, static_cast<uint8_t>(pixelColor.GetClampedRed()),
-                                   static_cast<uint8_t>(pixelColor.GetClampedGreen()),
-                                   static_cast<uint8_t>(pixelColor.GetClampedBlue()), 1.0f);
-            SDL_RenderDrawPoint(renderer, static_cast<int>(x), static_cast<int>(y));
+            std::size_t width = displayCanvas->GetWidth();
+            std::size_t height = displayCanvas->GetHeight();
+            if (!texture || textureWidth != width || textureHeight != height)
+            {
+                if (texture)
+                {
+                    SDL_DestroyTexture(texture);
+                }
+                texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING,
+                                            static_cast<int>(width), static_cast<int>(height));
+                textureWidth = width;
+                textureHeight = height;
+            }
+
+            void* pixels = nullptr;
+            int pitch = 0;
+            if (texture && SDL_LockTexture(texture, nullptr, &pixels, &pitch) == 0)
+            {
+                for (std::size_t y = 0; y < height; ++y)
+                {
+                    uint32_t* row = reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(pixels)
+                                                                + y * static_cast<std::size_t>(pitch));
+                    for (std::size_t x = 0; x < width; ++x)
+                    {
+                        const NMColor& color = displayCanvas->ReadPixel(x, y);
+                        row[x] = 0xFF000000u | static_cast<uint32_t>(color.GetClampedRed()) << 16
+                                 | static_cast<uint32_t>(color.GetClampedGreen()) << 8
+                                 | static_cast<uint32_t>(color.GetClampedBlue());
+                    }
+                }
+                SDL_UnlockTexture(texture);
+            }
         }
     }
 
+    if (texture)
+    {
+        // Scale the canvas to the window, keeping its aspect ratio
+        float scaleX = static_cast<float>(windowWidth) / static_cast<float>(textureWidth);
+        float scaleY = static_cast<float>(windowHeight) / static_cast<float>(textureHeight);
+        float scale = std::min(scaleX, scaleY);
+
+        SDL_Rect target;
+        target.w = static_cast<int>(static_cast<float>(textureWidth) * scale);
+        target.h = static_cast<int>(static_cast<float>(textureHeight) * scale);
+        target.x = (static_cast<int>(windowWidth) - target.w) / 2;
+        target.y = (static_cast<int>(windowHeight) - target.h) / 2;
+        SDL_RenderCopy(renderer, texture, nullptr, &target);
+    }
+
+    if (showOverlay)
+    {
+        DrawOverlay();
+    }
+
     SDL_RenderPresent(renderer);
+
+    drawSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - drawStart).count();
+}
+
+void Application::DrawOverlay()
+{
+    SNMFrameInfo info;
+    {
+        std::unique_lock<std::mutex> lock(renderMutex);
+        info = frameInfo;
+    }
+
+    double raysPerSecond = info.seconds > 0.0 ? static_cast<double>(info.rays) / info.seconds : 0.0;
+
+    char lines[4][96];
+    std::snprintf(lines[0], sizeof(lines[0]), "FRAME %.1f MS  %.2f MRAYS/S", info.seconds * 1000.0,
+                  raysPerSecond / 1e6);
+    std::snprintf(lines[1], sizeof(lines[1]), "%zux%zu  %s  %s", info.width, info.height,
+                  info.complete ? "DONE" : "PREVIEW",
+                  controller.GetMode() == ENMCameraMode::Orbit ? "ORBIT" : "FLY");
+    std::snprintf(lines[2], sizeof(lines[2]), "DRAW %.1f MS", drawSeconds * 1000.0);
+    std::snprintf(lines[3], sizeof(lines[3]), "TAB MODE  N SCENE  R RESET  +/- RES  H HIDE");
+
+    int lineHeight = (nmoverlay::GLYPH_HEIGHT + 2) * OVERLAY_SCALE;
+    std::vector<SNMOverlayRect> glyphs;
+    int width = 0;
+    for (int line = 0; line < 4; ++line)
+    {
+        std::vector<SNMOverlayRect> text = nmoverlay::LayoutText(lines[line], OVERLAY_MARGIN * 2,
+                                                                 OVERLAY_MARGIN * 2 + line * lineHeight, OVERLAY_SCALE);
+        glyphs.insert(glyphs.end(), text.begin(), text.end());
+        width = std::max(width, nmoverlay::TextWidth(lines[line], OVERLAY_SCALE));
+    }
+
+    // Dark backdrop so the text stays readable on bright scenes
+    SDL_Rect backdrop;
+    backdrop.x = OVERLAY_MARGIN;
+    backdrop.y = OVERLAY_MARGIN;
+    backdrop.w = width + OVERLAY_MARGIN * 2;
+    backdrop.h = 4 * lineHeight + OVERLAY_MARGIN * 2 - 2 * OVERLAY_SCALE;
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 160);
+    SDL_RenderFillRect(renderer, &backdrop);
+
+    std::vector<SDL_Rect> rects(glyphs.size());
+    for (std::size_t i = 0; i < glyphs.size(); ++i)
+    {
+        rects[i].x = glyphs[i].x;
+        rects[i].y = glyphs[i].y;
+        rects[i].w = glyphs[i].w;
+        rects[i].h = glyphs[i].h;
+    }
+    SDL_SetRenderDrawColor(renderer, 235, 235, 235, 255);
+    SDL_RenderFillRects(renderer, rects.data(), static_cast<int>(rects.size()));
 }
@@ -0,0 +1,94 @@
+#include "NMRender/CameraController.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "NMM/Util.hpp"
+
+namespace
+{
+constexpr float MAX_PITCH = nmmath::halfPi - 0.01f;
+constexpr float MIN_DISTANCE = 0.05f;
+
+const NMVector WORLD_UP = NMVector(0.0f, 1.0f, 0.0f);
+}  // namespace
+
+void NMCameraController::LookAt(const NMPoint& from, const NMPoint& to)
+{
+    NMVector direction = to - from;
+    distance = std::max(direction.Magnitude(), MIN_DISTANCE);
+    direction = direction / distance;
+
+    target = to;
+    pitch = std::min(std::max(std::asin(std::min(std::max(direction.GetY(), -1.0f), 1.0f)), -MAX_PITCH), MAX_PITCH);
+    yaw = std::atan2(-direction.GetX(), direction.GetZ());
+}
+
+void NMCameraController::SetViewTransform(const NMMatrix& viewTransform)
+{
+    NMMatrix inverse = viewTransform.Inverse();
+    NMPoint eye = inverse * NMPoint(0.0f, 0.0f, 0.0f);
+    NMVector forward = (inverse * NMVector(0.0f, 0.0f, -1.0f)).Normalized();
+
+    // The point of the view ray closest to the origin, at least one unit in front of the eye
+    float along = std::max((NMPoint(0.0f, 0.0f, 0.0f) - eye).DotProduct(forward), 1.0f);
+    LookAt(eye, eye + forward * along);
+}
+
+void NMCameraController::Rotate(float yawDelta, float pitchDelta)
+{
+    NMPoint eye = GetEye();
+
+    yaw += yawDelta;
+    pitch = std::min(std::max(pitch + pitchDelta, -MAX_PITCH), MAX_PITCH);
+
+    // Flying turns around the eye, orbiting keeps the target
+    if (mode == ENMCameraMode::Fly)
+    {
+        target = eye + GetForward() * distance;
+    }
+}
+
+void NMCameraController::Move(float forward, float right, float up)
+{
+    NMVector forwardAxis = GetForward();
+    // The view is left-handed: looking along +z, +x is to the right
+    NMVector rightAxis = WORLD_UP.CrossProduct(forwardAxis).Normalized();
+    NMVector upAxis = forwardAxis.CrossProduct(rightAxis);
+
+    if (mode == ENMCameraMode::Fly)
+    {
+        target = target + forwardAxis * forward + rightAxis * right + WORLD_UP * up;
+    }
+    else
+    {
+        target = target + rightAxis * right + upAxis * up;
+        distance = std::max(distance - forward, MIN_DISTANCE);
+    }
+}
+
+void NMCameraController::Zoom(float factor)
+{
+    if (mode == ENMCameraMode::Fly)
+    {
+        Move(distance * (1.0f - factor), 0.0f, 0.0f);
+        return;
+    }
+
+    distance = std::max(distance * factor, MIN_DISTANCE);
+}
+
+NMPoint NMCameraController::GetEye() const
+{
+    return target - GetForward() * distance;
+}
+
+NMVector NMCameraController::GetForward() const
+{
+    return NMVector(-std::cos(pitch) * std::sin(yaw), std::sin(pitch), std::cos(pitch) * std::cos(yaw));
+}
+
+NMMatrix NMCameraController::GetViewTransform() const
+{
+    return NMMatrix::ViewTransform(GetEye(), target, WORLD_UP);
+}
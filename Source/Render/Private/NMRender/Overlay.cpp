@@ -0,0 +1,63 @@
+#include "NMRender/Overlay.hpp"
+
+#include <cctype>
+#include <cstdint>
+
+namespace
+{
+struct SNMGlyph
+{
+    char character;
+
+    // Five rows of three bits, top row and left column in the most significant bits
+    uint16_t rows;
+};
+
+const SNMGlyph FONT[] = {
+    {'0', 0x7B6F}, {'1', 0x2C97}, {'2', 0x73E7}, {'3', 0x73CF}, {'4', 0x5BC9}, {'5', 0x79CF}, {'6', 0x79EF},
+    {'7', 0x7292}, {'8', 0x7BEF}, {'9', 0x7BCF}, {'A', 0x2BED}, {'B', 0x6BAE}, {'C', 0x3923}, {'D', 0x6B6E},
+    {'E', 0x79A7}, {'F', 0x79A4}, {'G', 0x396B}, {'H', 0x5BED}, {'I', 0x7497}, {'J', 0x126A}, {'K', 0x5BAD},
+    {'L', 0x4927}, {'M', 0x5FED}, {'N', 0x6B6D}, {'O', 0x2B6A}, {'P', 0x6BA4}, {'Q', 0x2B73}, {'R', 0x6BAD},
+    {'S', 0x388E}, {'T', 0x7492}, {'U', 0x5B6F}, {'V', 0x5B6A}, {'W', 0x5BFD}, {'X', 0x5AAD}, {'Y', 0x5A92},
+    {'Z', 0x72A7}, {'.', 0x0002}, {':', 0x0410}, {'/', 0x12A4}, {'-', 0x01C0}, {'%', 0x52A5}, {'(', 0x2922},
+    {')', 0x224A}, {'+', 0x05D0}, {'=', 0x0E38},
+};
+
+uint16_t GlyphRows(char character)
+{
+    char upper = static_cast<char>(std::toupper(static_cast<unsigned char>(character)));
+    for (const SNMGlyph& glyph : FONT)
+    {
+        if (glyph.character == upper)
+        {
+            return glyph.rows;
+        }
+    }
+
+    return 0;
+}
+}  // namespace
+
+std::vector<SNMOverlayRect> nmoverlay::LayoutText(const std::string& text, int x, int y, int scale)
+{
+    std::vector<SNMOverlayRect> rects;
+    for (std::size_t i = 0; i < text.size(); ++i)
+    {
+        uint16_t rows = GlyphRows(text[i]);
+        int glyphX = x + static_cast<int>(i) * (GLYPH_WIDTH + 1) * scale;
+
+        for (int row = 0; row < GLYPH_HEIGHT; ++row)
+        {
+            for (int column = 0; column < GLYPH_WIDTH; ++column)
+            {
+                int bit = (GLYPH_HEIGHT - 1 - row) * GLYPH_WIDTH + (GLYPH_WIDTH - 1 - column);
+                if (rows & (1 << bit))
+                {
+                    rects.emplace_back(glyphX + column * scale, y + row * scale, scale, scale);
+                }
+            }
+        }
+    }
+
+    return rects;
+}
@@ -1,12 +1,64 @@
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
 #include "NMCore/Camera.hpp"
 #include "NMCore/Canvas.hpp"
+#include "NMCore/FrameHistory.hpp"
+#include "NMCore/ThreadPool.hpp"
 #include "NMCore/World.hpp"
+#include "NMRender/CameraController.hpp"
 
 struct SDL_Renderer;
+struct SDL_Texture;
 struct SDL_Window;
 
+/**
+ * @brief The view the render thread should render next, posted by the main thread.
+ */
+struct SNMViewRequest
+{
+    NMMatrix transform = NMMatrix::Identity4x4();
+    std::size_t width = 0;
+    std::size_t height = 0;
+    float fov = 0.0f;
+    std::shared_ptr<const NMWorld> world;
+};
+
+/**
+ * @brief The last frame finished by the render thread, shown in the overlay.
+ */
+struct SNMFrameInfo
+{
+    double seconds = 0.0;
+    uint64_t rays = 0;
+    std::size_t width = 0;
+    std::size_t height = 0;
+
+    /**
+     * @brief Whether every pixel of the frame was traced for its view, i.e. it was neither stopped nor a preview.
+     */
+    bool complete = false;
+};
+
+/**
+ * @brief An SDL window that renders a scene continuously while the camera is flown or orbited.
+ *
+ * Rendering runs on its own thread with a persistent pool. Every camera move, window resize or scene change posts a
+ * new view and stops the frame in progress; the render thread then reprojects the last frame into the new view (see
+ * NMCamera::Reproject()) so the image follows the camera while the disoccluded and reprojected pixels are traced.
+ * The window shows a copy of the canvas taken after the preview and after the refinement, never pixels that are still
+ * being written.
+ *
+ * Controls:
+ * - Left mouse drag, arrow keys: turn. Right or middle mouse drag: pan. Mouse wheel: zoom.
+ * - W/A/S/D: move, Q/E: down/up, Shift: faster.
+ * - Tab: switch between orbiting and flying. N: next scene. R: reload the scene and reset the view.
+ * - +/-: render resolution. H: overlay. Escape: quit.
+ */
 class Application
 {
 public:
@@ -21,23 +73,65 @@ public:
     virtual NMWorld LoadWorld() = 0;
     virtual NMCamera LoadScene() = 0;
 
+    /**
+     * @brief Switch to the next scene, LoadWorld() and LoadScene() are called afterwards.
+     * @return False if there is no other scene.
+     */
+    virtual bool NextScene() { return false; }
+
     int WindowEventCallback(void* sdlEvent);
 
     void ResizeWindow(std::size_t width, std::size_t height, bool updateSDL = true);
 
 protected:
 
-    bool isRunning = true;
+    std::atomic<bool> isRunning{true};
 
     const char* windowTitle = "NMRNDR";
 
     SDL_Window* window = nullptr;
     SDL_Renderer* renderer = nullptr;
+    SDL_Texture* texture = nullptr;
+    std::size_t textureWidth = 0;
+    std::size_t textureHeight = 0;
 
     std::size_t windowWidth = 800;
     std::size_t windowHeight = 600;
 
+    // Owned by the render thread; the main thread only calls camera.StopRender()
+    std::unique_ptr<ThreadPool> workers;
+    NMCamera camera;
+    NMFrameHistory history;
+    std::unique_ptr<NMCanvas> canvas;
+    std::atomic<bool> renderLoopDone{false};
+
+    // A copy of the canvas made whenever the render thread finished a frame, drawn by the main thread
+    std::unique_ptr<NMCanvas> displayCanvas;
+    std::mutex canvasMutex;
+
+    // Shared between the threads under renderMutex
+    std::mutex renderMutex;
+    std::condition_variable renderCondition;
+    SNMViewRequest request;
+    bool requestPending = false;
+    SNMFrameInfo frameInfo;
+
+    // The view of the main thread
+    NMCameraController controller;
+    std::shared_ptr<const NMWorld> world;
+    float fov = 0.0f;
+    std::size_t renderScale = 2;
+    bool showOverlay = true;
+    double drawSeconds = 0.0;
+
     bool Initialize();
-    void ProcessInput();
-    void DrawFrame(NMCanvas* canvas);
+    void LoadCurrentScene();
+    void RequestRender();
+    bool IsRequestPending();
+    void RenderLoop();
+    void PublishFrame(const SNMRenderStats& stats, const SNMViewRequest& view);
+
+    void ProcessInput(float deltaSeconds);
+    void DrawFrame();
+    void DrawOverlay();
 };
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+
+#include "NMM/Matrix.hpp"
+#include "NMM/Point.hpp"
+#include "NMM/Vector.hpp"
+
+/**
+ * @brief How NMCameraController moves the camera.
+ */
+enum class ENMCameraMode : uint8_t
+{
+    /**
+     * @brief Turning moves the eye around a fixed target, moving pans the target and zooming changes the distance.
+     */
+    Orbit = 0,
+
+    /**
+     * @brief Turning turns the eye in place and moving flies along the view direction.
+     */
+    Fly,
+};
+
+/**
+ * @brief Turns mouse and keyboard input into the view transform of a camera.
+ * The view is kept as a target point seen from a yaw, pitch and distance, so both modes share one state and switching
+ * between them does not move the camera.
+ */
+class NMCameraController
+{
+public:
+
+    NMCameraController() = default;
+
+    inline ENMCameraMode GetMode() const { return mode; }
+    inline void SetMode(ENMCameraMode newMode) { mode = newMode; }
+
+    inline const NMPoint& GetTarget() const { return target; }
+    inline float GetDistance() const { return distance; }
+
+    /**
+     * @brief Look from one point at another.
+     */
+    void LookAt(const NMPoint& from, const NMPoint& to);
+
+    /**
+     * @brief Take over the view of an existing camera transform (see NMMatrix::ViewTransform()).
+     * The target is placed where the view direction passes closest to the world origin.
+     */
+    void SetViewTransform(const NMMatrix& viewTransform);
+
+    /**
+     * @brief Turn the view, in radians: a positive yaw turns left and a positive pitch up. The pitch is limited to
+     *        just short of straight up and down.
+     */
+    void Rotate(float yawDelta, float pitchDelta);
+
+    /**
+     * @brief Move along the view axes, in world units, to the front, the right of the screen and up.
+     * Orbiting pans the target sideways and up and zooms with the forward movement.
+     */
+    void Move(float forward, float right, float up);
+
+    /**
+     * @brief Scale the distance to the target when orbiting, or fly forward by the scaled distance.
+     * @param factor Greater than 1 moves away from the target.
+     */
+    void Zoom(float factor);
+
+    NMPoint GetEye() const;
+
+    NMVector GetForward() const;
+
+    NMMatrix GetViewTransform() const;
+
+protected:
+
+    ENMCameraMode mode = ENMCameraMode::Orbit;
+
+    NMPoint target = NMPoint(0.0f, 0.0f, 0.0f);
+    float yaw = 0.0f;
+    float pitch = 0.0f;
+    float distance = 5.0f;
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief A filled rectangle in window pixels.
+ */
+struct SNMOverlayRect
+{
+    int x = 0;
+    int y = 0;
+    int w = 0;
+    int h = 0;
+
+    SNMOverlayRect() = default;
+    SNMOverlayRect(int x, int y, int w, int h) : x(x), y(y), w(w), h(h) {}
+};
+
+namespace nmoverlay
+{
+constexpr int GLYPH_WIDTH = 3;
+constexpr int GLYPH_HEIGHT = 5;
+
+/**
+ * @brief The rectangles that draw a line of text in a 3x5 pixel font, so overlays need nothing but rectangle fills.
+ * Lowercase letters are drawn as uppercase, characters without a glyph as blanks.
+ * @param scale The size of one font pixel in window pixels.
+ */
+std::vector<SNMOverlayRect> LayoutText(const std::string& text, int x, int y, int scale);
+
+/**
+ * @brief The width of a line of text laid out by LayoutText(), in window pixels.
+ */
+inline int TextWidth(const std::string& text, int scale)
+{
+    return static_cast<int>(text.size()) * (GLYPH_WIDTH + 1) * scale - scale;
+}
+}  // namespace nmoverlay
@@ -2,6 +2,8 @@
 
 #include <NMRender/Application.hpp>
 
+#include <string>
+
 class TestApplication : public Application
 {
 public:
@@ -10,4 +12,13 @@ public:
 
     virtual NMWorld LoadWorld();
     virtual NMCamera LoadScene();
+
+    /**
+     * @brief Cycle through the scenes of NMSceneLibrary.
+     */
+    virtual bool NextScene();
+
+protected:
+
+    std::string sceneName = "application";
 };
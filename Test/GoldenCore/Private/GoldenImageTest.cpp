@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <fstream>
+
+#include "GoldenImage.hpp"
+#include "NMCore/Camera.hpp"
+#include "NMCore/Scene/SceneLibrary.hpp"
+
+constexpr std::size_t GOLDEN_WIDTH = 128;
+constexpr std::size_t GOLDEN_HEIGHT = 72;
+constexpr uint64_t GOLDEN_SEED = 1;
+
+// A pixel differs when its luminance weighted 8-bit distance is above 2, and at most 0.1% of the pixels may differ.
+// This absorbs rounding differences between compilers and instruction sets but catches any visible change.
+constexpr double GOLDEN_PIXEL_THRESHOLD = 2.0;
+constexpr double GOLDEN_MAX_DIFFERING_FRACTION = 0.001;
+
+namespace
+{
+bool IsEnvSet(const char* name)
+{
+    const char* value = std::getenv(name);
+    return value && *value && std::string(value) != "0";
+}
+
+std::string ReferencePath(const std::string& scene)
+{
+    return std::string(NM_GOLDEN_DATA_DIR) + "/" + scene + "_" + std::to_string(GOLDEN_WIDTH) + "x"
+           + std::to_string(GOLDEN_HEIGHT) + ".ppm";
+}
+}  // namespace
+
+/**
+ * Every canonical scene is rendered with a fixed seed and compared against its checked-in reference image.
+ *
+ * - NM_GOLDEN_UPDATE=1 rewrites the reference images instead of comparing them.
+ */
+class NMGoldenImageTest : public testing::TestWithParam<std::string>
+{
+};
+
+// Scenario: A scene renders the same image as its reference
+TEST_P(NMGoldenImageTest, MatchesReference)
+{
+    // Given
+    SNMScene scene = NMSceneLibrary::Create(GetParam(), GOLDEN_WIDTH, GOLDEN_HEIGHT);
+    scene.world.BuildBVH();
+    scene.camera.SetSeed(GOLDEN_SEED);
+    NMCanvas canvas(GOLDEN_WIDTH, GOLDEN_HEIGHT);
+
+    // When
+    scene.camera.Render(scene.world, &canvas);
+    SNMGoldenImage image = SNMGoldenImage::FromCanvas(canvas);
+
+    // Then
+    std::string referencePath = ReferencePath(GetParam());
+    if (IsEnvSet("NM_GOLDEN_UPDATE"))
+    {
+        std::ofstream reference(referencePath);
+        canvas.ToPPM(reference);
+        ASSERT_TRUE(reference.good()) << "Failed to write " << referencePath;
+        GTEST_SKIP() << "Updated " << referencePath;
+    }
+
+    SNMGoldenImage reference = SNMGoldenImage::ReadPPM(referencePath);
+    SNMImageDiff diff = SNMImageDiff::Compare(image, reference, GOLDEN_PIXEL_THRESHOLD);
+
+    ASSERT_TRUE(diff.sameSize);
+    EXPECT_LE(static_cast<double>(diff.differingPixels),
+              GOLDEN_MAX_DIFFERING_FRACTION * static_cast<double>(GOLDEN_WIDTH * GOLDEN_HEIGHT))
+        << diff.differingPixels << " pixels differ from " << referencePath << ", max distance " << diff.maxDistance
+        << ", mean distance " << diff.meanDistance;
+}
+
+// The scenes of Examples/3_RenderSphere, 4_FirstScene, 5_PlaneScene and the SDL TestApplication
+INSTANTIATE_TEST_SUITE_P(Examples, NMGoldenImageTest, testing::Values("sphere", "first", "plane", "application"),
+                         [](const testing::TestParamInfo<std::string>& info) { return info.param; });
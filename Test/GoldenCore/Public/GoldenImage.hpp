@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "NMCore/Canvas.hpp"
+
+/**
+ * @brief An 8-bit RGB image, the precision reference images are stored with.
+ */
+struct SNMGoldenImage
+{
+    std::size_t width = 0;
+    std::size_t height = 0;
+    std::vector<int> values;
+
+    static SNMGoldenImage FromCanvas(const NMCanvas& canvas)
+    {
+        SNMGoldenImage image;
+        image.width = canvas.GetWidth();
+        image.height = canvas.GetHeight();
+        image.values.reserve(image.width * image.height * 3);
+        for (std::size_t y = 0; y < image.height; ++y)
+        {
+            for (std::size_t x = 0; x < image.width; ++x)
+            {
+                const NMColor& color = canvas.ReadPixel(x, y);
+                image.values.push_back(color.GetClampedRed());
+                image.values.push_back(color.GetClampedGreen());
+                image.values.push_back(color.GetClampedBlue());
+            }
+        }
+
+        return image;
+    }
+
+    /**
+     * @brief Read a plain (P3) PPM as written by NMCanvas::ToPPM.
+     * @throws std::runtime_error if the file cannot be read or is not a P3 PPM with a maximum value of 255.
+     */
+    static SNMGoldenImage ReadPPM(const std::string& path)
+    {
+        std::ifstream file(path);
+        std::string magic;
+        int maxValue = 0;
+
+        SNMGoldenImage image;
+        if (!(file >> magic >> image.width >> image.height >> maxValue) || magic != "P3" || maxValue != 255)
+        {
+            throw std::runtime_error("Cannot read reference image " + path);
+        }
+
+        image.values.resize(image.width * image.height * 3);
+        for (int& value : image.values)
+        {
+            if (!(file >> value))
+            {
+                throw std::runtime_error("Reference image " + path + " is truncated");
+            }
+        }
+
+        return image;
+    }
+};
+
+/**
+ * @brief How far a render is from its reference image.
+ * A pixel differs when its perceptual distance is above the threshold the comparison was made with. The distance
+ * weighs the channel differences by their contribution to luminance (Rec. 601), so small shifts in blue count less
+ * than the same shift in green.
+ */
+struct SNMImageDiff
+{
+    bool sameSize = false;
+    std::size_t differingPixels = 0;
+    double maxDistance = 0.0;
+    double meanDistance = 0.0;
+
+    static SNMImageDiff Compare(const SNMGoldenImage& image, const SNMGoldenImage& reference, double threshold)
+    {
+        SNMImageDiff diff;
+        diff.sameSize = image.width == reference.width && image.height == reference.height;
+        if (!diff.sameSize)
+        {
+            return diff;
+        }
+
+        std::size_t pixels = image.width * image.height;
+        double total = 0.0;
+        for (std::size_t i = 0; i < pixels; ++i)
+        {
+            double r = std::abs(image.values[i * 3] - reference.values[i * 3]);
+            double g = std::abs(image.values[i * 3 + 1] - reference.values[i * 3 + 1]);
+            double b = std::abs(image.values[i * 3 + 2] - reference.values[i * 3 + 2]);
+            double distance = 0.299 * r + 0.587 * g + 0.114 * b;
+
+            total += distance;
+            diff.maxDistance = std::max(diff.maxDistance, distance);
+            diff.differingPixels += distance > threshold ? 1 : 0;
+        }
+
+        diff.meanDistance = pixels > 0 ? total / static_cast<double>(pixels) : 0.0;
+        return diff;
+    }
+};
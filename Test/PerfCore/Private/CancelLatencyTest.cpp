@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "NMCore/Camera.hpp"
+#include "NMCore/Scene/SceneLibrary.hpp"
+
+constexpr double PERF_MAX_CANCEL_SECONDS = 0.025;
+
+class NMCancelLatencyTest : public testing::Test
+{
+};
+
+// Scenario: Stopping a 4K render returns within a few milliseconds, even in the middle of long reflection chains
+TEST_F(NMCancelLatencyTest, RenderCancel_Latency)
+{
+    // Given the reflective room with deep reflections, far too slow to finish before it is stopped
+    SNMScene scene = NMSceneLibrary::Create("application", 3840, 2160);
+    SNMWorldSettings settings = scene.world.GetSettings();
+    settings.ReflectionTraceDepth = 64;
+    scene.world.SetSettings(settings);
+    scene.world.BuildBVH();
+
+    NMCanvas canvas(3840, 2160, DEFAULT_COLOR, ENMCanvasLayout::Tiled);
+    ThreadPool workers(4);
+
+    // When the render is stopped a few times at different points
+    double worstSeconds = 0.0;
+    for (int run = 0; run < 5; ++run)
+    {
+        std::atomic<bool> finished(false);
+        std::thread renderThread([&scene, &canvas, &workers, &finished]
+        {
+            scene.camera.Render(scene.world, &canvas, workers);
+            finished = true;
+        });
+
+        // A stop before the render started is ignored, so keep asking until it returns
+        std::this_thread::sleep_for(std::chrono::milliseconds(20 + 10 * run));
+        auto stopStart = std::chrono::steady_clock::now();
+        while (!finished)
+        {
+            scene.camera.StopRender();
+            std::this_thread::yield();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - stopStart).count();
+        renderThread.join();
+
+        worstSeconds = std::max(worstSeconds, seconds);
+    }
+
+    // Then
+    EXPECT_LT(worstSeconds, PERF_MAX_CANCEL_SECONDS) << "worst cancel latency " << worstSeconds * 1000.0 << " ms";
+}
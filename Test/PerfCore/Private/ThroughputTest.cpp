@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+
+#include "NMCore/Camera.hpp"
+#include "NMCore/Scene/SceneLibrary.hpp"
+
+// The size and seed of the golden image renders (Test/GoldenCore), so both time and check the same frames
+constexpr std::size_t PERF_WIDTH = 128;
+constexpr std::size_t PERF_HEIGHT = 72;
+constexpr uint64_t PERF_SEED = 1;
+constexpr int PERF_TIMED_RUNS = 3;
+
+namespace
+{
+bool IsEnvSet(const char* name)
+{
+    const char* value = std::getenv(name);
+    return value && *value && std::string(value) != "0";
+}
+
+double PerfTolerance()
+{
+    const char* value = std::getenv("NM_PERF_TOLERANCE");
+    return value && *value ? std::atof(value) : static_cast<double>(NM_PERF_TOLERANCE);
+}
+
+std::string BaselinePath(const std::string& scene)
+{
+    const char* directory = std::getenv("NM_PERF_BASELINE_DIR");
+    return std::string(directory && *directory ? directory : NM_PERF_BASELINE_DIR) + "/" + scene + ".txt";
+}
+}  // namespace
+
+/**
+ * Every canonical scene is rendered single threaded and its throughput is compared against the baseline recorded on
+ * the same machine.
+ *
+ * - NM_PERF_BASELINE_UPDATE=1 records new baselines instead of comparing. Without a baseline the test fails, so a
+ *   lost baseline directory cannot turn the check into a silent pass.
+ * - NM_PERF_BASELINE_DIR overrides where baselines are kept, e.g. a directory kept between CI runs.
+ * - NM_PERF_TOLERANCE overrides the allowed throughput drop in percent (PERF_TOLERANCE in CMake).
+ */
+class NMThroughputTest : public testing::TestWithParam<std::string>
+{
+};
+
+// Scenario: A scene renders at least as fast as its baseline, within the tolerance
+TEST_P(NMThroughputTest, Throughput)
+{
+    // Given
+    SNMScene scene = NMSceneLibrary::Create(GetParam(), PERF_WIDTH, PERF_HEIGHT);
+    scene.world.BuildBVH();
+    scene.camera.SetSeed(PERF_SEED);
+    NMCanvas canvas(PERF_WIDTH, PERF_HEIGHT, DEFAULT_COLOR, ENMCanvasLayout::Tiled);
+
+    // When the best of a few single threaded renders is timed
+    double bestSeconds = std::numeric_limits<double>::infinity();
+    uint64_t rays = 0;
+    for (int run = 0; run < PERF_TIMED_RUNS; ++run)
+    {
+        SNMRenderStats stats = scene.camera.Render(scene.world, &canvas, 1);
+        bestSeconds = std::min(bestSeconds, stats.frameSeconds);
+        rays = stats.enabled ? stats.TotalRays() : PERF_WIDTH * PERF_HEIGHT;
+    }
+
+    double raysPerSecond = static_cast<double>(rays) / bestSeconds;
+    RecordProperty("render_seconds", std::to_string(bestSeconds));
+    RecordProperty("rays_per_second", std::to_string(raysPerSecond));
+
+    // Then
+    std::string baselinePath = BaselinePath(GetParam());
+    if (IsEnvSet("NM_PERF_BASELINE_UPDATE"))
+    {
+        std::ofstream output(baselinePath);
+        output << raysPerSecond << "\n";
+        ASSERT_TRUE(output.good()) << "Failed to record the baseline in " << baselinePath;
+        GTEST_SKIP() << "Recorded a baseline of " << raysPerSecond << " rays/s in " << baselinePath;
+    }
+
+    double baseline = 0.0;
+    std::ifstream baselineFile(baselinePath);
+    ASSERT_TRUE(static_cast<bool>(baselineFile >> baseline) && baseline > 0.0)
+        << "No baseline in " << baselinePath << ", record one with NM_PERF_BASELINE_UPDATE=1 (this run traced "
+        << raysPerSecond << " rays/s)";
+
+    double minimum = baseline * (1.0 - PerfTolerance() / 100.0);
+    EXPECT_GE(raysPerSecond, minimum) << GetParam() << " traced " << raysPerSecond << " rays/s, the baseline is "
+                                      << baseline << " rays/s with a tolerance of " << PerfTolerance() << "%";
+}
+
+// The scenes of the golden image tests
+INSTANTIATE_TEST_SUITE_P(Examples, NMThroughputTest, testing::Values("sphere", "first", "plane", "application"),
+                         [](const testing::TestParamInfo<std::string>& info) { return info.param; });
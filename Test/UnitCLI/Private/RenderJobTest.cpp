@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "RenderJob.hpp"
+
+class NMRenderJobTest : public testing::Test
+{
+protected:
+
+    static std::vector<SNMRenderJob> Parse(const std::string& text)
+    {
+        std::istringstream is(text);
+        return NMJobFile::Parse(is);
+    }
+
+    // The message of the error thrown for a job file, empty if it parses
+    static std::string ParseError(const std::string& text)
+    {
+        try
+        {
+            Parse(text);
+        }
+        catch (const std::runtime_error& err)
+        {
+            return err.what();
+        }
+
+        return std::string();
+    }
+};
+
+// Scenario: Parsing a job file with comments, blank lines and every key
+TEST_F(NMRenderJobTest, Parse_Valid)
+{
+    // When
+    std::vector<SNMRenderJob> jobs = Parse(
+        "# two jobs\n"
+        "\n"
+        "scene=plane width=320 height=200 fov=45 from=1,2,-3 to=0,1,0 up=0,0,1 frames=2-5 orbit=2.5 threads=3 "
+        "output=out/plane_###.ppm seed=42\n"
+        "   scene=scenes/room.txt\n");
+
+    // Then
+    ASSERT_EQ(jobs.size(), 2u);
+    const SNMRenderJob& job = jobs[0];
+    EXPECT_EQ(job.scene, "plane");
+    EXPECT_EQ(job.width, 320u);
+    EXPECT_EQ(job.height, 200u);
+    EXPECT_FLOAT_EQ(job.fov, 45.0f);
+    EXPECT_EQ(job.from, NMPoint(1.0f, 2.0f, -3.0f));
+    EXPECT_EQ(job.to, NMPoint(0.0f, 1.0f, 0.0f));
+    EXPECT_EQ(job.up, NMVector(0.0f, 0.0f, 1.0f));
+    EXPECT_EQ(job.firstFrame, 2u);
+    EXPECT_EQ(job.lastFrame, 5u);
+    EXPECT_FLOAT_EQ(job.orbit, 2.5f);
+    EXPECT_EQ(job.threads, 3u);
+    EXPECT_EQ(job.output, "out/plane_###.ppm");
+    EXPECT_TRUE(job.seeded);
+    EXPECT_EQ(job.seed, 42u);
+    EXPECT_FALSE(job.heatmap);
+
+    // Keys that are not given keep their defaults
+    SNMRenderJob defaults;
+    EXPECT_EQ(jobs[1].scene, "scenes/room.txt");
+    EXPECT_EQ(jobs[1].width, defaults.width);
+    EXPECT_EQ(jobs[1].firstFrame, 0u);
+    EXPECT_EQ(jobs[1].lastFrame, 0u);
+    EXPECT_FALSE(jobs[1].seeded);
+    EXPECT_EQ(jobs[1].output, defaults.output);
+}
+
+// Scenario: A single frame number renders one frame
+TEST_F(NMRenderJobTest, Parse_SingleFrame)
+{
+    // When
+    std::vector<SNMRenderJob> jobs = Parse("scene=sphere frames=7\n");
+
+    // Then
+    ASSERT_EQ(jobs.size(), 1u);
+    EXPECT_EQ(jobs[0].firstFrame, 7u);
+    EXPECT_EQ(jobs[0].lastFrame, 7u);
+}
+
+// Scenario: Heatmaps need a known metric that the build can measure
+TEST_F(NMRenderJobTest, Parse_Heatmap)
+{
+    // When
+    std::vector<SNMRenderJob> jobs = Parse("scene=sphere heatmap=time\n");
+
+    // Then
+    ASSERT_EQ(jobs.size(), 1u);
+    EXPECT_TRUE(jobs[0].heatmap);
+    EXPECT_EQ(jobs[0].heatmapMetric, ENMCostMetric::Time);
+    EXPECT_NE(ParseError("scene=sphere heatmap=colors\n"), "");
+    EXPECT_EQ(ParseError("scene=sphere heatmap=rays\n").empty(), NMCostMap::IsMetricAvailable(ENMCostMetric::Rays));
+}
+
+// Scenario: Malformed jobs are errors that name their line
+TEST_F(NMRenderJobTest, Parse_Malformed)
+{
+    EXPECT_EQ(ParseError("# comment\nscene=plane\nscene=plane size=3\n"), "job file line 3: unknown key 'size'");
+    EXPECT_EQ(ParseError("scene=plane width\n"), "job file line 1: expected key=value but got 'width'");
+    EXPECT_EQ(ParseError("width=10\n"), "job file line 1: missing scene");
+    EXPECT_NE(ParseError("scene=plane width=-10\n"), "");
+    EXPECT_NE(ParseError("scene=plane width=10px\n"), "");
+    EXPECT_NE(ParseError("scene=plane width=0\n"), "");
+    EXPECT_NE(ParseError("scene=plane fov=wide\n"), "");
+    EXPECT_NE(ParseError("scene=plane fov=\n"), "");
+    EXPECT_NE(ParseError("scene=plane from=1,2\n"), "");
+    EXPECT_NE(ParseError("scene=plane from=1,2,x\n"), "");
+    EXPECT_NE(ParseError("scene=plane frames=5-2\n"), "");
+    EXPECT_NE(ParseError("scene=plane frames=1-\n"), "");
+    EXPECT_NE(ParseError("scene=plane seed=99999999999999999999999\n"), "");
+}
+
+// Scenario: Numbers must be finite and the field of view must open less than a half turn
+TEST_F(NMRenderJobTest, Parse_NumberRange)
+{
+    EXPECT_EQ(ParseError("scene=plane\nscene=plane fov=nan\n"),
+              "job file line 2: expected a finite number but got 'nan'");
+    EXPECT_EQ(ParseError("scene=plane fov=inf\n"), "job file line 1: expected a finite number but got 'inf'");
+    EXPECT_EQ(ParseError("scene=plane orbit=1e40\n"), "job file line 1: expected a finite number but got '1e40'");
+    EXPECT_NE(ParseError("scene=plane from=0,-INF,0\n"), "");
+    EXPECT_EQ(ParseError("scene=plane fov=0\n"), "job file line 1: fov must be between 0 and 180 degrees but got '0'");
+    EXPECT_EQ(ParseError("scene=plane fov=180\n"),
+              "job file line 1: fov must be between 0 and 180 degrees but got '180'");
+    EXPECT_NE(ParseError("scene=plane fov=-30\n"), "");
+    EXPECT_EQ(ParseError("scene=plane fov=179.5\n"), "");
+}
+
+// Scenario: The largest frame number is a valid end of a frame range
+TEST_F(NMRenderJobTest, Parse_LargestFrame)
+{
+    // Given
+    std::string largest = std::to_string(std::numeric_limits<std::size_t>::max());
+
+    // When
+    std::vector<SNMRenderJob> jobs = Parse("scene=plane frames=" + largest + "-" + largest + "\n");
+
+    // Then
+    ASSERT_EQ(jobs.size(), 1u);
+    EXPECT_EQ(jobs[0].firstFrame, std::numeric_limits<std::size_t>::max());
+    EXPECT_EQ(jobs[0].lastFrame, std::numeric_limits<std::size_t>::max());
+}
+
+// Scenario: A run of '#' in the output path is replaced with the zero padded frame number
+TEST_F(NMRenderJobTest, OutputForFrame)
+{
+    // Given
+    SNMRenderJob job;
+
+    // When / Then
+    job.output = "out/frame_####.ppm";
+    EXPECT_EQ(job.OutputForFrame(7), "out/frame_0007.ppm");
+    EXPECT_EQ(job.OutputForFrame(12345), "out/frame_12345.ppm");
+
+    // Only the first run is replaced
+    job.output = "#_#.ppm";
+    EXPECT_EQ(job.OutputForFrame(3), "3_#.ppm");
+
+    job.output = "still.ppm";
+    EXPECT_EQ(job.OutputForFrame(3), "still.ppm");
+}
+
+// Scenario: The heatmap of a frame is written next to it with ".heat" before the extension
+TEST_F(NMRenderJobTest, HeatmapForFrame)
+{
+    // Given
+    SNMRenderJob job;
+
+    // When / Then
+    job.output = "out/frame_##.ppm";
+    EXPECT_EQ(job.HeatmapForFrame(4), "out/frame_04.heat.ppm");
+
+    job.output = "out.d/frame_##";
+    EXPECT_EQ(job.HeatmapForFrame(4), "out.d/frame_04.heat");
+
+    job.output = "out.d\\frame";
+    EXPECT_EQ(job.HeatmapForFrame(4), "out.d\\frame.heat");
+}
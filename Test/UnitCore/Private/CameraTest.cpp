@@ -2,7 +2,12 @@
 
 #include <math.h>
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 #include "NMCore/Camera.hpp"
+#include "NMCore/Scene/SceneLibrary.hpp"
 #include "NMCore/World.hpp"
 
 class NMCameraTest : public testing::Test
@@ -59,6 +64,7 @@ TEST_F(NMCameraTest, RayThroughCenter)
     // Then
     EXPECT_EQ(ray.GetOrigin(), NMPoint(0.0f, 0.0f, 0.0f));
     EXPECT_EQ(ray.GetDirection(), NMVector(0.0f, 0.0f, -1.0f));
+    EXPECT_FLOAT_EQ(ray.GetSpread(), camera.GetPixelSize());
 }
 
 // Scenario: Constructing a ray through a corner of the canvas
@@ -128,12 +134,162 @@ TEST_F(NMCameraTest, RenderMultiThreaded)
     EXPECT_EQ(pixelColor, NMColor(0.380661f, 0.475827f, 0.285496f));
 }
 
+// Scenario: Rendering several frames on one persistent thread pool
+TEST_F(NMCameraTest, Render_WithThreadPool)
+{
+    // Given
+    NMWorld world = NMWorld::Default();
+    NMCamera camera(11, 11, nmmath::halfPi);
+    NMPoint from(0.0f, 0.0f, -5.0f);
+    NMPoint to(0.0f, 0.0f, 0.0f);
+    NMVector up(0.0f, 1.0f, 0.0f);
+    camera.SetTransform(NMMatrix::ViewTransform(from, to, up));
+    ThreadPool pool(4);
+    NMCanvas first(11, 11);
+    NMCanvas second(11, 11, DEFAULT_COLOR, ENMCanvasLayout::Tiled);
+
+    // When
+    camera.Render(world, &first, pool);
+    camera.Render(world, &second, pool, 2);
+
+    // Then
+    EXPECT_EQ(first.ReadPixel(5, 5), NMColor(0.380661f, 0.475827f, 0.285496f));
+    EXPECT_EQ(second.ReadPixel(5, 5), NMColor(0.380661f, 0.475827f, 0.285496f));
+    EXPECT_EQ(first.ToPPM(), second.ToPPM());
+}
+
+// Scenario: Render returns the statistics of the frame
+TEST_F(NMCameraTest, Render_Stats)
+{
+    // Given
+    NMWorld world = NMWorld::Default();
+    NMCamera camera(11, 11, nmmath::halfPi);
+    NMPoint from(0.0f, 0.0f, -5.0f);
+    NMPoint to(0.0f, 0.0f, 0.0f);
+    NMVector up(0.0f, 1.0f, 0.0f);
+    camera.SetTransform(NMMatrix::ViewTransform(from, to, up));
+    ThreadPool pool(2);
+    NMCanvas canvas(11, 11);
+
+    // When
+    SNMRenderStats stats = camera.Render(world, &canvas, pool);
+
+    // Then
+    EXPECT_GT(stats.frameSeconds, 0.0);
+    EXPECT_EQ(stats.tileCount, 1u);
+    if (!stats.enabled)
+    {
+        GTEST_SKIP() << "Built without NM_RENDER_STATS";
+    }
+
+    uint64_t primary = stats.GetRays(ENMRayType::Primary);
+    uint64_t shadow = stats.GetRays(ENMRayType::Shadow);
+    EXPECT_EQ(primary, 121u);
+    EXPECT_GT(shadow, 0u);
+    EXPECT_LE(shadow, primary);
+    EXPECT_EQ(stats.GetRays(ENMRayType::Reflection), 0u);
+    EXPECT_EQ(stats.AverageReflectionDepth(), 0.0);
+
+    // Without a BVH every ray is tested against both spheres
+    EXPECT_EQ(stats.intersectionTests, 2 * (primary + shadow));
+    EXPECT_GT(stats.intersectionHits, 0u);
+    EXPECT_LE(stats.intersectionHits, stats.intersectionTests);
+
+    ASSERT_EQ(stats.workers.size(), 2u);
+    EXPECT_EQ(stats.workers[0].tiles + stats.workers[1].tiles, 1u);
+    ASSERT_EQ(stats.tiles.size(), 1u);
+    EXPECT_GT(stats.tiles[0].seconds, 0.0);
+    EXPECT_LE(stats.MaxTileSeconds(), stats.frameSeconds);
+}
+
+// Scenario: Reflection rays are counted
+TEST_F(NMCameraTest, Render_StatsReflection)
+{
+    // Given
+    NMWorld world = NMWorld::Default();
+    NMMaterial mirror = world.GetObject(0)->GetMaterial();
+    mirror.SetReflective(0.5f);
+    world.GetObject(0)->SetMaterial(mirror);
+    NMCamera camera(11, 11, nmmath::halfPi);
+    camera.SetTransform(NMMatrix::ViewTransform(NMPoint(0.0f, 0.0f, -5.0f), NMPoint(0.0f, 0.0f, 0.0f),
+                                                NMVector(0.0f, 1.0f, 0.0f)));
+    NMCanvas canvas(11, 11);
+
+    // When
+    SNMRenderStats stats = camera.Render(world, &canvas, 1);
+
+    // Then
+    if (!stats.enabled)
+    {
+        GTEST_SKIP() << "Built without NM_RENDER_STATS";
+    }
+
+    EXPECT_GT(stats.GetRays(ENMRayType::Reflection), 0u);
+    EXPECT_GT(stats.AverageReflectionDepth(), 0.0);
+    EXPECT_EQ(stats.TotalRays(), stats.GetRays(ENMRayType::Primary) + stats.GetRays(ENMRayType::Shadow)
+                                     + stats.GetRays(ENMRayType::Reflection));
+}
+
+// Scenario: A seeded camera hands out tiles in a fixed order
+TEST_F(NMCameraTest, TileOrder_Seeded)
+{
+    // Given
+    NMCamera first(100, 60, nmmath::halfPi);
+    NMCamera second(100, 60, nmmath::halfPi);
+    NMCamera other(100, 60, nmmath::halfPi);
+    first.SetSeed(1234u);
+    second.SetSeed(1234u);
+    other.SetSeed(4321u);
+
+    // When
+    std::vector<SNMTile> firstOrder = first.TileOrder();
+    std::vector<SNMTile> secondOrder = second.TileOrder();
+    std::vector<SNMTile> otherOrder = other.TileOrder();
+
+    // Then
+    ASSERT_EQ(firstOrder.size(), SNMTile::Split(100, 60).size());
+    bool sameAsOther = true;
+    for (std::size_t i = 0; i < firstOrder.size(); ++i)
+    {
+        EXPECT_EQ(firstOrder[i].x, secondOrder[i].x);
+        EXPECT_EQ(firstOrder[i].y, secondOrder[i].y);
+        sameAsOther = sameAsOther && firstOrder[i].x == otherOrder[i].x && firstOrder[i].y == otherOrder[i].y;
+    }
+    EXPECT_FALSE(sameAsOther);
+    EXPECT_TRUE(first.IsDeterministic());
+    EXPECT_EQ(NMCamera(first).GetSeed(), 1234u);
+}
+
+// Scenario: A deterministic render is bitwise identical on one and on many threads
+TEST_F(NMCameraTest, Render_DeterministicAcrossThreadCounts)
+{
+    // Given
+    SNMScene scene = NMSceneLibrary::Create("application", 96, 64);
+    scene.world.BuildBVH();
+    scene.camera.SetSeed(42u);
+    NMCanvas single(96, 64);
+    NMCanvas multi(96, 64, DEFAULT_COLOR, ENMCanvasLayout::Tiled);
+    NMCanvas repeated(96, 64);
+    ThreadPool pool(8);
+
+    // When
+    scene.camera.Render(scene.world, &single, 1);
+    scene.camera.Render(scene.world, &multi, pool);
+    scene.camera.Render(scene.world, &repeated, pool, 3);
+
+    // Then
+    EXPECT_EQ(single.Hash(), multi.Hash());
+    EXPECT_EQ(single.Hash(), repeated.Hash());
+    EXPECT_NE(single.Hash(), NMCanvas(96, 64).Hash());
+}
+
 // Scenario: Render throws an error if already rendering
 TEST_F(NMCameraTest, Render_WhenAlreadyRendering)
 {
     // Given
     NMWorld world = NMWorld::Default();
-    NMCamera camera(11, 11, nmmath::halfPi);
+    // Large enough that the first render is still running when the second one starts
+    NMCamera camera(400, 400, nmmath::halfPi);
     NMPoint from(0.0f, 0.0f, -5.0f);
     NMPoint to(0.0f, 0.0f, 0.0f);
     NMVector up(0.0f, 1.0f, 0.0f);
@@ -160,6 +316,7 @@ TEST_F(NMCameraTest, Render_WhenAlreadyRendering)
         FAIL() << "Expected std::runtime_error, but a different exception was thrown";
     }
 
+    camera.StopRender();
     renderThread.join();
 
     // Then
@@ -191,6 +348,43 @@ TEST_F(NMCameraTest, RenderCancel)
     EXPECT_TRUE(true);
 }
 
+// Scenario: Stopping a 4K render returns early, even in the middle of long reflection chains
+TEST_F(NMCameraTest, RenderCancel_DeepReflections)
+{
+    // Given the reflective room with deep reflections, far too slow to finish before it is stopped
+    SNMScene scene = NMSceneLibrary::Create("application", 3840, 2160);
+    SNMWorldSettings settings = scene.world.GetSettings();
+    settings.ReflectionTraceDepth = 64;
+    scene.world.SetSettings(settings);
+    scene.world.BuildBVH();
+
+    NMCanvas canvas(3840, 2160, DEFAULT_COLOR, ENMCanvasLayout::Tiled);
+    ThreadPool workers(4);
+
+    // When the render is stopped a few times at different points
+    for (int run = 0; run < 3; ++run)
+    {
+        std::atomic<bool> finished(false);
+        std::thread renderThread([&scene, &canvas, &workers, &finished]
+        {
+            scene.camera.Render(scene.world, &canvas, workers);
+            finished = true;
+        });
+
+        // A stop before the render started is ignored, so keep asking until it returns
+        std::this_thread::sleep_for(std::chrono::milliseconds(5 * run));
+        while (!finished)
+        {
+            scene.camera.StopRender();
+            std::this_thread::yield();
+        }
+        renderThread.join();
+    }
+
+    // Then the renders returned (the latency is measured by TestPerfNMCore)
+    EXPECT_TRUE(true);
+}
+
 // Scenario: StopRender can be called even when not rendering
 TEST_F(NMCameraTest, RenderCancel_WhenNotRendering)
 {
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include <cmath>
+
 #include "NMCore/Canvas.hpp"
 
 class NMCanvasTest : public testing::Test
@@ -329,3 +331,192 @@ TEST_F(NMCanvasTest, ToPPM_TerminatedWithNewLine)
     // Then
     ASSERT_EQ(ppm.substr(ppm.length() - 1, 1), "\n");
 }
+
+// Scenario: A tiled canvas reads back what was written
+TEST_F(NMCanvasTest, TiledLayout_ReadWrite)
+{
+    // Given
+    NMCanvas canvas(21, 13, DEFAULT_COLOR, ENMCanvasLayout::Tiled);
+
+    // When
+    for (std::size_t y = 0; y < canvas.GetHeight(); ++y)
+    {
+        for (std::size_t x = 0; x < canvas.GetWidth(); ++x)
+        {
+            canvas.WritePixel(x, y, NMColor(static_cast<float>(x), static_cast<float>(y), 0.0f));
+        }
+    }
+
+    // Then
+    ASSERT_EQ(canvas.GetLayout(), ENMCanvasLayout::Tiled);
+    for (std::size_t y = 0; y < canvas.GetHeight(); ++y)
+    {
+        for (std::size_t x = 0; x < canvas.GetWidth(); ++x)
+        {
+            ASSERT_EQ(canvas.ReadPixel(x, y), NMColor(static_cast<float>(x), static_cast<float>(y), 0.0f));
+        }
+    }
+}
+
+// Scenario: Converting a tiled canvas to linear keeps the image in row-major order
+TEST_F(NMCanvasTest, TiledLayout_ToLinear)
+{
+    // Given
+    NMCanvas canvas(11, 9, DEFAULT_COLOR, ENMCanvasLayout::Tiled);
+    canvas.WritePixel(0, 0, NMColor(1.0f, 0.0f, 0.0f));
+    canvas.WritePixel(9, 2, NMColor(0.0f, 1.0f, 0.0f));
+    canvas.WritePixel(10, 8, NMColor(0.0f, 0.0f, 1.0f));
+
+    // When
+    std::vector<NMColor> linear = canvas.ToLinear();
+
+    // Then
+    ASSERT_EQ(linear.size(), 99);
+    ASSERT_EQ(linear[0], NMColor(1.0f, 0.0f, 0.0f));
+    ASSERT_EQ(linear[2 * 11 + 9], NMColor(0.0f, 1.0f, 0.0f));
+    ASSERT_EQ(linear[8 * 11 + 10], NMColor(0.0f, 0.0f, 1.0f));
+    ASSERT_EQ(linear[1], NMColor(0.0f, 0.0f, 0.0f));
+}
+
+// Scenario: A linear buffer can be loaded into a tiled canvas
+TEST_F(NMCanvasTest, TiledLayout_FromLinear)
+{
+    // Given
+    NMCanvas canvas(10, 10, DEFAULT_COLOR, ENMCanvasLayout::Tiled);
+    std::vector<NMColor> linear(100);
+    for (std::size_t i = 0; i < linear.size(); ++i)
+    {
+        linear[i] = NMColor(static_cast<float>(i), 0.0f, 0.0f);
+    }
+
+    // When
+    canvas.FromLinear(linear.data());
+
+    // Then
+    ASSERT_EQ(canvas.ReadPixel(0, 0), NMColor(0.0f, 0.0f, 0.0f));
+    ASSERT_EQ(canvas.ReadPixel(9, 0), NMColor(9.0f, 0.0f, 0.0f));
+    ASSERT_EQ(canvas.ReadPixel(3, 8), NMColor(83.0f, 0.0f, 0.0f));
+    ASSERT_EQ(canvas.ToLinear(), linear);
+}
+
+// Scenario: Changing the layout keeps the image contents
+TEST_F(NMCanvasTest, SetLayout_KeepsContents)
+{
+    // Given
+    NMCanvas canvas(12, 5);
+    canvas.WritePixel(11, 4, NMColor(0.2f, 0.4f, 0.6f));
+    std::string linearPPM = canvas.ToPPM();
+
+    // When
+    canvas.SetLayout(ENMCanvasLayout::Tiled);
+
+    // Then
+    ASSERT_EQ(canvas.ReadPixel(11, 4), NMColor(0.2f, 0.4f, 0.6f));
+    ASSERT_EQ(canvas.ToPPM(), linearPPM);
+
+    // When
+    canvas.SetLayout(ENMCanvasLayout::Linear);
+
+    // Then
+    ASSERT_EQ(canvas.ReadPixel(11, 4), NMColor(0.2f, 0.4f, 0.6f));
+}
+
+// Scenario: Bilinear sampling between pixels
+TEST_F(NMCanvasTest, SampleBilinear)
+{
+    // Given
+    NMCanvas canvas(2, 2);
+    canvas.WritePixel(0, 0, NMColor(1.0f, 0.0f, 0.0f));
+    canvas.WritePixel(1, 0, NMColor(0.0f, 1.0f, 0.0f));
+    canvas.WritePixel(0, 1, NMColor(0.0f, 0.0f, 1.0f));
+    canvas.WritePixel(1, 1, NMColor(1.0f, 1.0f, 1.0f));
+
+    // Then
+    ASSERT_EQ(canvas.SampleBilinear(0.0f, 0.0f), NMColor(1.0f, 0.0f, 0.0f));
+    ASSERT_EQ(canvas.SampleBilinear(0.5f, 0.0f), NMColor(0.5f, 0.5f, 0.0f));
+    ASSERT_EQ(canvas.SampleBilinear(0.5f, 0.5f), NMColor(0.5f, 0.5f, 0.5f));
+    ASSERT_EQ(canvas.SampleBilinear(1.5f, 1.0f), NMColor(0.5f, 0.5f, 0.5f));
+}
+
+// Scenario: Writing a block of pixels into a linear canvas
+TEST_F(NMCanvasTest, WriteBlock)
+{
+    // Given
+    NMCanvas canvas(10, 10);
+    std::vector<NMColor> block = {NMColor(1.0f, 0.0f, 0.0f), NMColor(0.0f, 1.0f, 0.0f), NMColor(0.0f, 0.0f, 1.0f),
+                                  NMColor(1.0f, 1.0f, 0.0f), NMColor(0.0f, 1.0f, 1.0f), NMColor(1.0f, 0.0f, 1.0f)};
+
+    // When
+    canvas.WriteBlock(4, 5, 3, 2, block.data());
+
+    // Then
+    ASSERT_EQ(canvas.ReadPixel(4, 5), NMColor(1.0f, 0.0f, 0.0f));
+    ASSERT_EQ(canvas.ReadPixel(6, 5), NMColor(0.0f, 0.0f, 1.0f));
+    ASSERT_EQ(canvas.ReadPixel(4, 6), NMColor(1.0f, 1.0f, 0.0f));
+    ASSERT_EQ(canvas.ReadPixel(6, 6), NMColor(1.0f, 0.0f, 1.0f));
+    ASSERT_EQ(canvas.ReadPixel(7, 5), NMColor(0.0f, 0.0f, 0.0f));
+    ASSERT_EQ(canvas.ReadPixel(4, 7), NMColor(0.0f, 0.0f, 0.0f));
+}
+
+// Scenario: Writing a block that crosses tile boundaries and the canvas edge of a tiled canvas
+TEST_F(NMCanvasTest, WriteBlock_TiledClipped)
+{
+    // Given
+    NMCanvas canvas(20, 12, DEFAULT_COLOR, ENMCanvasLayout::Tiled);
+    std::vector<NMColor> block(16 * 16);
+    for (std::size_t i = 0; i < block.size(); ++i)
+    {
+        block[i] = NMColor(static_cast<float>(i % 16), static_cast<float>(i / 16), 0.0f);
+    }
+
+    // When
+    canvas.WriteBlock(6, 3, 16, 16, block.data());
+
+    // Then
+    for (std::size_t y = 3; y < 12; ++y)
+    {
+        for (std::size_t x = 6; x < 20; ++x)
+        {
+            ASSERT_EQ(canvas.ReadPixel(x, y), NMColor(static_cast<float>(x - 6), static_cast<float>(y - 3), 0.0f));
+        }
+    }
+    ASSERT_EQ(canvas.ReadPixel(5, 3), NMColor(0.0f, 0.0f, 0.0f));
+    ASSERT_EQ(canvas.ReadPixel(6, 2), NMColor(0.0f, 0.0f, 0.0f));
+}
+
+// Scenario: Writing a block with a row stride wider than the block
+TEST_F(NMCanvasTest, WriteBlock_Stride)
+{
+    // Given
+    NMCanvas canvas(4, 4);
+    std::vector<NMColor> block = {NMColor(1.0f, 0.0f, 0.0f), NMColor(0.0f, 1.0f, 0.0f), NMColor(9.0f, 9.0f, 9.0f),
+                                  NMColor(0.0f, 0.0f, 1.0f), NMColor(1.0f, 1.0f, 1.0f), NMColor(9.0f, 9.0f, 9.0f)};
+
+    // When
+    canvas.WriteBlock(0, 0, 2, 2, block.data(), 3);
+
+    // Then
+    ASSERT_EQ(canvas.ReadPixel(1, 0), NMColor(0.0f, 1.0f, 0.0f));
+    ASSERT_EQ(canvas.ReadPixel(0, 1), NMColor(0.0f, 0.0f, 1.0f));
+    ASSERT_EQ(canvas.ReadPixel(1, 1), NMColor(1.0f, 1.0f, 1.0f));
+    ASSERT_EQ(canvas.ReadPixel(2, 0), NMColor(0.0f, 0.0f, 0.0f));
+}
+
+// Scenario: The hash only depends on the pixels, not on the layout
+TEST_F(NMCanvasTest, Hash)
+{
+    // Given
+    NMCanvas linear(20, 10);
+    NMCanvas tiled(20, 10, DEFAULT_COLOR, ENMCanvasLayout::Tiled);
+    NMCanvas other(20, 10);
+
+    // When
+    linear.WritePixel(13, 7, NMColor(0.25f, 0.5f, 0.75f));
+    tiled.WritePixel(13, 7, NMColor(0.25f, 0.5f, 0.75f));
+    other.WritePixel(13, 7, NMColor(0.25f, 0.5f, std::nextafter(0.75f, 1.0f)));
+
+    // Then
+    EXPECT_EQ(linear.Hash(), tiled.Hash());
+    EXPECT_NE(linear.Hash(), other.Hash());
+    EXPECT_NE(linear.Hash(), NMCanvas(20, 10).Hash());
+}
@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+
+#include "NMCore/Camera.hpp"
+#include "NMCore/CostMap.hpp"
+
+class NMCostMapTest : public testing::Test
+{
+};
+
+// Scenario: A new cost map is empty
+TEST_F(NMCostMapTest, Construct)
+{
+    // Given
+    NMCostMap map(4, 3, ENMCostMetric::Rays);
+
+    // Then
+    EXPECT_EQ(map.GetWidth(), 4u);
+    EXPECT_EQ(map.GetHeight(), 3u);
+    EXPECT_EQ(map.GetMetric(), ENMCostMetric::Rays);
+    EXPECT_EQ(map.Max(), 0.0f);
+    EXPECT_EQ(map.Total(), 0.0);
+}
+
+// Scenario: Writing and reading pixel costs
+TEST_F(NMCostMapTest, WriteRead)
+{
+    // Given
+    NMCostMap map(4, 3);
+
+    // When
+    map.Write(1, 2, 5.0f);
+    map.Write(3, 0, 2.0f);
+    map.Write(4, 0, 9.0f);
+
+    // Then
+    EXPECT_EQ(map.Read(1, 2), 5.0f);
+    EXPECT_EQ(map.Read(3, 0), 2.0f);
+    EXPECT_EQ(map.Read(4, 0), 0.0f);
+    EXPECT_EQ(map.Max(), 5.0f);
+    EXPECT_EQ(map.Total(), 7.0);
+}
+
+// Scenario: Resizing a cost map clears it
+TEST_F(NMCostMapTest, Resize)
+{
+    // Given
+    NMCostMap map(4, 3);
+    map.Write(1, 1, 5.0f);
+
+    // When
+    map.Resize(4, 3);
+    float kept = map.Read(1, 1);
+    map.Resize(8, 2);
+
+    // Then
+    EXPECT_EQ(kept, 5.0f);
+    EXPECT_EQ(map.GetWidth(), 8u);
+    EXPECT_EQ(map.GetHeight(), 2u);
+    EXPECT_EQ(map.Total(), 0.0);
+}
+
+// Scenario: The false-color image runs from black to white
+TEST_F(NMCostMapTest, ToFalseColor)
+{
+    // Given
+    NMCostMap map(3, 1);
+    map.Write(1, 0, 2.0f);
+    map.Write(2, 0, 4.0f);
+
+    // When
+    NMCanvas image = map.ToFalseColor();
+    NMCanvas scaled = map.ToFalseColor(8.0f);
+
+    // Then
+    EXPECT_EQ(image.GetWidth(), 3u);
+    EXPECT_EQ(image.ReadPixel(0, 0), NMColor(0.0f, 0.0f, 0.0f));
+    EXPECT_EQ(image.ReadPixel(1, 0), NMColor(0.85f, 0.15f, 0.25f));
+    EXPECT_EQ(image.ReadPixel(2, 0), NMColor(1.0f, 1.0f, 1.0f));
+    EXPECT_EQ(scaled.ReadPixel(2, 0), NMColor(0.85f, 0.15f, 0.25f));
+}
+
+// Scenario: Outliers do not set the false-color scale
+TEST_F(NMCostMapTest, ToFalseColor_Outlier)
+{
+    // Given
+    NMCostMap map(200, 1);
+    for (std::size_t x = 0; x < 200; ++x)
+    {
+        map.Write(x, 0, 1.0f);
+    }
+    map.Write(0, 0, 1000.0f);
+
+    // When
+    NMCanvas image = map.ToFalseColor();
+
+    // Then
+    EXPECT_EQ(map.Percentile(0.99f), 1.0f);
+    EXPECT_EQ(map.Percentile(1.0f), 1000.0f);
+    EXPECT_EQ(image.ReadPixel(1, 0), NMColor(1.0f, 1.0f, 1.0f));
+    EXPECT_EQ(image.ReadPixel(0, 0), NMColor(1.0f, 1.0f, 1.0f));
+}
+
+// Scenario: An empty map renders black
+TEST_F(NMCostMapTest, ToFalseColor_Empty)
+{
+    // Given
+    NMCostMap map(2, 2);
+
+    // When
+    NMCanvas image = map.ToFalseColor();
+
+    // Then
+    EXPECT_EQ(image.ReadPixel(1, 1), NMColor(0.0f, 0.0f, 0.0f));
+}
+
+// Scenario: Parsing metric names
+TEST_F(NMCostMapTest, ParseMetric)
+{
+    EXPECT_EQ(NMCostMap::ParseMetric("time"), ENMCostMetric::Time);
+    EXPECT_EQ(NMCostMap::ParseMetric("rays"), ENMCostMetric::Rays);
+    EXPECT_EQ(NMCostMap::ParseMetric("tests"), ENMCostMetric::IntersectionTests);
+    EXPECT_THROW(NMCostMap::ParseMetric("cycles"), std::runtime_error);
+    EXPECT_TRUE(NMCostMap::IsMetricAvailable(ENMCostMetric::Time));
+}
+
+// Scenario: Rendering records the time spent on every pixel
+TEST_F(NMCostMapTest, Render_Time)
+{
+    // Given
+    NMWorld world = NMWorld::Default();
+    NMCamera camera(11, 11, nmmath::halfPi);
+    camera.SetTransform(NMMatrix::ViewTransform(NMPoint(0.0f, 0.0f, -5.0f), NMPoint(0.0f, 0.0f, 0.0f),
+                                                NMVector(0.0f, 1.0f, 0.0f)));
+    NMCostMap map(1, 1);
+    camera.SetCostMap(&map);
+
+    // When
+    NMCanvas canvas = camera.Render(world, 2);
+
+    // Then
+    EXPECT_EQ(map.GetWidth(), 11u);
+    EXPECT_EQ(map.GetHeight(), 11u);
+    EXPECT_GT(map.Read(0, 0), 0.0f);
+    EXPECT_GT(map.Read(5, 5), 0.0f);
+    EXPECT_EQ(canvas.ReadPixel(5, 5), NMColor(0.380661f, 0.475827f, 0.285496f));
+}
+
+// Scenario: Rendering records the rays traced for every pixel
+TEST_F(NMCostMapTest, Render_Rays)
+{
+    if (!NMCostMap::IsMetricAvailable(ENMCostMetric::Rays))
+    {
+        GTEST_SKIP() << "Built without NM_RENDER_STATS";
+    }
+
+    // Given
+    NMWorld world = NMWorld::Default();
+    NMCamera camera(11, 11, nmmath::halfPi);
+    camera.SetTransform(NMMatrix::ViewTransform(NMPoint(0.0f, 0.0f, -5.0f), NMPoint(0.0f, 0.0f, 0.0f),
+                                                NMVector(0.0f, 1.0f, 0.0f)));
+    NMCostMap rays(11, 11, ENMCostMetric::Rays);
+    NMCostMap tests(11, 11, ENMCostMetric::IntersectionTests);
+
+    // When
+    camera.SetCostMap(&rays);
+    camera.Render(world, 1);
+    camera.SetCostMap(&tests);
+    camera.Render(world, 1);
+
+    // Then the corner only traces its primary ray, the center also casts a shadow ray
+    EXPECT_EQ(rays.Read(0, 0), 1.0f);
+    EXPECT_EQ(rays.Read(5, 5), 2.0f);
+    EXPECT_EQ(tests.Read(0, 0), 2.0f);
+    EXPECT_EQ(tests.Read(5, 5), 4.0f);
+}
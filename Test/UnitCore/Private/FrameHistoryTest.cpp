@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+
+#include <limits>
+
+#include "NMCore/Camera.hpp"
+#include "NMCore/FrameHistory.hpp"
+#include "NMCore/Scene/SceneLibrary.hpp"
+
+class NMFrameHistoryTest : public testing::Test
+{
+protected:
+
+    static constexpr std::size_t WIDTH = 48;
+    static constexpr std::size_t HEIGHT = 32;
+
+    static SNMScene Scene()
+    {
+        SNMScene scene = NMSceneLibrary::Create("application", WIDTH, HEIGHT);
+        scene.world.BuildBVH();
+        scene.camera.SetSeed(1);
+        return scene;
+    }
+
+    // The hash of a full render of the world, without a frame history
+    static uint64_t FullRenderHash(const NMCamera& sceneCamera, const NMWorld& world)
+    {
+        NMCamera camera = sceneCamera;
+        NMCanvas canvas(camera.GetHSize(), camera.GetVSize());
+        camera.Render(world, &canvas, 2);
+        return canvas.Hash();
+    }
+};
+
+constexpr std::size_t NMFrameHistoryTest::WIDTH;
+constexpr std::size_t NMFrameHistoryTest::HEIGHT;
+
+// Scenario: A render stores the color and depth of every pixel
+TEST_F(NMFrameHistoryTest, Render_StoresSamples)
+{
+    // Given
+    NMWorld world = NMWorld::Default();
+    NMCamera camera(11, 11, nmmath::halfPi);
+    camera.SetTransform(
+        NMMatrix::ViewTransform(NMPoint(0.0f, 0.0f, -5.0f), NMPoint(0.0f, 0.0f, 0.0f), NMVector(0.0f, 1.0f, 0.0f)));
+    NMFrameHistory history;
+    camera.SetFrameHistory(&history);
+    NMCanvas canvas(11, 11);
+
+    // When
+    camera.Render(world, &canvas, 2);
+
+    // Then
+    ASSERT_TRUE(history.Matches(11, 11));
+    EXPECT_EQ(history.Count(ENMSampleState::Traced), 121u);
+    EXPECT_FLOAT_EQ(history.GetDepth(5, 5), 4.0f);
+    EXPECT_EQ(history.GetColor(5, 5), canvas.ReadPixel(5, 5));
+    EXPECT_EQ(history.GetDepth(0, 0), std::numeric_limits<float>::infinity());
+}
+
+// Scenario: Reprojecting with an unchanged camera traces nothing
+TEST_F(NMFrameHistoryTest, Reproject_SameView)
+{
+    // Given
+    SNMScene scene = Scene();
+    NMFrameHistory history;
+    scene.camera.SetFrameHistory(&history);
+    NMCanvas canvas(WIDTH, HEIGHT);
+    scene.camera.Render(scene.world, &canvas, 2);
+    uint64_t rendered = canvas.Hash();
+
+    // When
+    SNMRenderStats stats = scene.camera.Reproject(scene.world, &canvas, 2);
+
+    // Then
+    EXPECT_EQ(canvas.Hash(), rendered);
+    EXPECT_EQ(history.Count(ENMSampleState::Traced), WIDTH * HEIGHT);
+    if (stats.enabled)
+    {
+        EXPECT_EQ(stats.GetRays(ENMRayType::Primary), 0u);
+    }
+}
+
+// Scenario: After a small camera move only the disoccluded pixels are traced first
+TEST_F(NMFrameHistoryTest, Reproject_TracesDisoccludedFirst)
+{
+    // Given
+    SNMScene scene = Scene();
+    NMFrameHistory history;
+    scene.camera.SetFrameHistory(&history);
+    NMCanvas canvas(WIDTH, HEIGHT);
+    scene.camera.Render(scene.world, &canvas, 2);
+
+    scene.camera.SetTransform(NMMatrix::RotationY(0.02f) * scene.camera.GetTransform());
+
+    // When
+    SNMRenderStats stats = scene.camera.Reproject(scene.world, &canvas, 2, false);
+
+    // Then most pixels are carried over, all others are traced
+    std::size_t reprojected = history.Count(ENMSampleState::Reprojected);
+    std::size_t traced = history.Count(ENMSampleState::Traced);
+    EXPECT_GT(reprojected, WIDTH * HEIGHT * 8 / 10);
+    EXPECT_GT(traced, 0u);
+    EXPECT_EQ(reprojected + traced, WIDTH * HEIGHT);
+    if (stats.enabled)
+    {
+        EXPECT_EQ(stats.GetRays(ENMRayType::Primary), traced);
+    }
+}
+
+// Scenario: Refinement converges to the image of a full render of the new view
+TEST_F(NMFrameHistoryTest, Reproject_RefinesToFullRender)
+{
+    // Given
+    SNMScene scene = Scene();
+    NMFrameHistory history;
+    scene.camera.SetFrameHistory(&history);
+    NMCanvas canvas(WIDTH, HEIGHT);
+    scene.camera.Render(scene.world, &canvas, 2);
+
+    scene.camera.SetTransform(NMMatrix::Translation(0.1f, 0.0f, 0.0f) * NMMatrix::RotationY(0.05f)
+                              * scene.camera.GetTransform());
+    scene.camera.Reproject(scene.world, &canvas, 2, false);
+
+    // When the preview is refined without moving the camera
+    SNMRenderStats stats = scene.camera.Reproject(scene.world, &canvas, 2);
+
+    // Then
+    EXPECT_EQ(history.Count(ENMSampleState::Traced), WIDTH * HEIGHT);
+    EXPECT_EQ(canvas.Hash(), FullRenderHash(scene.camera, scene.world));
+    if (stats.enabled)
+    {
+        EXPECT_LT(stats.GetRays(ENMRayType::Primary), WIDTH * HEIGHT);
+    }
+}
+
+// Scenario: With fewer tiles than threads, refinement does not start on a tile before its disoccluded pass finished
+TEST_F(NMFrameHistoryTest, Reproject_FewerTilesThanThreads)
+{
+    // Given a single tile frame and many more workers than tiles
+    SNMScene scene = NMSceneLibrary::Create("application", 16, 16);
+    scene.world.BuildBVH();
+    scene.camera.SetSeed(1);
+    NMFrameHistory history;
+    scene.camera.SetFrameHistory(&history);
+    NMCanvas canvas(16, 16);
+    ThreadPool workers(8);
+    scene.camera.Render(scene.world, &canvas, workers);
+
+    for (int move = 0; move < 10; ++move)
+    {
+        // When
+        scene.camera.SetTransform(NMMatrix::RotationY(0.03f) * scene.camera.GetTransform());
+        scene.camera.Reproject(scene.world, &canvas, workers);
+
+        // Then
+        EXPECT_EQ(history.Count(ENMSampleState::Traced), 256u) << "move " << move;
+        EXPECT_EQ(canvas.Hash(), FullRenderHash(scene.camera, scene.world)) << "move " << move;
+    }
+}
+
+// Scenario: Turning the camera around leaves no sample in view
+TEST_F(NMFrameHistoryTest, Reproject_BehindCamera)
+{
+    // Given
+    SNMScene scene = Scene();
+    NMFrameHistory history;
+    scene.camera.SetFrameHistory(&history);
+    NMCanvas canvas(WIDTH, HEIGHT);
+    scene.camera.Render(scene.world, &canvas, 2);
+
+    scene.camera.SetTransform(NMMatrix::RotationY(nmmath::pi) * scene.camera.GetTransform());
+
+    // When
+    SNMRenderStats stats = scene.camera.Reproject(scene.world, &canvas, 2);
+
+    // Then
+    EXPECT_EQ(history.Count(ENMSampleState::Traced), WIDTH * HEIGHT);
+    EXPECT_EQ(canvas.Hash(), FullRenderHash(scene.camera, scene.world));
+    if (stats.enabled)
+    {
+        EXPECT_EQ(stats.GetRays(ENMRayType::Primary), WIDTH * HEIGHT);
+    }
+}
+
+// Scenario: An invalidated history is traced again completely
+TEST_F(NMFrameHistoryTest, Invalidate)
+{
+    // Given
+    SNMScene scene = Scene();
+    NMFrameHistory history;
+    scene.camera.SetFrameHistory(&history);
+    NMCanvas canvas(WIDTH, HEIGHT);
+    scene.camera.Render(scene.world, &canvas, 2);
+
+    // When
+    history.Invalidate();
+    SNMRenderStats stats = scene.camera.Reproject(scene.world, &canvas, 2);
+
+    // Then
+    EXPECT_EQ(history.Count(ENMSampleState::Traced), WIDTH * HEIGHT);
+    if (stats.enabled)
+    {
+        EXPECT_EQ(stats.GetRays(ENMRayType::Primary), WIDTH * HEIGHT);
+    }
+}
@@ -0,0 +1,237 @@
+#include <gtest/gtest.h>
+
+#include "NMCore/Camera.hpp"
+#include "NMCore/GBuffer.hpp"
+#include "NMCore/Primitive/Group.hpp"
+#include "NMCore/Scene/SceneLibrary.hpp"
+
+class NMGBufferTest : public testing::Test
+{
+protected:
+
+    static SNMScene ReflectiveScene()
+    {
+        SNMScene scene = NMSceneLibrary::Create("application", 48, 32);
+        scene.world.BuildBVH();
+        scene.camera.SetSeed(1);
+        return scene;
+    }
+
+    // The hash of a full render of the world, without a G-buffer
+    static uint64_t FullRenderHash(const NMCamera& sceneCamera, const NMWorld& world)
+    {
+        NMCamera camera = sceneCamera;
+        NMCanvas canvas(camera.GetHSize(), camera.GetVSize());
+        camera.Render(world, &canvas, 2);
+        return canvas.Hash();
+    }
+};
+
+// Scenario: A render fills the G-buffer with the first hits of the frame
+TEST_F(NMGBufferTest, Render_FillsBuffer)
+{
+    // Given
+    NMWorld world = NMWorld::Default();
+    NMCamera camera(11, 11, nmmath::halfPi);
+    camera.SetTransform(
+        NMMatrix::ViewTransform(NMPoint(0.0f, 0.0f, -5.0f), NMPoint(0.0f, 0.0f, 0.0f), NMVector(0.0f, 1.0f, 0.0f)));
+    NMGBuffer buffer;
+    camera.SetGBuffer(&buffer);
+    NMCanvas canvas(11, 11);
+
+    // When
+    camera.Render(world, &canvas, 2);
+
+    // Then
+    EXPECT_TRUE(buffer.IsValid());
+    EXPECT_TRUE(buffer.IsValidFor(world, 11, 11, nmmath::halfPi, camera.GetTransform()));
+    ASSERT_EQ(buffer.GetWidth(), 11u);
+    ASSERT_EQ(buffer.GetHeight(), 11u);
+
+    // The center ray hits the outer sphere at (0, 0, -1), the corner rays miss
+    const SNMGBufferSample& center = buffer.At(5, 5);
+    EXPECT_EQ(center.state.object, world.GetObject(0).get());
+    EXPECT_EQ(center.state.point, NMPoint(0.0f, 0.0f, -1.0f));
+    EXPECT_EQ(center.state.normalVector, NMVector(0.0f, 0.0f, -1.0f));
+    EXPECT_EQ(center.state.eyeVector, NMVector(0.0f, 0.0f, -1.0f));
+    EXPECT_EQ(buffer.At(0, 0).state.object, nullptr);
+    EXPECT_EQ(canvas.ReadPixel(5, 5), NMColor(0.380661f, 0.475827f, 0.285496f));
+}
+
+// Scenario: Reshading after a material change matches a full render and traces no primary rays
+TEST_F(NMGBufferTest, Reshade_MaterialChange)
+{
+    // Given
+    SNMScene scene = ReflectiveScene();
+    NMGBuffer buffer;
+    scene.camera.SetGBuffer(&buffer);
+    NMCanvas canvas(48, 32);
+    scene.camera.Render(scene.world, &canvas, 2);
+
+    std::shared_ptr<NMPrimitiveBase> object = scene.world.GetObject(scene.world.GetObjectCount() - 1);
+    NMMaterial material = object->GetMaterial();
+    material.SetColor(NMColor(0.2f, 0.3f, 0.9f));
+    material.SetSpecular(0.1f);
+    object->SetMaterial(material);
+
+    // When
+    SNMRenderStats stats = scene.camera.Reshade(scene.world, &canvas, 2);
+
+    // Then
+    EXPECT_TRUE(buffer.IsValid());
+    EXPECT_EQ(canvas.Hash(), FullRenderHash(scene.camera, scene.world));
+    if (stats.enabled)
+    {
+        EXPECT_EQ(stats.GetRays(ENMRayType::Primary), 0u);
+        EXPECT_LE(stats.GetRays(ENMRayType::Shadow), stats.GetRays(ENMRayType::Reflection));
+        EXPECT_GT(stats.GetRays(ENMRayType::Reflection), 0u);
+    }
+}
+
+// Scenario: Reshading after a light color change reuses the cached shadows
+TEST_F(NMGBufferTest, Reshade_LightColorChange)
+{
+    // Given
+    SNMScene scene = ReflectiveScene();
+    NMGBuffer buffer;
+    scene.camera.SetGBuffer(&buffer);
+    NMCanvas canvas(48, 32);
+    scene.camera.Render(scene.world, &canvas, 2);
+
+    NMPointLight light = scene.world.GetPointLight(0);
+    scene.world.SetLight(0, NMPointLight(light.GetPosition(), NMColor(1.0f, 0.5f, 0.25f)));
+
+    // When
+    SNMRenderStats stats = scene.camera.Reshade(scene.world, &canvas, 2);
+
+    // Then
+    EXPECT_EQ(canvas.Hash(), FullRenderHash(scene.camera, scene.world));
+    if (stats.enabled)
+    {
+        EXPECT_EQ(stats.GetRays(ENMRayType::Primary), 0u);
+        EXPECT_LE(stats.GetRays(ENMRayType::Shadow), stats.GetRays(ENMRayType::Reflection));
+    }
+}
+
+// Scenario: Reshading after moving the shadow casting light traces the shadow rays again
+TEST_F(NMGBufferTest, Reshade_LightMoved)
+{
+    // Given
+    SNMScene scene = ReflectiveScene();
+    NMGBuffer buffer;
+    scene.camera.SetGBuffer(&buffer);
+    NMCanvas canvas(48, 32);
+    scene.camera.Render(scene.world, &canvas, 2);
+    uint64_t before = canvas.Hash();
+
+    scene.world.SetLight(0, NMPointLight(NMPoint(5.0f, 8.0f, -10.0f), NMColor(1.0f, 1.0f, 1.0f)));
+
+    // When
+    SNMRenderStats stats = scene.camera.Reshade(scene.world, &canvas, 2);
+    SNMRenderStats again = scene.camera.Reshade(scene.world, &canvas, 2);
+
+    // Then
+    EXPECT_NE(canvas.Hash(), before);
+    EXPECT_EQ(canvas.Hash(), FullRenderHash(scene.camera, scene.world));
+    if (stats.enabled)
+    {
+        EXPECT_EQ(stats.GetRays(ENMRayType::Primary), 0u);
+        EXPECT_GT(stats.GetRays(ENMRayType::Shadow), stats.GetRays(ENMRayType::Reflection));
+
+        // The shadows of the new position are cached by the first reshade
+        EXPECT_LE(again.GetRays(ENMRayType::Shadow), again.GetRays(ENMRayType::Reflection));
+    }
+}
+
+// Scenario: Moving an object invalidates the G-buffer and Reshade renders the frame again
+TEST_F(NMGBufferTest, Reshade_TransformChangeInvalidates)
+{
+    // Given
+    SNMScene scene = ReflectiveScene();
+    NMGBuffer buffer;
+    scene.camera.SetGBuffer(&buffer);
+    NMCanvas canvas(48, 32);
+    scene.camera.Render(scene.world, &canvas, 2);
+
+    std::shared_ptr<NMPrimitiveBase> object = scene.world.GetObject(scene.world.GetObjectCount() - 1);
+    object->SetTransform(NMMatrix::Translation(0.0f, 0.25f, 0.0f) * object->GetTransform());
+    scene.world.BuildBVH();
+
+    // When
+    bool validBefore = buffer.IsValidFor(scene.world, 48, 32, scene.camera.GetFOV(), scene.camera.GetTransform());
+    SNMRenderStats stats = scene.camera.Reshade(scene.world, &canvas, 2);
+
+    // Then
+    EXPECT_FALSE(validBefore);
+    EXPECT_TRUE(buffer.IsValidFor(scene.world, 48, 32, scene.camera.GetFOV(), scene.camera.GetTransform()));
+    EXPECT_EQ(canvas.Hash(), FullRenderHash(scene.camera, scene.world));
+    if (stats.enabled)
+    {
+        EXPECT_EQ(stats.GetRays(ENMRayType::Primary), 48u * 32u);
+    }
+}
+
+// Scenario: Adding an object or moving the camera invalidates the G-buffer
+TEST_F(NMGBufferTest, IsValidFor_ObjectsAndCamera)
+{
+    // Given
+    SNMScene scene = ReflectiveScene();
+    NMGBuffer buffer;
+    scene.camera.SetGBuffer(&buffer);
+    NMCanvas canvas(48, 32);
+    scene.camera.Render(scene.world, &canvas, 2);
+    NMMatrix cameraTransform = scene.camera.GetTransform();
+
+    // When
+    NMWorld moreObjects = scene.world;
+    moreObjects.AddObject(std::make_shared<NMSphere>());
+
+    // Then
+    EXPECT_TRUE(buffer.IsValidFor(scene.world, 48, 32, scene.camera.GetFOV(), cameraTransform));
+    EXPECT_FALSE(buffer.IsValidFor(moreObjects, 48, 32, scene.camera.GetFOV(), cameraTransform));
+    EXPECT_FALSE(buffer.IsValidFor(scene.world, 48, 32, scene.camera.GetFOV(),
+                                   NMMatrix::Translation(0.0f, 0.0f, 0.001f) * cameraTransform));
+    EXPECT_FALSE(buffer.IsValidFor(scene.world, 48, 32, scene.camera.GetFOV() * 0.5f, cameraTransform));
+    EXPECT_FALSE(buffer.IsValidFor(scene.world, 32, 48, scene.camera.GetFOV(), cameraTransform));
+}
+
+// Scenario: Moving a child of a group invalidates the G-buffer although the group itself did not move
+TEST_F(NMGBufferTest, IsValidFor_GroupedChildMoved)
+{
+    // Given
+    std::shared_ptr<NMSphere> child = std::make_shared<NMSphere>();
+    std::shared_ptr<NMGroup> group = std::make_shared<NMGroup>();
+    group->AddChild(child);
+    NMWorld world = NMWorld::Default();
+    world.AddObject(group);
+
+    NMCamera camera(11, 11, nmmath::halfPi);
+    camera.SetTransform(NMMatrix::ViewTransform(NMPoint(0.0f, 0.0f, -5.0f), NMPoint(0.0f, 0.0f, 0.0f),
+                                                NMVector(0.0f, 1.0f, 0.0f)));
+    NMGBuffer buffer;
+    camera.SetGBuffer(&buffer);
+    NMCanvas canvas(11, 11);
+    camera.Render(world, &canvas, 2);
+    bool validBefore = buffer.IsValidFor(world, 11, 11, nmmath::halfPi, camera.GetTransform());
+
+    // When
+    child->SetTransform(NMMatrix::Translation(0.5f, 0.0f, 0.0f));
+
+    // Then
+    EXPECT_TRUE(validBefore);
+    EXPECT_FALSE(buffer.IsValidFor(world, 11, 11, nmmath::halfPi, camera.GetTransform()));
+}
+
+// Scenario: Reshading without a G-buffer renders the frame
+TEST_F(NMGBufferTest, Reshade_WithoutBuffer)
+{
+    // Given
+    SNMScene scene = ReflectiveScene();
+    NMCanvas canvas(48, 32);
+
+    // When
+    scene.camera.Reshade(scene.world, &canvas, 2);
+
+    // Then
+    EXPECT_EQ(canvas.Hash(), FullRenderHash(scene.camera, scene.world));
+}
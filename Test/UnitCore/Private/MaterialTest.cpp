@@ -404,6 +404,28 @@ TEST_F(NMMaterialTest, Lighting_PatternApplied)
     ASSERT_EQ(c2, NMColor(0, 0, 0));
 }
 
+// Scenario: Lighting a point whose surface color is already known, as done once per hit for all lights
+TEST_F(NMMaterialTest, Lighting_SurfaceColor)
+{
+    // Given
+    NMSphere sphere;
+    NMMaterial material;
+    material.SetPattern(std::make_shared<NMStripePattern>(NMColor(1, 0.5f, 0), NMColor(0, 0, 0)));
+    NMPoint position(0.5f, 0, 0);
+    NMVector eyev(0, -nmmath::sqrt2Over2, -nmmath::sqrt2Over2);
+    NMVector normalv(0, 0, -1);
+    NMPointLight light(NMPoint(0, 10, -10), NMColor(1, 1, 1));
+
+    // When
+    NMColor surfaceColor = material.SurfaceColor(sphere, position);
+    NMColor result = material.Lighting(surfaceColor, light, position, eyev, normalv, false);
+
+    // Then
+    EXPECT_EQ(surfaceColor, NMColor(1, 0.5f, 0));
+    EXPECT_EQ(result, material.Lighting(sphere, light, position, eyev, normalv, false));
+    EXPECT_EQ(material.Lighting(surfaceColor, light, position, eyev, normalv, true), NMColor(0.1f, 0.05f, 0));
+}
+
 // Scenario: Reflectivity for the default material
 //   Given m ← material()
 //   Then m.reflective = 0.0
@@ -0,0 +1,197 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "NMCore/Pattern/Checker.hpp"
+#include "NMCore/Pattern/Composite.hpp"
+#include "NMCore/Pattern/Gradient.hpp"
+#include "NMCore/Pattern/Ring.hpp"
+#include "NMCore/Pattern/Stripe.hpp"
+#include "NMCore/Primitive/Sphere.hpp"
+
+class NMCompositePatternTest : public testing::Test
+{
+protected:
+
+    NMColor black = NMColor(0.0f, 0.0f, 0.0f);
+    NMColor white = NMColor(1.0f, 1.0f, 1.0f);
+    NMColor red = NMColor(1.0f, 0.0f, 0.0f);
+    NMColor blue = NMColor(0.0f, 0.0f, 1.0f);
+
+    // Compares along a line through many cells; expected is evaluated at inverse * point
+    static void ExpectSameColors(const NMPatternBase& expected, const NMPatternBase& actual,
+                                 const NMMatrix& inverse = NMMatrix::Identity4x4())
+    {
+        for (int i = 0; i < 200; ++i)
+        {
+            float t = static_cast<float>(i) * 0.173f - 17.0f;
+            NMPoint point(t, 0.61f * t + 0.2f, -0.37f * t + 0.1f);
+            EXPECT_EQ(actual.ColorAt(point), expected.ColorAt(inverse * point)) << "at " << t;
+        }
+    }
+};
+
+// Scenario: Selectors and gradients of solid colors match the single patterns, with the colors inline
+TEST_F(NMCompositePatternTest, ColorAt_MatchesSinglePatterns)
+{
+    // Given
+    NMCompositePattern stripe(SNMPatternNode::Stripe(SNMPatternNode::Solid(white), SNMPatternNode::Solid(black)));
+    NMCompositePattern ring(SNMPatternNode::Ring(SNMPatternNode::Solid(white), SNMPatternNode::Solid(black)));
+    NMCompositePattern checker(SNMPatternNode::Checker(SNMPatternNode::Solid(white), SNMPatternNode::Solid(black)));
+    NMCompositePattern gradient(SNMPatternNode::Gradient(SNMPatternNode::Solid(red), SNMPatternNode::Solid(blue)));
+
+    // Then
+    ExpectSameColors(NMStripePattern(white, black), stripe);
+    ExpectSameColors(NMRingPattern(white, black), ring);
+    ExpectSameColors(NMCheckerPattern(white, black), checker);
+    ExpectSameColors(NMGradientPattern(red, blue), gradient);
+    ASSERT_EQ(stripe.GetProgram().size(), 1u);
+    EXPECT_TRUE(stripe.GetProgram()[0].inlineColors);
+}
+
+// Scenario: Nested patterns are picked by the parent and evaluated with their own transforms
+TEST_F(NMCompositePatternTest, ColorAt_Nested)
+{
+    // Given stripes alternating between checkers and rings scaled down by 4
+    SNMPatternNode checker = SNMPatternNode::Checker(SNMPatternNode::Solid(white), SNMPatternNode::Solid(black));
+    SNMPatternNode ring = SNMPatternNode::Ring(SNMPatternNode::Solid(red), SNMPatternNode::Solid(blue));
+    NMMatrix scaling = NMMatrix::Scaling(0.25f, 0.25f, 0.25f);
+    NMCompositePattern pattern(
+        SNMPatternNode::Stripe(SNMPatternNode::Transform(checker, scaling), SNMPatternNode::Transform(ring, scaling)));
+    NMCheckerPattern expectedChecker(white, black);
+    NMRingPattern expectedRing(red, blue);
+
+    // Then
+    for (int i = 0; i < 100; ++i)
+    {
+        NMPoint point(static_cast<float>(i) * 0.07f - 3.0f, 0.4f, static_cast<float>(i) * 0.031f);
+        NMPoint patternPoint = scaling.Inverse() * point;
+        const NMColor expected = static_cast<int>(std::floor(point.GetX())) % 2 == 0
+                                     ? expectedChecker.ColorAt(patternPoint)
+                                     : expectedRing.ColorAt(patternPoint);
+        EXPECT_EQ(pattern.ColorAt(point), expected) << "at " << point.GetX();
+    }
+}
+
+// Scenario: Nested transforms are merged into one matrix and identity transforms are dropped
+TEST_F(NMCompositePatternTest, Compile_Transforms)
+{
+    // Given
+    SNMPatternNode stripe = SNMPatternNode::Stripe(SNMPatternNode::Solid(white), SNMPatternNode::Solid(black));
+    NMMatrix translation = NMMatrix::Translation(0.5f, 0.0f, 0.0f);
+    NMMatrix scaling = NMMatrix::Scaling(2.0f, 1.0f, 1.0f);
+
+    // When
+    NMCompositePattern merged(SNMPatternNode::Transform(SNMPatternNode::Transform(stripe, scaling), translation));
+    NMCompositePattern identity(SNMPatternNode::Transform(stripe, NMMatrix::Identity4x4()));
+
+    // Then
+    ASSERT_EQ(merged.GetProgram().size(), 3u);
+    EXPECT_EQ(merged.GetProgram()[0].opcode, ENMPatternOpcode::Transform);
+    EXPECT_EQ(merged.GetProgram()[2].opcode, ENMPatternOpcode::PopPoint);
+    ExpectSameColors(NMStripePattern(white, black), merged, (translation * scaling).Inverse());
+    EXPECT_EQ(identity.GetProgram().size(), 1u);
+}
+
+// Scenario: Blends mix their children, and blends of solid colors are folded into one color
+TEST_F(NMCompositePatternTest, ColorAt_Blend)
+{
+    // Given
+    NMCompositePattern constant(SNMPatternNode::Blend(SNMPatternNode::Solid(red), SNMPatternNode::Solid(blue), 0.25f));
+    NMCompositePattern stripes(SNMPatternNode::Blend(
+        SNMPatternNode::Stripe(SNMPatternNode::Solid(white), SNMPatternNode::Solid(black)),
+        SNMPatternNode::Transform(SNMPatternNode::Stripe(SNMPatternNode::Solid(white), SNMPatternNode::Solid(black)),
+                                  NMMatrix::RotationY(nmmath::halfPi))));
+
+    // Then
+    ASSERT_EQ(constant.GetProgram().size(), 1u);
+    EXPECT_EQ(constant.GetProgram()[0].opcode, ENMPatternOpcode::Solid);
+    EXPECT_EQ(constant.ColorAt(NMPoint(3.0f, 2.0f, 1.0f)), NMColor(0.75f, 0.0f, 0.25f));
+    EXPECT_EQ(stripes.ColorAt(NMPoint(0.5f, 0.0f, -0.5f)), white);
+    EXPECT_EQ(stripes.ColorAt(NMPoint(0.5f, 0.0f, 0.5f)), NMColor(0.5f, 0.5f, 0.5f));
+    EXPECT_EQ(stripes.ColorAt(NMPoint(1.5f, 0.0f, 0.5f)), black);
+}
+
+// Scenario: Perturbing moves the edges of a stripe by at most the scale, up to the slight overshoot of the noise
+TEST_F(NMCompositePatternTest, ColorAt_Perturb)
+{
+    // Given
+    SNMPatternNode stripe = SNMPatternNode::Stripe(SNMPatternNode::Solid(white), SNMPatternNode::Solid(black));
+    NMCompositePattern pattern(SNMPatternNode::Perturb(stripe, 0.2f, 2.0f));
+    NMStripePattern reference(white, black);
+
+    // When
+    int changed = 0;
+    for (int i = 0; i < 400; ++i)
+    {
+        NMPoint point(static_cast<float>(i) * 0.05f - 10.0f, 0.3f, static_cast<float>(i) * 0.013f);
+        NMColor color = pattern.ColorAt(point);
+        if (!(color == reference.ColorAt(point)))
+        {
+            ++changed;
+
+            // Then only points close to an edge can change
+            float fraction = point.GetX() - std::floor(point.GetX());
+            EXPECT_LE(std::min(fraction, 1.0f - fraction), 0.2f * 1.1f) << "at " << point.GetX();
+        }
+    }
+
+    EXPECT_GT(changed, 0);
+}
+
+// Scenario: Noise mixes its children by a smooth value between them
+TEST_F(NMCompositePatternTest, ColorAt_Noise)
+{
+    // Given
+    NMCompositePattern pattern(
+        SNMPatternNode::Noise(SNMPatternNode::Solid(black), SNMPatternNode::Solid(white), 1.5f, 3));
+
+    // Then
+    EXPECT_EQ(pattern.ColorAt(NMPoint(0.0f, 0.0f, 0.0f)), NMColor(0.5f, 0.5f, 0.5f));
+    bool varies = false;
+    for (int i = 0; i < 100; ++i)
+    {
+        NMColor color = pattern.ColorAt(NMPoint(static_cast<float>(i) * 0.11f, 0.3f, -0.7f));
+        EXPECT_GE(color.GetRed(), 0.0f);
+        EXPECT_LE(color.GetRed(), 1.0f);
+        EXPECT_EQ(color.GetRed(), color.GetBlue());
+        varies = varies || std::abs(color.GetRed() - 0.5f) > 0.1f;
+    }
+    EXPECT_TRUE(varies);
+}
+
+// Scenario: The pattern's own transform applies to the whole tree through ColorAtShapePoint
+TEST_F(NMCompositePatternTest, ColorAtShapePoint_Transform)
+{
+    // Given
+    NMSphere sphere;
+    sphere.SetTransform(NMMatrix::Scaling(2.0f, 2.0f, 2.0f));
+    NMMatrix translation = NMMatrix::Translation(0.5f, 0.0f, 0.0f);
+    NMCompositePattern pattern(SNMPatternNode::Stripe(SNMPatternNode::Solid(white), SNMPatternNode::Solid(black)),
+                               translation);
+    NMStripePattern reference(white, black, translation);
+
+    // Then
+    EXPECT_EQ(pattern.ColorAtShapePoint(sphere, NMPoint(2.5f, 0.0f, 0.0f)),
+              reference.ColorAtShapePoint(sphere, NMPoint(2.5f, 0.0f, 0.0f)));
+    EXPECT_EQ(pattern.ColorAtShapePoint(sphere, NMPoint(3.5f, 0.0f, 0.0f)),
+              reference.ColorAtShapePoint(sphere, NMPoint(3.5f, 0.0f, 0.0f)));
+}
+
+// Scenario: Trees deeper than the evaluation stack and nodes with the wrong children are rejected
+TEST_F(NMCompositePatternTest, Compile_Invalid)
+{
+    // Given a chain of blends, each holding the color stack of its parent plus one
+    SNMPatternNode deep = SNMPatternNode::Gradient(SNMPatternNode::Solid(white), SNMPatternNode::Solid(black));
+    for (uint32_t i = 0; i < NMCompositePattern::MAX_STACK_DEPTH; ++i)
+    {
+        deep = SNMPatternNode::Blend(SNMPatternNode::Solid(red), deep);
+    }
+
+    SNMPatternNode childless = SNMPatternNode::Stripe(SNMPatternNode::Solid(white), SNMPatternNode::Solid(black));
+    childless.children.pop_back();
+
+    // Then
+    EXPECT_THROW(NMCompositePattern pattern(deep), std::runtime_error);
+    EXPECT_THROW(NMCompositePattern pattern(childless), std::runtime_error);
+}
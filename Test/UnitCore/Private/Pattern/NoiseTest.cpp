@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "NMCore/Pattern/Noise.hpp"
+
+class NMNoiseTest : public testing::Test
+{
+};
+
+// Scenario: Perlin noise is zero on the lattice and varies between lattice points
+TEST_F(NMNoiseTest, Perlin_Lattice)
+{
+    // Then
+    EXPECT_EQ(nmnoise::Perlin(0.0f, 0.0f, 0.0f), 0.0f);
+    EXPECT_EQ(nmnoise::Perlin(3.0f, -2.0f, 7.0f), 0.0f);
+    EXPECT_NE(nmnoise::Perlin(0.5f, 0.25f, 0.75f), 0.0f);
+    EXPECT_EQ(nmnoise::Perlin(0.5f, 0.25f, 0.75f), nmnoise::Perlin(0.5f, 0.25f, 0.75f));
+}
+
+// Scenario: Perlin noise stays in range and changes little between close points
+TEST_F(NMNoiseTest, Perlin_RangeAndContinuity)
+{
+    // Given
+    float smallest = 0.0f;
+    float largest = 0.0f;
+    float largestStep = 0.0f;
+
+    // When sweeping a line through many cells, also across negative coordinates
+    for (int i = 0; i < 4000; ++i)
+    {
+        float t = -20.0f + static_cast<float>(i) * 0.01f;
+        float value = nmnoise::Perlin(t, 0.37f * t + 0.1f, -0.61f * t + 0.3f);
+        float next = nmnoise::Perlin(t + 0.001f, 0.37f * (t + 0.001f) + 0.1f, -0.61f * (t + 0.001f) + 0.3f);
+        smallest = std::min(smallest, value);
+        largest = std::max(largest, value);
+        largestStep = std::max(largestStep, std::abs(next - value));
+    }
+
+    // Then
+    EXPECT_GE(smallest, -1.1f);
+    EXPECT_LE(largest, 1.1f);
+    EXPECT_LT(smallest, -0.2f);
+    EXPECT_GT(largest, 0.2f);
+    EXPECT_LT(largestStep, 0.01f);
+}
+
+// Scenario: Fractal noise of one octave is Perlin noise, more octaves stay in the same range
+TEST_F(NMNoiseTest, Fractal_Octaves)
+{
+    // Then
+    EXPECT_EQ(nmnoise::Fractal(0.3f, 1.7f, -2.2f, 1), nmnoise::Perlin(0.3f, 1.7f, -2.2f));
+    EXPECT_EQ(nmnoise::Fractal(0.3f, 1.7f, -2.2f, 0), 0.0f);
+    EXPECT_NE(nmnoise::Fractal(0.3f, 1.7f, -2.2f, 4), nmnoise::Perlin(0.3f, 1.7f, -2.2f));
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        float t = static_cast<float>(i) * 0.037f;
+        float value = nmnoise::Fractal(t, -t, 0.5f * t, 5);
+        EXPECT_GE(value, -1.1f);
+        EXPECT_LE(value, 1.1f);
+    }
+}
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include "NMCore/Pattern/Texture.hpp"
+#include "NMCore/Primitive/Sphere.hpp"
+
+class NMTexturePatternTest : public testing::Test
+{
+protected:
+
+    // A checkerboard of black and white pixels, which averages to gray
+    static std::shared_ptr<const NMTexture> Checkers(std::size_t size)
+    {
+        NMCanvas canvas(size, size);
+        for (std::size_t y = 0; y < size; ++y)
+        {
+            for (std::size_t x = 0; x < size; ++x)
+            {
+                float value = static_cast<float>((x + y) % 2);
+                canvas.WritePixel(x, y, NMColor(value, value, value));
+            }
+        }
+
+        return std::make_shared<const NMTexture>(canvas);
+    }
+};
+
+// Scenario: A texture pattern inherits from PatternBase
+TEST_F(NMTexturePatternTest, Creation_PatternBase)
+{
+    static_assert(std::is_base_of<NMPatternBase, NMTexturePattern>::value,
+                  "NMTexturePattern must inherit from NMPatternBase");
+    EXPECT_THROW(NMTexturePattern(nullptr), std::runtime_error);
+}
+
+// Scenario: Unfiltered lookups map the point to the texture and sample its full resolution
+TEST_F(NMTexturePatternTest, ColorAt)
+{
+    // Given
+    NMTexturePattern planar(Checkers(16));
+    NMTexturePattern spherical(Checkers(16), ENMUVMapping::Spherical);
+
+    // Then pixel (0, 15) is white, pixel (1, 15) black
+    EXPECT_EQ(planar.GetMapping(), ENMUVMapping::Planar);
+    EXPECT_EQ(planar.ColorAt(NMPoint(0.5f / 16.0f, 0.0f, 0.5f / 16.0f)), NMColor(1.0f, 1.0f, 1.0f));
+    EXPECT_EQ(planar.ColorAt(NMPoint(1.5f / 16.0f, 0.0f, 0.5f / 16.0f)), NMColor(0.0f, 0.0f, 0.0f));
+    EXPECT_EQ(planar.ColorAt(NMPoint(3.5f / 16.0f, 7.0f, 3.5f / 16.0f)), NMColor(1.0f, 1.0f, 1.0f));
+    SNMUV uv = nmuv::Spherical(NMPoint(0.0f, 0.6f, 0.8f));
+    EXPECT_EQ(spherical.ColorAt(NMPoint(0.0f, 0.6f, 0.8f)), spherical.GetTexture()->SampleBilinear(uv.u, uv.v));
+}
+
+// Scenario: Filtered lookups with footprints many pixels wide average the texture instead of aliasing
+TEST_F(NMTexturePatternTest, ColorAtFiltered)
+{
+    // Given
+    NMTexturePattern pattern(Checkers(16));
+    NMPoint point(0.5f / 16.0f, 0.0f, 0.5f / 16.0f);
+
+    // Then
+    EXPECT_EQ(pattern.ColorAtFiltered(point, 0.0f), pattern.ColorAt(point));
+    EXPECT_EQ(pattern.ColorAtFiltered(point, 2.0f), NMColor(0.5f, 0.5f, 0.5f));
+    EXPECT_EQ(pattern.ColorAtFiltered(point, 1.0f / 16.0f), pattern.ColorAt(point));
+}
+
+// Scenario: Footprints are scaled from world space into pattern space by the object's and the pattern's transforms
+TEST_F(NMTexturePatternTest, ColorAtShapePoint_Footprint)
+{
+    // Given a texture repeated every 1/16 of a unit, on a sphere scaled up by 16
+    NMSphere sphere;
+    sphere.SetTransform(NMMatrix::Scaling(16.0f, 16.0f, 16.0f));
+    NMMatrix transform = NMMatrix::Scaling(1.0f / 16.0f, 1.0f / 16.0f, 1.0f / 16.0f);
+    NMTexturePattern pattern(Checkers(16), ENMUVMapping::Planar, transform);
+    NMPoint point(0.5f / 16.0f, 0.0f, 0.5f / 16.0f);
+
+    // Then a footprint of one world unit covers one texture width, which is the texture's average
+    EXPECT_EQ(pattern.ColorAtShapePoint(sphere, point), NMColor(1.0f, 1.0f, 1.0f));
+    EXPECT_EQ(pattern.ColorAtShapePoint(sphere, point, 1.0f), NMColor(0.5f, 0.5f, 0.5f));
+}
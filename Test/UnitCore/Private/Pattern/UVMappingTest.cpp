@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include "NMCore/Pattern/UVMapping.hpp"
+
+class NMUVMappingTest : public testing::Test
+{
+protected:
+
+    static void ExpectUV(const SNMUV& uv, float u, float v)
+    {
+        EXPECT_NEAR(uv.u, u, 1e-5f);
+        EXPECT_NEAR(uv.v, v, 1e-5f);
+    }
+};
+
+// Scenario: Using a spherical mapping on a 3D point
+TEST_F(NMUVMappingTest, Spherical)
+{
+    ExpectUV(nmuv::Spherical(NMPoint(0.0f, 0.0f, -1.0f)), 0.0f, 0.5f);
+    ExpectUV(nmuv::Spherical(NMPoint(1.0f, 0.0f, 0.0f)), 0.25f, 0.5f);
+    ExpectUV(nmuv::Spherical(NMPoint(0.0f, 0.0f, 1.0f)), 0.5f, 0.5f);
+    ExpectUV(nmuv::Spherical(NMPoint(-1.0f, 0.0f, 0.0f)), 0.75f, 0.5f);
+    ExpectUV(nmuv::Spherical(NMPoint(0.0f, 1.0f, 0.0f)), 0.5f, 1.0f);
+    ExpectUV(nmuv::Spherical(NMPoint(0.0f, -1.0f, 0.0f)), 0.5f, 0.0f);
+    ExpectUV(nmuv::Spherical(NMPoint(nmmath::sqrt2Over2, nmmath::sqrt2Over2, 0.0f)), 0.25f, 0.75f);
+}
+
+// Scenario: Using a planar mapping on a 3D point
+TEST_F(NMUVMappingTest, Planar)
+{
+    ExpectUV(nmuv::Planar(NMPoint(0.25f, 0.0f, 0.5f)), 0.25f, 0.5f);
+    ExpectUV(nmuv::Planar(NMPoint(0.25f, 0.0f, -0.25f)), 0.25f, 0.75f);
+    ExpectUV(nmuv::Planar(NMPoint(0.25f, 0.5f, -0.25f)), 0.25f, 0.75f);
+    ExpectUV(nmuv::Planar(NMPoint(1.25f, 0.0f, 0.5f)), 0.25f, 0.5f);
+    ExpectUV(nmuv::Planar(NMPoint(0.25f, 0.0f, -1.75f)), 0.25f, 0.25f);
+    ExpectUV(nmuv::Planar(NMPoint(1.0f, 0.0f, -1.0f)), 0.0f, 0.0f);
+    ExpectUV(nmuv::Planar(NMPoint(0.0f, 0.0f, 0.0f)), 0.0f, 0.0f);
+}
+
+// Scenario: Using a cylindrical mapping on a 3D point
+TEST_F(NMUVMappingTest, Cylindrical)
+{
+    ExpectUV(nmuv::Cylindrical(NMPoint(0.0f, 0.0f, -1.0f)), 0.0f, 0.0f);
+    ExpectUV(nmuv::Cylindrical(NMPoint(0.0f, 0.5f, -1.0f)), 0.0f, 0.5f);
+    ExpectUV(nmuv::Cylindrical(NMPoint(0.0f, 1.0f, -1.0f)), 0.0f, 0.0f);
+    ExpectUV(nmuv::Cylindrical(NMPoint(0.70711f, 0.5f, -0.70711f)), 0.125f, 0.5f);
+    ExpectUV(nmuv::Cylindrical(NMPoint(1.0f, 0.5f, 0.0f)), 0.25f, 0.5f);
+    ExpectUV(nmuv::Cylindrical(NMPoint(0.70711f, 0.5f, 0.70711f)), 0.375f, 0.5f);
+    ExpectUV(nmuv::Cylindrical(NMPoint(0.0f, -0.25f, 1.0f)), 0.5f, 0.75f);
+    ExpectUV(nmuv::Cylindrical(NMPoint(-0.70711f, 0.5f, 0.70711f)), 0.625f, 0.5f);
+    ExpectUV(nmuv::Cylindrical(NMPoint(-1.0f, 1.25f, 0.0f)), 0.75f, 0.25f);
+}
+
+// Scenario: Map dispatches on the mapping
+TEST_F(NMUVMappingTest, Map)
+{
+    NMPoint point(0.25f, 0.5f, -1.0f);
+    ExpectUV(nmuv::Map(ENMUVMapping::Planar, point), nmuv::Planar(point).u, nmuv::Planar(point).v);
+    ExpectUV(nmuv::Map(ENMUVMapping::Spherical, point), nmuv::Spherical(point).u, nmuv::Spherical(point).v);
+    ExpectUV(nmuv::Map(ENMUVMapping::Cylindrical, point), nmuv::Cylindrical(point).u, nmuv::Cylindrical(point).v);
+}
@@ -0,0 +1,284 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "NMCore/Primitive/CSG.hpp"
+#include "NMCore/Primitive/Cube.hpp"
+#include "NMCore/Primitive/Group.hpp"
+#include "NMCore/Primitive/Sphere.hpp"
+#include "NMCore/World.hpp"
+
+#define ASSERT_INHERITS_FROM(base, derived) \
+    static_assert(std::is_base_of<base, derived>::value, \
+    #derived " must inherit from " #base)
+
+class NMCSGTest : public testing::Test
+{
+protected:
+
+    // A sphere that counts how often it was intersected
+    class NMCountingSphere : public NMSphere
+    {
+    public:
+
+        mutable int intersectCount = 0;
+
+        virtual std::vector<SNMIntersection> LocalIntersect(const NMRay& localRay) const override
+        {
+            ++intersectCount;
+            return NMSphere::LocalIntersect(localRay);
+        }
+    };
+
+    // The sorted distances of a list of hits
+    static std::vector<float> Distances(std::vector<SNMIntersection> xs)
+    {
+        std::vector<float> ts;
+        for (const SNMIntersection& x : xs)
+        {
+            ts.push_back(x.t);
+        }
+
+        std::sort(ts.begin(), ts.end());
+        return ts;
+    }
+};
+
+// Scenario: A CSG inherits from PrimitiveBase
+TEST_F(NMCSGTest, Creation_PrimitiveBase)
+{
+    ASSERT_INHERITS_FROM(NMPrimitiveBase, NMCSG);
+}
+
+// Scenario: A CSG is created with an operation and two operands
+TEST_F(NMCSGTest, Creation)
+{
+    // Given
+    std::shared_ptr<NMSphere> sphere = std::make_shared<NMSphere>();
+    std::shared_ptr<NMCube> cube = std::make_shared<NMCube>();
+
+    // When
+    NMCSG csg(ENMCSGOperation::Union, sphere, cube);
+
+    // Then
+    EXPECT_EQ(csg.GetOperation(), ENMCSGOperation::Union);
+    EXPECT_EQ(csg.GetLeft(), sphere);
+    EXPECT_EQ(csg.GetRight(), cube);
+    EXPECT_THROW(NMCSG(ENMCSGOperation::Union, sphere, nullptr), std::runtime_error);
+    EXPECT_THROW(csg.LocalNormalAt(NMPoint(0.0f, 0.0f, 0.0f)), std::runtime_error);
+}
+
+// Scenario: Evaluating the rule for a CSG operation
+TEST_F(NMCSGTest, IsHitAllowed)
+{
+    struct SCase
+    {
+        ENMCSGOperation operation;
+        bool isLeftHit;
+        bool isInsideLeft;
+        bool isInsideRight;
+        bool result;
+    };
+
+    const SCase cases[] = {
+        {ENMCSGOperation::Union, true, true, true, false},
+        {ENMCSGOperation::Union, true, true, false, true},
+        {ENMCSGOperation::Union, true, false, true, false},
+        {ENMCSGOperation::Union, true, false, false, true},
+        {ENMCSGOperation::Union, false, true, true, false},
+        {ENMCSGOperation::Union, false, true, false, false},
+        {ENMCSGOperation::Union, false, false, true, true},
+        {ENMCSGOperation::Union, false, false, false, true},
+        {ENMCSGOperation::Intersection, true, true, true, true},
+        {ENMCSGOperation::Intersection, true, true, false, false},
+        {ENMCSGOperation::Intersection, true, false, true, true},
+        {ENMCSGOperation::Intersection, true, false, false, false},
+        {ENMCSGOperation::Intersection, false, true, true, true},
+        {ENMCSGOperation::Intersection, false, true, false, true},
+        {ENMCSGOperation::Intersection, false, false, true, false},
+        {ENMCSGOperation::Intersection, false, false, false, false},
+        {ENMCSGOperation::Difference, true, true, true, false},
+        {ENMCSGOperation::Difference, true, true, false, true},
+        {ENMCSGOperation::Difference, true, false, true, false},
+        {ENMCSGOperation::Difference, true, false, false, true},
+        {ENMCSGOperation::Difference, false, true, true, true},
+        {ENMCSGOperation::Difference, false, true, false, true},
+        {ENMCSGOperation::Difference, false, false, true, false},
+        {ENMCSGOperation::Difference, false, false, false, false},
+    };
+
+    for (const SCase& c : cases)
+    {
+        EXPECT_EQ(NMCSG::IsHitAllowed(c.operation, c.isLeftHit, c.isInsideLeft, c.isInsideRight), c.result);
+    }
+}
+
+// Scenario: Filtering the hits of overlapping operands
+TEST_F(NMCSGTest, Intersect_Filter)
+{
+    struct SCase
+    {
+        ENMCSGOperation operation;
+        float t0;
+        float t1;
+    };
+
+    // The ray enters the sphere at 4, the cube at 5, leaves the sphere at 6 and the cube at 7
+    const SCase cases[] = {
+        {ENMCSGOperation::Union, 4.0f, 7.0f},
+        {ENMCSGOperation::Intersection, 5.0f, 6.0f},
+        {ENMCSGOperation::Difference, 4.0f, 5.0f},
+    };
+
+    std::shared_ptr<NMSphere> sphere = std::make_shared<NMSphere>();
+    std::shared_ptr<NMCube> cube = std::make_shared<NMCube>();
+    cube->SetTransform(NMMatrix::Translation(0.0f, 0.0f, 1.0f));
+    NMRay ray(NMPoint(0.0f, 0.0f, -5.0f), NMVector(0.0f, 0.0f, 1.0f));
+
+    for (const SCase& c : cases)
+    {
+        // Given
+        NMCSG csg(c.operation, sphere, cube);
+
+        // When
+        std::vector<float> ts = Distances(csg.Intersect(ray));
+
+        // Then
+        ASSERT_EQ(ts.size(), 2u);
+        EXPECT_FLOAT_EQ(ts[0], c.t0);
+        EXPECT_FLOAT_EQ(ts[1], c.t1);
+    }
+}
+
+// Scenario: A ray hits a transformed CSG and its hits report the operands
+TEST_F(NMCSGTest, Intersect_Hit)
+{
+    // Given
+    std::shared_ptr<NMSphere> s1 = std::make_shared<NMSphere>();
+    std::shared_ptr<NMSphere> s2 = std::make_shared<NMSphere>();
+    s2->SetTransform(NMMatrix::Translation(0.0f, 0.0f, 0.5f));
+    NMCSG csg(ENMCSGOperation::Union, s1, s2);
+    csg.SetTransform(NMMatrix::Translation(0.0f, 0.0f, 1.0f));
+
+    // When
+    SNMIntersectionList xs(csg.Intersect(NMRay(NMPoint(0.0f, 0.0f, -5.0f), NMVector(0.0f, 0.0f, 1.0f))));
+    xs.Sort();
+
+    // Then
+    ASSERT_EQ(xs.Size(), 2u);
+    EXPECT_FLOAT_EQ(xs[0].t, 5.0f);
+    EXPECT_EQ(xs[0].object, s1.get());
+    EXPECT_FLOAT_EQ(xs[1].t, 7.5f);
+    EXPECT_EQ(xs[1].object, s2.get());
+    EXPECT_TRUE(csg.Intersect(NMRay(NMPoint(0.0f, 2.0f, -5.0f), NMVector(0.0f, 0.0f, 1.0f))).empty());
+}
+
+// Scenario: Rays that miss the bounds of an operand skip its intersection
+TEST_F(NMCSGTest, Intersect_Culled)
+{
+    // Given
+    std::shared_ptr<NMCountingSphere> left = std::make_shared<NMCountingSphere>();
+    std::shared_ptr<NMCountingSphere> right = std::make_shared<NMCountingSphere>();
+    right->SetTransform(NMMatrix::Translation(1.5f, 0.0f, 0.0f));
+    NMCSG intersection(ENMCSGOperation::Intersection, left, right);
+    NMCSG difference(ENMCSGOperation::Difference, left, right);
+    NMRay leftOnly(NMPoint(-0.8f, 0.0f, -5.0f), NMVector(0.0f, 0.0f, 1.0f));
+    NMRay rightOnly(NMPoint(2.0f, 0.0f, -5.0f), NMVector(0.0f, 0.0f, 1.0f));
+
+    // When
+    std::vector<SNMIntersection> xs = intersection.Intersect(leftOnly);
+    std::vector<SNMIntersection> cut = difference.Intersect(leftOnly);
+    std::vector<SNMIntersection> outside = difference.Intersect(rightOnly);
+
+    // Then
+    EXPECT_TRUE(xs.empty());
+    EXPECT_EQ(cut.size(), 2u);
+    EXPECT_TRUE(outside.empty());
+    EXPECT_EQ(left->intersectCount, 2);
+    EXPECT_EQ(right->intersectCount, 0);
+    EXPECT_EQ(intersection.LocalBounds().min, NMPoint(0.5f, -1.0f, -1.0f));
+    EXPECT_EQ(intersection.LocalBounds().max, NMPoint(1.0f, 1.0f, 1.0f));
+    EXPECT_EQ(difference.LocalBounds().max, NMPoint(1.0f, 1.0f, 1.0f));
+}
+
+// Scenario: More operand hits than the stack buffer holds are merged on the heap
+TEST_F(NMCSGTest, Intersect_ManyHits)
+{
+    // Given a union of two rows of spheres along the ray, overlapping pairwise
+    std::shared_ptr<NMGroup> left = std::make_shared<NMGroup>();
+    std::shared_ptr<NMGroup> right = std::make_shared<NMGroup>();
+    for (int i = 0; i < 10; ++i)
+    {
+        std::shared_ptr<NMSphere> a = std::make_shared<NMSphere>();
+        a->SetTransform(NMMatrix::Translation(0.0f, 0.0f, 4.0f * static_cast<float>(i)));
+        left->AddChild(a);
+        std::shared_ptr<NMSphere> b = std::make_shared<NMSphere>();
+        b->SetTransform(NMMatrix::Translation(0.0f, 0.0f, 4.0f * static_cast<float>(i) + 1.0f));
+        right->AddChild(b);
+    }
+
+    NMCSG csg(ENMCSGOperation::Union, left, right);
+
+    // When
+    std::vector<float> ts = Distances(csg.Intersect(NMRay(NMPoint(0.0f, 0.0f, -5.0f), NMVector(0.0f, 0.0f, 1.0f))));
+
+    // Then each pair contributes the entry of its first and the exit of its second sphere
+    ASSERT_GT(40u, NMCSG::HIT_BUFFER_SIZE);
+    ASSERT_EQ(ts.size(), 20u);
+    EXPECT_FLOAT_EQ(ts[0], 4.0f);
+    EXPECT_FLOAT_EQ(ts[1], 7.0f);
+    EXPECT_FLOAT_EQ(ts[19], 43.0f);
+}
+
+// Scenario: Building the world BVH compiles a transformed CSG so its hits can be shaded
+TEST_F(NMCSGTest, World_Compile)
+{
+    // Given
+    std::shared_ptr<NMSphere> sphere = std::make_shared<NMSphere>();
+    std::shared_ptr<NMCube> cube = std::make_shared<NMCube>();
+    cube->SetTransform(NMMatrix::Translation(0.0f, 0.0f, -1.0f));
+    std::shared_ptr<NMCSG> csg = std::make_shared<NMCSG>(ENMCSGOperation::Difference, sphere, cube);
+    csg->SetTransform(NMMatrix::Translation(0.0f, 0.0f, 5.0f));
+    NMWorld world;
+    world.AddObject(csg);
+
+    // When
+    world.BuildBVH();
+    SNMIntersectionList xs = world.Intersect(NMRay(NMPoint(0.0f, 0.0f, -5.0f), NMVector(0.0f, 0.0f, 1.0f)));
+
+    // Then the ray enters through the cut at the cube's back face
+    ASSERT_EQ(xs.Size(), 2u);
+    EXPECT_FLOAT_EQ(xs[0].t, 10.0f);
+    EXPECT_EQ(xs[0].object, cube.get());
+    EXPECT_EQ(cube->NormalAt(NMPoint(0.0f, 0.0f, 5.0f)), NMVector(0.0f, 0.0f, 1.0f));
+    EXPECT_FLOAT_EQ(xs[1].t, 11.0f);
+    EXPECT_EQ(xs[1].object, sphere.get());
+    EXPECT_EQ(csg->GetTransform(), NMMatrix::Identity4x4());
+}
+
+// Scenario: Adding a CSG to a world compiles it, so its hits are shaded with the CSG transform without a BVH
+TEST_F(NMCSGTest, World_AddObject)
+{
+    // Given
+    std::shared_ptr<NMSphere> sphere = std::make_shared<NMSphere>();
+    std::shared_ptr<NMCube> cube = std::make_shared<NMCube>();
+    cube->SetTransform(NMMatrix::Translation(0.0f, 0.0f, -1.0f));
+    std::shared_ptr<NMCSG> csg = std::make_shared<NMCSG>(ENMCSGOperation::Difference, sphere, cube);
+    csg->SetTransform(NMMatrix::Translation(0.0f, 0.0f, 5.0f) * NMMatrix::Scaling(1.0f, 1.0f, 2.0f));
+    NMWorld world;
+
+    // When
+    world.AddObject(csg);
+    SNMIntersectionList xs = world.Intersect(NMRay(NMPoint(0.0f, 0.0f, -5.0f), NMVector(0.0f, 0.0f, 1.0f)));
+
+    // Then
+    EXPECT_FALSE(world.HasBVH());
+    EXPECT_EQ(csg->GetTransform(), NMMatrix::Identity4x4());
+    ASSERT_EQ(xs.Size(), 2u);
+    EXPECT_FLOAT_EQ(xs[0].t, 10.0f);
+    EXPECT_EQ(xs[0].object, cube.get());
+    EXPECT_EQ(cube->NormalAt(NMPoint(0.0f, 0.0f, 5.0f)), NMVector(0.0f, 0.0f, 1.0f));
+    EXPECT_EQ(sphere->NormalAt(NMPoint(0.0f, 0.0f, 7.0f)), NMVector(0.0f, 0.0f, 1.0f));
+    EXPECT_EQ(sphere->NormalAt(NMPoint(1.0f, 0.0f, 5.0f)), NMVector(1.0f, 0.0f, 0.0f));
+}
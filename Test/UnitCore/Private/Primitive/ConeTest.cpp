@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "NMCore/Primitive/Cone.hpp"
+
+#define ASSERT_INHERITS_FROM(base, derived) \
+    static_assert(std::is_base_of<base, derived>::value, \
+    #derived " must inherit from " #base)
+
+class NMConeTest : public testing::Test
+{
+};
+
+// Scenario: A cone inherits from PrimitiveBase
+TEST_F(NMConeTest, Creation_PrimitiveBase)
+{
+    ASSERT_INHERITS_FROM(NMPrimitiveBase, NMCone);
+}
+
+// Scenario: Intersecting a cone with a ray
+TEST_F(NMConeTest, Intersect_Hit)
+{
+    struct SCase
+    {
+        NMPoint origin;
+        NMVector direction;
+        float t0;
+        float t1;
+    };
+
+    const SCase cases[] = {
+        {NMPoint(0.0f, 0.0f, -5.0f), NMVector(0.0f, 0.0f, 1.0f), 5.0f, 5.0f},
+        {NMPoint(0.0f, 0.0f, -5.0f), NMVector(1.0f, 1.0f, 1.0f).Normalized(), 8.66025f, 8.66025f},
+        {NMPoint(1.0f, 1.0f, -5.0f), NMVector(-0.5f, -1.0f, 1.0f).Normalized(), 4.55006f, 49.44994f},
+    };
+
+    NMCone cone;
+    for (const SCase& c : cases)
+    {
+        // When
+        std::vector<SNMIntersection> xs = cone.LocalIntersect(NMRay(c.origin, c.direction));
+
+        // Then
+        ASSERT_EQ(xs.size(), 2u);
+        EXPECT_NEAR(std::min(xs[0].t, xs[1].t), c.t0, 1e-3f);
+        EXPECT_NEAR(std::max(xs[0].t, xs[1].t), c.t1, 1e-3f);
+    }
+}
+
+// Scenario: Intersecting a cone with a ray parallel to one of its halves
+TEST_F(NMConeTest, Intersect_ParallelToHalf)
+{
+    // Given
+    NMCone cone;
+
+    // When
+    std::vector<SNMIntersection> xs =
+        cone.LocalIntersect(NMRay(NMPoint(0.0f, 0.0f, -1.0f), NMVector(0.0f, 1.0f, 1.0f).Normalized()));
+
+    // Then
+    ASSERT_EQ(xs.size(), 1u);
+    EXPECT_NEAR(xs[0].t, 0.35355f, 1e-4f);
+}
+
+// Scenario: Intersecting the caps of a closed cone
+TEST_F(NMConeTest, Intersect_Caps)
+{
+    // Given
+    NMCone cone;
+    cone.SetMinimum(-0.5f);
+    cone.SetMaximum(0.5f);
+    cone.SetClosed(true);
+
+    // Then
+    EXPECT_EQ(cone.LocalIntersect(NMRay(NMPoint(0.0f, 0.0f, -5.0f), NMVector(0.0f, 1.0f, 0.0f))).size(), 0u);
+    EXPECT_EQ(cone.LocalIntersect(NMRay(NMPoint(0.0f, 0.0f, -0.25f), NMVector(0.0f, 1.0f, 1.0f).Normalized())).size(),
+              2u);
+    EXPECT_EQ(cone.LocalIntersect(NMRay(NMPoint(0.0f, 0.0f, -0.25f), NMVector(0.0f, 1.0f, 0.0f))).size(), 4u);
+    EXPECT_EQ(cone.LocalBounds().min, NMPoint(-0.5f, -0.5f, -0.5f));
+    EXPECT_EQ(cone.LocalBounds().max, NMPoint(0.5f, 0.5f, 0.5f));
+}
+
+// Scenario: The normal on the side and the caps of a cone
+TEST_F(NMConeTest, NormalAt)
+{
+    // Given
+    NMCone cone;
+    NMCone closed;
+    closed.SetMinimum(-1.0f);
+    closed.SetMaximum(2.0f);
+    closed.SetClosed(true);
+
+    // Then
+    EXPECT_EQ(cone.LocalNormalAt(NMPoint(0.0f, 0.0f, 0.0f)), NMVector(0.0f, 0.0f, 0.0f));
+    EXPECT_EQ(cone.LocalNormalAt(NMPoint(1.0f, 1.0f, 1.0f)), NMVector(1.0f, -std::sqrt(2.0f), 1.0f));
+    EXPECT_EQ(cone.LocalNormalAt(NMPoint(-1.0f, -1.0f, 0.0f)), NMVector(-1.0f, 1.0f, 0.0f));
+    EXPECT_EQ(closed.LocalNormalAt(NMPoint(0.5f, 2.0f, 0.5f)), NMVector(0.0f, 1.0f, 0.0f));
+    EXPECT_EQ(closed.LocalNormalAt(NMPoint(0.5f, -1.0f, 0.0f)), NMVector(0.0f, -1.0f, 0.0f));
+}
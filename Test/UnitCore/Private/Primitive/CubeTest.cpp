@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include "NMCore/Primitive/Cube.hpp"
+
+#define ASSERT_INHERITS_FROM(base, derived) \
+    static_assert(std::is_base_of<base, derived>::value, \
+    #derived " must inherit from " #base)
+
+class NMCubeTest : public testing::Test
+{
+};
+
+// Scenario: A cube inherits from PrimitiveBase
+TEST_F(NMCubeTest, Creation_PrimitiveBase)
+{
+    ASSERT_INHERITS_FROM(NMPrimitiveBase, NMCube);
+}
+
+// Scenario: A ray intersects a cube through each face and from the inside
+TEST_F(NMCubeTest, Intersect_Hit)
+{
+    struct SCase
+    {
+        NMPoint origin;
+        NMVector direction;
+        float t1;
+        float t2;
+    };
+
+    const SCase cases[] = {
+        {NMPoint(5.0f, 0.5f, 0.0f), NMVector(-1.0f, 0.0f, 0.0f), 4.0f, 6.0f},
+        {NMPoint(-5.0f, 0.5f, 0.0f), NMVector(1.0f, 0.0f, 0.0f), 4.0f, 6.0f},
+        {NMPoint(0.5f, 5.0f, 0.0f), NMVector(0.0f, -1.0f, 0.0f), 4.0f, 6.0f},
+        {NMPoint(0.5f, -5.0f, 0.0f), NMVector(0.0f, 1.0f, 0.0f), 4.0f, 6.0f},
+        {NMPoint(0.5f, 0.0f, 5.0f), NMVector(0.0f, 0.0f, -1.0f), 4.0f, 6.0f},
+        {NMPoint(0.5f, 0.0f, -5.0f), NMVector(0.0f, 0.0f, 1.0f), 4.0f, 6.0f},
+        {NMPoint(0.0f, 0.5f, 0.0f), NMVector(0.0f, 0.0f, 1.0f), -1.0f, 1.0f},
+    };
+
+    NMCube cube;
+    for (const SCase& c : cases)
+    {
+        // When
+        std::vector<SNMIntersection> xs = cube.LocalIntersect(NMRay(c.origin, c.direction));
+
+        // Then
+        ASSERT_EQ(xs.size(), 2u);
+        EXPECT_FLOAT_EQ(xs[0].t, c.t1);
+        EXPECT_FLOAT_EQ(xs[1].t, c.t2);
+    }
+}
+
+// Scenario: A ray misses a cube
+TEST_F(NMCubeTest, Intersect_Miss)
+{
+    const NMRay rays[] = {
+        NMRay(NMPoint(-2.0f, 0.0f, 0.0f), NMVector(0.2673f, 0.5345f, 0.8018f)),
+        NMRay(NMPoint(0.0f, -2.0f, 0.0f), NMVector(0.8018f, 0.2673f, 0.5345f)),
+        NMRay(NMPoint(0.0f, 0.0f, -2.0f), NMVector(0.5345f, 0.8018f, 0.2673f)),
+        NMRay(NMPoint(2.0f, 0.0f, 2.0f), NMVector(0.0f, 0.0f, -1.0f)),
+        NMRay(NMPoint(0.0f, 2.0f, 2.0f), NMVector(0.0f, -1.0f, 0.0f)),
+        NMRay(NMPoint(2.0f, 2.0f, 0.0f), NMVector(-1.0f, 0.0f, 0.0f)),
+    };
+
+    NMCube cube;
+    for (const NMRay& ray : rays)
+    {
+        EXPECT_TRUE(cube.LocalIntersect(ray).empty());
+    }
+}
+
+// Scenario: The normal on the surface of a cube
+TEST_F(NMCubeTest, NormalAt)
+{
+    NMCube cube;
+    EXPECT_EQ(cube.LocalNormalAt(NMPoint(1.0f, 0.5f, -0.8f)), NMVector(1.0f, 0.0f, 0.0f));
+    EXPECT_EQ(cube.LocalNormalAt(NMPoint(-1.0f, -0.2f, 0.9f)), NMVector(-1.0f, 0.0f, 0.0f));
+    EXPECT_EQ(cube.LocalNormalAt(NMPoint(-0.4f, 1.0f, -0.1f)), NMVector(0.0f, 1.0f, 0.0f));
+    EXPECT_EQ(cube.LocalNormalAt(NMPoint(0.3f, -1.0f, -0.7f)), NMVector(0.0f, -1.0f, 0.0f));
+    EXPECT_EQ(cube.LocalNormalAt(NMPoint(-0.6f, 0.3f, 1.0f)), NMVector(0.0f, 0.0f, 1.0f));
+    EXPECT_EQ(cube.LocalNormalAt(NMPoint(0.4f, 0.4f, -1.0f)), NMVector(0.0f, 0.0f, -1.0f));
+    EXPECT_EQ(cube.LocalNormalAt(NMPoint(1.0f, 1.0f, 1.0f)), NMVector(1.0f, 0.0f, 0.0f));
+    EXPECT_EQ(cube.LocalNormalAt(NMPoint(-1.0f, -1.0f, -1.0f)), NMVector(-1.0f, 0.0f, 0.0f));
+}
+
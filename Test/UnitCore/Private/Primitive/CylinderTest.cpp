@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "NMCore/Primitive/Cylinder.hpp"
+
+#define ASSERT_INHERITS_FROM(base, derived) \
+    static_assert(std::is_base_of<base, derived>::value, \
+    #derived " must inherit from " #base)
+
+class NMCylinderTest : public testing::Test
+{
+protected:
+
+    // The cylinder from y = 1 to y = 2
+    static NMCylinder Truncated(bool closed)
+    {
+        NMCylinder cylinder;
+        cylinder.SetMinimum(1.0f);
+        cylinder.SetMaximum(2.0f);
+        cylinder.SetClosed(closed);
+        return cylinder;
+    }
+};
+
+// Scenario: A cylinder inherits from PrimitiveBase
+TEST_F(NMCylinderTest, Creation_PrimitiveBase)
+{
+    ASSERT_INHERITS_FROM(NMPrimitiveBase, NMCylinder);
+}
+
+// Scenario: The default cylinder is infinite and open
+TEST_F(NMCylinderTest, Creation_Default)
+{
+    // Given
+    NMCylinder cylinder;
+
+    // Then
+    EXPECT_EQ(cylinder.GetMinimum(), -std::numeric_limits<float>::infinity());
+    EXPECT_EQ(cylinder.GetMaximum(), std::numeric_limits<float>::infinity());
+    EXPECT_FALSE(cylinder.IsClosed());
+    EXPECT_FALSE(cylinder.LocalBounds().IsFinite());
+}
+
+// Scenario: A ray misses a cylinder
+TEST_F(NMCylinderTest, Intersect_Miss)
+{
+    NMCylinder cylinder;
+    EXPECT_TRUE(cylinder.LocalIntersect(NMRay(NMPoint(1.0f, 0.0f, 0.0f), NMVector(0.0f, 1.0f, 0.0f))).empty());
+    EXPECT_TRUE(cylinder.LocalIntersect(NMRay(NMPoint(0.0f, 0.0f, 0.0f), NMVector(0.0f, 1.0f, 0.0f))).empty());
+    EXPECT_TRUE(
+        cylinder.LocalIntersect(NMRay(NMPoint(0.0f, 0.0f, -5.0f), NMVector(1.0f, 1.0f, 1.0f).Normalized())).empty());
+}
+
+// Scenario: A ray strikes a cylinder
+TEST_F(NMCylinderTest, Intersect_Hit)
+{
+    struct SCase
+    {
+        NMPoint origin;
+        NMVector direction;
+        float t0;
+        float t1;
+    };
+
+    const SCase cases[] = {
+        {NMPoint(1.0f, 0.0f, -5.0f), NMVector(0.0f, 0.0f, 1.0f), 5.0f, 5.0f},
+        {NMPoint(0.0f, 0.0f, -5.0f), NMVector(0.0f, 0.0f, 1.0f), 4.0f, 6.0f},
+        {NMPoint(0.5f, 0.0f, -5.0f), NMVector(0.1f, 1.0f, 1.0f).Normalized(), 6.80798f, 7.08872f},
+    };
+
+    NMCylinder cylinder;
+    for (const SCase& c : cases)
+    {
+        // When
+        std::vector<SNMIntersection> xs = cylinder.LocalIntersect(NMRay(c.origin, c.direction));
+
+        // Then
+        ASSERT_EQ(xs.size(), 2u);
+        EXPECT_NEAR(xs[0].t, c.t0, 1e-4f);
+        EXPECT_NEAR(xs[1].t, c.t1, 1e-4f);
+    }
+}
+
+// Scenario: Intersecting a truncated cylinder
+TEST_F(NMCylinderTest, Intersect_Truncated)
+{
+    // Given
+    NMCylinder cylinder = Truncated(false);
+
+    // Then
+    EXPECT_EQ(cylinder.LocalIntersect(NMRay(NMPoint(0.0f, 1.5f, 0.0f), NMVector(0.1f, 1.0f, 0.0f))).size(), 0u);
+    EXPECT_EQ(cylinder.LocalIntersect(NMRay(NMPoint(0.0f, 3.0f, -5.0f), NMVector(0.0f, 0.0f, 1.0f))).size(), 0u);
+    EXPECT_EQ(cylinder.LocalIntersect(NMRay(NMPoint(0.0f, 0.0f, -5.0f), NMVector(0.0f, 0.0f, 1.0f))).size(), 0u);
+    EXPECT_EQ(cylinder.LocalIntersect(NMRay(NMPoint(0.0f, 2.0f, -5.0f), NMVector(0.0f, 0.0f, 1.0f))).size(), 0u);
+    EXPECT_EQ(cylinder.LocalIntersect(NMRay(NMPoint(0.0f, 1.0f, -5.0f), NMVector(0.0f, 0.0f, 1.0f))).size(), 0u);
+    EXPECT_EQ(cylinder.LocalIntersect(NMRay(NMPoint(0.0f, 1.5f, -2.0f), NMVector(0.0f, 0.0f, 1.0f))).size(), 2u);
+    EXPECT_EQ(cylinder.LocalBounds().min, NMPoint(-1.0f, 1.0f, -1.0f));
+    EXPECT_EQ(cylinder.LocalBounds().max, NMPoint(1.0f, 2.0f, 1.0f));
+}
+
+// Scenario: Intersecting the caps of a closed cylinder
+TEST_F(NMCylinderTest, Intersect_Caps)
+{
+    // Given
+    NMCylinder cylinder = Truncated(true);
+
+    // Then
+    const NMRay rays[] = {
+        NMRay(NMPoint(0.0f, 3.0f, 0.0f), NMVector(0.0f, -1.0f, 0.0f)),
+        NMRay(NMPoint(0.0f, 3.0f, -2.0f), NMVector(0.0f, -1.0f, 2.0f).Normalized()),
+        NMRay(NMPoint(0.0f, 4.0f, -2.0f), NMVector(0.0f, -1.0f, 1.0f).Normalized()),
+        NMRay(NMPoint(0.0f, 0.0f, -2.0f), NMVector(0.0f, 1.0f, 2.0f).Normalized()),
+        NMRay(NMPoint(0.0f, -1.0f, -2.0f), NMVector(0.0f, 1.0f, 1.0f).Normalized()),
+    };
+
+    for (const NMRay& ray : rays)
+    {
+        EXPECT_EQ(cylinder.LocalIntersect(ray).size(), 2u);
+    }
+}
+
+// Scenario: The normal on the wall and the caps of a cylinder
+TEST_F(NMCylinderTest, NormalAt)
+{
+    // Given
+    NMCylinder cylinder;
+    NMCylinder closed = Truncated(true);
+
+    // Then
+    EXPECT_EQ(cylinder.LocalNormalAt(NMPoint(1.0f, 0.0f, 0.0f)), NMVector(1.0f, 0.0f, 0.0f));
+    EXPECT_EQ(cylinder.LocalNormalAt(NMPoint(0.0f, 5.0f, -1.0f)), NMVector(0.0f, 0.0f, -1.0f));
+    EXPECT_EQ(cylinder.LocalNormalAt(NMPoint(0.0f, -2.0f, 1.0f)), NMVector(0.0f, 0.0f, 1.0f));
+    EXPECT_EQ(cylinder.LocalNormalAt(NMPoint(-1.0f, 1.0f, 0.0f)), NMVector(-1.0f, 0.0f, 0.0f));
+
+    EXPECT_EQ(closed.LocalNormalAt(NMPoint(0.0f, 1.0f, 0.0f)), NMVector(0.0f, -1.0f, 0.0f));
+    EXPECT_EQ(closed.LocalNormalAt(NMPoint(0.5f, 1.0f, 0.0f)), NMVector(0.0f, -1.0f, 0.0f));
+    EXPECT_EQ(closed.LocalNormalAt(NMPoint(0.0f, 1.0f, 0.5f)), NMVector(0.0f, -1.0f, 0.0f));
+    EXPECT_EQ(closed.LocalNormalAt(NMPoint(0.0f, 2.0f, 0.0f)), NMVector(0.0f, 1.0f, 0.0f));
+    EXPECT_EQ(closed.LocalNormalAt(NMPoint(0.5f, 2.0f, 0.0f)), NMVector(0.0f, 1.0f, 0.0f));
+    EXPECT_EQ(closed.LocalNormalAt(NMPoint(0.0f, 2.0f, 0.5f)), NMVector(0.0f, 1.0f, 0.0f));
+}
@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include "NMCore/Primitive/Disk.hpp"
+
+#define ASSERT_INHERITS_FROM(base, derived) \
+    static_assert(std::is_base_of<base, derived>::value, \
+    #derived " must inherit from " #base)
+
+class NMDiskTest : public testing::Test
+{
+};
+
+// Scenario: A disk inherits from PrimitiveBase
+TEST_F(NMDiskTest, Creation_PrimitiveBase)
+{
+    ASSERT_INHERITS_FROM(NMPrimitiveBase, NMDisk);
+}
+
+// Scenario: A ray strikes a disk from above and below
+TEST_F(NMDiskTest, Intersect_Hit)
+{
+    // Given
+    NMDisk disk;
+
+    // When
+    std::vector<SNMIntersection> above =
+        disk.LocalIntersect(NMRay(NMPoint(0.5f, 1.0f, 0.2f), NMVector(0.0f, -1.0f, 0.0f)));
+    std::vector<SNMIntersection> below =
+        disk.LocalIntersect(NMRay(NMPoint(0.0f, -2.0f, -0.9f), NMVector(0.0f, 1.0f, 0.0f)));
+
+    // Then
+    ASSERT_EQ(above.size(), 1u);
+    EXPECT_FLOAT_EQ(above[0].t, 1.0f);
+    EXPECT_EQ(above[0].object, &disk);
+    ASSERT_EQ(below.size(), 1u);
+    EXPECT_FLOAT_EQ(below[0].t, 2.0f);
+}
+
+// Scenario: A ray misses a disk outside its radius or parallel to it
+TEST_F(NMDiskTest, Intersect_Miss)
+{
+    NMDisk disk;
+    EXPECT_TRUE(disk.LocalIntersect(NMRay(NMPoint(0.8f, 1.0f, 0.8f), NMVector(0.0f, -1.0f, 0.0f))).empty());
+    EXPECT_TRUE(disk.LocalIntersect(NMRay(NMPoint(0.0f, 0.0f, -5.0f), NMVector(0.0f, 0.0f, 1.0f))).empty());
+}
+
+// Scenario: The normal and bounds of a disk
+TEST_F(NMDiskTest, NormalAt_Bounds)
+{
+    NMDisk disk;
+    EXPECT_EQ(disk.LocalNormalAt(NMPoint(0.3f, 0.0f, -0.4f)), NMVector(0.0f, 1.0f, 0.0f));
+    EXPECT_EQ(disk.LocalBounds().min, NMPoint(-1.0f, 0.0f, -1.0f));
+    EXPECT_EQ(disk.LocalBounds().max, NMPoint(1.0f, 0.0f, 1.0f));
+    EXPECT_TRUE(disk.WorldBounds().IsFinite());
+}
@@ -0,0 +1,250 @@
+#include <gtest/gtest.h>
+
+#include "NMCore/Primitive/Group.hpp"
+#include "NMCore/Primitive/Plane.hpp"
+#include "NMCore/Primitive/Sphere.hpp"
+#include "NMCore/World.hpp"
+
+#define ASSERT_INHERITS_FROM(base, derived) \
+    static_assert(std::is_base_of<base, derived>::value, \
+    #derived " must inherit from " #base)
+
+class NMGroupTest : public testing::Test
+{
+protected:
+
+    // A sphere that counts how often it was intersected
+    class NMCountingSphere : public NMSphere
+    {
+    public:
+
+        mutable int intersectCount = 0;
+
+        virtual std::vector<SNMIntersection> LocalIntersect(const NMRay& localRay) const override
+        {
+            ++intersectCount;
+            return NMSphere::LocalIntersect(localRay);
+        }
+    };
+};
+
+// Scenario: A group inherits from PrimitiveBase
+TEST_F(NMGroupTest, Creation_PrimitiveBase)
+{
+    ASSERT_INHERITS_FROM(NMPrimitiveBase, NMGroup);
+}
+
+// Scenario: Intersecting a ray with an empty group
+TEST_F(NMGroupTest, Intersect_Empty)
+{
+    // Given
+    NMGroup group;
+
+    // When
+    std::vector<SNMIntersection> xs = group.Intersect(NMRay(NMPoint(0.0f, 0.0f, 0.0f), NMVector(0.0f, 0.0f, 1.0f)));
+
+    // Then
+    EXPECT_EQ(group.GetChildCount(), 0u);
+    EXPECT_TRUE(group.LocalBounds().IsEmpty());
+    EXPECT_TRUE(xs.empty());
+}
+
+// Scenario: Intersecting a ray with a nonempty group reports the children that were hit
+TEST_F(NMGroupTest, Intersect_Children)
+{
+    // Given
+    NMGroup group;
+    std::shared_ptr<NMSphere> s1 = std::make_shared<NMSphere>();
+    std::shared_ptr<NMSphere> s2 = std::make_shared<NMSphere>();
+    s2->SetTransform(NMMatrix::Translation(0.0f, 0.0f, -3.0f));
+    std::shared_ptr<NMSphere> s3 = std::make_shared<NMSphere>();
+    s3->SetTransform(NMMatrix::Translation(5.0f, 0.0f, 0.0f));
+    group.AddChild(s1);
+    group.AddChild(s2);
+    group.AddChild(s3);
+
+    // When
+    SNMIntersectionList xs(group.Intersect(NMRay(NMPoint(0.0f, 0.0f, -5.0f), NMVector(0.0f, 0.0f, 1.0f))));
+    xs.Sort();
+
+    // Then
+    ASSERT_EQ(xs.Size(), 4u);
+    EXPECT_EQ(xs[0].object, s2.get());
+    EXPECT_EQ(xs[1].object, s2.get());
+    EXPECT_EQ(xs[2].object, s1.get());
+    EXPECT_EQ(xs[3].object, s1.get());
+    EXPECT_EQ(group.LocalBounds().min, NMPoint(-1.0f, -1.0f, -4.0f));
+    EXPECT_EQ(group.LocalBounds().max, NMPoint(6.0f, 1.0f, 1.0f));
+}
+
+// Scenario: Intersecting a transformed group
+TEST_F(NMGroupTest, Intersect_Transformed)
+{
+    // Given
+    NMGroup group;
+    group.SetTransform(NMMatrix::Scaling(2.0f, 2.0f, 2.0f));
+    std::shared_ptr<NMSphere> sphere = std::make_shared<NMSphere>();
+    sphere->SetTransform(NMMatrix::Translation(5.0f, 0.0f, 0.0f));
+    group.AddChild(sphere);
+    NMRay ray(NMPoint(10.0f, 0.0f, -10.0f), NMVector(0.0f, 0.0f, 1.0f));
+
+    // When
+    std::vector<SNMIntersection> before = group.Intersect(ray);
+    group.Compile();
+    std::vector<SNMIntersection> after = group.Intersect(ray);
+
+    // Then
+    EXPECT_EQ(before.size(), 2u);
+    ASSERT_EQ(after.size(), 2u);
+    EXPECT_FLOAT_EQ(after[0].t, before[0].t);
+    EXPECT_FLOAT_EQ(after[1].t, before[1].t);
+}
+
+// Scenario: Compiling pushes the group transforms into the children with baked inverses
+TEST_F(NMGroupTest, Compile)
+{
+    // Given
+    std::shared_ptr<NMGroup> outer = std::make_shared<NMGroup>();
+    outer->SetTransform(NMMatrix::RotationY(nmmath::halfPi));
+    std::shared_ptr<NMGroup> inner = std::make_shared<NMGroup>();
+    inner->SetTransform(NMMatrix::Scaling(1.0f, 2.0f, 3.0f));
+    std::shared_ptr<NMSphere> sphere = std::make_shared<NMSphere>();
+    sphere->SetTransform(NMMatrix::Translation(5.0f, 0.0f, 0.0f));
+    inner->AddChild(sphere);
+    outer->AddChild(inner);
+
+    // When
+    outer->Compile();
+
+    // Then
+    NMMatrix expected = NMMatrix::RotationY(nmmath::halfPi) * NMMatrix::Scaling(1.0f, 2.0f, 3.0f)
+                        * NMMatrix::Translation(5.0f, 0.0f, 0.0f);
+    EXPECT_EQ(outer->GetTransform(), NMMatrix::Identity4x4());
+    EXPECT_EQ(inner->GetTransform(), NMMatrix::Identity4x4());
+    EXPECT_EQ(sphere->GetTransform(), expected);
+    EXPECT_EQ(sphere->GetInverseTransform(), expected.Inverse());
+    EXPECT_EQ(outer->WorldBounds().min, sphere->WorldBounds().min);
+    EXPECT_EQ(outer->WorldBounds().max, sphere->WorldBounds().max);
+
+    // Compiling again changes nothing
+    outer->Compile();
+    EXPECT_EQ(sphere->GetTransform(), expected);
+}
+
+// Scenario: Finding the normal on a child of nested groups
+TEST_F(NMGroupTest, NormalAt_NestedChild)
+{
+    // Given
+    std::shared_ptr<NMGroup> outer = std::make_shared<NMGroup>();
+    outer->SetTransform(NMMatrix::RotationY(nmmath::halfPi));
+    std::shared_ptr<NMGroup> inner = std::make_shared<NMGroup>();
+    inner->SetTransform(NMMatrix::Scaling(1.0f, 2.0f, 3.0f));
+    std::shared_ptr<NMSphere> sphere = std::make_shared<NMSphere>();
+    sphere->SetTransform(NMMatrix::Translation(5.0f, 0.0f, 0.0f));
+    inner->AddChild(sphere);
+    outer->AddChild(inner);
+
+    // When
+    outer->Compile();
+    NMVector normal = sphere->NormalAt(NMPoint(1.7321f, 1.1547f, -5.5774f));
+
+    // Then
+    EXPECT_NEAR(normal.GetX(), 0.2857f, 1e-4f);
+    EXPECT_NEAR(normal.GetY(), 0.4286f, 1e-4f);
+    EXPECT_NEAR(normal.GetZ(), -0.8571f, 1e-4f);
+    EXPECT_THROW(outer->LocalNormalAt(NMPoint(0.0f, 0.0f, 0.0f)), std::runtime_error);
+}
+
+// Scenario: A ray that misses the bounds of a group tests none of its children
+TEST_F(NMGroupTest, Intersect_Culled)
+{
+    // Given
+    NMGroup group;
+    std::shared_ptr<NMCountingSphere> sphere = std::make_shared<NMCountingSphere>();
+    sphere->SetTransform(NMMatrix::Translation(5.0f, 0.0f, 0.0f));
+    group.AddChild(sphere);
+    group.Compile();
+
+    // When
+    group.Intersect(NMRay(NMPoint(0.0f, 0.0f, -5.0f), NMVector(0.0f, 0.0f, 1.0f)));
+    group.Intersect(NMRay(NMPoint(5.0f, 3.0f, -5.0f), NMVector(0.0f, 0.0f, 1.0f)));
+    std::vector<SNMIntersection> xs = group.Intersect(NMRay(NMPoint(5.0f, 0.0f, -5.0f), NMVector(0.0f, 0.0f, 1.0f)));
+
+    // Then
+    EXPECT_EQ(sphere->intersectCount, 1);
+    EXPECT_EQ(xs.size(), 2u);
+}
+
+// Scenario: Groups with unbounded children are never culled
+TEST_F(NMGroupTest, Intersect_Unbounded)
+{
+    // Given
+    NMGroup group;
+    group.AddChild(std::make_shared<NMPlane>());
+
+    // When
+    std::vector<SNMIntersection> xs = group.Intersect(NMRay(NMPoint(100.0f, 1.0f, 0.0f), NMVector(0.0f, -1.0f, 0.0f)));
+
+    // Then
+    EXPECT_FALSE(group.LocalBounds().IsFinite());
+    ASSERT_EQ(xs.size(), 1u);
+    EXPECT_FLOAT_EQ(xs[0].t, 1.0f);
+}
+
+// Scenario: Building the world BVH compiles its groups before shading them
+TEST_F(NMGroupTest, World_ColorAt)
+{
+    // Given a group that moves a sphere in front of the camera
+    NMWorld world;
+    world.AddLight(NMPointLight(NMPoint(-10.0f, 10.0f, -10.0f), NMColor(1.0f, 1.0f, 1.0f)));
+    std::shared_ptr<NMGroup> group = std::make_shared<NMGroup>();
+    group->SetTransform(NMMatrix::Translation(0.0f, 0.0f, 5.0f));
+    std::shared_ptr<NMSphere> sphere = std::make_shared<NMSphere>();
+    sphere->SetMaterial(NMMaterial(NMColor(0.8f, 1.0f, 0.6f), 0.1f, 0.7f, 0.2f, 200.0f));
+    group->AddChild(sphere);
+    world.AddObject(group);
+
+    std::shared_ptr<NMSphere> referenceSphere = std::make_shared<NMSphere>();
+    referenceSphere->SetTransform(NMMatrix::Translation(0.0f, 0.0f, 5.0f));
+    referenceSphere->SetMaterial(sphere->GetMaterial());
+    NMWorld expected;
+    expected.AddLight(world.GetPointLight(0));
+    expected.AddObject(referenceSphere);
+
+    // When
+    world.BuildBVH();
+    NMRay ray(NMPoint(0.2f, 0.3f, -5.0f), NMVector(0.0f, 0.0f, 1.0f));
+
+    // Then
+    EXPECT_EQ(sphere->GetTransform(), NMMatrix::Translation(0.0f, 0.0f, 5.0f));
+    EXPECT_EQ(world.ColorAt(ray), expected.ColorAt(ray));
+}
+
+// Scenario: Adding a group to a world compiles it, so it shades correctly without a BVH
+TEST_F(NMGroupTest, World_ColorAtWithoutBVH)
+{
+    // Given a group that moves and stretches a sphere in front of the camera
+    NMWorld world;
+    world.AddLight(NMPointLight(NMPoint(-10.0f, 10.0f, -10.0f), NMColor(1.0f, 1.0f, 1.0f)));
+    std::shared_ptr<NMGroup> group = std::make_shared<NMGroup>();
+    group->SetTransform(NMMatrix::Translation(0.0f, 0.0f, 5.0f) * NMMatrix::Scaling(2.0f, 1.0f, 1.0f));
+    std::shared_ptr<NMSphere> sphere = std::make_shared<NMSphere>();
+    sphere->SetMaterial(NMMaterial(NMColor(0.8f, 1.0f, 0.6f), 0.1f, 0.7f, 0.2f, 200.0f));
+    group->AddChild(sphere);
+
+    std::shared_ptr<NMSphere> referenceSphere = std::make_shared<NMSphere>();
+    referenceSphere->SetTransform(group->GetTransform());
+    referenceSphere->SetMaterial(sphere->GetMaterial());
+    NMWorld expected;
+    expected.AddLight(world.GetPointLight(0));
+    expected.AddObject(referenceSphere);
+
+    // When
+    world.AddObject(group);
+    NMRay ray(NMPoint(0.7f, 0.3f, -5.0f), NMVector(0.0f, 0.0f, 1.0f));
+
+    // Then
+    EXPECT_FALSE(world.HasBVH());
+    EXPECT_EQ(group->GetTransform(), NMMatrix::Identity4x4());
+    EXPECT_EQ(world.ColorAt(ray), expected.ColorAt(ray));
+}
@@ -0,0 +1,242 @@
+#include <gtest/gtest.h>
+
+#include "NMCore/Camera.hpp"
+#include "NMCore/Primitive/CSG.hpp"
+#include "NMCore/Primitive/Cube.hpp"
+#include "NMCore/Primitive/Group.hpp"
+#include "NMCore/Primitive/Instance.hpp"
+#include "NMCore/Primitive/Sphere.hpp"
+#include "NMCore/Primitive/TriangleMesh.hpp"
+#include "NMCore/RT/IntersectionState.hpp"
+#include "NMCore/World.hpp"
+
+#define ASSERT_INHERITS_FROM(base, derived) \
+    static_assert(std::is_base_of<base, derived>::value, \
+    #derived " must inherit from " #base)
+
+class NMInstanceTest : public testing::Test
+{
+protected:
+
+    // Two triangles covering the unit square in the xy plane
+    static std::shared_ptr<NMTriangleMesh> Square()
+    {
+        std::shared_ptr<NMTriangleMesh> mesh = std::make_shared<NMTriangleMesh>();
+        mesh->SetGeometry({0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f}, {0, 1, 2, 0, 2, 3});
+        return mesh;
+    }
+
+    // Render a world on a small camera looking at the origin, on four threads
+    static NMCanvas Render(const NMWorld& world)
+    {
+        NMCamera camera(21, 21, nmmath::halfPi);
+        camera.SetTransform(NMMatrix::ViewTransform(NMPoint(0.0f, 1.0f, -6.0f), NMPoint(0.0f, 0.0f, 0.0f),
+                                                    NMVector(0.0f, 1.0f, 0.0f)));
+        return camera.Render(world, 4);
+    }
+
+    static NMWorld LitWorld()
+    {
+        NMWorld world;
+        world.AddLight(NMPointLight(NMPoint(-10.0f, 10.0f, -10.0f), NMColor(1.0f, 1.0f, 1.0f)));
+        return world;
+    }
+};
+
+// Scenario: An instance inherits from PrimitiveBase
+TEST_F(NMInstanceTest, Creation_PrimitiveBase)
+{
+    ASSERT_INHERITS_FROM(NMPrimitiveBase, NMInstance);
+}
+
+// Scenario: An instance starts out with the material of its geometry
+TEST_F(NMInstanceTest, Creation_Material)
+{
+    // Given
+    std::shared_ptr<NMSphere> sphere = std::make_shared<NMSphere>();
+    sphere->SetMaterial(NMMaterial(NMColor(0.2f, 0.4f, 0.6f)));
+
+    // When
+    NMInstance instance(sphere);
+
+    // Then
+    EXPECT_EQ(instance.GetGeometry(), sphere);
+    EXPECT_EQ(instance.GetMaterial(), sphere->GetMaterial());
+    EXPECT_THROW(NMInstance(nullptr), std::runtime_error);
+}
+
+// Scenario: Most of the memory of an instance is its transform and inverse
+TEST_F(NMInstanceTest, Creation_Size)
+{
+    EXPECT_GT(2 * sizeof(NMMatrix), sizeof(NMInstance) - 2 * sizeof(NMMatrix));
+}
+
+// Scenario: Hits on the shared geometry are reported for the instance
+TEST_F(NMInstanceTest, Intersect)
+{
+    // Given
+    std::shared_ptr<NMTriangleMesh> mesh = Square();
+    NMInstance instance(mesh);
+    instance.SetTransform(NMMatrix::Translation(10.0f, 0.0f, 0.0f));
+
+    // When
+    NMVector direction(0.0f, 0.0f, 1.0f);
+    std::vector<SNMIntersection> hit = instance.Intersect(NMRay(NMPoint(10.75f, 0.25f, -2.0f), direction));
+    std::vector<SNMIntersection> miss = instance.Intersect(NMRay(NMPoint(0.75f, 0.25f, -2.0f), direction));
+
+    // Then
+    ASSERT_EQ(hit.size(), 1u);
+    EXPECT_FLOAT_EQ(hit[0].t, 2.0f);
+    EXPECT_EQ(hit[0].object, &instance);
+    EXPECT_EQ(hit[0].index, 0u);
+    EXPECT_TRUE(miss.empty());
+}
+
+// Scenario: The geometry's transform is applied inside the instance's
+TEST_F(NMInstanceTest, Intersect_NestedTransforms)
+{
+    // Given
+    std::shared_ptr<NMSphere> sphere = std::make_shared<NMSphere>();
+    sphere->SetTransform(NMMatrix::Scaling(2.0f, 2.0f, 2.0f));
+    NMInstance instance(sphere);
+    instance.SetTransform(NMMatrix::Translation(0.0f, 0.0f, 5.0f));
+
+    NMSphere reference;
+    reference.SetTransform(NMMatrix::Translation(0.0f, 0.0f, 5.0f) * NMMatrix::Scaling(2.0f, 2.0f, 2.0f));
+
+    NMRay ray(NMPoint(1.0f, 0.5f, -5.0f), NMVector(0.0f, 0.0f, 1.0f));
+
+    // When
+    std::vector<SNMIntersection> xs = instance.Intersect(ray);
+    std::vector<SNMIntersection> expected = reference.Intersect(ray);
+
+    // Then
+    ASSERT_EQ(xs.size(), 2u);
+    EXPECT_FLOAT_EQ(xs[0].t, expected[0].t);
+    EXPECT_FLOAT_EQ(xs[1].t, expected[1].t);
+
+    NMPoint point = ray.Position(xs[0].t);
+    EXPECT_EQ(instance.NormalAt(point, xs[0]), reference.NormalAt(point));
+    EXPECT_EQ(instance.WorldBounds().min, NMPoint(-2.0f, -2.0f, 3.0f));
+    EXPECT_EQ(instance.WorldBounds().max, NMPoint(2.0f, 2.0f, 7.0f));
+}
+
+// Scenario: The normal of an instanced mesh comes from the triangle that was hit
+TEST_F(NMInstanceTest, IntersectionState)
+{
+    // Given
+    std::shared_ptr<NMTriangleMesh> mesh = Square();
+    NMInstance instance(mesh);
+    instance.SetTransform(NMMatrix::RotationY(nmmath::halfPi));
+    NMRay ray(NMPoint(-5.0f, 0.25f, -0.5f), NMVector(1.0f, 0.0f, 0.0f));
+
+    // When
+    std::vector<SNMIntersection> xs = instance.Intersect(ray);
+    ASSERT_EQ(xs.size(), 1u);
+    SNMIntersectionState state(xs[0], ray);
+
+    // Then
+    EXPECT_EQ(state.object, &instance);
+    EXPECT_EQ(state.normalVector, NMVector(-1.0f, 0.0f, 0.0f));
+}
+
+// Scenario: A world of many instances shares one mesh and finds every instance through its BVH
+TEST_F(NMInstanceTest, World_ManyInstances)
+{
+    // Given a 100 x 100 field of squares, one unit apart
+    std::shared_ptr<NMTriangleMesh> mesh = Square();
+    NMWorld world;
+    world.AddLight(NMPointLight(NMPoint(0.0f, 0.0f, -10.0f), NMColor(1.0f, 1.0f, 1.0f)));
+    world.ReserveObjects(100 * 100);
+    for (int y = 0; y < 100; ++y)
+    {
+        for (int x = 0; x < 100; ++x)
+        {
+            std::shared_ptr<NMInstance> instance = std::make_shared<NMInstance>(mesh);
+            instance->SetTransform(NMMatrix::Translation(static_cast<float>(x) * 2.0f, static_cast<float>(y) * 2.0f,
+                                                         0.0f));
+            world.AddObject(instance);
+        }
+    }
+    world.BuildBVH();
+
+    // When
+    SNMIntersectionList hits = world.Intersect(NMRay(NMPoint(150.5f, 70.5f, -1.0f), NMVector(0.0f, 0.0f, 1.0f)));
+    SNMIntersectionList gap = world.Intersect(NMRay(NMPoint(151.5f, 70.5f, -1.0f), NMVector(0.0f, 0.0f, 1.0f)));
+
+    // Then
+    EXPECT_EQ(mesh.use_count(), 100 * 100 + 1);
+    EXPECT_TRUE(world.HasBVH());
+    ASSERT_NE(hits.Hit(), nullptr);
+    EXPECT_EQ(hits.Hit()->object, world.GetObject(35 * 100 + 75).get());
+    EXPECT_EQ(gap.Hit(), nullptr);
+}
+
+// Scenario: An instanced group renders like its children placed in the world, including a nested, uncompiled group
+TEST_F(NMInstanceTest, Render_InstancedGroup)
+{
+    // Given
+    std::shared_ptr<NMSphere> left = std::make_shared<NMSphere>();
+    left->SetTransform(NMMatrix::Translation(-1.5f, 0.0f, 0.0f));
+    std::shared_ptr<NMSphere> right = std::make_shared<NMSphere>();
+    right->SetTransform(NMMatrix::Scaling(0.5f, 1.0f, 1.0f));
+    std::shared_ptr<NMGroup> inner = std::make_shared<NMGroup>();
+    inner->SetTransform(NMMatrix::Translation(1.5f, 0.0f, 0.0f));
+    inner->AddChild(right);
+    std::shared_ptr<NMGroup> group = std::make_shared<NMGroup>();
+    group->AddChild(left);
+    group->AddChild(inner);
+
+    NMMatrix placement = NMMatrix::Translation(0.0f, 0.0f, 1.0f) * NMMatrix::RotationY(0.5f);
+    std::shared_ptr<NMInstance> instance = std::make_shared<NMInstance>(group);
+    instance->SetTransform(placement);
+    NMWorld world = LitWorld();
+    world.AddObject(instance);
+
+    NMWorld expected = LitWorld();
+    std::shared_ptr<NMSphere> leftReference = std::make_shared<NMSphere>();
+    leftReference->SetTransform(placement * NMMatrix::Translation(-1.5f, 0.0f, 0.0f));
+    std::shared_ptr<NMSphere> rightReference = std::make_shared<NMSphere>();
+    rightReference->SetTransform(placement * NMMatrix::Translation(1.5f, 0.0f, 0.0f) *
+                                 NMMatrix::Scaling(0.5f, 1.0f, 1.0f));
+    expected.AddObject(leftReference);
+    expected.AddObject(rightReference);
+
+    // When
+    NMCanvas canvas = Render(world);
+
+    // Then
+    EXPECT_EQ(canvas.ToPPM(), Render(expected).ToPPM());
+    EXPECT_NE(canvas.ToPPM(), Render(LitWorld()).ToPPM());
+}
+
+// Scenario: An instanced CSG renders like the CSG placed in the world
+TEST_F(NMInstanceTest, Render_InstancedCSG)
+{
+    // Given
+    std::shared_ptr<NMSphere> sphere = std::make_shared<NMSphere>();
+    sphere->SetTransform(NMMatrix::Scaling(1.3f, 1.3f, 1.3f));
+    std::shared_ptr<NMCSG> csg = std::make_shared<NMCSG>(ENMCSGOperation::Difference, std::make_shared<NMCube>(),
+                                                         sphere);
+
+    NMMatrix placement = NMMatrix::Translation(0.5f, 0.0f, 1.0f) * NMMatrix::RotationY(0.5f);
+    std::shared_ptr<NMInstance> instance = std::make_shared<NMInstance>(csg);
+    instance->SetTransform(placement);
+    NMWorld world = LitWorld();
+    world.AddObject(instance);
+
+    std::shared_ptr<NMSphere> sphereReference = std::make_shared<NMSphere>();
+    sphereReference->SetTransform(NMMatrix::Scaling(1.3f, 1.3f, 1.3f));
+    std::shared_ptr<NMCSG> reference = std::make_shared<NMCSG>(ENMCSGOperation::Difference,
+                                                               std::make_shared<NMCube>(), sphereReference);
+    reference->SetTransform(placement);
+    NMWorld expected = LitWorld();
+    expected.AddObject(reference);
+
+    // When
+    NMCanvas canvas = Render(world);
+
+    // Then
+    EXPECT_EQ(canvas.ToPPM(), Render(expected).ToPPM());
+    EXPECT_NE(canvas.ToPPM(), Render(LitWorld()).ToPPM());
+}
@@ -1,6 +1,15 @@
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <memory>
+
+#include "NMCore/Primitive/Cone.hpp"
+#include "NMCore/Primitive/Cube.hpp"
+#include "NMCore/Primitive/Cylinder.hpp"
+#include "NMCore/Primitive/Disk.hpp"
 #include "NMCore/Primitive/PrimitiveBase.hpp"
+#include "NMCore/Primitive/Sphere.hpp"
+#include "NMCore/Random.hpp"
 
 class NMTestShape : public NMPrimitiveBase
 {
@@ -106,6 +115,24 @@ TEST_F(NMPrimitiveBaseTest, PrimitiveBase_AssigningTransformation)
 
     // Then
     EXPECT_EQ(shape.GetTransform(), transform);
+    EXPECT_EQ(shape.GetInverseTransform(), transform.Inverse());
+}
+
+// Scenario: Assigning a transformation with a precomputed inverse
+TEST_F(NMPrimitiveBaseTest, PrimitiveBase_AssigningTransformationWithInverse)
+{
+    // Given
+    NMTestShape shape;
+    NMMatrix transform = NMMatrix::Scaling(2.0f, 2.0f, 2.0f);
+
+    // When
+    shape.SetTransform(transform, NMMatrix::Scaling(0.5f, 0.5f, 0.5f));
+    shape.Intersect(NMRay(NMPoint(0.0f, 0.0f, -5.0f), NMVector(0.0f, 0.0f, 1.0f)));
+
+    // Then
+    EXPECT_EQ(shape.GetInverseTransform(), NMMatrix::Scaling(0.5f, 0.5f, 0.5f));
+    EXPECT_EQ(shape.lastLocalIntersectRay.GetOrigin(), NMPoint(0.0f, 0.0f, -2.5f));
+    EXPECT_EQ(shape.lastLocalIntersectRay.GetDirection(), NMVector(0.0f, 0.0f, 0.5f));
 }
 
 // Scenario: The default material
@@ -193,3 +220,67 @@ TEST_F(NMPrimitiveBaseTest, PrimitiveBase_ComputingNormalOnTransformedShape)
     // Then
     EXPECT_EQ(normal, NMVector(0.0f, 0.970143f, -0.242536f));
 }
+
+// Scenario: The packet routines find the same nearest hits as intersecting the rays one by one
+TEST_F(NMPrimitiveBaseTest, PrimitiveBase_IntersectPacket)
+{
+    // Given every primitive with a packet routine, and the sphere for the default one
+    std::shared_ptr<NMCylinder> cylinder = std::make_shared<NMCylinder>();
+    cylinder->SetMinimum(-1.0f);
+    cylinder->SetMaximum(1.0f);
+    cylinder->SetClosed(true);
+    std::shared_ptr<NMCylinder> openCylinder = std::make_shared<NMCylinder>();
+    openCylinder->SetMinimum(-0.5f);
+    openCylinder->SetMaximum(2.0f);
+    std::shared_ptr<NMCone> cone = std::make_shared<NMCone>();
+    cone->SetMinimum(-1.5f);
+    cone->SetMaximum(1.0f);
+    cone->SetClosed(true);
+
+    std::vector<std::shared_ptr<NMPrimitiveBase>> primitives = {
+        std::make_shared<NMSphere>(), std::make_shared<NMCube>(), cylinder, openCylinder, cone,
+        std::make_shared<NMCone>(), std::make_shared<NMDisk>()};
+
+    NMRandom random(11);
+    for (std::size_t i = 0; i < primitives.size(); ++i)
+    {
+        primitives[i]->SetTransform(NMMatrix::Translation(0.2f, -0.1f, 0.0f) * NMMatrix::RotationX(0.4f)
+                                    * NMMatrix::RotationZ(0.3f));
+
+        for (int packetIndex = 0; packetIndex < 32; ++packetIndex)
+        {
+            // Rays from around z = -5 aimed at the primitive, some starting inside it
+            SNMRayPacket packet;
+            for (uint32_t lane = 0; lane < RAY_PACKET_SIZE; ++lane)
+            {
+                NMPoint origin(random.NextFloat() * 2.0f - 1.0f, random.NextFloat() * 2.0f - 1.0f,
+                               static_cast<float>(lane) - 5.0f);
+                NMPoint target(random.NextFloat() * 4.0f - 2.0f, random.NextFloat() * 4.0f - 2.0f, 0.0f);
+                packet.Add(NMRay(origin, (target - origin).Normalized()));
+            }
+
+            // When
+            float nearest[RAY_PACKET_SIZE];
+            primitives[i]->IntersectPacket(packet, nearest);
+
+            // Then
+            for (uint32_t lane = 0; lane < RAY_PACKET_SIZE; ++lane)
+            {
+                float expected = nmpacket::NoHit();
+                for (const SNMIntersection& hit : primitives[i]->Intersect(packet.GetRay(lane)))
+                {
+                    expected = nmpacket::Nearest(hit.t, expected);
+                }
+
+                if (std::isinf(expected))
+                {
+                    EXPECT_TRUE(std::isinf(nearest[lane])) << "primitive " << i << " lane " << lane;
+                }
+                else
+                {
+                    EXPECT_NEAR(nearest[lane], expected, 1e-4f) << "primitive " << i << " lane " << lane;
+                }
+            }
+        }
+    }
+}
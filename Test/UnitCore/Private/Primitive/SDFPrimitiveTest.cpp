@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <stdexcept>
+
+#include "NMCore/Primitive/SDFPrimitive.hpp"
+#include "NMCore/World.hpp"
+
+#define ASSERT_INHERITS_FROM(base, derived) \
+    static_assert(std::is_base_of<base, derived>::value, \
+    #derived " must inherit from " #base)
+
+class NMSDFPrimitiveTest : public testing::Test
+{
+protected:
+
+    // Five spheres of radius 0.5 along the x axis, 2 apart
+    static SNMSDFNode Row()
+    {
+        return SNMSDFNode::Repeat(SNMSDFNode::Sphere(0.5f), NMVector(2.0f, 0.0f, 0.0f), NMVector(2.0f, 0.0f, 0.0f));
+    }
+};
+
+// Scenario: An SDF primitive inherits from PrimitiveBase
+TEST_F(NMSDFPrimitiveTest, Creation_PrimitiveBase)
+{
+    ASSERT_INHERITS_FROM(NMPrimitiveBase, NMSDFPrimitive);
+}
+
+// Scenario: A node tree compiles into a flat postfix program
+TEST_F(NMSDFPrimitiveTest, Creation_Program)
+{
+    // Given
+    SNMSDFNode root = SNMSDFNode::SmoothUnion(
+        SNMSDFNode::Sphere(1.0f), SNMSDFNode::Translate(SNMSDFNode::Box(NMVector(1.0f, 1.0f, 1.0f)),
+                                                       NMVector(2.0f, 0.0f, 0.0f)),
+        0.5f);
+
+    // When
+    NMSDFPrimitive sdf(root);
+
+    // Then
+    const std::vector<SNMSDFInstruction>& program = sdf.GetProgram();
+    ASSERT_EQ(program.size(), 5u);
+    EXPECT_EQ(program[0].opcode, ENMSDFOpcode::Sphere);
+    EXPECT_EQ(program[1].opcode, ENMSDFOpcode::Translate);
+    EXPECT_EQ(program[2].opcode, ENMSDFOpcode::Box);
+    EXPECT_EQ(program[3].opcode, ENMSDFOpcode::PopPoint);
+    EXPECT_EQ(program[4].opcode, ENMSDFOpcode::SmoothUnion);
+    EXPECT_TRUE(sdf == NMSDFPrimitive(root));
+    EXPECT_FALSE(sdf == NMSDFPrimitive(SNMSDFNode::Sphere(1.0f)));
+}
+
+// Scenario: Trees deeper than the evaluation stack are rejected
+TEST_F(NMSDFPrimitiveTest, Creation_TooDeep)
+{
+    // Given
+    SNMSDFNode root = SNMSDFNode::Sphere(1.0f);
+    for (uint32_t i = 0; i < NMSDFPrimitive::MAX_STACK_DEPTH; ++i)
+    {
+        root = SNMSDFNode::Union(SNMSDFNode::Sphere(1.0f), root);
+    }
+
+    // Then
+    EXPECT_THROW(NMSDFPrimitive sdf(root), std::runtime_error);
+}
+
+// Scenario: The distances of the built-in shapes
+TEST_F(NMSDFPrimitiveTest, Distance_Shapes)
+{
+    // Given
+    NMSDFPrimitive sphere(SNMSDFNode::Sphere(2.0f));
+    NMSDFPrimitive box(SNMSDFNode::Box(NMVector(1.0f, 2.0f, 3.0f)));
+    NMSDFPrimitive torus(SNMSDFNode::Torus(2.0f, 0.5f));
+
+    // Then
+    EXPECT_FLOAT_EQ(sphere.Distance(NMPoint(0.0f, 0.0f, 5.0f)), 3.0f);
+    EXPECT_FLOAT_EQ(sphere.Distance(NMPoint(0.0f, 0.0f, 0.0f)), -2.0f);
+    EXPECT_FLOAT_EQ(box.Distance(NMPoint(3.0f, 0.0f, 0.0f)), 2.0f);
+    EXPECT_FLOAT_EQ(box.Distance(NMPoint(4.0f, 6.0f, 0.0f)), 5.0f);
+    EXPECT_FLOAT_EQ(box.Distance(NMPoint(0.5f, 0.0f, 0.0f)), -0.5f);
+    EXPECT_FLOAT_EQ(torus.Distance(NMPoint(2.0f, 0.0f, 0.0f)), -0.5f);
+    EXPECT_FLOAT_EQ(torus.Distance(NMPoint(0.0f, 0.0f, 0.0f)), 1.5f);
+    EXPECT_FLOAT_EQ(torus.Distance(NMPoint(0.0f, 1.0f, -2.0f)), 0.5f);
+}
+
+// Scenario: Combining and modifying shapes
+TEST_F(NMSDFPrimitiveTest, Distance_Operations)
+{
+    // Given two unit spheres 3 apart, hard and blended, and a row of five spheres
+    SNMSDFNode left = SNMSDFNode::Translate(SNMSDFNode::Sphere(1.0f), NMVector(-1.5f, 0.0f, 0.0f));
+    SNMSDFNode right = SNMSDFNode::Translate(SNMSDFNode::Sphere(1.0f), NMVector(1.5f, 0.0f, 0.0f));
+    NMSDFPrimitive hard(SNMSDFNode::Union(left, right));
+    NMSDFPrimitive smooth(SNMSDFNode::SmoothUnion(left, right, 1.0f));
+    NMSDFPrimitive row(Row());
+
+    // Then
+    EXPECT_FLOAT_EQ(hard.Distance(NMPoint(0.0f, 0.0f, 0.0f)), 0.5f);
+    EXPECT_FLOAT_EQ(hard.Distance(NMPoint(-1.5f, 0.0f, 0.0f)), -1.0f);
+    EXPECT_FLOAT_EQ(smooth.Distance(NMPoint(0.0f, 0.0f, 0.0f)), 0.25f);
+    EXPECT_FLOAT_EQ(smooth.Distance(NMPoint(-1.5f, 0.0f, 0.0f)), -1.0f);
+    EXPECT_FLOAT_EQ(row.Distance(NMPoint(4.0f, 0.0f, 0.0f)), -0.5f);
+    EXPECT_FLOAT_EQ(row.Distance(NMPoint(-4.0f, 1.0f, 0.0f)), 0.5f);
+    EXPECT_FLOAT_EQ(row.Distance(NMPoint(6.0f, 0.0f, 0.0f)), 1.5f);
+}
+
+// Scenario: The bounds enclose the shapes
+TEST_F(NMSDFPrimitiveTest, LocalBounds)
+{
+    // Given
+    NMSDFPrimitive torus(SNMSDFNode::Torus(2.0f, 0.5f));
+    NMSDFPrimitive row(Row());
+    NMSDFPrimitive smooth(SNMSDFNode::SmoothUnion(
+        SNMSDFNode::Sphere(1.0f), SNMSDFNode::Translate(SNMSDFNode::Sphere(1.0f), NMVector(0.0f, 3.0f, 0.0f)), 1.0f));
+
+    // Then
+    EXPECT_EQ(torus.LocalBounds().min, NMPoint(-2.5f, -0.5f, -2.5f));
+    EXPECT_EQ(torus.LocalBounds().max, NMPoint(2.5f, 0.5f, 2.5f));
+    EXPECT_EQ(row.LocalBounds().min, NMPoint(-4.5f, -0.5f, -0.5f));
+    EXPECT_EQ(row.LocalBounds().max, NMPoint(4.5f, 0.5f, 0.5f));
+    EXPECT_EQ(smooth.LocalBounds().min, NMPoint(-1.25f, -1.25f, -1.25f));
+    EXPECT_EQ(smooth.LocalBounds().max, NMPoint(1.25f, 4.25f, 1.25f));
+}
+
+// Scenario: Sphere tracing finds the first surface in front of the ray
+TEST_F(NMSDFPrimitiveTest, Intersect_Hit)
+{
+    // Given
+    NMSDFPrimitive sphere(SNMSDFNode::Sphere(1.0f));
+    NMSDFPrimitive torus(SNMSDFNode::Torus(2.0f, 0.5f));
+
+    // When
+    NMVector forward(0.0f, 0.0f, 1.0f);
+    NMVector down(0.0f, -1.0f, 0.0f);
+    std::vector<SNMIntersection> outside = sphere.LocalIntersect(NMRay(NMPoint(0.0f, 0.0f, -5.0f), forward));
+    std::vector<SNMIntersection> inside = sphere.LocalIntersect(NMRay(NMPoint(0.0f, 0.0f, 0.0f), forward));
+    std::vector<SNMIntersection> hole = torus.LocalIntersect(NMRay(NMPoint(0.0f, 5.0f, 0.0f), down));
+    std::vector<SNMIntersection> ring = torus.LocalIntersect(NMRay(NMPoint(2.0f, 5.0f, 0.0f), down));
+
+    // Then
+    ASSERT_EQ(outside.size(), 1u);
+    EXPECT_NEAR(outside[0].t, 4.0f, 1e-3f);
+    EXPECT_EQ(outside[0].object, &sphere);
+    ASSERT_EQ(inside.size(), 1u);
+    EXPECT_NEAR(inside[0].t, 1.0f, 1e-3f);
+    EXPECT_TRUE(hole.empty());
+    ASSERT_EQ(ring.size(), 1u);
+    EXPECT_NEAR(ring[0].t, 4.5f, 1e-3f);
+}
+
+// Scenario: Rays that miss the bounds or the surface report nothing
+TEST_F(NMSDFPrimitiveTest, Intersect_Miss)
+{
+    NMSDFPrimitive sphere(SNMSDFNode::Sphere(1.0f));
+    EXPECT_TRUE(sphere.LocalIntersect(NMRay(NMPoint(0.0f, 2.0f, -5.0f), NMVector(0.0f, 0.0f, 1.0f))).empty());
+    EXPECT_TRUE(sphere.LocalIntersect(NMRay(NMPoint(0.9f, 0.9f, -5.0f), NMVector(0.0f, 0.0f, 1.0f))).empty());
+    EXPECT_TRUE(sphere.LocalIntersect(NMRay(NMPoint(0.0f, 0.0f, 5.0f), NMVector(0.0f, 0.0f, 1.0f))).empty());
+}
+
+// Scenario: A transformed SDF in a world matches the analytic sphere it describes
+TEST_F(NMSDFPrimitiveTest, World_MatchesSphere)
+{
+    // Given
+    std::shared_ptr<NMSDFPrimitive> sdf = std::make_shared<NMSDFPrimitive>(SNMSDFNode::Sphere(1.0f));
+    sdf->SetTransform(NMMatrix::Translation(0.0f, 0.0f, 5.0f) * NMMatrix::Scaling(2.0f, 2.0f, 2.0f));
+    NMWorld world;
+    world.AddLight(NMPointLight(NMPoint(-10.0f, 10.0f, -10.0f), NMColor(1.0f, 1.0f, 1.0f)));
+    world.AddObject(sdf);
+
+    NMSphere sphere;
+    sphere.SetTransform(sdf->GetTransform());
+    NMPoint point(0.0f, 2.0f * std::sqrt(0.5f), 5.0f - 2.0f * std::sqrt(0.5f));
+
+    // When
+    world.BuildBVH();
+    SNMIntersectionList xs = world.Intersect(NMRay(NMPoint(0.3f, 0.2f, -5.0f), NMVector(0.0f, 0.0f, 1.0f)));
+    NMVector normal = sdf->NormalAt(point);
+
+    // Then
+    EXPECT_TRUE(world.GetUnboundedObjects().empty());
+    ASSERT_EQ(xs.Size(), 1u);
+    EXPECT_NEAR(xs[0].t, sphere.Intersect(NMRay(NMPoint(0.3f, 0.2f, -5.0f), NMVector(0.0f, 0.0f, 1.0f)))[0].t, 1e-3f);
+    EXPECT_NEAR(normal.GetX(), 0.0f, 1e-3f);
+    EXPECT_NEAR(normal.GetY(), std::sqrt(0.5f), 1e-3f);
+    EXPECT_NEAR(normal.GetZ(), -std::sqrt(0.5f), 1e-3f);
+}
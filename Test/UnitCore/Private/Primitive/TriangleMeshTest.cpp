@@ -0,0 +1,235 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "NMCore/Primitive/TriangleMesh.hpp"
+#include "NMCore/RT/IntersectionState.hpp"
+#include "NMCore/Random.hpp"
+#include "NMCore/World.hpp"
+
+#define ASSERT_INHERITS_FROM(base, derived) \
+    static_assert(std::is_base_of<base, derived>::value, \
+    #derived " must inherit from " #base)
+
+class NMTriangleMeshTest : public testing::Test
+{
+protected:
+
+    // The triangle (0, 1, 0), (-1, 0, 0), (1, 0, 0)
+    static NMTriangleMesh Triangle()
+    {
+        NMTriangleMesh mesh;
+        mesh.SetGeometry({0.0f, 1.0f, 0.0f, -1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f}, {0, 1, 2});
+        return mesh;
+    }
+
+    // A size x size grid of unit quads in the xy plane, two triangles each
+    static NMTriangleMesh Grid(uint32_t size)
+    {
+        std::vector<float> positions;
+        for (uint32_t y = 0; y <= size; ++y)
+        {
+            for (uint32_t x = 0; x <= size; ++x)
+            {
+                positions.insert(positions.end(), {static_cast<float>(x), static_cast<float>(y), 0.0f});
+            }
+        }
+
+        std::vector<uint32_t> indices;
+        for (uint32_t y = 0; y < size; ++y)
+        {
+            for (uint32_t x = 0; x < size; ++x)
+            {
+                uint32_t corner = y * (size + 1) + x;
+                indices.insert(indices.end(), {corner, corner + 1, corner + size + 2});
+                indices.insert(indices.end(), {corner, corner + size + 2, corner + size + 1});
+            }
+        }
+
+        NMTriangleMesh mesh;
+        mesh.SetGeometry(positions, indices);
+        return mesh;
+    }
+};
+
+// Scenario: A triangle mesh inherits from PrimitiveBase
+TEST_F(NMTriangleMeshTest, Creation_PrimitiveBase)
+{
+    ASSERT_INHERITS_FROM(NMPrimitiveBase, NMTriangleMesh);
+}
+
+// Scenario: Setting the geometry of a mesh
+TEST_F(NMTriangleMeshTest, SetGeometry)
+{
+    // When
+    NMTriangleMesh mesh = Triangle();
+
+    // Then
+    EXPECT_EQ(mesh.GetVertexCount(), 3u);
+    EXPECT_EQ(mesh.GetTriangleCount(), 1u);
+    EXPECT_EQ(mesh.GetVertex(1), NMPoint(-1.0f, 0.0f, 0.0f));
+    EXPECT_EQ(mesh.LocalBounds().min, NMPoint(-1.0f, 0.0f, 0.0f));
+    EXPECT_EQ(mesh.LocalBounds().max, NMPoint(1.0f, 1.0f, 0.0f));
+}
+
+// Scenario: Indices outside of the buffers are rejected
+TEST_F(NMTriangleMeshTest, SetGeometry_OutOfRange)
+{
+    // Given
+    NMTriangleMesh mesh;
+
+    // Then
+    EXPECT_THROW(mesh.SetGeometry({0.0f, 0.0f, 0.0f}, {0, 0, 1}), std::runtime_error);
+    EXPECT_THROW(mesh.SetGeometry({0.0f, 0.0f, 0.0f}, {0, 0}), std::runtime_error);
+    EXPECT_THROW(mesh.SetGeometry({0.0f, 0.0f, 0.0f}, {0, 0, 0}, {0.0f, 1.0f, 0.0f}, {0, 0, 1}), std::runtime_error);
+}
+
+// Scenario: A ray strikes a triangle
+TEST_F(NMTriangleMeshTest, Intersect_Hit)
+{
+    // Given
+    NMTriangleMesh mesh = Triangle();
+    NMRay ray(NMPoint(-0.2f, 0.3f, -2.0f), NMVector(0.0f, 0.0f, 1.0f));
+
+    // When
+    std::vector<SNMIntersection> xs = mesh.LocalIntersect(ray);
+
+    // Then
+    ASSERT_EQ(xs.size(), 1u);
+    EXPECT_FLOAT_EQ(xs[0].t, 2.0f);
+    EXPECT_EQ(xs[0].object, &mesh);
+    EXPECT_EQ(xs[0].index, 0u);
+    EXPECT_NEAR(xs[0].u, 0.45f, 1e-5f);
+    EXPECT_NEAR(xs[0].v, 0.25f, 1e-5f);
+}
+
+// Scenario: A ray misses a triangle past each edge and when parallel to it
+TEST_F(NMTriangleMeshTest, Intersect_Miss)
+{
+    // Given
+    NMTriangleMesh mesh = Triangle();
+
+    // Then
+    EXPECT_TRUE(mesh.LocalIntersect(NMRay(NMPoint(0.0f, -1.0f, -2.0f), NMVector(0.0f, 1.0f, 0.0f))).empty());
+    EXPECT_TRUE(mesh.LocalIntersect(NMRay(NMPoint(1.0f, 1.0f, -2.0f), NMVector(0.0f, 0.0f, 1.0f))).empty());
+    EXPECT_TRUE(mesh.LocalIntersect(NMRay(NMPoint(-1.0f, 1.0f, -2.0f), NMVector(0.0f, 0.0f, 1.0f))).empty());
+    EXPECT_TRUE(mesh.LocalIntersect(NMRay(NMPoint(0.0f, -1.0f, -2.0f), NMVector(0.0f, 0.0f, 1.0f))).empty());
+}
+
+// Scenario: Rays through the shared edges and corners of a grid never slip through
+TEST_F(NMTriangleMeshTest, Intersect_Watertight)
+{
+    // Given
+    NMTriangleMesh mesh = Grid(4);
+
+    // When every vertex, edge midpoint and diagonal point is shot at from an angle
+    std::size_t misses = 0;
+    for (int y = 1; y < 8; ++y)
+    {
+        for (int x = 1; x < 8; ++x)
+        {
+            NMPoint target(static_cast<float>(x) * 0.5f, static_cast<float>(y) * 0.5f, 0.0f);
+            NMVector direction(0.1f, -0.3f, 1.0f);
+            NMRay ray(target - direction * 3.0f, direction);
+            misses += mesh.LocalIntersect(ray).empty() ? 1u : 0u;
+        }
+    }
+
+    // Then
+    EXPECT_EQ(misses, 0u);
+}
+
+// Scenario: The BVH finds the triangle under every ray into a large grid
+TEST_F(NMTriangleMeshTest, Intersect_LargeGrid)
+{
+    // Given
+    NMTriangleMesh mesh = Grid(32);
+    NMRandom random(7);
+
+    for (int i = 0; i < 200; ++i)
+    {
+        NMPoint target(random.NextFloat() * 34.0f - 1.0f, random.NextFloat() * 34.0f - 1.0f, 0.0f);
+        NMVector direction(random.NextFloat() - 0.5f, random.NextFloat() - 0.5f, 1.0f);
+        NMRay ray(target - direction * 5.0f, direction);
+
+        // When
+        std::vector<SNMIntersection> xs = mesh.LocalIntersect(ray);
+
+        // Then the hit triangle is the grid cell under the target
+        bool inside = target.GetX() > 0.0f && target.GetX() < 32.0f && target.GetY() > 0.0f && target.GetY() < 32.0f;
+        ASSERT_EQ(xs.empty(), !inside) << "ray " << i;
+        if (inside)
+        {
+            uint32_t cell = static_cast<uint32_t>(target.GetY()) * 32 + static_cast<uint32_t>(target.GetX());
+            EXPECT_EQ(xs[0].index / 2, cell);
+            EXPECT_NEAR(xs[0].t, 5.0f, 1e-3f);
+        }
+    }
+}
+
+// Scenario: A flat triangle's normal is its face normal
+TEST_F(NMTriangleMeshTest, NormalAt_Flat)
+{
+    // Given
+    NMTriangleMesh mesh = Triangle();
+    SNMIntersection hit(2.0f, &mesh, 0, 0.45f, 0.25f);
+
+    // When
+    NMVector normal = mesh.NormalAt(NMPoint(0.0f, 0.5f, 0.0f), hit);
+
+    // Then
+    EXPECT_EQ(normal, NMVector(0.0f, 0.0f, -1.0f));
+}
+
+// Scenario: A smooth triangle interpolates its vertex normals at the hit
+TEST_F(NMTriangleMeshTest, NormalAt_Smooth)
+{
+    // Given
+    NMTriangleMesh mesh;
+    mesh.SetGeometry({0.0f, 1.0f, 0.0f, -1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f}, {0, 1, 2},
+                     {0.0f, 1.0f, 0.0f, -1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f}, {0, 1, 2});
+    SNMIntersection hit(1.0f, &mesh, 0, 0.45f, 0.25f);
+
+    // When
+    NMVector normal = mesh.NormalAt(NMPoint(0.0f, 0.0f, 0.0f), hit);
+
+    // Then
+    EXPECT_EQ(normal, NMVector(-0.5547f, 0.83205f, 0.0f));
+}
+
+// Scenario: The intersection state of a mesh hit uses the hit triangle's normal
+TEST_F(NMTriangleMeshTest, IntersectionState)
+{
+    // Given
+    NMTriangleMesh mesh;
+    mesh.SetGeometry({0.0f, 1.0f, 0.0f, -1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f}, {0, 1, 2},
+                     {0.0f, 1.0f, 0.0f, -1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f}, {0, 1, 2});
+    NMRay ray(NMPoint(-0.2f, 0.3f, -2.0f), NMVector(0.0f, 1.0f, 0.0f));
+    SNMIntersection hit(1.0f, &mesh, 0, 0.45f, 0.25f);
+
+    // When
+    SNMIntersectionState state(hit, ray);
+
+    // Then
+    EXPECT_EQ(state.normalVector, NMVector(0.5547f, -0.83205f, 0.0f));
+}
+
+// Scenario: A transformed mesh in a world is shaded
+TEST_F(NMTriangleMeshTest, World_ColorAt)
+{
+    // Given
+    NMWorld world;
+    world.AddLight(NMPointLight(NMPoint(0.0f, 0.0f, -10.0f), NMColor(1.0f, 1.0f, 1.0f)));
+    std::shared_ptr<NMTriangleMesh> mesh = std::make_shared<NMTriangleMesh>(Grid(2));
+    mesh->SetTransform(NMMatrix::Translation(-1.0f, -1.0f, 0.0f));
+    world.AddObject(mesh);
+    world.BuildBVH();
+
+    // When
+    NMColor hit = world.ColorAt(NMRay(NMPoint(0.1f, 0.2f, -5.0f), NMVector(0.0f, 0.0f, 1.0f)));
+    NMColor miss = world.ColorAt(NMRay(NMPoint(3.0f, 0.0f, -5.0f), NMVector(0.0f, 0.0f, 1.0f)));
+
+    // Then
+    EXPECT_GT(hit.GetRed(), 0.5f);
+    EXPECT_EQ(miss, NMColor(0.0f, 0.0f, 0.0f));
+}
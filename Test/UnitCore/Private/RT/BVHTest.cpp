@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "NMCore/RT/BVH.hpp"
+
+class NMBVHTest : public testing::Test
+{
+protected:
+
+    static std::vector<uint32_t> Visit(const NMBVH& bvh, const NMRay& ray)
+    {
+        std::vector<uint32_t> visited;
+        bvh.Traverse(ray, [&visited](uint32_t id) { visited.push_back(id); });
+        std::sort(visited.begin(), visited.end());
+        return visited;
+    }
+};
+
+// Scenario: An empty hierarchy visits nothing
+TEST_F(NMBVHTest, Build_Empty)
+{
+    // Given
+    NMBVH bvh;
+
+    // When
+    bvh.Build({}, {});
+
+    // Then
+    EXPECT_TRUE(bvh.IsEmpty());
+    EXPECT_TRUE(Visit(bvh, NMRay(NMPoint(0.0f, 0.0f, 0.0f), NMVector(0.0f, 0.0f, 1.0f))).empty());
+}
+
+// Scenario: Traversal only visits items along the ray
+TEST_F(NMBVHTest, Traverse)
+{
+    // Given a row of 100 unit boxes along x
+    std::vector<SNMBounds> bounds;
+    std::vector<uint32_t> ids;
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        float x = static_cast<float>(i) * 3.0f;
+        bounds.push_back(SNMBounds(NMPoint(x - 1.0f, -1.0f, -1.0f), NMPoint(x + 1.0f, 1.0f, 1.0f)));
+        ids.push_back(i + 1000);
+    }
+
+    NMBVH bvh;
+    bvh.Build(bounds, ids);
+
+    // When
+    std::vector<uint32_t> hitOne = Visit(bvh, NMRay(NMPoint(30.0f, 0.0f, -5.0f), NMVector(0.0f, 0.0f, 1.0f)));
+    std::vector<uint32_t> hitAll = Visit(bvh, NMRay(NMPoint(-5.0f, 0.0f, 0.0f), NMVector(1.0f, 0.0f, 0.0f)));
+    std::vector<uint32_t> hitNone = Visit(bvh, NMRay(NMPoint(0.0f, 5.0f, 0.0f), NMVector(1.0f, 0.0f, 0.0f)));
+
+    // Then
+    // Items are culled per leaf, so neighbours sharing the leaf of the hit item are visited as well
+    EXPECT_NE(std::find(hitOne.begin(), hitOne.end(), 1010), hitOne.end());
+    EXPECT_LE(hitOne.size(), BVH_LEAF_SIZE);
+    EXPECT_EQ(hitAll.size(), 100);
+    EXPECT_TRUE(hitNone.empty());
+    EXPECT_LE(bvh.GetNodes()[0].min[0], -1.0f);
+    EXPECT_GE(bvh.GetNodes()[0].max[0], 298.0f);
+}
+
+// Scenario: A hierarchy can be copied from flat arrays
+TEST_F(NMBVHTest, Assign)
+{
+    // Given
+    NMBVH source;
+    source.Build({SNMBounds(NMPoint(-1.0f, -1.0f, -1.0f), NMPoint(1.0f, 1.0f, 1.0f))}, {7});
+
+    // When
+    NMBVH copy;
+    copy.Assign(source.GetNodes().data(), source.GetNodes().size(), source.GetIndices().data(),
+                source.GetIndices().size());
+
+    // Then
+    EXPECT_EQ(Visit(copy, NMRay(NMPoint(0.0f, 0.0f, -5.0f), NMVector(0.0f, 0.0f, 1.0f))), std::vector<uint32_t>({7}));
+}
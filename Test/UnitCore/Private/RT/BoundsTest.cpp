@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include "NMCore/Primitive/Plane.hpp"
+#include "NMCore/Primitive/Sphere.hpp"
+#include "NMCore/RT/Bounds.hpp"
+
+class NMBoundsTest : public testing::Test
+{
+};
+
+// Scenario: A default bounding box is empty
+TEST_F(NMBoundsTest, Default_IsEmpty)
+{
+    // Given
+    SNMBounds bounds;
+
+    // Then
+    EXPECT_TRUE(bounds.IsEmpty());
+    EXPECT_FALSE(bounds.IsFinite());
+}
+
+// Scenario: Extending a bounding box with points
+TEST_F(NMBoundsTest, Extend)
+{
+    // Given
+    SNMBounds bounds;
+
+    // When
+    bounds.Extend(NMPoint(-5.0f, 2.0f, 0.0f));
+    bounds.Extend(NMPoint(7.0f, 0.0f, -3.0f));
+
+    // Then
+    EXPECT_EQ(bounds.min, NMPoint(-5.0f, 0.0f, -3.0f));
+    EXPECT_EQ(bounds.max, NMPoint(7.0f, 2.0f, 0.0f));
+    EXPECT_TRUE(bounds.IsFinite());
+}
+
+// Scenario: Transforming a bounding box
+TEST_F(NMBoundsTest, Transformed)
+{
+    // Given
+    SNMBounds bounds(NMPoint(-1.0f, -1.0f, -1.0f), NMPoint(1.0f, 1.0f, 1.0f));
+    NMMatrix transform = NMMatrix::RotationX(nmmath::quarterPi) * NMMatrix::RotationY(nmmath::quarterPi);
+
+    // When
+    SNMBounds result = bounds.Transformed(transform);
+
+    // Then
+    EXPECT_TRUE(nmmath::FloatEquals(result.min.GetX(), -1.4142135f, 1e-5f));
+    EXPECT_TRUE(nmmath::FloatEquals(result.min.GetY(), -1.7071067f, 1e-5f));
+    EXPECT_TRUE(nmmath::FloatEquals(result.min.GetZ(), -1.7071067f, 1e-5f));
+    EXPECT_TRUE(nmmath::FloatEquals(result.max.GetX(), 1.4142135f, 1e-5f));
+    EXPECT_TRUE(nmmath::FloatEquals(result.max.GetY(), 1.7071067f, 1e-5f));
+    EXPECT_TRUE(nmmath::FloatEquals(result.max.GetZ(), 1.7071067f, 1e-5f));
+}
+
+// Scenario: Intersecting a ray with a bounding box
+TEST_F(NMBoundsTest, Intersects)
+{
+    // Given
+    SNMBounds bounds(NMPoint(5.0f, -2.0f, 0.0f), NMPoint(11.0f, 4.0f, 7.0f));
+
+    // Then
+    EXPECT_TRUE(bounds.Intersects(NMRay(NMPoint(15.0f, 1.0f, 2.0f), NMVector(-1.0f, 0.0f, 0.0f))));
+    EXPECT_TRUE(bounds.Intersects(NMRay(NMPoint(-5.0f, -1.0f, 4.0f), NMVector(1.0f, 0.0f, 0.0f))));
+    EXPECT_TRUE(bounds.Intersects(NMRay(NMPoint(7.0f, 6.0f, 5.0f), NMVector(0.0f, -1.0f, 0.0f))));
+    EXPECT_TRUE(bounds.Intersects(NMRay(NMPoint(9.0f, -5.0f, 6.0f), NMVector(0.0f, 1.0f, 0.0f))));
+    EXPECT_TRUE(bounds.Intersects(NMRay(NMPoint(8.0f, 2.0f, 12.0f), NMVector(0.0f, 0.0f, -1.0f))));
+    EXPECT_TRUE(bounds.Intersects(NMRay(NMPoint(6.0f, 0.0f, -5.0f), NMVector(0.0f, 0.0f, 1.0f))));
+    EXPECT_TRUE(bounds.Intersects(NMRay(NMPoint(8.0f, 1.0f, 3.5f), NMVector(0.0f, 0.0f, 1.0f))));
+
+    EXPECT_FALSE(bounds.Intersects(NMRay(NMPoint(9.0f, -1.0f, -8.0f), NMVector(2.0f, 4.0f, 6.0f).Normalized())));
+    EXPECT_FALSE(bounds.Intersects(NMRay(NMPoint(8.0f, 3.0f, -4.0f), NMVector(6.0f, 2.0f, 4.0f).Normalized())));
+    EXPECT_FALSE(bounds.Intersects(NMRay(NMPoint(12.0f, 5.0f, 4.0f), NMVector(0.0f, 0.0f, -1.0f))));
+}
+
+// Scenario: Intersecting a ray with a bounding box behind its origin
+TEST_F(NMBoundsTest, Intersects_Interval)
+{
+    // Given
+    SNMBounds bounds(NMPoint(-1.0f, -1.0f, -1.0f), NMPoint(1.0f, 1.0f, 1.0f));
+    NMRay ray(NMPoint(0.0f, 0.0f, 5.0f), NMVector(0.0f, 0.0f, 1.0f));
+
+    // Then
+    EXPECT_TRUE(bounds.Intersects(ray));
+    EXPECT_FALSE(bounds.Intersects(ray, 0.0f));
+}
+
+// Scenario: The bounds of primitives
+TEST_F(NMBoundsTest, PrimitiveBounds)
+{
+    // Given
+    NMSphere sphere;
+    sphere.SetTransform(NMMatrix::Translation(1.0f, -3.0f, 5.0f) * NMMatrix::Scaling(0.5f, 2.0f, 4.0f));
+    NMPlane plane;
+
+    // When
+    SNMBounds sphereBounds = sphere.WorldBounds();
+    SNMBounds planeBounds = plane.WorldBounds();
+
+    // Then
+    EXPECT_EQ(sphere.LocalBounds().min, NMPoint(-1.0f, -1.0f, -1.0f));
+    EXPECT_EQ(sphere.LocalBounds().max, NMPoint(1.0f, 1.0f, 1.0f));
+    EXPECT_EQ(sphereBounds.min, NMPoint(0.5f, -5.0f, 1.0f));
+    EXPECT_EQ(sphereBounds.max, NMPoint(1.5f, -1.0f, 9.0f));
+    EXPECT_FALSE(planeBounds.IsFinite());
+    EXPECT_FALSE(planeBounds.IsEmpty());
+}
@@ -30,6 +30,23 @@ TEST_F(SNMIntersectionStateTest, PrecomputeState)
     ASSERT_EQ(state.normalVector, NMVector(0.0f, 0.0f, -1.0f));
 }
 
+// Scenario: The footprint of a hit is the ray's spread times the distance to it
+TEST_F(SNMIntersectionStateTest, Footprint)
+{
+    // Given
+    NMRay ray(NMPoint(0.0f, 0.0f, -5.0f), NMVector(0.0f, 0.0f, 1.0f));
+    ray.SetSpread(0.01f);
+    SNMIntersectionList intersections = defaultWorld.Intersect(ray);
+
+    // When
+    SNMIntersectionState state = SNMIntersectionState(intersections[0], ray);
+    SNMIntersectionState thinState = SNMIntersectionState(intersections[0], NMRay(ray.GetOrigin(), ray.GetDirection()));
+
+    // Then
+    EXPECT_FLOAT_EQ(state.footprint, 0.04f);
+    EXPECT_FLOAT_EQ(thinState.footprint, 0.0f);
+}
+
 // Scenario: The hit, when an intersection occurs on the outside
 TEST_F(SNMIntersectionStateTest, HitOutside)
 {
@@ -75,3 +75,18 @@ TEST_F(NMRayTest, RayScaling)
     EXPECT_EQ(transformedRay.GetOrigin(), NMPoint(2.0f, 6.0f, 12.0f));
     EXPECT_EQ(transformedRay.GetDirection(), NMVector(0.0f, 3.0f, 0.0f));
 }
+
+// Scenario: Transforming a ray keeps its spread
+TEST_F(NMRayTest, RayTransformedSpread)
+{
+    // Given
+    NMRay ray = NMRay(NMPoint(1.0f, 2.0f, 3.0f), NMVector(0.0f, 1.0f, 0.0f));
+    ray.SetSpread(0.25f);
+
+    // When
+    NMRay transformedRay = ray.Transformed(NMMatrix::Translation(3.0f, 4.0f, 5.0f));
+
+    // Then
+    EXPECT_FLOAT_EQ(NMRay().GetSpread(), 0.0f);
+    EXPECT_FLOAT_EQ(transformedRay.GetSpread(), 0.25f);
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include "NMCore/RenderStats.hpp"
+
+class NMRenderStatsTest : public testing::Test
+{
+};
+
+// Scenario: Worker counters are summed into the frame totals
+TEST_F(NMRenderStatsTest, Accumulate)
+{
+    // Given
+    SNMRenderStats stats;
+    SNMRenderCounters first;
+    first.rays[static_cast<std::size_t>(ENMRayType::Primary)] = 10;
+    first.rays[static_cast<std::size_t>(ENMRayType::Reflection)] = 4;
+    first.intersectionTests = 30;
+    first.intersectionHits = 12;
+    first.textureTileHits = 6;
+    first.textureTileMisses = 1;
+    first.textureBytesRead = 4096;
+    SNMRenderCounters second;
+    second.rays[static_cast<std::size_t>(ENMRayType::Primary)] = 6;
+    second.rays[static_cast<std::size_t>(ENMRayType::Shadow)] = 5;
+    second.intersectionTests = 20;
+    second.intersectionHits = 3;
+    second.textureTileHits = 2;
+
+    // When
+    stats.Accumulate(first);
+    stats.Accumulate(second);
+
+    // Then
+    EXPECT_EQ(stats.GetRays(ENMRayType::Primary), 16u);
+    EXPECT_EQ(stats.GetRays(ENMRayType::Shadow), 5u);
+    EXPECT_EQ(stats.GetRays(ENMRayType::Reflection), 4u);
+    EXPECT_EQ(stats.GetRays(ENMRayType::Refraction), 0u);
+    EXPECT_EQ(stats.TotalRays(), 25u);
+    EXPECT_EQ(stats.intersectionTests, 50u);
+    EXPECT_EQ(stats.intersectionHits, 15u);
+    EXPECT_DOUBLE_EQ(stats.AverageReflectionDepth(), 0.25);
+    EXPECT_EQ(stats.textureTileHits, 8u);
+    EXPECT_EQ(stats.textureTileMisses, 1u);
+    EXPECT_EQ(stats.textureBytesRead, 4096u);
+    EXPECT_DOUBLE_EQ(stats.TextureHitRate(), 8.0 / 9.0);
+}
+
+// Scenario: Worker counters never share a cache line
+TEST_F(NMRenderStatsTest, CountersArePadded)
+{
+    // Given
+    NMRenderCountersArray counters(3);
+
+    // Then
+    EXPECT_EQ(alignof(SNMRenderCounters), CACHE_LINE_SIZE);
+    EXPECT_EQ(sizeof(SNMRenderCounters) % CACHE_LINE_SIZE, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(counters.data()) % CACHE_LINE_SIZE, 0u);
+}
+
+// Scenario: Worker times and tile lists never share a cache line
+TEST_F(NMRenderStatsTest, WorkerSlotsArePadded)
+{
+    // Given
+    NMWorkerSlotArray slots(3);
+
+    // Then
+    EXPECT_EQ(alignof(SNMWorkerSlot), CACHE_LINE_SIZE);
+    EXPECT_EQ(sizeof(SNMWorkerSlot) % CACHE_LINE_SIZE, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(slots.data()) % CACHE_LINE_SIZE, 0u);
+}
+
+// Scenario: An empty frame has no reflection depth
+TEST_F(NMRenderStatsTest, AverageReflectionDepth_NoRays)
+{
+    // Given
+    SNMRenderStats stats;
+
+    // Then
+    EXPECT_EQ(stats.AverageReflectionDepth(), 0.0);
+    EXPECT_EQ(stats.MaxTileSeconds(), 0.0);
+    EXPECT_EQ(stats.TextureHitRate(), 1.0);
+}
+
+// Scenario: Counters are only collected on render worker threads
+TEST_F(NMRenderStatsTest, CountOutsideRender)
+{
+    // Given
+    SNMRenderCounters counters;
+
+    // When
+    nmstats::CountRay(ENMRayType::Primary);
+    nmstats::CurrentCounters() = &counters;
+    nmstats::CountRay(ENMRayType::Shadow);
+    nmstats::CountIntersectionTest(true);
+    nmstats::CountIntersectionTest(false);
+    nmstats::CountTextureTile(false, 12288);
+    nmstats::CurrentCounters() = nullptr;
+
+    // Then
+    EXPECT_EQ(counters.rays[static_cast<std::size_t>(ENMRayType::Primary)], 0u);
+    EXPECT_EQ(counters.rays[static_cast<std::size_t>(ENMRayType::Shadow)], NM_RENDER_STATS ? 1u : 0u);
+    EXPECT_EQ(counters.intersectionTests, NM_RENDER_STATS ? 2u : 0u);
+    EXPECT_EQ(counters.intersectionHits, NM_RENDER_STATS ? 1u : 0u);
+    EXPECT_EQ(counters.textureTileMisses, NM_RENDER_STATS ? 1u : 0u);
+    EXPECT_EQ(counters.textureBytesRead, NM_RENDER_STATS ? 12288u : 0u);
+}
+
+// Scenario: Stats serialize to a single line JSON object
+TEST_F(NMRenderStatsTest, ToJSON)
+{
+    // Given
+    SNMRenderStats stats;
+    stats.enabled = true;
+    stats.frameSeconds = 0.5;
+    stats.tileCount = 2;
+    stats.rays[static_cast<std::size_t>(ENMRayType::Primary)] = 8;
+    stats.workers.resize(1);
+    stats.workers[0].tiles = 2;
+
+    // When
+    std::string json = stats.ToJSON();
+
+    // Then
+    EXPECT_EQ(json.find('\n'), std::string::npos);
+    EXPECT_NE(json.find("\"frame_seconds\":0.500000"), std::string::npos);
+    EXPECT_NE(json.find("\"rays\":{\"primary\":8,"), std::string::npos);
+    EXPECT_NE(json.find("\"texture_tiles\":{\"hits\":0,\"misses\":0,\"hit_rate\":1.000000,"), std::string::npos);
+    EXPECT_NE(json.find("\"workers\":[{\"tiles\":2,"), std::string::npos);
+    EXPECT_EQ(json.front(), '{');
+    EXPECT_EQ(json.back(), '}');
+}
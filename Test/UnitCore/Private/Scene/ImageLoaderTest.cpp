@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include "NMCore/Pattern/Texture.hpp"
+#include "NMCore/Scene/ImageLoader.hpp"
+#include "NMCore/Scene/SceneParser.hpp"
+
+class NMImageLoaderTest : public testing::Test
+{
+protected:
+
+    static NMCanvas Load(const std::string& data)
+    {
+        std::istringstream stream(data);
+        return NMImageLoader::Load(stream);
+    }
+
+    // The bytes of a float in little-endian order, whatever the host's
+    static std::string LittleEndian(float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        std::string bytes;
+        for (int shift = 0; shift < 32; shift += 8)
+        {
+            bytes += static_cast<char>((bits >> shift) & 0xFF);
+        }
+
+        return bytes;
+    }
+};
+
+// Scenario: Reading a plain PPM with comments, scaled by its maximum value
+TEST_F(NMImageLoaderTest, Load_PlainPPM)
+{
+    // When
+    NMCanvas canvas = Load("P3\n# made by hand\n2 1\n# maximum\n10\n10 0 5  0 10\n  0\n");
+
+    // Then
+    ASSERT_TRUE(canvas.IsSize(2, 1));
+    EXPECT_EQ(canvas.ReadPixel(0, 0), NMColor(1.0f, 0.0f, 0.5f));
+    EXPECT_EQ(canvas.ReadPixel(1, 0), NMColor(0.0f, 1.0f, 0.0f));
+}
+
+// Scenario: Reading binary PPMs with 8 and 16 bit channels
+TEST_F(NMImageLoaderTest, Load_BinaryPPM)
+{
+    // When
+    NMCanvas bytes = Load(std::string("P6 1 2 255\n\xFF\x00\x33\x00\x00\xFF", 17));
+    NMCanvas words = Load(std::string("P6\n1 1\n65535\n\xFF\xFF\x80\x00\x00\x00", 19));
+
+    // Then
+    ASSERT_TRUE(bytes.IsSize(1, 2));
+    EXPECT_EQ(bytes.ReadPixel(0, 0), NMColor(1.0f, 0.0f, 0.2f));
+    EXPECT_EQ(bytes.ReadPixel(0, 1), NMColor(0.0f, 0.0f, 1.0f));
+    EXPECT_EQ(words.ReadPixel(0, 0), NMColor(1.0f, 32768.0f / 65535.0f, 0.0f));
+}
+
+// Scenario: Reading PFMs, whose rows run bottom to top and whose scale gives the byte order
+TEST_F(NMImageLoaderTest, Load_PFM)
+{
+    // Given
+    std::string color = "PF\n1 2\n-1.0\n" + LittleEndian(0.25f) + LittleEndian(2.0f) + LittleEndian(0.0f)
+                        + LittleEndian(1.0f) + LittleEndian(0.5f) + LittleEndian(0.75f);
+    std::string gray = "Pf\n1 1\n1.0\n";
+    gray += std::string("\x3F\x00\x00\x00", 4);
+
+    // When
+    NMCanvas colorCanvas = Load(color);
+    NMCanvas grayCanvas = Load(gray);
+
+    // Then
+    ASSERT_TRUE(colorCanvas.IsSize(1, 2));
+    EXPECT_EQ(colorCanvas.ReadPixel(0, 1), NMColor(0.25f, 2.0f, 0.0f));
+    EXPECT_EQ(colorCanvas.ReadPixel(0, 0), NMColor(1.0f, 0.5f, 0.75f));
+    EXPECT_EQ(grayCanvas.ReadPixel(0, 0), NMColor(0.5f, 0.5f, 0.5f));
+}
+
+// Scenario: Malformed, truncated and unsupported images are rejected
+TEST_F(NMImageLoaderTest, Load_Errors)
+{
+    EXPECT_THROW(Load(""), std::runtime_error);
+    EXPECT_THROW(Load("P5 1 1 255\n\x01"), std::runtime_error);
+    EXPECT_THROW(Load("P3 0 1 255\n"), std::runtime_error);
+    EXPECT_THROW(Load("P3 1 x 255\n1 2 3"), std::runtime_error);
+    EXPECT_THROW(Load("P3 1 1 255\n1 2"), std::runtime_error);
+    EXPECT_THROW(Load("P3 1 1 255\n1 2 256"), std::runtime_error);
+    EXPECT_THROW(Load("P6 2 1 255\n\x01\x02\x03"), std::runtime_error);
+    EXPECT_THROW(Load("PF 1 1 0\n"), std::runtime_error);
+    EXPECT_THROW(Load("PF 1 1 -1\n\x00\x00"), std::runtime_error);
+    EXPECT_THROW(NMImageLoader::LoadFile("/nonexistent/texture.ppm"), std::runtime_error);
+}
+
+// Scenario: A scene's image patterns load a PPM next to the scene once and share its texture
+TEST_F(NMImageLoaderTest, SceneParser_ImagePattern)
+{
+    // Given
+    std::string directory = testing::TempDir();
+    {
+        std::ofstream ppm(directory + "nm_image_loader_test.ppm");
+        ppm << "P3\n2 2\n255\n255 0 0  0 255 0\n0 0 255  255 255 255\n";
+    }
+
+    // When
+    SNMScene scene = NMSceneParser::Parse("pattern flat image nm_image_loader_test.ppm scale 2 2 2\n"
+                                          "pattern globe image nm_image_loader_test.ppm spherical\n"
+                                          "material a pattern flat\n"
+                                          "material b pattern globe\n"
+                                          "sphere material a\n"
+                                          "sphere material b\n",
+                                          directory + "scene.txt");
+
+    // Then
+    ASSERT_EQ(scene.world.GetObjectCount(), 2u);
+    const NMTexturePattern* flat =
+        dynamic_cast<const NMTexturePattern*>(scene.world.GetObject(0)->GetMaterial().GetPattern().get());
+    const NMTexturePattern* globe =
+        dynamic_cast<const NMTexturePattern*>(scene.world.GetObject(1)->GetMaterial().GetPattern().get());
+    ASSERT_NE(flat, nullptr);
+    ASSERT_NE(globe, nullptr);
+    EXPECT_EQ(flat->GetTexture(), globe->GetTexture());
+    EXPECT_EQ(flat->GetMapping(), ENMUVMapping::Planar);
+    EXPECT_EQ(globe->GetMapping(), ENMUVMapping::Spherical);
+    EXPECT_EQ(flat->GetTransform(), NMMatrix::Scaling(2.0f, 2.0f, 2.0f));
+    EXPECT_EQ(flat->GetTexture()->GetLevelCount(), 2u);
+    EXPECT_EQ(flat->GetTexture()->SampleBilinear(0.75f, 0.75f), NMColor(0.0f, 1.0f, 0.0f));
+    EXPECT_THROW(NMSceneParser::Parse("pattern p image missing.ppm\n", directory + "scene.txt"), NMSceneParseError);
+    EXPECT_THROW(NMSceneParser::Parse("pattern p image nm_image_loader_test.ppm conical\n", directory + "scene.txt"),
+                 NMSceneParseError);
+}
@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <sstream>
+
+#include "NMCore/Primitive/Instance.hpp"
+#include "NMCore/Scene/ObjLoader.hpp"
+#include "NMCore/Scene/SceneParser.hpp"
+
+class NMObjLoaderTest : public testing::Test
+{
+protected:
+
+    static std::shared_ptr<NMTriangleMesh> Load(const std::string& text)
+    {
+        std::istringstream stream(text);
+        return NMObjLoader::Load(stream);
+    }
+};
+
+// Scenario: Vertices and triangles are read, unknown statements are ignored
+TEST_F(NMObjLoaderTest, Load_Triangles)
+{
+    // When
+    std::shared_ptr<NMTriangleMesh> mesh = Load(
+        "# a comment\n"
+        "There was a young lady named Bright\n"
+        "mtllib scene.mtl\n"
+        "v -1 1 0\n"
+        "v -1.0000 0.5000 0.0000\n"
+        "v 1 0 0\n"
+        "v 1e0 1 0\n"
+        "\n"
+        "g FirstGroup\n"
+        "f 1 2 3\n"
+        "f 1 3 4");
+
+    // Then
+    ASSERT_EQ(mesh->GetVertexCount(), 4u);
+    EXPECT_EQ(mesh->GetVertex(1), NMPoint(-1.0f, 0.5f, 0.0f));
+    EXPECT_EQ(mesh->GetVertex(3), NMPoint(1.0f, 1.0f, 0.0f));
+    EXPECT_EQ(mesh->GetPositionIndices(), std::vector<uint32_t>({0, 1, 2, 0, 2, 3}));
+    EXPECT_TRUE(mesh->GetNormals().empty());
+}
+
+// Scenario: Polygons are fanned into triangles
+TEST_F(NMObjLoaderTest, Load_Polygon)
+{
+    // When
+    std::shared_ptr<NMTriangleMesh> mesh = Load(
+        "v -1 1 0\nv -1 0 0\nv 1 0 0\nv 1 1 0\nv 0 2 0\n"
+        "f 1 2 3 4 5\n");
+
+    // Then
+    EXPECT_EQ(mesh->GetPositionIndices(), std::vector<uint32_t>({0, 1, 2, 0, 2, 3, 0, 3, 4}));
+}
+
+// Scenario: Normals, texture coordinates and relative indices in face corners
+TEST_F(NMObjLoaderTest, Load_Normals)
+{
+    // When
+    std::shared_ptr<NMTriangleMesh> mesh = Load(
+        "v 0 1 0\r\nv -1 0 0\r\nv 1 0 0\r\n"
+        "vn -1 0 0\r\nvn 1 0 0\r\nvn 0 1 0\r\n"
+        "vt 0 0\r\n"
+        "f 1//3 2//1 3//2\r\n"
+        "f 1/1/3 2/1/1 3/1/2\r\n"
+        "f -3//-1 -2 -1/1\r\n");
+
+    // Then
+    EXPECT_EQ(mesh->GetTriangleCount(), 3u);
+    EXPECT_EQ(mesh->GetNormals().size(), 9u);
+    EXPECT_EQ(mesh->GetNormalIndices(),
+              std::vector<uint32_t>({2, 0, 1, 2, 0, 1, 2, NMTriangleMesh::NO_NORMAL, NMTriangleMesh::NO_NORMAL}));
+    EXPECT_EQ(mesh->GetPositionIndices(), std::vector<uint32_t>({0, 1, 2, 0, 1, 2, 0, 1, 2}));
+}
+
+// Scenario: Lines that span the read chunks of a large file are parsed whole
+TEST_F(NMObjLoaderTest, Load_Large)
+{
+    // Given a file of several read chunks
+    std::ostringstream text;
+    const uint32_t quads = 40000;
+    for (uint32_t i = 0; i <= quads; ++i)
+    {
+        text << "v " << i << ".25 0.000000 -1.500000\nv " << i << ".25 1.000000 -1.500000\n";
+    }
+    for (uint32_t i = 0; i < quads; ++i)
+    {
+        text << "f " << 2 * i + 1 << " " << 2 * i + 3 << " " << 2 * i + 4 << " " << 2 * i + 2 << "\n";
+    }
+    ASSERT_GT(text.str().size(), 2u << 20);
+
+    // When
+    std::shared_ptr<NMTriangleMesh> mesh = Load(text.str());
+
+    // Then
+    ASSERT_EQ(mesh->GetVertexCount(), 2u * (quads + 1));
+    ASSERT_EQ(mesh->GetTriangleCount(), 2u * quads);
+    for (uint32_t i = 0; i < mesh->GetVertexCount(); ++i)
+    {
+        ASSERT_EQ(mesh->GetVertex(i), NMPoint(static_cast<float>(i / 2) + 0.25f, static_cast<float>(i % 2), -1.5f));
+    }
+
+    std::vector<SNMIntersection> xs =
+        mesh->LocalIntersect(NMRay(NMPoint(12345.5f, 0.5f, -5.0f), NMVector(0.0f, 0.0f, 1.0f)));
+    ASSERT_EQ(xs.size(), 1u);
+    EXPECT_EQ(xs[0].index / 2, 12345u);
+}
+
+// Scenario: Malformed statements report their line and column
+TEST_F(NMObjLoaderTest, Load_Errors)
+{
+    try
+    {
+        Load("v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 4\n");
+        FAIL() << "Expected NMSceneParseError";
+    }
+    catch (const NMSceneParseError& error)
+    {
+        EXPECT_EQ(error.GetLine(), 4u);
+        EXPECT_EQ(error.GetColumn(), 7u);
+    }
+
+    EXPECT_THROW(Load("v 0 0\n"), NMSceneParseError);
+    EXPECT_THROW(Load("v 0 0 x\n"), NMSceneParseError);
+    EXPECT_THROW(Load("v 0 0 0\nv 1 0 0\nf 1 2\n"), NMSceneParseError);
+    EXPECT_THROW(Load("v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 0\n"), NMSceneParseError);
+    EXPECT_THROW(Load("v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3x\n"), NMSceneParseError);
+}
+
+// Scenario: Loading a missing file
+TEST_F(NMObjLoaderTest, LoadFile_Missing)
+{
+    EXPECT_THROW(NMObjLoader::LoadFile("/nonexistent/mesh.obj"), std::runtime_error);
+}
+
+// Scenario: A scene's mesh statements load an OBJ file next to the scene once and instance it
+TEST_F(NMObjLoaderTest, SceneParser_Mesh)
+{
+    // Given
+    std::string directory = testing::TempDir();
+    {
+        std::ofstream obj(directory + "nm_obj_loader_test.obj");
+        obj << "v 0 1 0\nv -1 0 0\nv 1 0 0\nf 1 2 3\n";
+    }
+
+    // When
+    SNMScene scene = NMSceneParser::Parse("mesh nm_obj_loader_test.obj translate 0 0 5 reflective 0.5\n"
+                                          "mesh nm_obj_loader_test.obj translate 0 0 7\n",
+                                          directory + "scene.txt");
+
+    // Then
+    ASSERT_EQ(scene.world.GetObjectCount(), 2u);
+    const NMInstance* first = dynamic_cast<const NMInstance*>(scene.world.GetObject(0).get());
+    const NMInstance* second = dynamic_cast<const NMInstance*>(scene.world.GetObject(1).get());
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    EXPECT_EQ(first->GetGeometry(), second->GetGeometry());
+
+    const NMTriangleMesh* mesh = dynamic_cast<const NMTriangleMesh*>(first->GetGeometry().get());
+    ASSERT_NE(mesh, nullptr);
+    EXPECT_EQ(mesh->GetTriangleCount(), 1u);
+    EXPECT_EQ(first->GetTransform(), NMMatrix::Translation(0.0f, 0.0f, 5.0f));
+    EXPECT_FLOAT_EQ(first->GetMaterial().GetReflective(), 0.5f);
+    EXPECT_FLOAT_EQ(second->GetMaterial().GetReflective(), 0.0f);
+    EXPECT_THROW(NMSceneParser::Parse("mesh missing.obj\n", directory + "scene.txt"), NMSceneParseError);
+}
@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+
+#include "NMCore/Pattern/Stripe.hpp"
+#include "NMCore/Primitive/Plane.hpp"
+#include "NMCore/Primitive/Sphere.hpp"
+#include "NMCore/Scene/SceneCache.hpp"
+
+class NMSceneCacheTest : public testing::Test
+{
+protected:
+
+    std::string path = testing::TempDir() + "nm_scene_cache_test.nmsc";
+
+    virtual void TearDown() override { std::remove(path.c_str()); }
+
+    static SNMScene MakeScene()
+    {
+        return NMSceneParser::Parse(
+            "settings reflection_depth 3\n"
+            "camera width 64 height 32 fov 90 from 0 1.5 -5 to 0 1 0 up 0 1 0\n"
+            "light position -10 10 -10 color 1 0.5 1\n"
+            "pattern stripes stripe 1 0 0  0 0 1  scale 0.1 0.1 0.1\n"
+            "material floor color 1 0.9 0.9 specular 0 pattern stripes\n"
+            "plane material floor\n"
+            "sphere material floor diffuse 0.7 reflective 0.5 translate 1.5 0.5 -0.5\n"
+            "sphere material floor translate -1.5 0.5 -0.5 scale 0.5 0.5 0.5\n");
+    }
+};
+
+// Scenario: A baked scene loads back with the same objects, lights and camera
+TEST_F(NMSceneCacheTest, WriteAndLoad)
+{
+    // Given
+    SNMScene source = MakeScene();
+
+    // When
+    NMSceneCache::Write(source, path);
+    NMSceneCache cache(path);
+    SNMScene scene = cache.Instantiate();
+
+    // Then
+    EXPECT_TRUE(NMSceneCache::IsCacheFile(path));
+    EXPECT_EQ(cache.GetHeader().primitiveCount, 3);
+    EXPECT_EQ(cache.GetHeader().materialCount, 2);
+    EXPECT_EQ(cache.GetHeader().patternCount, 1);
+    EXPECT_EQ(cache.GetHeader().unboundedCount, 1);
+
+    EXPECT_EQ(scene.world.GetSettings().ReflectionTraceDepth, 3);
+    EXPECT_EQ(scene.camera.GetHSize(), 64);
+    EXPECT_EQ(scene.camera.GetVSize(), 32);
+    EXPECT_EQ(scene.camera.GetTransform(), source.camera.GetTransform());
+    ASSERT_EQ(scene.world.GetPointLightCount(), 1);
+    EXPECT_EQ(scene.world.GetPointLight(0).GetColor(), NMColor(1.0f, 0.5f, 1.0f));
+
+    ASSERT_EQ(scene.world.GetObjectCount(), 3);
+    EXPECT_TRUE(scene.world.HasBVH());
+    EXPECT_NE(dynamic_cast<NMPlane*>(scene.world.GetObject(0).get()), nullptr);
+    EXPECT_NE(dynamic_cast<NMSphere*>(scene.world.GetObject(1).get()), nullptr);
+    for (std::size_t i = 0; i < scene.world.GetObjectCount(); ++i)
+    {
+        EXPECT_EQ(*scene.world.GetObject(i), *source.world.GetObject(i));
+        EXPECT_EQ(scene.world.GetObject(i)->GetInverseTransform(), source.world.GetObject(i)->GetInverseTransform());
+        EXPECT_FLOAT_EQ(scene.world.GetObject(i)->GetMaterial().GetReflective(),
+                        source.world.GetObject(i)->GetMaterial().GetReflective());
+    }
+
+    // Objects sharing a pattern in the source share it after loading as well
+    std::shared_ptr<NMPatternBase> pattern = scene.world.GetObject(0)->GetMaterial().GetPattern();
+    ASSERT_NE(dynamic_cast<NMStripePattern*>(pattern.get()), nullptr);
+    EXPECT_EQ(pattern, scene.world.GetObject(2)->GetMaterial().GetPattern());
+    EXPECT_EQ(pattern->GetTransform(), NMMatrix::Scaling(0.1f, 0.1f, 0.1f));
+}
+
+// Scenario: A baked scene renders the same image as its source
+TEST_F(NMSceneCacheTest, Render_MatchesSource)
+{
+    // Given
+    SNMScene source = MakeScene();
+    NMSceneCache::Write(source, path);
+    SNMScene scene = NMSceneCache(path).Instantiate();
+
+    // When
+    NMCanvas expected = source.camera.Render(source.world, 1);
+    NMCanvas actual = scene.camera.Render(scene.world, 1);
+
+    // Then
+    for (std::size_t y = 0; y < expected.GetHeight(); ++y)
+    {
+        for (std::size_t x = 0; x < expected.GetWidth(); ++x)
+        {
+            ASSERT_EQ(actual.ReadPixel(x, y), expected.ReadPixel(x, y)) << x << ", " << y;
+        }
+    }
+}
+
+// Scenario: Baking a scene with objects or patterns the format has no record for
+TEST_F(NMSceneCacheTest, Write_Unsupported)
+{
+    // Given
+    SNMScene cube = NMSceneParser::Parse("sphere\ncube translate 3 0 0\n");
+    SNMScene group = NMSceneParser::Parse("group\n  sphere\nend\n");
+
+    struct SNMSolidPattern : public NMPatternBase
+    {
+        virtual NMColor ColorAt(const NMPoint& /* point */) const override { return NMColor(1.0f, 1.0f, 1.0f); }
+    };
+    SNMScene pattern;
+    std::shared_ptr<NMSphere> sphere = std::make_shared<NMSphere>();
+    NMMaterial material;
+    material.SetPattern(std::make_shared<SNMSolidPattern>());
+    sphere->SetMaterial(material);
+    pattern.world.AddObject(sphere);
+
+    // When
+    auto writeError = [this](const SNMScene& scene)
+    {
+        try
+        {
+            NMSceneCache::Write(scene, path);
+        }
+        catch (const std::runtime_error& err)
+        {
+            return std::string(err.what());
+        }
+        return std::string();
+    };
+
+    // Then
+    EXPECT_EQ(writeError(cube), "Scene cache does not support object 1");
+    EXPECT_EQ(writeError(group), "Scene cache does not support object 0");
+    EXPECT_EQ(writeError(pattern), "Scene cache does not support the pattern of object 0");
+}
+
+// Scenario: Loading a file that is not a cache
+TEST_F(NMSceneCacheTest, Load_Invalid)
+{
+    // Given
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "sphere translate 1 2 3\n";
+    }
+
+    // Then
+    EXPECT_FALSE(NMSceneCache::IsCacheFile(path));
+    EXPECT_THROW(NMSceneCache cache(path), std::runtime_error);
+    EXPECT_THROW(NMSceneCache cache(path + ".missing"), std::runtime_error);
+}
+
+// Scenario: Loading a truncated cache
+TEST_F(NMSceneCacheTest, Load_Truncated)
+{
+    // Given
+    NMSceneCache::Write(MakeScene(), path);
+    std::string bytes;
+    {
+        std::ifstream file(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 8));
+    }
+
+    // Then
+    EXPECT_THROW(NMSceneCache cache(path), std::runtime_error);
+}
+
+// Scenario: Loading a cache whose bounded primitives are listed but have no hierarchy over them
+TEST_F(NMSceneCacheTest, Load_BVHWithoutNodes)
+{
+    // Given
+    NMSceneCache::Write(MakeScene(), path);
+    SNMSceneCacheHeader header;
+    {
+        std::ifstream file(path, std::ios::binary);
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    }
+    header.bvhNodeCount = 0;
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+
+    // Then
+    ASSERT_GT(header.bvhIndexCount, 0u);
+    EXPECT_THROW(NMSceneCache cache(path), std::runtime_error);
+}
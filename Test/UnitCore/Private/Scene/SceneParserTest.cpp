@@ -0,0 +1,250 @@
+#include <gtest/gtest.h>
+
+#include "NMCore/Pattern/Stripe.hpp"
+#include "NMCore/Primitive/CSG.hpp"
+#include "NMCore/Primitive/Cone.hpp"
+#include "NMCore/Primitive/Cube.hpp"
+#include "NMCore/Primitive/Cylinder.hpp"
+#include "NMCore/Primitive/Disk.hpp"
+#include "NMCore/Primitive/Group.hpp"
+#include "NMCore/Primitive/Plane.hpp"
+#include "NMCore/Primitive/Sphere.hpp"
+#include "NMCore/Scene/SceneParser.hpp"
+
+class NMSceneParserTest : public testing::Test
+{
+};
+
+// Scenario: Parsing an empty scene
+TEST_F(NMSceneParserTest, Parse_Empty)
+{
+    // When
+    SNMScene scene = NMSceneParser::Parse("# nothing here\n\n   \n");
+
+    // Then
+    EXPECT_EQ(scene.world.GetObjectCount(), 0);
+    EXPECT_EQ(scene.world.GetPointLightCount(), 0);
+    EXPECT_EQ(scene.camera.GetHSize(), DEFAULT_SCENE_WIDTH);
+    EXPECT_EQ(scene.camera.GetVSize(), DEFAULT_SCENE_HEIGHT);
+}
+
+// Scenario: Parsing objects with transforms
+TEST_F(NMSceneParserTest, Parse_Objects)
+{
+    // When
+    SNMScene scene = NMSceneParser::Parse(
+        "sphere translate 1 2 3 scale 0.5 0.5 0.5\n"
+        "plane rotate_x 90  # a wall\n");
+
+    // Then
+    ASSERT_EQ(scene.world.GetObjectCount(), 2);
+    EXPECT_NE(dynamic_cast<NMSphere*>(scene.world.GetObject(0).get()), nullptr);
+    EXPECT_NE(dynamic_cast<NMPlane*>(scene.world.GetObject(1).get()), nullptr);
+    EXPECT_EQ(scene.world.GetObject(0)->GetTransform(),
+              NMMatrix::Translation(1.0f, 2.0f, 3.0f) * NMMatrix::Scaling(0.5f, 0.5f, 0.5f));
+    EXPECT_EQ(scene.world.GetObject(1)->GetTransform(), NMMatrix::RotationX(nmmath::halfPi));
+}
+
+// Scenario: Parsing named materials and patterns
+TEST_F(NMSceneParserTest, Parse_Materials)
+{
+    // When
+    SNMScene scene = NMSceneParser::Parse(
+        "pattern stripes stripe 1 0 0 0 0 1 scale 0.1 0.1 0.1\n"
+        "material red color 1 0 0 ambient 0.2 diffuse 0.5 specular 0.1 shininess 10 reflective 0.5\n"
+        "sphere material red\n"
+        "sphere material red pattern stripes diffuse 0.7\n");
+
+    // Then
+    ASSERT_EQ(scene.world.GetObjectCount(), 2);
+    const NMMaterial& red = scene.world.GetObject(0)->GetMaterial();
+    EXPECT_EQ(red.GetColor(), NMColor(1.0f, 0.0f, 0.0f));
+    EXPECT_FLOAT_EQ(red.GetAmbient(), 0.2f);
+    EXPECT_FLOAT_EQ(red.GetDiffuse(), 0.5f);
+    EXPECT_FLOAT_EQ(red.GetSpecular(), 0.1f);
+    EXPECT_FLOAT_EQ(red.GetShininess(), 10.0f);
+    EXPECT_FLOAT_EQ(red.GetReflective(), 0.5f);
+    EXPECT_EQ(red.GetPattern(), nullptr);
+
+    const NMMaterial& striped = scene.world.GetObject(1)->GetMaterial();
+    EXPECT_FLOAT_EQ(striped.GetDiffuse(), 0.7f);
+    EXPECT_FLOAT_EQ(striped.GetAmbient(), 0.2f);
+    NMStripePattern* pattern = dynamic_cast<NMStripePattern*>(striped.GetPattern().get());
+    ASSERT_NE(pattern, nullptr);
+    EXPECT_EQ(pattern->GetColorA(), NMColor(1.0f, 0.0f, 0.0f));
+    EXPECT_EQ(pattern->GetTransform(), NMMatrix::Scaling(0.1f, 0.1f, 0.1f));
+}
+
+// Scenario: Parsing lights, camera and settings
+TEST_F(NMSceneParserTest, Parse_LightCameraSettings)
+{
+    // When
+    SNMScene scene = NMSceneParser::Parse(
+        "settings reflection_depth 3\n"
+        "light position -10 10 -10 color 1 0.5 1e-1\n"
+        "camera width 200 height 125 fov 90 from 0 1.5 -5 to 0 1 0 up 0 1 0\n");
+
+    // Then
+    EXPECT_EQ(scene.world.GetSettings().ReflectionTraceDepth, 3);
+    ASSERT_EQ(scene.world.GetPointLightCount(), 1);
+    EXPECT_EQ(scene.world.GetPointLight(0).GetPosition(), NMPoint(-10.0f, 10.0f, -10.0f));
+    EXPECT_EQ(scene.world.GetPointLight(0).GetColor(), NMColor(1.0f, 0.5f, 0.1f));
+    EXPECT_EQ(scene.camera.GetHSize(), 200);
+    EXPECT_EQ(scene.camera.GetVSize(), 125);
+    EXPECT_FLOAT_EQ(scene.camera.GetPixelSize(), 0.01f);
+    EXPECT_EQ(scene.camera.GetTransform(), NMMatrix::ViewTransform(NMPoint(0.0f, 1.5f, -5.0f),
+                                                                   NMPoint(0.0f, 1.0f, 0.0f),
+                                                                   NMVector(0.0f, 1.0f, 0.0f)));
+}
+
+// Scenario: Numbers outside the range of their type are errors, long exponents included
+TEST_F(NMSceneParserTest, Parse_NumberRange)
+{
+    // When
+    SNMScene scene = NMSceneParser::Parse(
+        "light position 1e-99999999999999999999 0e99999999999999999999 -2.5E+0 color 1 1 1\n");
+
+    // Then
+    ASSERT_EQ(scene.world.GetPointLightCount(), 1);
+    EXPECT_EQ(scene.world.GetPointLight(0).GetPosition(), NMPoint(0.0f, 0.0f, -2.5f));
+
+    EXPECT_THROW(NMSceneParser::Parse("light position 1e99999999999999999999 0 0 color 1 1 1\n"), NMSceneParseError);
+    EXPECT_THROW(NMSceneParser::Parse("light position 1e39 0 0 color 1 1 1\n"), NMSceneParseError);
+    EXPECT_THROW(NMSceneParser::Parse("light position -1e39 0 0 color 1 1 1\n"), NMSceneParseError);
+    EXPECT_THROW(NMSceneParser::Parse("light position 1" + std::string(400, '0') + "e-390 0 0 color 1 1 1\n"),
+                 NMSceneParseError);
+    EXPECT_THROW(NMSceneParser::Parse("camera width 99999999999999999999999\n"), NMSceneParseError);
+    EXPECT_THROW(NMSceneParser::Parse("settings texture_cache_mb 18446744073709551615\n"), NMSceneParseError);
+}
+
+// Scenario: Errors report the line and column of the offending token
+TEST_F(NMSceneParserTest, Parse_ErrorLocation)
+{
+    try
+    {
+        NMSceneParser::Parse("sphere\nsphere translate 1 x 3\n", "test.scene");
+        FAIL() << "Expected NMSceneParseError";
+    }
+    catch (const NMSceneParseError& err)
+    {
+        EXPECT_EQ(err.GetLine(), 2);
+        EXPECT_EQ(err.GetColumn(), 20);
+        EXPECT_EQ(std::string(err.what()), "test.scene:2:20: expected a number but got 'x'");
+    }
+}
+
+// Scenario: Parsing the analytic primitives and their extents
+TEST_F(NMSceneParserTest, Parse_Primitives)
+{
+    // When
+    SNMScene scene = NMSceneParser::Parse(
+        "cube scale 2 2 2\n"
+        "cylinder minimum 0 maximum 2 closed\n"
+        "cone minimum -1 maximum 0\n"
+        "disk translate 0 1 0\n");
+
+    // Then
+    ASSERT_EQ(scene.world.GetObjectCount(), 4);
+    EXPECT_NE(dynamic_cast<NMCube*>(scene.world.GetObject(0).get()), nullptr);
+
+    const NMCylinder* cylinder = dynamic_cast<NMCylinder*>(scene.world.GetObject(1).get());
+    ASSERT_NE(cylinder, nullptr);
+    EXPECT_EQ(cylinder->GetMinimum(), 0.0f);
+    EXPECT_EQ(cylinder->GetMaximum(), 2.0f);
+    EXPECT_TRUE(cylinder->IsClosed());
+
+    const NMCone* cone = dynamic_cast<NMCone*>(scene.world.GetObject(2).get());
+    ASSERT_NE(cone, nullptr);
+    EXPECT_EQ(cone->GetMinimum(), -1.0f);
+    EXPECT_EQ(cone->GetMaximum(), 0.0f);
+    EXPECT_FALSE(cone->IsClosed());
+
+    EXPECT_NE(dynamic_cast<NMDisk*>(scene.world.GetObject(3).get()), nullptr);
+    EXPECT_THROW(NMSceneParser::Parse("cube minimum 0\n"), NMSceneParseError);
+}
+
+// Scenario: Objects between group and end are children of a group, groups nest
+TEST_F(NMSceneParserTest, Parse_Groups)
+{
+    // When
+    SNMScene scene = NMSceneParser::Parse(
+        "group translate 0 0 5\n"
+        "    sphere\n"
+        "    group rotate_y 90\n"
+        "        plane\n"
+        "    end\n"
+        "end\n"
+        "sphere\n");
+
+    // Then the groups are compiled into their children when added to the world
+    ASSERT_EQ(scene.world.GetObjectCount(), 2);
+    const NMGroup* group = dynamic_cast<NMGroup*>(scene.world.GetObject(0).get());
+    ASSERT_NE(group, nullptr);
+    EXPECT_EQ(group->GetTransform(), NMMatrix::Identity4x4());
+    ASSERT_EQ(group->GetChildCount(), 2);
+    ASSERT_NE(dynamic_cast<NMSphere*>(group->GetChild(0).get()), nullptr);
+    EXPECT_EQ(group->GetChild(0)->GetTransform(), NMMatrix::Translation(0.0f, 0.0f, 5.0f));
+
+    const NMGroup* inner = dynamic_cast<NMGroup*>(group->GetChild(1).get());
+    ASSERT_NE(inner, nullptr);
+    EXPECT_EQ(inner->GetTransform(), NMMatrix::Identity4x4());
+    ASSERT_EQ(inner->GetChildCount(), 1);
+    ASSERT_NE(dynamic_cast<NMPlane*>(inner->GetChild(0).get()), nullptr);
+    EXPECT_EQ(inner->GetChild(0)->GetTransform(),
+              NMMatrix::Translation(0.0f, 0.0f, 5.0f) * NMMatrix::RotationY(nmmath::halfPi));
+
+    EXPECT_THROW(NMSceneParser::Parse("group\nsphere\n"), NMSceneParseError);
+    EXPECT_THROW(NMSceneParser::Parse("sphere\nend\n"), NMSceneParseError);
+    EXPECT_THROW(NMSceneParser::Parse("group material m\nend\n"), NMSceneParseError);
+}
+
+// Scenario: Parsing CSG objects
+TEST_F(NMSceneParserTest, Parse_CSG)
+{
+    // When
+    SNMScene scene = NMSceneParser::Parse(
+        "csg difference translate 0 1 0\n"
+        "    cube\n"
+        "    csg union\n"
+        "        sphere scale 1.3 1.3 1.3\n"
+        "        cylinder\n"
+        "    end\n"
+        "end\n");
+
+    // Then
+    ASSERT_EQ(scene.world.GetObjectCount(), 1);
+    const NMCSG* csg = dynamic_cast<NMCSG*>(scene.world.GetObject(0).get());
+    ASSERT_NE(csg, nullptr);
+    EXPECT_EQ(csg->GetOperation(), ENMCSGOperation::Difference);
+    EXPECT_EQ(csg->GetTransform(), NMMatrix::Identity4x4());
+    ASSERT_NE(dynamic_cast<NMCube*>(csg->GetLeft().get()), nullptr);
+    EXPECT_EQ(csg->GetLeft()->GetTransform(), NMMatrix::Translation(0.0f, 1.0f, 0.0f));
+    const NMCSG* inner = dynamic_cast<NMCSG*>(csg->GetRight().get());
+    ASSERT_NE(inner, nullptr);
+    EXPECT_EQ(inner->GetOperation(), ENMCSGOperation::Union);
+    EXPECT_NE(dynamic_cast<NMCylinder*>(inner->GetRight().get()), nullptr);
+
+    EXPECT_THROW(NMSceneParser::Parse("csg union\nsphere\nend\n"), NMSceneParseError);
+    EXPECT_THROW(NMSceneParser::Parse("csg union\nsphere\nsphere\nsphere\nend\n"), NMSceneParseError);
+    EXPECT_THROW(NMSceneParser::Parse("csg xor\nsphere\nsphere\nend\n"), NMSceneParseError);
+    EXPECT_THROW(NMSceneParser::Parse("csg union\nsphere\nsphere\n"), NMSceneParseError);
+}
+
+// Scenario: Unknown statements, keys and names are errors
+TEST_F(NMSceneParserTest, Parse_Errors)
+{
+    EXPECT_THROW(NMSceneParser::Parse("torus\n"), NMSceneParseError);
+    EXPECT_THROW(NMSceneParser::Parse("sphere size 2\n"), NMSceneParseError);
+    EXPECT_THROW(NMSceneParser::Parse("sphere material missing\n"), NMSceneParseError);
+    EXPECT_THROW(NMSceneParser::Parse("material m pattern missing\n"), NMSceneParseError);
+    EXPECT_THROW(NMSceneParser::Parse("pattern p waves 1 1 1 0 0 0\n"), NMSceneParseError);
+    EXPECT_THROW(NMSceneParser::Parse("sphere translate 1 2\n"), NMSceneParseError);
+    EXPECT_THROW(NMSceneParser::Parse("camera width -5\n"), NMSceneParseError);
+    EXPECT_THROW(NMSceneParser::Parse("settings reflection_depth 300\n"), NMSceneParseError);
+}
+
+// Scenario: Reading a missing file
+TEST_F(NMSceneParserTest, ParseFile_Missing)
+{
+    EXPECT_THROW(NMSceneParser::ParseFile("/nonexistent/missing.scene"), std::runtime_error);
+}
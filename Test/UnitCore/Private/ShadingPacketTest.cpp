@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include "NMCore/Pattern/Stripe.hpp"
+#include "NMCore/Primitive/Sphere.hpp"
+#include "NMCore/ShadingPacket.hpp"
+
+class NMShadingPacketTest : public testing::Test
+{
+protected:
+
+    // Hits around a sphere seen from different eyes, so lanes cover lit, unlit, highlighted and shadowed cases
+    static SNMIntersectionState Hit(const NMSphere& sphere, uint32_t lane)
+    {
+        float angle = static_cast<float>(lane) * 0.7f;
+        NMPoint point(std::cos(angle), std::sin(angle) * 0.6f, std::sin(angle) * 0.8f);
+
+        SNMIntersectionState state;
+        state.object = &sphere;
+        state.point = point;
+        state.normalVector = sphere.NormalAt(point);
+        state.eyeVector = NMVector(0.3f * static_cast<float>(lane) - 1.0f, 0.5f, -1.0f).Normalized();
+        return state;
+    }
+
+    static std::vector<NMPointLight> Lights()
+    {
+        return {NMPointLight(NMPoint(-10.0f, 10.0f, -10.0f), NMColor(1.0f, 1.0f, 1.0f)),
+                NMPointLight(NMPoint(5.0f, -2.0f, 3.0f), NMColor(0.5f, 0.2f, 0.9f)),
+                NMPointLight(NMPoint(0.0f, 0.0f, -3.0f), NMColor(0.3f, 0.3f, 0.3f))};
+    }
+};
+
+// Scenario: A packet of hits is lit like each hit on its own, per light shadows included
+TEST_F(NMShadingPacketTest, Lighting_MatchesMaterial)
+{
+    // Given a shiny patterned sphere and a dull one, and hits alternating between them
+    NMSphere shiny;
+    NMMaterial shinyMaterial(NMColor(0.8f, 1.0f, 0.6f), 0.1f, 0.7f, 0.9f, 200.0f);
+    shinyMaterial.SetPattern<NMStripePattern>(NMColor(1.0f, 0.5f, 0.0f), NMColor(0.2f, 0.4f, 1.0f),
+                                              NMMatrix::Scaling(0.2f, 0.2f, 0.2f));
+    shiny.SetMaterial(shinyMaterial);
+    NMSphere dull;
+    dull.SetMaterial(NMMaterial(NMColor(0.3f, 0.6f, 0.9f), 0.2f, 0.9f, 0.3f, 10.0f));
+
+    std::vector<NMPointLight> lights = Lights();
+    SNMShadingPacket packet;
+    std::vector<SNMIntersectionState> states;
+    for (uint32_t lane = 0; lane < SHADING_PACKET_SIZE; ++lane)
+    {
+        states.push_back(Hit(lane % 2 == 0 ? shiny : dull, lane));
+        packet.Add(states.back(), lane % 3 == 0 ? 0x2u : 0u);
+    }
+
+    // When
+    float result[3][SHADING_PACKET_SIZE];
+    nmshade::Lighting(packet, lights, result);
+
+    // Then
+    for (uint32_t lane = 0; lane < SHADING_PACKET_SIZE; ++lane)
+    {
+        const SNMIntersectionState& state = states[lane];
+        NMColor expected;
+        for (std::size_t light = 0; light < lights.size(); ++light)
+        {
+            bool inShadow = lane % 3 == 0 && light == 1;
+            expected += state.object->GetMaterial().Lighting(*state.object, lights[light], state.point,
+                                                             state.eyeVector, state.normalVector, inShadow);
+        }
+
+        EXPECT_NEAR(result[0][lane], expected.GetRed(), 1e-5f) << "lane " << lane;
+        EXPECT_NEAR(result[1][lane], expected.GetGreen(), 1e-5f) << "lane " << lane;
+        EXPECT_NEAR(result[2][lane], expected.GetBlue(), 1e-5f) << "lane " << lane;
+    }
+}
+
+// Scenario: A partial packet lights its hits, a packet without lights is black
+TEST_F(NMShadingPacketTest, Lighting_PartialAndNoLights)
+{
+    // Given
+    NMSphere sphere;
+    SNMIntersectionState state = Hit(sphere, 1);
+    SNMShadingPacket packet;
+    packet.Add(state, 0u);
+
+    // When
+    float lit[3][SHADING_PACKET_SIZE];
+    float dark[3][SHADING_PACKET_SIZE];
+    nmshade::Lighting(packet, Lights(), lit);
+    nmshade::Lighting(packet, {}, dark);
+
+    // Then
+    NMColor expected;
+    for (const NMPointLight& light : Lights())
+    {
+        expected += sphere.GetMaterial().Lighting(sphere, light, state.point, state.eyeVector, state.normalVector,
+                                                  false);
+    }
+
+    EXPECT_EQ(packet.count, 1u);
+    EXPECT_EQ(NMColor(lit[0][0], lit[1][0], lit[2][0]), expected);
+    EXPECT_EQ(NMColor(dark[0][0], dark[1][0], dark[2][0]), NMColor(0.0f, 0.0f, 0.0f));
+}
+
+// Scenario: Shadows are one bit per light, so packets take at most 32 lights
+TEST_F(NMShadingPacketTest, Lighting_TooManyLights)
+{
+    // Given
+    SNMShadingPacket packet;
+    std::vector<NMPointLight> lights(SHADING_PACKET_MAX_LIGHTS + 1,
+                                     NMPointLight(NMPoint(0.0f, 0.0f, -5.0f), NMColor(1.0f, 1.0f, 1.0f)));
+    float result[3][SHADING_PACKET_SIZE];
+
+    // Then
+    EXPECT_THROW(nmshade::Lighting(packet, lights, result), std::runtime_error);
+}
@@ -0,0 +1,252 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <thread>
+
+#include "NMCore/Pattern/Texture.hpp"
+#include "NMCore/Scene/SceneParser.hpp"
+#include "NMCore/TextureCache.hpp"
+
+class NMTextureCacheTest : public testing::Test
+{
+protected:
+
+    // Every texel a different color, so reading the wrong tile or texel shows
+    static NMTexture Ramp(std::size_t width, std::size_t height)
+    {
+        NMCanvas canvas(width, height);
+        for (std::size_t y = 0; y < height; ++y)
+        {
+            for (std::size_t x = 0; x < width; ++x)
+            {
+                canvas.WritePixel(x, y, NMColor(static_cast<float>(x), static_cast<float>(y), 1.0f));
+            }
+        }
+
+        return NMTexture(canvas);
+    }
+
+    static std::string WriteRamp(const std::string& name, std::size_t width, std::size_t height)
+    {
+        std::string path = testing::TempDir() + name;
+        NMTextureCache::WriteFile(Ramp(width, height), path);
+        return path;
+    }
+
+    static void ExpectSameTexels(const NMTextureBase& expected, const NMTextureBase& actual)
+    {
+        ASSERT_EQ(actual.GetLevelCount(), expected.GetLevelCount());
+        for (std::size_t level = 0; level < expected.GetLevelCount(); ++level)
+        {
+            ASSERT_EQ(actual.GetLevelWidth(level), expected.GetLevelWidth(level));
+            ASSERT_EQ(actual.GetLevelHeight(level), expected.GetLevelHeight(level));
+            for (std::size_t y = 0; y < expected.GetLevelHeight(level); ++y)
+            {
+                for (std::size_t x = 0; x < expected.GetLevelWidth(level); ++x)
+                {
+                    NMColor expectedTexels[4];
+                    NMColor actualTexels[4];
+                    std::size_t x1 = (x + 1) % expected.GetLevelWidth(level);
+                    std::size_t y1 = (y + 1) % expected.GetLevelHeight(level);
+                    expected.ReadQuad(level, x, x1, y, y1, expectedTexels);
+                    actual.ReadQuad(level, x, x1, y, y1, actualTexels);
+                    for (std::size_t i = 0; i < 4; ++i)
+                    {
+                        ASSERT_EQ(actualTexels[i], expectedTexels[i]) << "level " << level << " at " << x << ", " << y;
+                    }
+                }
+            }
+        }
+    }
+};
+
+// Scenario: A tiled texture file reads back every texel of every level, including partial edge tiles
+TEST_F(NMTextureCacheTest, WriteFile_RoundTrip)
+{
+    // Given
+    std::string path = WriteRamp("nm_texture_cache_round_trip.nmtx", 70, 40);
+    std::shared_ptr<NMTextureCache> cache = std::make_shared<NMTextureCache>();
+
+    // When
+    NMCachedTexture texture(cache, path);
+
+    // Then
+    EXPECT_TRUE(NMTextureCache::IsTextureFile(path));
+    ExpectSameTexels(Ramp(70, 40), texture);
+    EXPECT_EQ(texture.SampleTrilinear(0.3f, 0.6f, 1.5f), Ramp(70, 40).SampleTrilinear(0.3f, 0.6f, 1.5f));
+}
+
+// Scenario: Opening files that are not valid tiled textures
+TEST_F(NMTextureCacheTest, Open_Invalid)
+{
+    // Given
+    std::shared_ptr<NMTextureCache> cache = std::make_shared<NMTextureCache>();
+    std::string imagePath = testing::TempDir() + "nm_texture_cache_image.ppm";
+    {
+        std::ofstream image(imagePath);
+        image << "P3\n1 1\n255\n1 2 3\n";
+    }
+
+    std::string truncatedPath = testing::TempDir() + "nm_texture_cache_truncated.nmtx";
+    {
+        std::string validPath = WriteRamp("nm_texture_cache_valid.nmtx", 40, 40);
+        std::ifstream valid(validPath, std::ios::binary);
+        std::ofstream truncated(truncatedPath, std::ios::binary);
+        std::vector<char> bytes(sizeof(SNMTextureFileHeader) + 100);
+        valid.read(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        truncated.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    // Then
+    EXPECT_FALSE(NMTextureCache::IsTextureFile(imagePath));
+    EXPECT_FALSE(NMTextureCache::IsTextureFile("/nonexistent/texture.nmtx"));
+    EXPECT_THROW(NMCachedTexture(cache, imagePath), std::runtime_error);
+    EXPECT_THROW(NMCachedTexture(cache, truncatedPath), std::runtime_error);
+    EXPECT_THROW(NMCachedTexture(cache, "/nonexistent/texture.nmtx"), std::runtime_error);
+}
+
+// Scenario: A texture larger than the cache is paged through it without exceeding its capacity
+TEST_F(NMTextureCacheTest, Pin_Bounded)
+{
+    // Given a cache of the minimum size and a texture of 16x16 tiles at full resolution
+    std::string path = WriteRamp("nm_texture_cache_bounded.nmtx", 512, 512);
+    std::shared_ptr<NMTextureCache> cache = std::make_shared<NMTextureCache>(0);
+    NMCachedTexture texture(cache, path);
+
+    // Then
+    EXPECT_EQ(cache->GetCapacity(), NMTextureCache::MIN_RESIDENT_TILES);
+    ExpectSameTexels(Ramp(512, 512), texture);
+    EXPECT_EQ(cache->GetResidentTiles(), cache->GetCapacity());
+
+    // Files opened twice are shared
+    NMCachedTexture again(cache, path);
+    EXPECT_EQ(again.SampleBilinear(0.1f, 0.2f), texture.SampleBilinear(0.1f, 0.2f));
+}
+
+// Scenario: Tile lookups are counted as hits and misses, misses with the bytes they read
+TEST_F(NMTextureCacheTest, Pin_Stats)
+{
+    // Given
+    std::string path = WriteRamp("nm_texture_cache_stats.nmtx", 64, 64);
+    std::shared_ptr<NMTextureCache> cache = std::make_shared<NMTextureCache>();
+    NMCachedTexture texture(cache, path);
+    SNMRenderCounters counters;
+
+    // When sampling the middle of one tile twice
+    nmstats::CurrentCounters() = &counters;
+    texture.SampleBilinear(0.25f, 0.75f);
+    texture.SampleBilinear(0.25f, 0.75f);
+    nmstats::CurrentCounters() = nullptr;
+
+    // Then
+    EXPECT_EQ(cache->GetResidentTiles(), 1u);
+    EXPECT_EQ(counters.textureTileMisses, NM_RENDER_STATS ? 1u : 0u);
+    EXPECT_EQ(counters.textureTileHits, NM_RENDER_STATS ? 1u : 0u);
+    EXPECT_EQ(counters.textureBytesRead, NM_RENDER_STATS ? TEXTURE_TILE_BYTES : 0u);
+}
+
+// Scenario: Workers sampling concurrently through a small cache all read the right texels
+TEST_F(NMTextureCacheTest, Pin_Concurrent)
+{
+    // Given
+    std::string path = WriteRamp("nm_texture_cache_concurrent.nmtx", 400, 300);
+    std::shared_ptr<NMTextureCache> cache = std::make_shared<NMTextureCache>(0);
+    std::shared_ptr<const NMCachedTexture> texture = std::make_shared<NMCachedTexture>(cache, path);
+    NMTexture reference = Ramp(400, 300);
+
+    // When
+    std::vector<int> mismatches(8, 0);
+    std::vector<std::thread> workers;
+    for (std::size_t worker = 0; worker < mismatches.size(); ++worker)
+    {
+        workers.emplace_back([&, worker]() {
+            for (int i = 0; i < 4000; ++i)
+            {
+                float u = static_cast<float>((i * 37 + static_cast<int>(worker) * 101) % 997) / 997.0f;
+                float v = static_cast<float>((i * 53 + static_cast<int>(worker) * 211) % 991) / 991.0f;
+                float lod = static_cast<float>(i % 5) * 0.5f;
+                if (!(texture->SampleTrilinear(u, v, lod) == reference.SampleTrilinear(u, v, lod)))
+                {
+                    ++mismatches[worker];
+                }
+            }
+        });
+    }
+
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+
+    // Then
+    for (int count : mismatches)
+    {
+        EXPECT_EQ(count, 0);
+    }
+    EXPECT_LE(cache->GetResidentTiles(), cache->GetCapacity());
+}
+
+// Scenario: A quad across a tile that cannot be read throws and leaves no tile pinned
+TEST_F(NMTextureCacheTest, ReadQuad_ReadError)
+{
+    // Given a file of two tiles side by side, cut after the first tile once it is open
+    std::string path = WriteRamp("nm_texture_cache_read_error.nmtx", 64, 32);
+    std::shared_ptr<NMTextureCache> cache = std::make_shared<NMTextureCache>(0);
+    NMCachedTexture texture(cache, path);
+    {
+        SNMTextureFileHeader header;
+        std::ifstream input(path, std::ios::binary);
+        input.read(reinterpret_cast<char*>(&header), sizeof(header));
+        std::vector<char> bytes(header.dataOffset + TEXTURE_TILE_BYTES);
+        input.seekg(0);
+        input.read(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        input.close();
+        std::ofstream(path, std::ios::binary | std::ios::trunc)
+            .write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    // When
+    NMColor texels[4];
+    EXPECT_THROW(texture.ReadQuad(0, 31, 32, 0, 1, texels), std::runtime_error);
+
+    // Then the first tile is still readable
+    texture.ReadQuad(0, 30, 31, 0, 1, texels);
+    EXPECT_EQ(texels[3], NMColor(31.0f, 1.0f, 1.0f));
+    EXPECT_EQ(cache->GetResidentTiles(), 1u);
+
+    // And it is evicted like any other tile when another texture pages through the whole cache
+    std::string otherPath = WriteRamp("nm_texture_cache_read_error_other.nmtx", 512, 512);
+    NMCachedTexture other(cache, otherPath);
+    ExpectSameTexels(Ramp(512, 512), other);
+
+    SNMRenderCounters counters;
+    nmstats::CurrentCounters() = &counters;
+    texture.ReadQuad(0, 30, 31, 0, 1, texels);
+    nmstats::CurrentCounters() = nullptr;
+    EXPECT_EQ(counters.textureTileMisses, NM_RENDER_STATS ? 1u : 0u);
+}
+
+// Scenario: Scene image patterns open tiled texture files through one texture cache
+TEST_F(NMTextureCacheTest, SceneParser_TiledTexture)
+{
+    // Given
+    std::string directory = testing::TempDir();
+    WriteRamp("nm_texture_cache_scene.nmtx", 64, 64);
+
+    // When
+    SNMScene scene = NMSceneParser::Parse("settings texture_cache_mb 1\n"
+                                          "pattern ramp image nm_texture_cache_scene.nmtx\n"
+                                          "material a pattern ramp\n"
+                                          "sphere material a\n",
+                                          directory + "scene.txt");
+
+    // Then
+    const NMTexturePattern* pattern =
+        dynamic_cast<const NMTexturePattern*>(scene.world.GetObject(0)->GetMaterial().GetPattern().get());
+    ASSERT_NE(pattern, nullptr);
+    EXPECT_NE(dynamic_cast<const NMCachedTexture*>(pattern->GetTexture().get()), nullptr);
+    EXPECT_THROW(NMSceneParser::Parse("pattern ramp image nm_texture_cache_scene.nmtx\n"
+                                      "settings texture_cache_mb 1\n",
+                                      directory + "scene.txt"),
+                 NMSceneParseError);
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include "NMCore/Texture.hpp"
+
+class NMTextureTest : public testing::Test
+{
+protected:
+
+    // Black and white columns: pixel x has the value x % 2
+    static NMCanvas Columns(std::size_t width, std::size_t height)
+    {
+        NMCanvas canvas(width, height);
+        for (std::size_t y = 0; y < height; ++y)
+        {
+            for (std::size_t x = 0; x < width; ++x)
+            {
+                float value = static_cast<float>(x % 2);
+                canvas.WritePixel(x, y, NMColor(value, value, value));
+            }
+        }
+
+        return canvas;
+    }
+};
+
+// Scenario: The mip pyramid halves each level down to a single pixel, rounding odd sizes up
+TEST_F(NMTextureTest, Pyramid_Sizes)
+{
+    // Given
+    NMTexture texture(Columns(6, 3));
+
+    // Then
+    ASSERT_EQ(texture.GetLevelCount(), 4u);
+    EXPECT_TRUE(texture.GetLevel(0).IsSize(6, 3));
+    EXPECT_TRUE(texture.GetLevel(1).IsSize(3, 2));
+    EXPECT_TRUE(texture.GetLevel(2).IsSize(2, 1));
+    EXPECT_TRUE(texture.GetLevel(3).IsSize(1, 1));
+    for (std::size_t level = 0; level < texture.GetLevelCount(); ++level)
+    {
+        EXPECT_EQ(texture.GetLevel(level).GetLayout(), ENMCanvasLayout::Tiled);
+    }
+}
+
+// Scenario: Each level averages 2x2 pixels of the level above
+TEST_F(NMTextureTest, Pyramid_Averages)
+{
+    // Given
+    NMCanvas image(2, 2);
+    image.WritePixel(0, 0, NMColor(1.0f, 0.0f, 0.0f));
+    image.WritePixel(1, 0, NMColor(0.0f, 1.0f, 0.0f));
+    image.WritePixel(0, 1, NMColor(0.0f, 0.0f, 1.0f));
+    image.WritePixel(1, 1, NMColor(1.0f, 1.0f, 1.0f));
+
+    // When
+    NMTexture texture(image);
+
+    // Then
+    ASSERT_EQ(texture.GetLevelCount(), 2u);
+    EXPECT_EQ(texture.GetLevel(0).ReadPixel(1, 0), NMColor(0.0f, 1.0f, 0.0f));
+    EXPECT_EQ(texture.GetLevel(1).ReadPixel(0, 0), NMColor(0.5f, 0.5f, 0.5f));
+    EXPECT_EQ(NMTexture(Columns(64, 64)).GetLevel(1).ReadPixel(7, 9), NMColor(0.5f, 0.5f, 0.5f));
+}
+
+// Scenario: An empty image cannot be a texture
+TEST_F(NMTextureTest, Create_Empty)
+{
+    EXPECT_THROW(NMTexture(NMCanvas(0, 4)), std::runtime_error);
+}
+
+// Scenario: Bilinear samples hit pixel centers exactly, blend between them and wrap around the edges
+TEST_F(NMTextureTest, SampleBilinear)
+{
+    // Given
+    NMTexture texture(Columns(4, 4));
+
+    // Then pixel centers are at (x + 0.5) / width, v runs bottom to top
+    EXPECT_EQ(texture.SampleBilinear(0.125f, 0.875f), NMColor(0.0f, 0.0f, 0.0f));
+    EXPECT_EQ(texture.SampleBilinear(0.375f, 0.125f), NMColor(1.0f, 1.0f, 1.0f));
+    EXPECT_EQ(texture.SampleBilinear(0.25f, 0.5f), NMColor(0.5f, 0.5f, 0.5f));
+    EXPECT_EQ(texture.SampleBilinear(0.3125f, 0.5f), NMColor(0.75f, 0.75f, 0.75f));
+
+    // Between the last and the first column
+    EXPECT_EQ(texture.SampleBilinear(0.0f, 0.5f), NMColor(0.5f, 0.5f, 0.5f));
+    EXPECT_EQ(texture.SampleBilinear(1.375f, 0.5f), texture.SampleBilinear(0.375f, 0.5f));
+    EXPECT_EQ(texture.SampleBilinear(-0.625f, -2.5f), texture.SampleBilinear(0.375f, 0.5f));
+}
+
+// Scenario: The image at a given position in the texture, including non-square images
+TEST_F(NMTextureTest, SampleBilinear_Orientation)
+{
+    // Given a 2x1 image, red on the left and blue on the right
+    NMCanvas image(2, 1);
+    image.WritePixel(0, 0, NMColor(1.0f, 0.0f, 0.0f));
+    image.WritePixel(1, 0, NMColor(0.0f, 0.0f, 1.0f));
+    NMTexture texture(image);
+
+    // Then
+    EXPECT_EQ(texture.SampleBilinear(0.25f, 0.3f), NMColor(1.0f, 0.0f, 0.0f));
+    EXPECT_EQ(texture.SampleBilinear(0.75f, 0.9f), NMColor(0.0f, 0.0f, 1.0f));
+}
+
+// Scenario: Trilinear samples blend the two levels around the level of detail, clamped to the pyramid
+TEST_F(NMTextureTest, SampleTrilinear)
+{
+    // Given
+    NMTexture texture(Columns(4, 4));
+    NMColor fine = texture.SampleBilinear(0.375f, 0.375f, 0);
+    NMColor coarse = texture.SampleBilinear(0.375f, 0.375f, 1);
+
+    // Then
+    EXPECT_EQ(texture.SampleTrilinear(0.375f, 0.375f, 0.0f), fine);
+    EXPECT_EQ(texture.SampleTrilinear(0.375f, 0.375f, -3.0f), fine);
+    EXPECT_EQ(texture.SampleTrilinear(0.375f, 0.375f, 0.25f), fine * 0.75f + coarse * 0.25f);
+    EXPECT_EQ(texture.SampleTrilinear(0.375f, 0.375f, 10.0f), NMColor(0.5f, 0.5f, 0.5f));
+}
+
+// Scenario: The level of detail of a footprint is the level whose pixels are that wide
+TEST_F(NMTextureTest, LevelOfDetail)
+{
+    // Given
+    NMTexture texture(Columns(64, 64));
+
+    // Then
+    EXPECT_FLOAT_EQ(texture.LevelOfDetail(0.0f), 0.0f);
+    EXPECT_FLOAT_EQ(texture.LevelOfDetail(1.0f / 128.0f), 0.0f);
+    EXPECT_FLOAT_EQ(texture.LevelOfDetail(1.0f / 64.0f), 0.0f);
+    EXPECT_FLOAT_EQ(texture.LevelOfDetail(4.0f / 64.0f), 2.0f);
+    EXPECT_FLOAT_EQ(texture.LevelOfDetail(1.0f), 6.0f);
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <memory>
+
+#include "NMCore/ThreadPool.hpp"
+
+class ThreadPoolTest : public testing::Test
+{
+};
+
+// Scenario: Wait blocks until every queued task has run
+TEST_F(ThreadPoolTest, Wait)
+{
+    // Given
+    ThreadPool pool(4);
+    std::atomic<int> count(0);
+
+    // When
+    for (int i = 0; i < 100; ++i)
+    {
+        pool.Enqueue([&count] { ++count; });
+    }
+    pool.Wait();
+
+    // Then
+    EXPECT_EQ(count, 100);
+    EXPECT_EQ(pool.GetThreadCount(), 4);
+}
+
+// Scenario: A pool can be reused after waiting
+TEST_F(ThreadPoolTest, Wait_Reuse)
+{
+    // Given
+    ThreadPool pool(2);
+    std::atomic<int> count(0);
+
+    // When
+    pool.Enqueue([&count] { ++count; });
+    pool.Wait();
+    pool.Enqueue([&count] { ++count; });
+    pool.Wait();
+
+    // Then
+    EXPECT_EQ(count, 2);
+}
+
+// Scenario: Wait returns immediately on an idle pool
+TEST_F(ThreadPoolTest, Wait_Idle)
+{
+    // Given
+    ThreadPool pool(2);
+
+    // When
+    pool.Wait();
+
+    // Then
+    SUCCEED();
+}
+
+// Scenario: Cancel drops the queued tasks at once, without running them, and the pool stays usable
+TEST_F(ThreadPoolTest, Cancel)
+{
+    // Given a busy pool with a long queue
+    ThreadPool pool(1);
+    std::promise<void> started;
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    pool.Enqueue([&started, released]
+    {
+        started.set_value();
+        released.wait();
+    });
+    started.get_future().wait();
+
+    std::shared_ptr<int> captured = std::make_shared<int>(0);
+    std::atomic<int> count(0);
+    for (int i = 0; i < 10000; ++i)
+    {
+        pool.Enqueue([captured, &count] { ++count; });
+    }
+
+    // When
+    std::size_t dropped = pool.Cancel();
+
+    // Then the queued tasks are freed before the running one finishes
+    EXPECT_EQ(dropped, 10000u);
+    EXPECT_EQ(captured.use_count(), 1);
+
+    release.set_value();
+    pool.Wait();
+    EXPECT_EQ(count, 0);
+
+    pool.Enqueue([&count] { ++count; });
+    pool.Wait();
+    EXPECT_EQ(count, 1);
+}
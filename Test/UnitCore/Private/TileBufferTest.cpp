@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "NMCore/TileBuffer.hpp"
+
+class NMTileBufferTest : public testing::Test
+{
+};
+
+// Scenario: Splitting an image into tiles covers every pixel once
+TEST_F(NMTileBufferTest, Split)
+{
+    // When
+    std::vector<SNMTile> tiles = SNMTile::Split(40, 20, 16);
+
+    // Then
+    ASSERT_EQ(tiles.size(), 6);
+    EXPECT_EQ(tiles[0].x, 0);
+    EXPECT_EQ(tiles[0].width, 16);
+    EXPECT_EQ(tiles[2].x, 32);
+    EXPECT_EQ(tiles[2].width, 8);
+    EXPECT_EQ(tiles[5].y, 16);
+    EXPECT_EQ(tiles[5].height, 4);
+
+    std::size_t area = 0;
+    for (const SNMTile& tile : tiles)
+    {
+        area += tile.Area();
+    }
+    EXPECT_EQ(area, 40 * 20);
+}
+
+// Scenario: A tile buffer is cache line aligned
+TEST_F(NMTileBufferTest, Alignment)
+{
+    // Given
+    NMTileBuffer buffer;
+
+    // Then
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&buffer) % CACHE_LINE_SIZE, 0);
+}
+
+// Scenario: Flushing a tile buffer writes the tile into the canvas
+TEST_F(NMTileBufferTest, FlushTo)
+{
+    // Given
+    NMCanvas canvas(20, 20, DEFAULT_COLOR, ENMCanvasLayout::Tiled);
+    NMTileBuffer buffer(SNMTile(16, 16, 4, 4));
+    for (std::size_t y = 0; y < 4; ++y)
+    {
+        for (std::size_t x = 0; x < 4; ++x)
+        {
+            buffer.Set(x, y, NMColor(static_cast<float>(x), static_cast<float>(y), 1.0f));
+        }
+    }
+
+    // When
+    buffer.FlushTo(canvas);
+
+    // Then
+    EXPECT_EQ(canvas.ReadPixel(16, 16), NMColor(0.0f, 0.0f, 1.0f));
+    EXPECT_EQ(canvas.ReadPixel(19, 17), NMColor(3.0f, 1.0f, 1.0f));
+    EXPECT_EQ(canvas.ReadPixel(15, 16), NMColor(0.0f, 0.0f, 0.0f));
+}
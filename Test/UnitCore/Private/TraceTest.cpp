@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <thread>
+
+#include "NMCore/Camera.hpp"
+#include "NMCore/Trace.hpp"
+
+class NMTraceTest : public testing::Test
+{
+protected:
+
+    void TearDown() override { NMTrace::Stop(); }
+};
+
+// Scenario: Nothing is recorded while the trace is disabled
+TEST_F(NMTraceTest, Disabled)
+{
+    // Given
+    NMTrace::Start();
+    NMTrace::Stop();
+
+    // When
+    {
+        NMTraceScope scope("Scope", "test");
+    }
+    NMTrace::Record("Event", "test", 0, 10);
+
+    // Then
+    EXPECT_FALSE(NMTrace::IsEnabled());
+    EXPECT_EQ(NMTrace::GetEventCount(), 0u);
+}
+
+// Scenario: A scope records one event with its duration
+TEST_F(NMTraceTest, Scope)
+{
+    // Given
+    NMTrace::Start();
+
+    // When
+    {
+        NMTraceScope scope("Scope", "test", 7);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    NMTrace::Stop();
+    std::ostringstream json;
+    NMTrace::WriteChromeJSON(json);
+
+    // Then
+    EXPECT_EQ(NMTrace::GetEventCount(), 1u);
+    EXPECT_NE(json.str().find("\"name\":\"Scope\",\"cat\":\"test\",\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(json.str().find("\"args\":{\"id\":7}"), std::string::npos);
+    EXPECT_EQ(json.str().find("\"dur\":0.000"), std::string::npos);
+}
+
+// Scenario: A full buffer overwrites its oldest events
+TEST_F(NMTraceTest, RingBufferWraps)
+{
+    // Given
+    NMTrace::Start(4);
+
+    // When
+    for (int64_t i = 0; i < 10; ++i)
+    {
+        NMTrace::Record("Event", "test", static_cast<uint64_t>(i), static_cast<uint64_t>(i + 1), i);
+    }
+    NMTrace::Stop();
+    std::ostringstream json;
+    NMTrace::WriteChromeJSON(json);
+
+    // Then
+    EXPECT_EQ(NMTrace::GetEventCount(), 4u);
+    EXPECT_EQ(NMTrace::GetDroppedCount(), 6u);
+    EXPECT_EQ(json.str().find("\"id\":5}"), std::string::npos);
+    EXPECT_NE(json.str().find("\"id\":6}"), std::string::npos);
+    EXPECT_NE(json.str().find("\"id\":9}"), std::string::npos);
+}
+
+// Scenario: Every thread gets its own named timeline
+TEST_F(NMTraceTest, ThreadNames)
+{
+    // Given
+    NMTrace::Start();
+
+    // When
+    std::thread worker(
+        []
+        {
+            NMTrace::SetThreadName("Test \"worker\"");
+            NMTraceScope scope("Work", "test");
+        });
+    worker.join();
+    NMTrace::Stop();
+    std::ostringstream json;
+    NMTrace::WriteChromeJSON(json);
+
+    // Then
+    EXPECT_NE(json.str().find("\"args\":{\"name\":\"Test \\\"worker\\\"\"}"), std::string::npos);
+    EXPECT_NE(json.str().find("\"name\":\"Work\""), std::string::npos);
+}
+
+// Scenario: Rendering records the frame, the queue waits and every tile
+TEST_F(NMTraceTest, Render)
+{
+    // Given
+    NMWorld world = NMWorld::Default();
+    NMCamera camera(40, 20, nmmath::halfPi);
+    ThreadPool pool(2);
+    NMCanvas canvas(40, 20);
+    NMTrace::Start();
+
+    // When
+    camera.Render(world, &canvas, pool);
+    NMTrace::Stop();
+    std::ostringstream json;
+    NMTrace::WriteChromeJSON(json);
+
+    // Then
+    std::string trace = json.str();
+    std::size_t tiles = 0;
+    for (std::size_t at = trace.find("\"name\":\"Tile\""); at != std::string::npos;
+         at = trace.find("\"name\":\"Tile\"", at + 1))
+    {
+        ++tiles;
+    }
+    EXPECT_EQ(tiles, SNMTile::Split(40, 20).size());
+    EXPECT_NE(trace.find("\"name\":\"Frame\""), std::string::npos);
+    EXPECT_NE(trace.find("\"name\":\"QueueWait\""), std::string::npos);
+    EXPECT_NE(trace.find("\"name\":\"Task\""), std::string::npos);
+    EXPECT_NE(trace.find("\"name\":\"Pool worker "), std::string::npos);
+}
+
+// Scenario: Threads that exit hand their buffer to the next thread instead of allocating new ones
+TEST_F(NMTraceTest, ExitedThreadsReuseBuffers)
+{
+    // Given
+    NMTrace::Start(64);
+
+    // When one short lived thread after the other records an event
+    for (int i = 0; i < 20; ++i)
+    {
+        std::thread worker([] { NMTraceScope scope("Work", "test"); });
+        worker.join();
+    }
+    NMTrace::Stop();
+    std::ostringstream json;
+    NMTrace::WriteChromeJSON(json);
+
+    // Then all events are kept on one reused timeline
+    EXPECT_EQ(NMTrace::GetEventCount(), 20u);
+    std::string trace = json.str();
+    std::size_t firstTid = trace.find("\"tid\":");
+    ASSERT_NE(firstTid, std::string::npos);
+    std::string tid = trace.substr(firstTid, trace.find(',', firstTid) - firstTid);
+    std::size_t events = 0;
+    for (std::size_t at = trace.find(tid + ","); at != std::string::npos; at = trace.find(tid + ",", at + 1))
+    {
+        ++events;
+    }
+    EXPECT_EQ(events, 20u);
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include "NMCore/Primitive/Group.hpp"
 #include "NMCore/Primitive/Plane.hpp"
 #include "NMCore/RT/Intersection.hpp"
 #include "NMCore/World.hpp"
@@ -88,6 +89,98 @@ TEST_F(NMWorldTest, IntersectWorld)
     ASSERT_FLOAT_EQ(intersections[3].t, 6.0f);
 }
 
+// Scenario: Intersect a world through its bounding volume hierarchy
+TEST_F(NMWorldTest, IntersectWorld_BVH)
+{
+    // Given
+    std::shared_ptr<NMPrimitiveBase> floor = std::make_shared<NMPlane>();
+    floor->SetTransform(NMMatrix::Translation(0.0f, -1.0f, 0.0f));
+    defaultWorld.AddObject(floor);
+
+    std::shared_ptr<NMPrimitiveBase> aside = std::make_shared<NMSphere>();
+    aside->SetTransform(NMMatrix::Translation(10.0f, 0.0f, 0.0f));
+    defaultWorld.AddObject(aside);
+
+    // When
+    defaultWorld.BuildBVH();
+    SNMIntersectionList intersections =
+        defaultWorld.Intersect(NMRay(NMPoint(0.0f, 0.0f, -5.0f), NMVector(0.0f, 0.0f, 1.0f)));
+
+    // Then
+    ASSERT_TRUE(defaultWorld.HasBVH());
+    ASSERT_EQ(defaultWorld.GetUnboundedObjects(), std::vector<uint32_t>({2}));
+    ASSERT_EQ(intersections.Size(), 4);
+    ASSERT_FLOAT_EQ(intersections[0].t, 4.0f);
+    ASSERT_FLOAT_EQ(intersections[1].t, 4.5f);
+    ASSERT_FLOAT_EQ(intersections[2].t, 5.5f);
+    ASSERT_FLOAT_EQ(intersections[3].t, 6.0f);
+
+    SNMIntersectionList floorHits =
+        defaultWorld.Intersect(NMRay(NMPoint(10.0f, 5.0f, 0.0f), NMVector(0.0f, -1.0f, 0.0f)));
+    ASSERT_EQ(floorHits.Size(), 3);
+}
+
+// Scenario: Adding objects after building the hierarchy falls back to testing every object
+TEST_F(NMWorldTest, IntersectWorld_StaleBVH)
+{
+    // Given
+    defaultWorld.BuildBVH();
+    std::shared_ptr<NMPrimitiveBase> added = std::make_shared<NMSphere>();
+    added->SetTransform(NMMatrix::Translation(0.0f, 0.0f, 10.0f));
+    defaultWorld.AddObject(added);
+
+    // When
+    SNMIntersectionList intersections =
+        defaultWorld.Intersect(NMRay(NMPoint(0.0f, 0.0f, -5.0f), NMVector(0.0f, 0.0f, 1.0f)));
+
+    // Then
+    ASSERT_FALSE(defaultWorld.HasBVH());
+    ASSERT_EQ(intersections.Size(), 6);
+}
+
+// Scenario: Moving an object after building the hierarchy falls back to testing every object
+TEST_F(NMWorldTest, IntersectWorld_MovedObject)
+{
+    // Given
+    defaultWorld.BuildBVH();
+
+    // When the outer sphere moves out of the ray's way
+    defaultWorld.GetObject(0)->SetTransform(NMMatrix::Translation(10.0f, 0.0f, 0.0f));
+    SNMIntersectionList intersections =
+        defaultWorld.Intersect(NMRay(NMPoint(0.0f, 0.0f, -5.0f), NMVector(0.0f, 0.0f, 1.0f)));
+
+    // Then
+    ASSERT_FALSE(defaultWorld.HasBVH());
+    ASSERT_EQ(intersections.Size(), 2);
+    ASSERT_FLOAT_EQ(intersections[0].t, 4.5f);
+
+    defaultWorld.BuildBVH();
+    ASSERT_TRUE(defaultWorld.HasBVH());
+    ASSERT_EQ(defaultWorld.Intersect(NMRay(NMPoint(10.0f, 0.0f, -5.0f), NMVector(0.0f, 0.0f, 1.0f))).Size(), 2);
+}
+
+// Scenario: Moving a grouped primitive of another world keeps the hierarchy, moving one of this world drops it
+TEST_F(NMWorldTest, IntersectWorld_MovedObjectOfOtherWorld)
+{
+    // Given
+    std::shared_ptr<NMSphere> child = std::make_shared<NMSphere>();
+    std::shared_ptr<NMGroup> group = std::make_shared<NMGroup>();
+    group->AddChild(child);
+    NMWorld otherWorld;
+    otherWorld.AddObject(group);
+    otherWorld.BuildBVH();
+    defaultWorld.BuildBVH();
+    uint64_t revision = defaultWorld.GetGeometryRevision();
+
+    // When
+    child->SetTransform(NMMatrix::Translation(10.0f, 0.0f, 0.0f));
+
+    // Then
+    EXPECT_TRUE(defaultWorld.HasBVH());
+    EXPECT_EQ(defaultWorld.GetGeometryRevision(), revision);
+    EXPECT_FALSE(otherWorld.HasBVH());
+}
+
 // Scenario: Shading an intersection
 TEST_F(NMWorldTest, ShadingIntersection)
 {
@@ -1416,3 +1416,25 @@ TEST_F(NMMatrixTest, ViewTransform_Arbitrary)
         0.00000f,  0.00000f,  0.00000f,  1.00000f,
     }));
 }
+
+TEST_F(NMMatrixTest, Creation_TooLarge)
+{
+    // Then
+    ASSERT_THROW(NMMatrix(5, 4), std::invalid_argument);
+    ASSERT_THROW(NMMatrix(4, 5, 1.0f), std::invalid_argument);
+}
+
+TEST_F(NMMatrixTest, Creation_WithPointer)
+{
+    // Given
+    const float values[16] = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f,
+                              9.0f, 10.0f, 11.0f, 12.0f, 13.0f, 14.0f, 15.0f, 16.0f};
+
+    // When
+    NMMatrix matrix(4, 4, values, 16);
+
+    // Then
+    ASSERT_EQ(matrix.Get(1, 0), 2.0f);
+    ASSERT_EQ(matrix.Get(0, 3), 13.0f);
+    ASSERT_EQ(matrix.GetData()[15], 16.0f);
+}
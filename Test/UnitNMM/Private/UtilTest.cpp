@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+
 #include "NMM/Util.hpp"
 
 class NMUtilTest : public testing::Test
@@ -33,3 +36,44 @@ TEST_F(NMUtilTest, Clamp_Middle)
     // Then
     EXPECT_EQ(nmmath::Clamp(5, 0, 10), 5);
 }
+
+TEST_F(NMUtilTest, FastLog2)
+{
+    // Then
+    EXPECT_EQ(nmmath::FastLog2(1.0f), 0.0f);
+    EXPECT_EQ(nmmath::FastLog2(8.0f), 3.0f);
+    EXPECT_EQ(nmmath::FastLog2(0.25f), -2.0f);
+    for (float x = 1e-6f; x < 1e6f; x *= 1.37f)
+    {
+        EXPECT_NEAR(nmmath::FastLog2(x), std::log2(x), 1e-6f * std::max(1.0f, std::abs(std::log2(x)))) << x;
+    }
+}
+
+TEST_F(NMUtilTest, FastExp2)
+{
+    // Then
+    EXPECT_EQ(nmmath::FastExp2(0.0f), 1.0f);
+    EXPECT_EQ(nmmath::FastExp2(-3.0f), 0.125f);
+    EXPECT_EQ(nmmath::FastExp2(-1000.0f), 0.0f);
+    EXPECT_EQ(nmmath::FastExp2(-126.0f), 0.0f);
+    for (float y = -120.0f; y < 120.0f; y += 0.731f)
+    {
+        EXPECT_NEAR(nmmath::FastExp2(y) / std::exp2(y), 1.0f, 1e-6f) << y;
+    }
+}
+
+// The specular exponents of lighting, compared with std::pow in double precision
+TEST_F(NMUtilTest, FastPow)
+{
+    // Then
+    EXPECT_EQ(nmmath::FastPow(1.0f, 200.0f), 1.0f);
+    for (float shininess : {1.0f, 10.0f, 50.0f, 200.0f, 300.0f})
+    {
+        for (float base = 0.001f; base <= 1.0f; base += 0.0037f)
+        {
+            float expected = static_cast<float>(std::pow(static_cast<double>(base), static_cast<double>(shininess)));
+            EXPECT_NEAR(nmmath::FastPow(base, shininess), expected, 2e-5f * expected + 1e-37f)
+                << base << "^" << shininess;
+        }
+    }
+}
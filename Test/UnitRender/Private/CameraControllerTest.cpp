@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "NMRender/CameraController.hpp"
+
+class NMCameraControllerTest : public testing::Test
+{
+protected:
+
+    static constexpr float TOLERANCE = 1e-4f;
+
+    static void ExpectNear(const NMPoint& actual, const NMPoint& expected)
+    {
+        EXPECT_NEAR(actual.GetX(), expected.GetX(), TOLERANCE);
+        EXPECT_NEAR(actual.GetY(), expected.GetY(), TOLERANCE);
+        EXPECT_NEAR(actual.GetZ(), expected.GetZ(), TOLERANCE);
+    }
+
+    static void ExpectNear(const NMVector& actual, const NMVector& expected)
+    {
+        EXPECT_NEAR(actual.GetX(), expected.GetX(), TOLERANCE);
+        EXPECT_NEAR(actual.GetY(), expected.GetY(), TOLERANCE);
+        EXPECT_NEAR(actual.GetZ(), expected.GetZ(), TOLERANCE);
+    }
+};
+
+constexpr float NMCameraControllerTest::TOLERANCE;
+
+// Scenario: Looking from one point at another
+TEST_F(NMCameraControllerTest, LookAt)
+{
+    // Given
+    NMCameraController controller;
+
+    // When
+    controller.LookAt(NMPoint(0.0f, 3.0f, -4.0f), NMPoint(0.0f, 0.0f, 0.0f));
+
+    // Then
+    EXPECT_EQ(controller.GetMode(), ENMCameraMode::Orbit);
+    EXPECT_FLOAT_EQ(controller.GetDistance(), 5.0f);
+    ExpectNear(controller.GetTarget(), NMPoint(0.0f, 0.0f, 0.0f));
+    ExpectNear(controller.GetEye(), NMPoint(0.0f, 3.0f, -4.0f));
+    ExpectNear(controller.GetForward(), NMVector(0.0f, -0.6f, 0.8f));
+}
+
+// Scenario: Taking over the view of a camera transform reproduces the transform
+TEST_F(NMCameraControllerTest, SetViewTransform)
+{
+    // Given
+    NMCameraController controller;
+    NMMatrix view =
+        NMMatrix::ViewTransform(NMPoint(2.0f, 1.5f, -5.0f), NMPoint(0.0f, 1.0f, 0.0f), NMVector(0.0f, 1.0f, 0.0f));
+
+    // When
+    controller.SetViewTransform(view);
+
+    // Then the eye is kept and the target lies on the view ray
+    NMMatrix result = controller.GetViewTransform();
+    for (std::size_t row = 0; row < 4; ++row)
+    {
+        for (std::size_t column = 0; column < 4; ++column)
+        {
+            EXPECT_NEAR(result.Get(row, column), view.Get(row, column), TOLERANCE) << row << ", " << column;
+        }
+    }
+    ExpectNear(controller.GetEye(), NMPoint(2.0f, 1.5f, -5.0f));
+}
+
+// Scenario: Orbiting turns the eye around the target, flying turns the view around the eye
+TEST_F(NMCameraControllerTest, Rotate)
+{
+    // Given
+    NMCameraController orbit;
+    orbit.LookAt(NMPoint(0.0f, 0.0f, -5.0f), NMPoint(0.0f, 0.0f, 0.0f));
+    NMCameraController fly = orbit;
+    fly.SetMode(ENMCameraMode::Fly);
+
+    // When
+    orbit.Rotate(nmmath::halfPi, 0.0f);
+    fly.Rotate(nmmath::halfPi, 0.0f);
+
+    // Then both turn left, towards -x
+    ExpectNear(orbit.GetTarget(), NMPoint(0.0f, 0.0f, 0.0f));
+    ExpectNear(orbit.GetEye(), NMPoint(5.0f, 0.0f, 0.0f));
+    ExpectNear(orbit.GetForward(), NMVector(-1.0f, 0.0f, 0.0f));
+    ExpectNear(fly.GetEye(), NMPoint(0.0f, 0.0f, -5.0f));
+    ExpectNear(fly.GetForward(), NMVector(-1.0f, 0.0f, 0.0f));
+    EXPECT_FLOAT_EQ(fly.GetDistance(), 5.0f);
+}
+
+// Scenario: The pitch stops just short of looking straight up or down
+TEST_F(NMCameraControllerTest, Rotate_PitchLimit)
+{
+    // Given
+    NMCameraController controller;
+
+    // When
+    controller.Rotate(0.0f, 10.0f);
+    NMVector up = controller.GetForward();
+    controller.Rotate(0.0f, -20.0f);
+    NMVector down = controller.GetForward();
+
+    // Then the view stays well defined
+    EXPECT_GT(up.GetY(), 0.99f);
+    EXPECT_LT(up.GetY(), 1.0f);
+    EXPECT_LT(down.GetY(), -0.99f);
+    EXPECT_GT(down.GetY(), -1.0f);
+    EXPECT_FALSE(std::isnan(controller.GetViewTransform().Get(0, 0)));
+}
+
+// Scenario: Moving pans the orbit target, or flies the eye along the view axes
+TEST_F(NMCameraControllerTest, Move)
+{
+    // Given
+    NMCameraController orbit;
+    orbit.LookAt(NMPoint(0.0f, 0.0f, -5.0f), NMPoint(0.0f, 0.0f, 0.0f));
+    NMCameraController fly = orbit;
+    fly.SetMode(ENMCameraMode::Fly);
+
+    // When
+    orbit.Move(1.0f, 2.0f, 3.0f);
+    fly.Move(1.0f, 2.0f, 3.0f);
+
+    // Then orbiting moves the target right (+x, see NMMatrix::ViewTransform()) and up and the eye closer
+    ExpectNear(orbit.GetTarget(), NMPoint(2.0f, 3.0f, 0.0f));
+    EXPECT_FLOAT_EQ(orbit.GetDistance(), 4.0f);
+    ExpectNear(fly.GetEye(), NMPoint(2.0f, 3.0f, -4.0f));
+    EXPECT_FLOAT_EQ(fly.GetDistance(), 5.0f);
+}
+
+// Scenario: Zooming scales the orbit distance, but never through the target, or flies forward
+TEST_F(NMCameraControllerTest, Zoom)
+{
+    // Given
+    NMCameraController orbit;
+    orbit.LookAt(NMPoint(0.0f, 0.0f, -5.0f), NMPoint(0.0f, 0.0f, 0.0f));
+    NMCameraController fly = orbit;
+    fly.SetMode(ENMCameraMode::Fly);
+
+    // When
+    orbit.Zoom(0.5f);
+    fly.Zoom(0.5f);
+
+    // Then
+    EXPECT_FLOAT_EQ(orbit.GetDistance(), 2.5f);
+    ExpectNear(orbit.GetEye(), NMPoint(0.0f, 0.0f, -2.5f));
+    ExpectNear(fly.GetEye(), NMPoint(0.0f, 0.0f, -2.5f));
+    EXPECT_FLOAT_EQ(fly.GetDistance(), 5.0f);
+
+    orbit.Zoom(0.0f);
+    EXPECT_GT(orbit.GetDistance(), 0.0f);
+    orbit.Move(100.0f, 0.0f, 0.0f);
+    EXPECT_GT(orbit.GetDistance(), 0.0f);
+}
+
+// Scenario: Switching between orbiting and flying does not move the camera
+TEST_F(NMCameraControllerTest, SetMode)
+{
+    // Given
+    NMCameraController controller;
+    controller.LookAt(NMPoint(1.0f, 2.0f, -5.0f), NMPoint(0.0f, 1.0f, 0.0f));
+    NMPoint eye = controller.GetEye();
+
+    // When
+    controller.SetMode(ENMCameraMode::Fly);
+
+    // Then
+    EXPECT_EQ(controller.GetMode(), ENMCameraMode::Fly);
+    ExpectNear(controller.GetEye(), eye);
+    ExpectNear(controller.GetTarget(), NMPoint(0.0f, 1.0f, 0.0f));
+}
+
+// Scenario: Moving right moves the view towards what is on the right of the rendered image
+TEST_F(NMCameraControllerTest, Move_MatchesViewTransform)
+{
+    // Given
+    NMCameraController controller;
+    controller.LookAt(NMPoint(1.0f, 2.0f, -5.0f), NMPoint(0.0f, 1.0f, 0.0f));
+    controller.Rotate(0.7f, -0.2f);
+
+    // When
+    NMMatrix before = controller.GetViewTransform();
+    controller.Move(0.0f, 1.0f, 1.0f);
+    NMPoint target = before * controller.GetTarget();
+
+    // Then camera space +x is to the left of the image (see NMCamera::RayForPixel()) and +y is up
+    EXPECT_LT(target.GetX(), 0.0f);
+    EXPECT_GT(target.GetY(), 0.0f);
+}
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "NMRender/Overlay.hpp"
+
+class NMOverlayTest : public testing::Test
+{
+};
+
+// Scenario: A glyph is laid out as one rectangle per set font pixel
+TEST_F(NMOverlayTest, LayoutText_Glyph)
+{
+    // When
+    std::vector<SNMOverlayRect> rects = nmoverlay::LayoutText("1", 10, 20, 2);
+
+    // Then the 1 is a stem with a flag and a foot: .#. ##. .#. .#. ###
+    ASSERT_EQ(rects.size(), 8u);
+    EXPECT_EQ(rects[0].x, 12);
+    EXPECT_EQ(rects[0].y, 20);
+    EXPECT_EQ(rects[0].w, 2);
+    EXPECT_EQ(rects[0].h, 2);
+    EXPECT_EQ(rects[1].x, 10);
+    EXPECT_EQ(rects[1].y, 22);
+    EXPECT_EQ(rects[7].x, 14);
+    EXPECT_EQ(rects[7].y, 28);
+}
+
+// Scenario: Characters advance by the glyph width and one pixel of spacing, unknown ones as blanks
+TEST_F(NMOverlayTest, LayoutText_Advance)
+{
+    // When
+    std::vector<SNMOverlayRect> single = nmoverlay::LayoutText("1", 0, 0, 1);
+    std::vector<SNMOverlayRect> spaced = nmoverlay::LayoutText("1 ~1", 0, 0, 1);
+
+    // Then
+    ASSERT_EQ(spaced.size(), 2 * single.size());
+    for (std::size_t i = 0; i < single.size(); ++i)
+    {
+        EXPECT_EQ(spaced[single.size() + i].x, single[i].x + 3 * (nmoverlay::GLYPH_WIDTH + 1));
+        EXPECT_EQ(spaced[single.size() + i].y, single[i].y);
+    }
+    EXPECT_TRUE(nmoverlay::LayoutText("", 0, 0, 1).empty());
+}
+
+// Scenario: Lowercase letters are drawn as uppercase
+TEST_F(NMOverlayTest, LayoutText_Lowercase)
+{
+    // When
+    std::vector<SNMOverlayRect> lower = nmoverlay::LayoutText("orbit", 0, 0, 1);
+    std::vector<SNMOverlayRect> upper = nmoverlay::LayoutText("ORBIT", 0, 0, 1);
+
+    // Then
+    ASSERT_EQ(lower.size(), upper.size());
+    ASSERT_FALSE(lower.empty());
+    for (std::size_t i = 0; i < lower.size(); ++i)
+    {
+        EXPECT_EQ(lower[i].x, upper[i].x);
+        EXPECT_EQ(lower[i].y, upper[i].y);
+    }
+}
+
+// Scenario: The text width ends at the last glyph, without trailing spacing
+TEST_F(NMOverlayTest, TextWidth)
+{
+    EXPECT_EQ(nmoverlay::TextWidth("ABC", 2), 22);
+    EXPECT_EQ(nmoverlay::TextWidth("8", 1), nmoverlay::GLYPH_WIDTH);
+
+    int right = 0;
+    for (const SNMOverlayRect& rect : nmoverlay::LayoutText("888", 5, 0, 3))
+    {
+        right = std::max(right, rect.x + rect.w);
+    }
+    EXPECT_EQ(right - 5, nmoverlay::TextWidth("888", 3));
+}
@@ -89,7 +89,7 @@ endfunction()
 function(nm_test)
     set(options "")
     set(oneValueArgs PKG_PREFIX PKG_NAME PKG_TYPE)
-    set(multiValueArgs LINK_LIBRARIES)
+    set(multiValueArgs LINK_LIBRARIES LABELS)
     cmake_parse_arguments(ARG "${options}" "${oneValueArgs}" "${multiValueArgs}" ${ARGN})
 
     # set default PKG_PREFIX if not specified
@@ -133,9 +133,17 @@ function(nm_test)
         $<BUILD_INTERFACE:${CMAKE_CURRENT_SOURCE_DIR}/Public>
     )
 
-    gtest_discover_tests(${PKG_NAME}
-        TEST_PREFIX "${ARG_PKG_TYPE}/${ARG_PKG_NAME}/"
-    )
+    # Labels select or exclude whole test executables, e.g. ctest -LE perf
+    if(ARG_LABELS)
+        gtest_discover_tests(${PKG_NAME}
+            TEST_PREFIX "${ARG_PKG_TYPE}/${ARG_PKG_NAME}/"
+            PROPERTIES LABELS "${ARG_LABELS}"
+        )
+    else()
+        gtest_discover_tests(${PKG_NAME}
+            TEST_PREFIX "${ARG_PKG_TYPE}/${ARG_PKG_NAME}/"
+        )
+    endif()
 
     if("${WITH_COVERAGE}" STREQUAL "ON")
         add_custom_target(${PKG_NAME}Coverage # ALL
@@ -175,3 +183,61 @@ function(nm_test)
         )
     endif()
 endfunction()
+
+function(nm_bench)
+    set(options "")
+    set(oneValueArgs PKG_PREFIX PKG_NAME PKG_TYPE)
+    set(multiValueArgs LINK_LIBRARIES)
+    cmake_parse_arguments(ARG "${options}" "${oneValueArgs}" "${multiValueArgs}" ${ARGN})
+
+    # set default PKG_PREFIX if not specified
+    if(NOT ARG_PKG_PREFIX)
+        set(ARG_PKG_PREFIX "NM")
+    endif()
+
+    set(PKG_NAME "Bench${ARG_PKG_TYPE}${ARG_PKG_PREFIX}${ARG_PKG_NAME}")
+    file(GLOB_RECURSE SOURCES CONFIGURE_DEPENDS
+        ${CMAKE_CURRENT_SOURCE_DIR}/Public/*.hpp
+        ${CMAKE_CURRENT_SOURCE_DIR}/Private/*.hpp
+        ${CMAKE_CURRENT_SOURCE_DIR}/Private/*.cpp
+    )
+
+    add_executable(${PKG_NAME} ${SOURCES})
+    set_target_properties(${PKG_NAME} PROPERTIES
+        FOLDER "Bench"
+    )
+
+    target_link_libraries(${PKG_NAME}
+        PUBLIC
+            benchmark::benchmark benchmark::benchmark_main
+
+            ${ARG_LINK_LIBRARIES}
+    )
+
+    target_compile_options(${PKG_NAME} PRIVATE
+        $<$<OR:$<CXX_COMPILER_ID:Clang>,$<CXX_COMPILER_ID:AppleClang>,$<CXX_COMPILER_ID:GNU>>:
+            -Wall -Werror -pedantic-errors -Wextra -Wconversion -Wsign-conversion
+        >
+        $<$<CXX_COMPILER_ID:MSVC>:
+            /W4 /WX
+        >
+    )
+
+    target_include_directories(${PKG_NAME} PUBLIC
+        $<BUILD_INTERFACE:${CMAKE_CURRENT_SOURCE_DIR}/Public>
+    )
+
+    # Run the benchmark and write a JSON report for regression tracking
+    set(REPORT ${PROJECT_BINARY_DIR}/bench/${PKG_NAME}.json)
+    add_custom_target(${PKG_NAME}JSON
+        COMMAND ${CMAKE_COMMAND} -E make_directory ${PROJECT_BINARY_DIR}/bench
+        COMMAND $<TARGET_FILE:${PKG_NAME}> --benchmark_out=${REPORT} --benchmark_out_format=json
+        DEPENDS ${PKG_NAME}
+        BYPRODUCTS ${REPORT}
+        WORKING_DIRECTORY ${CMAKE_CURRENT_BINARY_DIR}
+    )
+    set_target_properties(${PKG_NAME}JSON PROPERTIES
+        FOLDER "Bench"
+    )
+    set_property(GLOBAL APPEND PROPERTY NM_BENCH_REPORTS ${PKG_NAME}JSON)
+endfunction()